@@ -0,0 +1,277 @@
+/*
+ * Arena functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_arena.h"
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_libcerror.h"
+
+/* Creates an arena
+ * Make sure the value arena is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_arena_initialize(
+     libfsntfs_arena_t **arena,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_arena_initialize";
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *arena != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid arena value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*arena = memory_allocate_structure(
+	          libfsntfs_arena_t );
+
+	if( *arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create arena.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *arena,
+	     0,
+	     sizeof( libfsntfs_arena_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear arena.",
+		 function );
+
+		goto on_error;
+	}
+	( *arena )->block_size = block_size;
+
+	return( 1 );
+
+on_error:
+	if( *arena != NULL )
+	{
+		memory_free(
+		 *arena );
+
+		*arena = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an arena
+ * All the data allocated from the arena is freed with it
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_arena_free(
+     libfsntfs_arena_t **arena,
+     libcerror_error_t **error )
+{
+	libfsntfs_arena_block_t *block = NULL;
+	static char *function          = "libfsntfs_arena_free";
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *arena != NULL )
+	{
+		while( ( *arena )->blocks != NULL )
+		{
+			block = ( *arena )->blocks;
+
+			( *arena )->blocks = block->next_block;
+
+			memory_free(
+			 block );
+		}
+		memory_free(
+		 *arena );
+
+		*arena = NULL;
+	}
+	return( 1 );
+}
+
+/* Allocates data from an arena
+ * The data is aligned to LIBFSNTFS_ARENA_ALIGNMENT, is not cleared
+ * and remains valid until the arena is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_arena_allocate(
+     libfsntfs_arena_t *arena,
+     size_t size,
+     uint8_t **data,
+     libcerror_error_t **error )
+{
+	libfsntfs_arena_block_t *block = NULL;
+	static char *function          = "libfsntfs_arena_allocate";
+	size_t block_data_size         = 0;
+	size_t block_header_size       = 0;
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) ( SSIZE_MAX - LIBFSNTFS_ARENA_ALIGNMENT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	/* Like memory_allocate a zero size allocation returns a distinct pointer
+	 */
+	if( size == 0 )
+	{
+		size = LIBFSNTFS_ARENA_ALIGNMENT;
+	}
+	else
+	{
+		size = ( size + ( LIBFSNTFS_ARENA_ALIGNMENT - 1 ) ) & ~( (size_t) LIBFSNTFS_ARENA_ALIGNMENT - 1 );
+	}
+
+	block = arena->blocks;
+
+	if( ( block == NULL )
+	 || ( size > ( block->data_size - block->data_offset ) ) )
+	{
+		block_header_size = ( sizeof( libfsntfs_arena_block_t ) + ( LIBFSNTFS_ARENA_ALIGNMENT - 1 ) ) & ~( (size_t) LIBFSNTFS_ARENA_ALIGNMENT - 1 );
+
+		/* Data larger than half the block size is allocated in a block of its own
+		 */
+		if( size > ( arena->block_size / 2 ) )
+		{
+			block_data_size = size;
+		}
+		else
+		{
+			block_data_size = arena->block_size;
+		}
+		block = (libfsntfs_arena_block_t *) memory_allocate(
+		                                     block_header_size + block_data_size );
+
+		if( block == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create block.",
+			 function );
+
+			return( -1 );
+		}
+		block->data        = &( ( (uint8_t *) block )[ block_header_size ] );
+		block->data_size   = block_data_size;
+		block->data_offset = 0;
+
+		/* A block of its own is linked after the first block so that
+		 * the unused data of the first block remains available
+		 */
+		if( ( size > ( arena->block_size / 2 ) )
+		 && ( arena->blocks != NULL ) )
+		{
+			block->next_block         = arena->blocks->next_block;
+			arena->blocks->next_block = block;
+		}
+		else
+		{
+			block->next_block = arena->blocks;
+			arena->blocks     = block;
+		}
+		arena->number_of_blocks += 1;
+	}
+	*data = &( block->data[ block->data_offset ] );
+
+	block->data_offset           += size;
+	arena->number_of_allocations += 1;
+
+	return( 1 );
+}
+
@@ -0,0 +1,97 @@
+/*
+ * Arena functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_ARENA_H )
+#define _LIBFSNTFS_ARENA_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_arena_block libfsntfs_arena_block_t;
+
+struct libfsntfs_arena_block
+{
+	/* The next block
+	 */
+	libfsntfs_arena_block_t *next_block;
+
+	/* The data
+	 * The data is stored directly after the block
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The offset of the unused data
+	 */
+	size_t data_offset;
+};
+
+typedef struct libfsntfs_arena libfsntfs_arena_t;
+
+struct libfsntfs_arena
+{
+	/* The blocks, allocations are made from the first block
+	 */
+	libfsntfs_arena_block_t *blocks;
+
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The number of blocks
+	 */
+	int number_of_blocks;
+
+	/* The number of allocations
+	 */
+	int number_of_allocations;
+};
+
+int libfsntfs_arena_initialize(
+     libfsntfs_arena_t **arena,
+     size_t block_size,
+     libcerror_error_t **error );
+
+int libfsntfs_arena_free(
+     libfsntfs_arena_t **arena,
+     libcerror_error_t **error );
+
+int libfsntfs_arena_allocate(
+     libfsntfs_arena_t *arena,
+     size_t size,
+     uint8_t **data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
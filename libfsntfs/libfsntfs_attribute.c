@@ -28,13 +28,14 @@
 #include <wctype.h>
 #endif
 
+#include "libfsntfs_arena.h"
 #include "libfsntfs_attribute.h"
 #include "libfsntfs_bitmap_values.h"
 #include "libfsntfs_cluster_block.h"
 #include "libfsntfs_cluster_block_vector.h"
-#include "libfsntfs_data_run.h"
 #include "libfsntfs_debug.h"
 #include "libfsntfs_definitions.h"
+#include "libfsntfs_extent_table.h"
 #include "libfsntfs_file_name_values.h"
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
@@ -60,10 +61,12 @@
 
 /* Creates an attribute
  * Make sure the value attribute is referencing, is set to NULL
+ * If an arena is provided the attribute, its name, data and value are allocated from the arena
  * Returns 1 if successful or -1 on error
  */
 int libfsntfs_attribute_initialize(
      libfsntfs_attribute_t **attribute,
+     libfsntfs_arena_t *arena,
      libcerror_error_t **error )
 {
 	libfsntfs_internal_attribute_t *internal_attribute = NULL;
@@ -91,19 +94,40 @@ int libfsntfs_attribute_initialize(
 
 		return( -1 );
 	}
-	internal_attribute = memory_allocate_structure(
-	                      libfsntfs_internal_attribute_t );
+	if( arena != NULL )
+	{
+		if( libfsntfs_arena_allocate(
+		     arena,
+		     sizeof( libfsntfs_internal_attribute_t ),
+		     (uint8_t **) &internal_attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create attribute.",
+			 function );
 
-	if( internal_attribute == NULL )
+			goto on_error;
+		}
+	}
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create attribute.",
-		 function );
+		internal_attribute = memory_allocate_structure(
+		                      libfsntfs_internal_attribute_t );
 
-		goto on_error;
+		if( internal_attribute == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create attribute.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	if( memory_set(
 	     internal_attribute,
@@ -117,31 +141,17 @@ int libfsntfs_attribute_initialize(
 		 "%s: unable to clear attribute.",
 		 function );
 
-		memory_free(
-		 internal_attribute );
-
-		return( -1 );
-	}
-	if( libcdata_array_initialize(
-	     &( internal_attribute->data_runs_array ),
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data runs array.",
-		 function );
-
 		goto on_error;
 	}
+	internal_attribute->arena = arena;
+
 	*attribute = (libfsntfs_attribute_t *) internal_attribute;
 
 	return( 1 );
 
 on_error:
-	if( internal_attribute != NULL )
+	if( ( internal_attribute != NULL )
+	 && ( arena == NULL ) )
 	{
 		memory_free(
 		 internal_attribute );
@@ -199,29 +209,34 @@ int libfsntfs_internal_attribute_free(
 	}
 	if( *internal_attribute != NULL )
 	{
-		if( ( *internal_attribute )->name != NULL )
-		{
-			memory_free(
-			 ( *internal_attribute )->name );
-		}
-		if( ( *internal_attribute )->data != NULL )
+		if( ( *internal_attribute )->arena == NULL )
 		{
-			memory_free(
-			 ( *internal_attribute )->data );
+			if( ( *internal_attribute )->name != NULL )
+			{
+				memory_free(
+				 ( *internal_attribute )->name );
+			}
+			if( ( *internal_attribute )->data != NULL )
+			{
+				memory_free(
+				 ( *internal_attribute )->data );
+			}
 		}
-		if( libcdata_array_free(
-		     &( ( *internal_attribute )->data_runs_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_data_run_free,
-		     error ) != 1 )
+		if( ( *internal_attribute )->extent_table != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free data runs array.",
-			 function );
+			if( libfsntfs_extent_table_free(
+			     &( ( *internal_attribute )->extent_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free extent table.",
+				 function );
 
-			result = -1;
+				result = -1;
+			}
 		}
 		if( ( *internal_attribute )->value != NULL )
 		{
@@ -242,9 +257,13 @@ int libfsntfs_internal_attribute_free(
 				}
 			}
 		}
-		memory_free(
-		 *internal_attribute );
-
+		/* An attribute allocated from the arena is freed together with the arena
+		 */
+		if( ( *internal_attribute )->arena == NULL )
+		{
+			memory_free(
+			 *internal_attribute );
+		}
 		*internal_attribute = NULL;
 	}
 	return( result );
@@ -310,7 +329,6 @@ ssize_t libfsntfs_attribute_read_from_mft(
          uint8_t flags,
          libcerror_error_t **error )
 {
-	libfsntfs_data_run_t *data_run                     = NULL;
 	libfsntfs_internal_attribute_t *internal_attribute = NULL;
 	uint8_t *mft_attribute_data_run_data               = NULL;
 	uint8_t *mft_attribute_header_data                 = NULL;
@@ -324,6 +342,8 @@ ssize_t libfsntfs_attribute_read_from_mft(
 	size_t non_resident_data_size                      = 0;
 	size_t unknown_data_size                           = 0;
 	uint64_t data_run_number_of_cluster_blocks         = 0;
+	uint64_t data_run_lcn                              = 0;
+	uint64_t data_run_vcn                              = 0;
 	uint64_t last_data_run_cluster_block_number        = 0;
 	int64_t data_run_cluster_block_number              = 0;
 	uint32_t attribute_data_size                       = 0;
@@ -337,7 +357,6 @@ ssize_t libfsntfs_attribute_read_from_mft(
 	uint8_t data_run_value_size_tuple                  = 0;
 	uint8_t non_resident_flag                          = 0;
 	int data_run_index                                 = 0;
-	int entry_index                                    = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	libcstring_system_character_t *value_string        = NULL;
@@ -893,19 +912,40 @@ ssize_t libfsntfs_attribute_read_from_mft(
 				 0 );
 			}
 #endif
-			internal_attribute->name = (uint8_t *) memory_allocate(
-			                                        sizeof( uint8_t ) * (size_t) internal_attribute->name_size );
+			if( internal_attribute->arena != NULL )
+			{
+				if( libfsntfs_arena_allocate(
+				     internal_attribute->arena,
+				     sizeof( uint8_t ) * (size_t) internal_attribute->name_size,
+				     &( internal_attribute->name ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create attribute name.",
+					 function );
 
-			if( internal_attribute->name == NULL )
+					goto on_error;
+				}
+			}
+			else
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-				 "%s: unable to create attribute name.",
-				 function );
+				internal_attribute->name = (uint8_t *) memory_allocate(
+				                                        sizeof( uint8_t ) * (size_t) internal_attribute->name_size );
 
-				goto on_error;
+				if( internal_attribute->name == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create attribute name.",
+					 function );
+
+					goto on_error;
+				}
 			}
 			if( memory_copy(
 			     internal_attribute->name,
@@ -1030,6 +1070,8 @@ ssize_t libfsntfs_attribute_read_from_mft(
 			}
 			mft_attribute_data_run_data = &( mft_entry_data[ mft_attribute_data_offset ] );
 
+			data_run_vcn = internal_attribute->data_first_vcn;
+
 			while( *mft_attribute_data_run_data != 0 )
 			{
 				if( ( mft_attribute_data_offset + 1 ) > mft_entry_data_size )
@@ -1172,12 +1214,14 @@ ssize_t libfsntfs_attribute_read_from_mft(
 				}
 				if( data_run_value_size == 0 )
 				{
+					data_run_lcn    = 0;
 					data_run_offset = 0;
 				}
 				else
 				{
 					last_data_run_cluster_block_number += data_run_cluster_block_number;
 
+					data_run_lcn    = last_data_run_cluster_block_number;
 					data_run_offset = (off64_t) ( last_data_run_cluster_block_number * io_handle->cluster_block_size );
 				}
 				data_run_size = (size64_t) ( data_run_number_of_cluster_blocks * io_handle->cluster_block_size );
@@ -1222,42 +1266,45 @@ ssize_t libfsntfs_attribute_read_from_mft(
 */
 				data_block_offset += data_run_size;
 
-				if( libfsntfs_data_run_initialize(
-				     &data_run,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create data run.",
-					 function );
-
-					goto on_error;
-				}
-				data_run->start_offset = data_run_offset;
-				data_run->size         = data_run_size;
-				data_run->range_flags  = range_flags;
-
 				if( ( flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) == 0 )
 				{
-					if( libcdata_array_append_entry(
-					     internal_attribute->data_runs_array,
-					     &entry_index,
-					     (intptr_t *) data_run,
+					if( internal_attribute->extent_table == NULL )
+					{
+						if( libfsntfs_extent_table_initialize(
+						     &( internal_attribute->extent_table ),
+						     io_handle->cluster_block_size,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+							 "%s: unable to create extent table.",
+							 function );
+
+							goto on_error;
+						}
+					}
+					if( libfsntfs_extent_table_append_extent(
+					     internal_attribute->extent_table,
+					     data_run_vcn,
+					     data_run_lcn,
+					     data_run_number_of_cluster_blocks,
+					     range_flags,
 					     error ) != 1 )
 					{
 						libcerror_error_set(
 						 error,
 						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-						 "%s: unable to append data run to array.",
-						 function );
+						 "%s: unable to append data run: %d to extent table.",
+						 function,
+						 data_run_index );
 
 						goto on_error;
 					}
 				}
-				data_run = NULL;
+				data_run_vcn += data_run_number_of_cluster_blocks;
 
 				data_run_index++;
 			}
@@ -1293,19 +1340,40 @@ ssize_t libfsntfs_attribute_read_from_mft(
 				goto on_error;
 			}
 #endif
-			internal_attribute->data = (uint8_t *) memory_allocate(
-			                                        sizeof( uint8_t ) * attribute_data_size );
+			if( internal_attribute->arena != NULL )
+			{
+				if( libfsntfs_arena_allocate(
+				     internal_attribute->arena,
+				     sizeof( uint8_t ) * attribute_data_size,
+				     &( internal_attribute->data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create attribute data.",
+					 function );
 
-			if( internal_attribute->data == NULL )
+					goto on_error;
+				}
+			}
+			else
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-				 "%s: unable to create attribute data.",
-				 function );
+				internal_attribute->data = (uint8_t *) memory_allocate(
+				                                        sizeof( uint8_t ) * attribute_data_size );
 
-				goto on_error;
+				if( internal_attribute->data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create attribute data.",
+					 function );
+
+					goto on_error;
+				}
 			}
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
@@ -1361,25 +1429,25 @@ on_error:
 		 value_string );
 	}
 #endif
-	if( data_run != NULL )
-	{
-		libfsntfs_data_run_free(
-		 &data_run,
-		 NULL );
-	}
 	if( internal_attribute->name != NULL )
 	{
-		memory_free(
-		 internal_attribute->name );
-
+		/* A name allocated from the arena is freed together with the arena
+		 */
+		if( internal_attribute->arena == NULL )
+		{
+			memory_free(
+			 internal_attribute->name );
+		}
 		internal_attribute->name = NULL;
 	}
 	internal_attribute->name_size = 0;
 
-	libcdata_array_empty(
-	 internal_attribute->data_runs_array,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_data_run_free,
-	 NULL );
+	if( internal_attribute->extent_table != NULL )
+	{
+		libfsntfs_extent_table_free(
+		 &( internal_attribute->extent_table ),
+		 NULL );
+	}
 
 	return( -1 );
 }
@@ -1878,6 +1946,7 @@ int libfsntfs_attribute_read_value(
 
 				if( libfsntfs_file_name_values_initialize(
 				     (libfsntfs_file_name_values_t **) &( internal_attribute->value ),
+				     internal_attribute->arena,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
@@ -2098,6 +2167,7 @@ int libfsntfs_attribute_read_value(
 
 				if( libfsntfs_standard_information_values_initialize(
 				     (libfsntfs_standard_information_values_t **) &( internal_attribute->value ),
+				     internal_attribute->arena,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
@@ -2273,8 +2343,8 @@ int libfsntfs_attribute_read_value(
 
 				goto on_error;
 			}
-			if( libcdata_array_get_number_of_entries(
-			     internal_attribute->data_runs_array,
+			if( libfsntfs_attribute_get_number_of_data_runs(
+			     attribute,
 			     &number_of_data_runs,
 			     error ) != 1 )
 			{
@@ -3539,16 +3609,31 @@ int libfsntfs_attribute_get_number_of_data_runs(
 	}
 	internal_attribute = (libfsntfs_internal_attribute_t *) attribute;
 
-	if( libcdata_array_get_number_of_entries(
-	     internal_attribute->data_runs_array,
-	     number_of_data_runs,
-	     error ) != 1 )
+	if( number_of_data_runs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of data runs.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_attribute->extent_table == NULL )
+	{
+		*number_of_data_runs = 0;
+	}
+	else if( libfsntfs_extent_table_get_number_of_extents(
+	          internal_attribute->extent_table,
+	          number_of_data_runs,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of data runs.",
+		 "%s: unable to retrieve number of extents.",
 		 function );
 
 		return( -1 );
@@ -3557,16 +3642,22 @@ int libfsntfs_attribute_get_number_of_data_runs(
 }
 
 /* Retrieves a specific data run
+ * The data run offset is 0 for a sparse data run
  * Returns 1 if successful or -1 on error
  */
 int libfsntfs_attribute_get_data_run_by_index(
      libfsntfs_attribute_t *attribute,
      int data_run_index,
-     libfsntfs_data_run_t **data_run,
+     off64_t *data_run_offset,
+     size64_t *data_run_size,
+     uint32_t *data_run_flags,
      libcerror_error_t **error )
 {
 	libfsntfs_internal_attribute_t *internal_attribute = NULL;
 	static char *function                              = "libfsntfs_attribute_get_data_run_by_index";
+	uint64_t first_lcn                                 = 0;
+	uint64_t first_vcn                                 = 0;
+	uint64_t number_of_clusters                        = 0;
 
 	if( attribute == NULL )
 	{
@@ -3581,22 +3672,102 @@ int libfsntfs_attribute_get_data_run_by_index(
 	}
 	internal_attribute = (libfsntfs_internal_attribute_t *) attribute;
 
-	if( libcdata_array_get_entry_by_index(
-	     internal_attribute->data_runs_array,
+	if( internal_attribute->extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid attribute - missing extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_run_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data run offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_run_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data run size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_extent_table_get_extent_by_index(
+	     internal_attribute->extent_table,
 	     data_run_index,
-	     (intptr_t **) data_run,
+	     &first_vcn,
+	     &first_lcn,
+	     &number_of_clusters,
+	     data_run_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data run: %d.",
+		 "%s: unable to retrieve extent: %d.",
 		 function,
 		 data_run_index );
 
 		return( -1 );
 	}
+	*data_run_offset = (off64_t) ( first_lcn * internal_attribute->extent_table->cluster_block_size );
+	*data_run_size   = (size64_t) ( number_of_clusters * internal_attribute->extent_table->cluster_block_size );
+
+	return( 1 );
+}
+
+/* Retrieves the extent table
+ * The extent table is NULL if the attribute has no data runs
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_attribute_get_extent_table(
+     libfsntfs_attribute_t *attribute,
+     libfsntfs_extent_table_t **extent_table,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_attribute_t *internal_attribute = NULL;
+	static char *function                              = "libfsntfs_attribute_get_extent_table";
+
+	if( attribute == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid attribute.",
+		 function );
+
+		return( -1 );
+	}
+	internal_attribute = (libfsntfs_internal_attribute_t *) attribute;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	*extent_table = internal_attribute->extent_table;
+
 	return( 1 );
 }
 
@@ -25,7 +25,8 @@
 #include <common.h>
 #include <types.h>
 
-#include "libfsntfs_data_run.h"
+#include "libfsntfs_arena.h"
+#include "libfsntfs_extent_table.h"
 #include "libfsntfs_extern.h"
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
@@ -43,6 +44,11 @@ typedef struct libfsntfs_internal_attribute libfsntfs_internal_attribute_t;
 
 struct libfsntfs_internal_attribute
 {
+	/* The arena the attribute, its name and data are allocated from
+	 * NULL if they are allocated on the heap
+	 */
+	libfsntfs_arena_t *arena;
+
 	/* The size
 	 */
 	uint32_t size;
@@ -99,9 +105,9 @@ struct libfsntfs_internal_attribute
 	 */
 	size64_t data_size;
 
-	/* The data runs array
+	/* The extent table that contains the data runs
 	 */
-	libcdata_array_t *data_runs_array;
+	libfsntfs_extent_table_t *extent_table;
 
 	/* The file reference
 	 */
@@ -124,6 +130,7 @@ struct libfsntfs_internal_attribute
 
 int libfsntfs_attribute_initialize(
      libfsntfs_attribute_t **attribute,
+     libfsntfs_arena_t *arena,
      libcerror_error_t **error );
 
 LIBFSNTFS_EXTERN \
@@ -275,7 +282,14 @@ int libfsntfs_attribute_get_number_of_data_runs(
 int libfsntfs_attribute_get_data_run_by_index(
      libfsntfs_attribute_t *attribute,
      int data_run_index,
-     libfsntfs_data_run_t **data_run,
+     off64_t *data_run_offset,
+     size64_t *data_run_size,
+     uint32_t *data_run_flags,
+     libcerror_error_t **error );
+
+int libfsntfs_attribute_get_extent_table(
+     libfsntfs_attribute_t *attribute,
+     libfsntfs_extent_table_t **extent_table,
      libcerror_error_t **error );
 
 int libfsntfs_attribute_get_chained_attribute(
@@ -100,6 +100,7 @@ int libfsntfs_attribute_list_read(
 	{
 		if( libfsntfs_attribute_initialize(
 		     &list_attribute,
+		     NULL,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -0,0 +1,266 @@
+/*
+ * Bitmap run functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <types.h>
+
+#include "libfsntfs_bitmap_runs.h"
+#include "libfsntfs_libcerror.h"
+
+/* Determines the number of trailing zero bits of a non-zero 64-bit value
+ * Returns the number of trailing zero bits
+ */
+int libfsntfs_bitmap_runs_get_number_of_trailing_zero_bits(
+     uint64_t value )
+{
+#if defined( __GNUC__ ) && ( __GNUC__ >= 4 )
+	return( __builtin_ctzll( (unsigned long long) value ) );
+#else
+	int number_of_bits = 0;
+
+	if( ( value & 0x00000000ffffffffULL ) == 0 )
+	{
+		number_of_bits += 32;
+		value         >>= 32;
+	}
+	if( ( value & 0x000000000000ffffULL ) == 0 )
+	{
+		number_of_bits += 16;
+		value         >>= 16;
+	}
+	if( ( value & 0x00000000000000ffULL ) == 0 )
+	{
+		number_of_bits += 8;
+		value         >>= 8;
+	}
+	if( ( value & 0x000000000000000fULL ) == 0 )
+	{
+		number_of_bits += 4;
+		value         >>= 4;
+	}
+	if( ( value & 0x0000000000000003ULL ) == 0 )
+	{
+		number_of_bits += 2;
+		value         >>= 2;
+	}
+	if( ( value & 0x0000000000000001ULL ) == 0 )
+	{
+		number_of_bits += 1;
+	}
+	return( number_of_bits );
+#endif
+}
+
+/* Finds the first bit with a specific value at or after a specific bit index
+ * The bitmap is processed 64 bits at a time, words that do not contain
+ * the bit value are skipped without inspecting the individual bits
+ * Returns 1 if successful, 0 if no such bit or -1 on error
+ */
+int libfsntfs_bitmap_runs_find_bit(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t bit_index,
+     uint8_t bit_value,
+     uint64_t *found_bit_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_bitmap_runs_find_bit";
+	size_t byte_index     = 0;
+	size_t data_offset    = 0;
+	size_t remaining_size = 0;
+	uint64_t value_64bit  = 0;
+	uint64_t valid_bits   = 0;
+	uint8_t bit_shift     = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( found_bit_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid found bit index.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_index >= ( (uint64_t) data_size * 8 ) )
+	{
+		return( 0 );
+	}
+	data_offset = (size_t) ( bit_index / 64 ) * 8;
+	bit_shift   = (uint8_t) ( bit_index % 64 );
+
+	while( data_offset < data_size )
+	{
+		remaining_size = data_size - data_offset;
+
+		if( remaining_size >= 8 )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( data[ data_offset ] ),
+			 value_64bit );
+
+			valid_bits = ~( (uint64_t) 0 );
+		}
+		else
+		{
+			value_64bit = 0;
+
+			for( byte_index = remaining_size;
+			     byte_index > 0;
+			     byte_index-- )
+			{
+				value_64bit <<= 8;
+				value_64bit  |= data[ data_offset + byte_index - 1 ];
+			}
+			valid_bits = ( (uint64_t) 1 << ( remaining_size * 8 ) ) - 1;
+		}
+		if( bit_value == 0 )
+		{
+			value_64bit = ~value_64bit;
+		}
+		value_64bit &= valid_bits & ( ~( (uint64_t) 0 ) << bit_shift );
+
+		if( value_64bit != 0 )
+		{
+			*found_bit_index = ( (uint64_t) data_offset * 8 )
+			                 + libfsntfs_bitmap_runs_get_number_of_trailing_zero_bits(
+			                    value_64bit );
+
+			return( 1 );
+		}
+		data_offset += 8;
+		bit_shift    = 0;
+	}
+	return( 0 );
+}
+
+/* Retrieves the next run of set bits at or after a specific bit index
+ * Returns 1 if successful, 0 if no such run or -1 on error
+ */
+int libfsntfs_bitmap_runs_get_next_run(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t bit_index,
+     uint64_t *run_bit_index,
+     uint64_t *run_number_of_bits,
+     libcerror_error_t **error )
+{
+	static char *function  = "libfsntfs_bitmap_runs_get_next_run";
+	uint64_t end_bit_index = 0;
+	int result             = 0;
+
+	if( run_bit_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run bit index.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_number_of_bits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run number of bits.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_bitmap_runs_find_bit(
+	          data,
+	          data_size,
+	          bit_index,
+	          1,
+	          run_bit_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find start of run.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	result = libfsntfs_bitmap_runs_find_bit(
+	          data,
+	          data_size,
+	          *run_bit_index + 1,
+	          0,
+	          &end_bit_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find end of run.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		end_bit_index = (uint64_t) data_size * 8;
+	}
+	*run_number_of_bits = end_bit_index - *run_bit_index;
+
+	return( 1 );
+}
+
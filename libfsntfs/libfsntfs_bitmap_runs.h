@@ -1,5 +1,5 @@
 /*
- * Data run functions
+ * Bitmap run functions
  *
  * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
  *
@@ -19,8 +19,8 @@
  * along with this software.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#if !defined( _LIBFSNTFS_DATA_RUN_H )
-#define _LIBFSNTFS_DATA_RUN_H
+#if !defined( _LIBFSNTFS_BITMAP_RUNS_H )
+#define _LIBFSNTFS_BITMAP_RUNS_H
 
 #include <common.h>
 #include <types.h>
@@ -31,29 +31,23 @@
 extern "C" {
 #endif
 
-typedef struct libfsntfs_data_run libfsntfs_data_run_t;
+int libfsntfs_bitmap_runs_get_number_of_trailing_zero_bits(
+     uint64_t value );
 
-struct libfsntfs_data_run
-{
-	/* The start offset
-	 */
-	off64_t start_offset;
-
-	/* The size
-	 */
-	size64_t size;
-
-	/* The range flags
-	 */
-	uint32_t range_flags;
-};
-
-int libfsntfs_data_run_initialize(
-     libfsntfs_data_run_t **data_run,
+int libfsntfs_bitmap_runs_find_bit(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t bit_index,
+     uint8_t bit_value,
+     uint64_t *found_bit_index,
      libcerror_error_t **error );
 
-int libfsntfs_data_run_free(
-     libfsntfs_data_run_t **data_run,
+int libfsntfs_bitmap_runs_get_next_run(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t bit_index,
+     uint64_t *run_bit_index,
+     uint64_t *run_number_of_bits,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
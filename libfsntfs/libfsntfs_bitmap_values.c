@@ -23,6 +23,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsntfs_bitmap_runs.h"
 #include "libfsntfs_bitmap_values.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libcnotify.h"
@@ -140,15 +141,13 @@ int libfsntfs_bitmap_values_read(
      size_t data_size,
      libcerror_error_t **error )
 {
-	static char *function             = "libfsntfs_bitmap_values_read";
-	size_t data_offset                = 0;
-	uint8_t bit_index                 = 0;
-	uint8_t byte_value                = 0;
-	uint8_t in_allocated_range        = 0;
-	int allocated_element_index       = 0;
+	static char *function       = "libfsntfs_bitmap_values_read";
 
 #if defined( HAVE_DEBUG_OUTPUT )
-	int first_allocated_element_index = 0;
+	uint64_t bit_index          = 0;
+	uint64_t run_bit_index      = 0;
+	uint64_t run_number_of_bits = 0;
+	int result                  = 0;
 #endif
 
 	if( bitmap_values == NULL )
@@ -194,83 +193,50 @@ int libfsntfs_bitmap_values_read(
 		 data,
 		 data_size,
 		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
-	}
-#endif
-	while( data_offset < data_size )
-	{
-		byte_value = data[ data_offset ];
-
-		data_offset++;
 
-		for( bit_index = 0;
-		     bit_index < 8;
-		     bit_index++ )
+		do
 		{
-			if( in_allocated_range == 0 )
+			result = libfsntfs_bitmap_runs_get_next_run(
+			          data,
+			          data_size,
+			          bit_index,
+			          &run_bit_index,
+			          &run_number_of_bits,
+			          error );
+
+			if( result == -1 )
 			{
-				if( ( byte_value & 0x01 ) != 0 )
-				{
-					in_allocated_range            = 1;
-#if defined( HAVE_DEBUG_OUTPUT )
-					first_allocated_element_index = allocated_element_index;
-#endif
-				}
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next run.",
+				 function );
+
+				return( -1 );
 			}
-			else if( ( byte_value & 0x01 ) == 0 )
+			else if( result != 0 )
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
+				if( run_number_of_bits == 1 )
 				{
-					if( first_allocated_element_index == ( allocated_element_index - 1 ) )
-					{
-						libcnotify_printf(
-						 "%s: allocated element\t\t\t\t: %d\n",
-						 function,
-						 first_allocated_element_index );
-					}
-					else
-					{
-						libcnotify_printf(
-						 "%s: allocated element\t\t\t\t: %d - %d\n",
-						 function,
-						 first_allocated_element_index,
-						 allocated_element_index - 1 );
-					}
+					libcnotify_printf(
+					 "%s: allocated element\t\t\t\t: %" PRIu64 "\n",
+					 function,
+					 run_bit_index );
 				}
-#endif
-				in_allocated_range = 0;
-			}
-			byte_value >>= 1;
-
-			allocated_element_index++;
-		}
-	}
-	if( in_allocated_range != 0 )
-	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			if( first_allocated_element_index == ( allocated_element_index - 1 ) )
-			{
-				libcnotify_printf(
-				 "%s: allocated element\t\t\t\t: %d\n",
-				 function,
-				 first_allocated_element_index );
-			}
-			else
-			{
-				libcnotify_printf(
-				 "%s: allocated element\t\t\t\t: %d - %d\n",
-				 function,
-				 first_allocated_element_index,
-				 allocated_element_index - 1 );
+				else
+				{
+					libcnotify_printf(
+					 "%s: allocated element\t\t\t\t: %" PRIu64 " - %" PRIu64 "\n",
+					 function,
+					 run_bit_index,
+					 run_bit_index + run_number_of_bits - 1 );
+				}
+				bit_index = run_bit_index + run_number_of_bits;
 			}
 		}
-#endif
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
+		while( result != 0 );
+
 		libcnotify_printf(
 		 "\n" );
 	}
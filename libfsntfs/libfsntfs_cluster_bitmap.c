@@ -0,0 +1,729 @@
+/*
+ * Cluster allocation bitmap functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_bitmap_runs.h"
+#include "libfsntfs_cluster_bitmap.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcnotify.h"
+
+/* Creates a cluster bitmap
+ * Make sure the value cluster_bitmap is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_bitmap_initialize(
+     libfsntfs_cluster_bitmap_t **cluster_bitmap,
+     uint64_t number_of_clusters,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_cluster_bitmap_initialize";
+
+	if( cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cluster_bitmap != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid cluster bitmap value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*cluster_bitmap = memory_allocate_structure(
+	                   libfsntfs_cluster_bitmap_t );
+
+	if( *cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cluster bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *cluster_bitmap,
+	     0,
+	     sizeof( libfsntfs_cluster_bitmap_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear cluster bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	( *cluster_bitmap )->number_of_clusters = number_of_clusters;
+
+	return( 1 );
+
+on_error:
+	if( *cluster_bitmap != NULL )
+	{
+		memory_free(
+		 *cluster_bitmap );
+
+		*cluster_bitmap = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a cluster bitmap
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_bitmap_free(
+     libfsntfs_cluster_bitmap_t **cluster_bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_cluster_bitmap_free";
+
+	if( cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cluster_bitmap != NULL )
+	{
+		if( ( *cluster_bitmap )->ranges != NULL )
+		{
+			memory_free(
+			 ( *cluster_bitmap )->ranges );
+		}
+		memory_free(
+		 *cluster_bitmap );
+
+		*cluster_bitmap = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends an allocated range
+ * The ranges must be appended in ascending order, a range that is adjacent
+ * to the last range is merged with it and clusters beyond the end of the volume are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_bitmap_append_range(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t first_cluster_number,
+     uint64_t number_of_clusters,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_bitmap_range_t *last_range = NULL;
+	libfsntfs_cluster_bitmap_range_t *ranges     = NULL;
+	static char *function                        = "libfsntfs_cluster_bitmap_append_range";
+	size_t ranges_size                           = 0;
+	int maximum_number_of_ranges                 = 0;
+
+	if( cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_clusters == 0 )
+	{
+		return( 1 );
+	}
+	if( cluster_bitmap->number_of_ranges > 0 )
+	{
+		last_range = &( cluster_bitmap->ranges[ cluster_bitmap->number_of_ranges - 1 ] );
+
+		if( first_cluster_number < ( last_range->first_cluster_number + last_range->number_of_clusters ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid first cluster number value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( first_cluster_number >= cluster_bitmap->number_of_clusters )
+	{
+		return( 1 );
+	}
+	if( number_of_clusters > ( cluster_bitmap->number_of_clusters - first_cluster_number ) )
+	{
+		number_of_clusters = cluster_bitmap->number_of_clusters - first_cluster_number;
+	}
+	if( ( last_range != NULL )
+	 && ( first_cluster_number == ( last_range->first_cluster_number + last_range->number_of_clusters ) ) )
+	{
+		last_range->number_of_clusters += number_of_clusters;
+
+		cluster_bitmap->number_of_allocated_clusters += number_of_clusters;
+
+		return( 1 );
+	}
+	if( cluster_bitmap->number_of_ranges >= cluster_bitmap->maximum_number_of_ranges )
+	{
+		if( cluster_bitmap->maximum_number_of_ranges == 0 )
+		{
+			maximum_number_of_ranges = 256;
+		}
+		else if( cluster_bitmap->maximum_number_of_ranges <= ( INT_MAX / 2 ) )
+		{
+			maximum_number_of_ranges = cluster_bitmap->maximum_number_of_ranges * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of ranges value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( (size_t) maximum_number_of_ranges > ( (size_t) SSIZE_MAX / sizeof( libfsntfs_cluster_bitmap_range_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid ranges size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		ranges_size = sizeof( libfsntfs_cluster_bitmap_range_t ) * maximum_number_of_ranges;
+
+		ranges = (libfsntfs_cluster_bitmap_range_t *) memory_reallocate(
+		                                               cluster_bitmap->ranges,
+		                                               ranges_size );
+
+		if( ranges == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize ranges.",
+			 function );
+
+			return( -1 );
+		}
+		cluster_bitmap->ranges                   = ranges;
+		cluster_bitmap->maximum_number_of_ranges = maximum_number_of_ranges;
+	}
+	cluster_bitmap->ranges[ cluster_bitmap->number_of_ranges ].first_cluster_number = first_cluster_number;
+	cluster_bitmap->ranges[ cluster_bitmap->number_of_ranges ].number_of_clusters   = number_of_clusters;
+
+	cluster_bitmap->number_of_ranges += 1;
+
+	cluster_bitmap->number_of_allocated_clusters += number_of_clusters;
+
+	return( 1 );
+}
+
+/* Reads the allocated ranges from $Bitmap data
+ * The first bit of the data corresponds to the first cluster number
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_bitmap_read_data(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t first_cluster_number,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfsntfs_cluster_bitmap_read_data";
+	uint64_t bit_index          = 0;
+	uint64_t number_of_bits     = 0;
+	uint64_t run_bit_index      = 0;
+	uint64_t run_number_of_bits = 0;
+	int result                  = 0;
+
+	if( cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_cluster_number >= cluster_bitmap->number_of_clusters )
+	{
+		return( 1 );
+	}
+	/* Ignore the bits of the clusters beyond the end of the volume
+	 */
+	number_of_bits = cluster_bitmap->number_of_clusters - first_cluster_number;
+
+	if( (uint64_t) data_size > ( ( number_of_bits + 7 ) / 8 ) )
+	{
+		data_size = (size_t) ( ( number_of_bits + 7 ) / 8 );
+	}
+	do
+	{
+		result = libfsntfs_bitmap_runs_get_next_run(
+		          data,
+		          data_size,
+		          bit_index,
+		          &run_bit_index,
+		          &run_number_of_bits,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next run.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: cluster range\t\t: %" PRIu64 " - %" PRIu64 " (%" PRIu64 ")\n",
+				 function,
+				 first_cluster_number + run_bit_index,
+				 first_cluster_number + run_bit_index + run_number_of_bits,
+				 run_number_of_bits );
+			}
+#endif
+			if( libfsntfs_cluster_bitmap_append_range(
+			     cluster_bitmap,
+			     first_cluster_number + run_bit_index,
+			     run_number_of_bits,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append range.",
+				 function );
+
+				return( -1 );
+			}
+			bit_index = run_bit_index + run_number_of_bits;
+		}
+	}
+	while( result != 0 );
+
+	return( 1 );
+}
+
+/* Retrieves the index of the last allocated range that starts at or before a specific cluster number
+ * The range index is set to -1 if there is no such range
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_bitmap_get_range_index(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t cluster_number,
+     int *range_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_cluster_bitmap_get_range_index";
+	int lower_index       = 0;
+	int middle_index      = 0;
+	int upper_index       = 0;
+
+	if( cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Find the first range that starts after the cluster number
+	 */
+	upper_index = cluster_bitmap->number_of_ranges;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( cluster_bitmap->ranges[ middle_index ].first_cluster_number <= cluster_number )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	*range_index = lower_index - 1;
+
+	return( 1 );
+}
+
+/* Determines if a specific cluster is allocated
+ * Returns 1 if allocated, 0 if not or -1 on error
+ */
+int libfsntfs_cluster_bitmap_is_cluster_allocated(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t cluster_number,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_bitmap_range_t *range = NULL;
+	static char *function                   = "libfsntfs_cluster_bitmap_is_cluster_allocated";
+	int range_index                         = 0;
+
+	if( cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( cluster_number >= cluster_bitmap->number_of_clusters )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid cluster number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_cluster_bitmap_get_range_index(
+	     cluster_bitmap,
+	     cluster_number,
+	     &range_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range index.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_index < 0 )
+	{
+		return( 0 );
+	}
+	range = &( cluster_bitmap->ranges[ range_index ] );
+
+	if( ( cluster_number - range->first_cluster_number ) >= range->number_of_clusters )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the allocated range that contains or follows a specific cluster number
+ * If the cluster is allocated the range starts at the cluster
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int libfsntfs_cluster_bitmap_get_next_allocated_range(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t cluster_number,
+     uint64_t *first_cluster_number,
+     uint64_t *number_of_clusters,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_bitmap_range_t *range = NULL;
+	static char *function                   = "libfsntfs_cluster_bitmap_get_next_allocated_range";
+	int range_index                         = 0;
+
+	if( cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_cluster_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first cluster number.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_clusters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of clusters.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_cluster_bitmap_get_range_index(
+	     cluster_bitmap,
+	     cluster_number,
+	     &range_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range index.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_index >= 0 )
+	{
+		range = &( cluster_bitmap->ranges[ range_index ] );
+
+		if( ( cluster_number - range->first_cluster_number ) < range->number_of_clusters )
+		{
+			*first_cluster_number = cluster_number;
+			*number_of_clusters   = range->number_of_clusters - ( cluster_number - range->first_cluster_number );
+
+			return( 1 );
+		}
+	}
+	range_index += 1;
+
+	if( range_index >= cluster_bitmap->number_of_ranges )
+	{
+		return( 0 );
+	}
+	range = &( cluster_bitmap->ranges[ range_index ] );
+
+	*first_cluster_number = range->first_cluster_number;
+	*number_of_clusters   = range->number_of_clusters;
+
+	return( 1 );
+}
+
+/* Retrieves the unallocated range that contains or follows a specific cluster number
+ * If the cluster is unallocated the range starts at the cluster
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int libfsntfs_cluster_bitmap_get_next_unallocated_range(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t cluster_number,
+     uint64_t *first_cluster_number,
+     uint64_t *number_of_clusters,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_bitmap_range_t *range = NULL;
+	static char *function                   = "libfsntfs_cluster_bitmap_get_next_unallocated_range";
+	uint64_t range_end_cluster_number       = 0;
+	uint64_t range_start_cluster_number     = 0;
+	int range_index                         = 0;
+
+	if( cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_cluster_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first cluster number.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_clusters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of clusters.",
+		 function );
+
+		return( -1 );
+	}
+	if( cluster_number >= cluster_bitmap->number_of_clusters )
+	{
+		return( 0 );
+	}
+	if( libfsntfs_cluster_bitmap_get_range_index(
+	     cluster_bitmap,
+	     cluster_number,
+	     &range_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range index.",
+		 function );
+
+		return( -1 );
+	}
+	range_start_cluster_number = cluster_number;
+
+	if( range_index >= 0 )
+	{
+		range = &( cluster_bitmap->ranges[ range_index ] );
+
+		if( ( cluster_number - range->first_cluster_number ) < range->number_of_clusters )
+		{
+			/* Adjacent allocated ranges are merged so the clusters that follow
+			 * the range are either unallocated or beyond the end of the volume
+			 */
+			range_start_cluster_number = range->first_cluster_number + range->number_of_clusters;
+		}
+	}
+	if( range_start_cluster_number >= cluster_bitmap->number_of_clusters )
+	{
+		return( 0 );
+	}
+	range_index += 1;
+
+	if( range_index < cluster_bitmap->number_of_ranges )
+	{
+		range_end_cluster_number = cluster_bitmap->ranges[ range_index ].first_cluster_number;
+	}
+	else
+	{
+		range_end_cluster_number = cluster_bitmap->number_of_clusters;
+	}
+	*first_cluster_number = range_start_cluster_number;
+	*number_of_clusters   = range_end_cluster_number - range_start_cluster_number;
+
+	return( 1 );
+}
+
+/* Retrieves the number of allocated and unallocated clusters
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_bitmap_get_allocation_counts(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t *number_of_allocated_clusters,
+     uint64_t *number_of_unallocated_clusters,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_cluster_bitmap_get_allocation_counts";
+
+	if( cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_allocated_clusters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of allocated clusters.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_unallocated_clusters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of unallocated clusters.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_allocated_clusters   = cluster_bitmap->number_of_allocated_clusters;
+	*number_of_unallocated_clusters = cluster_bitmap->number_of_clusters - cluster_bitmap->number_of_allocated_clusters;
+
+	return( 1 );
+}
+
@@ -0,0 +1,130 @@
+/*
+ * Cluster allocation bitmap functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_CLUSTER_BITMAP_H )
+#define _LIBFSNTFS_CLUSTER_BITMAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_cluster_bitmap_range libfsntfs_cluster_bitmap_range_t;
+
+struct libfsntfs_cluster_bitmap_range
+{
+	/* The first cluster number
+	 */
+	uint64_t first_cluster_number;
+
+	/* The number of clusters
+	 */
+	uint64_t number_of_clusters;
+};
+
+typedef struct libfsntfs_cluster_bitmap libfsntfs_cluster_bitmap_t;
+
+struct libfsntfs_cluster_bitmap
+{
+	/* The allocated ranges, sorted by first cluster number
+	 */
+	libfsntfs_cluster_bitmap_range_t *ranges;
+
+	/* The number of allocated ranges
+	 */
+	int number_of_ranges;
+
+	/* The maximum number of allocated ranges
+	 */
+	int maximum_number_of_ranges;
+
+	/* The number of clusters
+	 */
+	uint64_t number_of_clusters;
+
+	/* The number of allocated clusters
+	 */
+	uint64_t number_of_allocated_clusters;
+};
+
+int libfsntfs_cluster_bitmap_initialize(
+     libfsntfs_cluster_bitmap_t **cluster_bitmap,
+     uint64_t number_of_clusters,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_bitmap_free(
+     libfsntfs_cluster_bitmap_t **cluster_bitmap,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_bitmap_append_range(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t first_cluster_number,
+     uint64_t number_of_clusters,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_bitmap_read_data(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t first_cluster_number,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_bitmap_get_range_index(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t cluster_number,
+     int *range_index,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_bitmap_is_cluster_allocated(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t cluster_number,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_bitmap_get_next_allocated_range(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t cluster_number,
+     uint64_t *first_cluster_number,
+     uint64_t *number_of_clusters,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_bitmap_get_next_unallocated_range(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t cluster_number,
+     uint64_t *first_cluster_number,
+     uint64_t *number_of_clusters,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_bitmap_get_allocation_counts(
+     libfsntfs_cluster_bitmap_t *cluster_bitmap,
+     uint64_t *number_of_allocated_clusters,
+     uint64_t *number_of_unallocated_clusters,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -288,26 +288,12 @@ int libfsntfs_cluster_block_read_element_data(
 			 cluster_block_size );
 		}
 #endif
-		if( libbfio_handle_seek_offset(
-		     file_io_handle,
-		     cluster_block_offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset: 0x%08" PRIx64 ".",
-			 function,
-			 cluster_block_offset );
-
-			goto on_error;
-		}
-		read_count = libbfio_handle_read_buffer(
+		read_count = libfsntfs_io_handle_read_buffer_at_offset(
+		              io_handle,
 		              file_io_handle,
 		              cluster_block->data,
 		              cluster_block->data_size,
+		              cluster_block_offset,
 		              error );
 
 		if( read_count != (ssize_t) cluster_block->data_size )
@@ -316,8 +302,9 @@ int libfsntfs_cluster_block_read_element_data(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read cluster block.",
-			 function );
+			 "%s: unable to read cluster block at offset: 0x%08" PRIx64 ".",
+			 function,
+			 cluster_block_offset );
 
 			goto on_error;
 		}
@@ -27,14 +27,16 @@
 #include "libfsntfs_cluster_block_stream.h"
 #include "libfsntfs_compressed_block.h"
 #include "libfsntfs_compressed_block_descriptor.h"
-#include "libfsntfs_data_run.h"
+#include "libfsntfs_decompression_pool.h"
 #include "libfsntfs_definitions.h"
+#include "libfsntfs_extent_table.h"
 #include "libfsntfs_io_handle.h"
-#include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libcnotify.h"
+#include "libfsntfs_libcthreads.h"
 #include "libfsntfs_libfcache.h"
 #include "libfsntfs_libfdata.h"
+#include "libfsntfs_lznt1.h"
 #include "libfsntfs_unused.h"
 
 /* Creates a data handle
@@ -121,27 +123,13 @@ int libfsntfs_cluster_block_stream_data_handle_initialize(
 	if( ( ( data_flags & LIBFSNTFS_ATTRIBUTE_FLAG_COMPRESSION_MASK ) != 0 )
 	 && ( resident_data == NULL ) )
 	{
-		if( libcdata_array_initialize(
-		     &( ( *data_handle )->compressed_block_descriptors_array ),
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create compressed block descriptors array.",
-			 function );
-
-			goto on_error;
-		}
 		if( libfdata_vector_initialize(
 		     &( ( *data_handle )->compressed_block_vector ),
 		     (size64_t) compression_unit_size,
-		     (intptr_t *) ( *data_handle )->compressed_block_descriptors_array,
+		     (intptr_t *) *data_handle,
 		     NULL,
 		     NULL,
-		     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfcache_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libfsntfs_compressed_block_read_element_data,
+		     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfcache_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libfsntfs_cluster_block_stream_data_handle_read_compressed_block_element_data,
 		     NULL,
 		     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
 		     error ) != 1 )
@@ -161,19 +149,13 @@ int libfsntfs_cluster_block_stream_data_handle_initialize(
 	( *data_handle )->resident_data         = resident_data;
 	( *data_handle )->compression_unit_size = compression_unit_size;
 	( *data_handle )->data_flags            = data_flags;
+	( *data_handle )->last_segment_index    = -1;
 
 	return( 1 );
 
 on_error:
 	if( *data_handle != NULL )
 	{
-		if( ( *data_handle )->compressed_block_descriptors_array != NULL )
-		{
-			libcdata_array_free(
-			 &( ( *data_handle )->compressed_block_descriptors_array ),
-			 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_compressed_block_descriptor_free,
-			 NULL );
-		}
 		memory_free(
 		 *data_handle );
 
@@ -207,34 +189,33 @@ int libfsntfs_cluster_block_stream_data_handle_free(
 	{
 		/* IO handle is freed elsewhere
 		 */
-		if( ( *data_handle )->compressed_block_descriptors_array != NULL )
+		if( ( *data_handle )->compressed_block_vector != NULL )
 		{
-			if( libcdata_array_free(
-			     &( ( *data_handle )->compressed_block_descriptors_array ),
-			     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_compressed_block_descriptor_free,
+			if( libfdata_vector_free(
+			     &( ( *data_handle )->compressed_block_vector ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free compressed block descriptors array.",
+				 "%s: unable to free compressed block vector.",
 				 function );
 
 				result = -1;
 			}
 		}
-		if( ( *data_handle )->compressed_block_vector != NULL )
+		if( ( *data_handle )->extent_table != NULL )
 		{
-			if( libfdata_vector_free(
-			     &( ( *data_handle )->compressed_block_vector ),
+			if( libfsntfs_extent_table_free(
+			     &( ( *data_handle )->extent_table ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free compressed block vector.",
+				 "%s: unable to free extent table.",
 				 function );
 
 				result = -1;
@@ -272,7 +253,9 @@ int libfsntfs_cluster_block_stream_data_handle_clone(
      libfsntfs_cluster_block_stream_data_handle_t *source_data_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_cluster_block_stream_data_handle_clone";
+	static char *function    = "libfsntfs_cluster_block_stream_data_handle_clone";
+	size64_t compressed_size = 0;
+	int element_index        = 0;
 
 	if( destination_data_handle == NULL )
 	{
@@ -331,7 +314,6 @@ int libfsntfs_cluster_block_stream_data_handle_clone(
 
 		return( -1 );
 	}
-/* TODO clone vectors and array */
 	if( libfcache_cache_clone(
 	     &( ( *destination_data_handle )->cache ),
 	     source_data_handle->cache,
@@ -346,6 +328,75 @@ int libfsntfs_cluster_block_stream_data_handle_clone(
 
 		goto on_error;
 	}
+	if( source_data_handle->extent_table != NULL )
+	{
+		if( libfsntfs_extent_table_initialize(
+		     &( ( *destination_data_handle )->extent_table ),
+		     source_data_handle->extent_table->cluster_block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination extent table.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_extent_table_append_extent_table(
+		     ( *destination_data_handle )->extent_table,
+		     source_data_handle->extent_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy extent table.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( source_data_handle->compressed_block_vector != NULL )
+	{
+		if( libfdata_vector_get_size(
+		     source_data_handle->compressed_block_vector,
+		     &compressed_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve compressed block vector size.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_vector_append_segment(
+		     ( *destination_data_handle )->compressed_block_vector,
+		     &element_index,
+		     0,
+		     0,
+		     compressed_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append compression units to destination compressed block vector.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *destination_data_handle )->valid_data_size         = source_data_handle->valid_data_size;
+	( *destination_data_handle )->number_of_cache_entries = source_data_handle->number_of_cache_entries;
+
 	return( 1 );
 
 on_error:
@@ -365,8 +416,8 @@ on_error:
 ssize_t libfsntfs_cluster_block_stream_data_handle_read_segment_data(
          libfsntfs_cluster_block_stream_data_handle_t *data_handle,
          libbfio_handle_t *file_io_handle,
-         int segment_index,
-         int segment_file_index,
+         int segment_index LIBFSNTFS_ATTRIBUTE_UNUSED,
+         int segment_file_index LIBFSNTFS_ATTRIBUTE_UNUSED,
          uint8_t *segment_data,
          size_t segment_data_size,
          uint32_t segment_flags,
@@ -377,7 +428,16 @@ ssize_t libfsntfs_cluster_block_stream_data_handle_read_segment_data(
 	static char *function                          = "libfsntfs_cluster_block_stream_data_handle_read_segment_data";
 	off64_t segment_offset                         = 0;
 	size64_t segment_size                          = 0;
+	size_t compressed_block_offset                 = 0;
+	size_t number_of_compressed_blocks             = 0;
+	size_t read_size                               = 0;
+	ssize_t compressed_blocks_read_count           = 0;
 	ssize_t read_count                             = 0;
+	int compressed_block_index                     = 0;
+	int maximum_number_of_compressed_blocks        = 0;
+
+	LIBFSNTFS_UNREFERENCED_PARAMETER( segment_index )
+	LIBFSNTFS_UNREFERENCED_PARAMETER( segment_file_index )
 
 	if( data_handle == NULL )
 	{
@@ -474,105 +534,177 @@ ssize_t libfsntfs_cluster_block_stream_data_handle_read_segment_data(
 	}
 	else if( data_handle->compressed_block_vector != NULL )
 	{
-		if( libfdata_vector_get_segment_by_index(
-		     data_handle->compressed_block_vector,
-		     segment_index,
-		     &segment_file_index,
-		     &segment_offset,
-		     &segment_size,
-		     &segment_flags,
-		     error ) != 1 )
+		/* The compressed data is mapped as a single segment, the compression unit
+		 * and the offset within it are calculated from the current offset
+		 */
+		while( (size_t) read_count < segment_data_size )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve compressed block vector element index: %d.",
-			 function,
-			 segment_index );
+			segment_offset          = data_handle->current_segment_offset + read_count;
+			compressed_block_index  = (int) ( segment_offset / data_handle->compression_unit_size );
+			compressed_block_offset = (size_t) ( segment_offset % data_handle->compression_unit_size );
+
+			/* Whole compression units are decompressed directly into the buffer,
+			 * in batches to limit the compressed data buffered for the decompression pool
+			 */
+			if( ( compressed_block_offset == 0 )
+			 && ( ( segment_data_size - (size_t) read_count ) >= data_handle->compression_unit_size ) )
+			{
+				maximum_number_of_compressed_blocks = LIBFSNTFS_MAXIMUM_DIRECT_READ_COMPRESSION_UNITS;
 
-			return( -1 );
-		}
-		if( data_handle->current_segment_offset < segment_offset )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid data handle - current segment offset value out of bounds.",
-			 function );
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+				if( data_handle->io_handle->decompression_pool != NULL )
+				{
+					maximum_number_of_compressed_blocks = data_handle->io_handle->decompression_pool->number_of_threads * 4;
+				}
+#endif
+				number_of_compressed_blocks = ( segment_data_size - (size_t) read_count ) / data_handle->compression_unit_size;
 
-			return( -1 );
-		}
-		segment_offset = data_handle->current_segment_offset - segment_offset;
+				if( number_of_compressed_blocks > (size_t) maximum_number_of_compressed_blocks )
+				{
+					number_of_compressed_blocks = (size_t) maximum_number_of_compressed_blocks;
+				}
+				compressed_blocks_read_count = libfsntfs_cluster_block_stream_data_handle_read_compression_units(
+				                                data_handle,
+				                                file_io_handle,
+				                                compressed_block_index,
+				                                (int) number_of_compressed_blocks,
+				                                &( segment_data[ read_count ] ),
+				                                segment_data_size - (size_t) read_count,
+				                                error );
+
+				if( compressed_blocks_read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read compressed blocks: %d to %d.",
+					 function,
+					 compressed_block_index,
+					 compressed_block_index + (int) number_of_compressed_blocks - 1 );
 
-		if( (size64_t) segment_offset >= segment_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid data handle - current segment offset value out of bounds.",
-			 function );
+					return( -1 );
+				}
+				read_count += compressed_blocks_read_count;
 
-			return( -1 );
-		}
-		if( libfdata_vector_get_element_value_by_index(
-		     data_handle->compressed_block_vector,
-		     (intptr_t *) file_io_handle,
-		     data_handle->cache,
-		     segment_index,
-		     (intptr_t **) &compressed_block,
-		     read_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve compressed block: %d from vector.",
-			 function,
-			 segment_index );
+				if( (size_t) compressed_blocks_read_count < ( number_of_compressed_blocks * data_handle->compression_unit_size ) )
+				{
+					break;
+				}
+				continue;
+			}
+			if( compressed_block_index != data_handle->last_segment_index )
+			{
+				if( libfsntfs_cluster_block_stream_data_handle_read_ahead(
+				     data_handle,
+				     file_io_handle,
+				     compressed_block_index,
+				     read_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read ahead of compressed block: %d.",
+					 function,
+					 compressed_block_index );
 
-			return( -1 );
-		}
-		if( compressed_block == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing compressed block: %d.",
-			 function,
-			 segment_index );
+					return( -1 );
+				}
+			}
+			if( libfsntfs_io_handle_update_cache_statistics(
+			     data_handle->io_handle,
+			     LIBFSNTFS_CACHE_TYPE_COMPRESSION_UNITS,
+			     1,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update cache statistics.",
+				 function );
 
-			return( -1 );
-		}
-		if( segment_offset >= (off64_t) compressed_block->data_size )
-		{
-			return( 0 );
-		}
-		read_count = compressed_block->data_size - segment_offset;
+				return( -1 );
+			}
+			if( libfdata_vector_get_element_value_by_index(
+			     data_handle->compressed_block_vector,
+			     (intptr_t *) file_io_handle,
+			     data_handle->cache,
+			     compressed_block_index,
+			     (intptr_t **) &compressed_block,
+			     read_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve compressed block: %d from vector.",
+				 function,
+				 compressed_block_index );
 
-		if( (size64_t) read_count > segment_data_size )
-		{
-			read_count = segment_data_size;
-		}
-		if( read_count == 0 )
-		{
-			return( 0 );
+				return( -1 );
+			}
+			if( compressed_block == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing compressed block: %d.",
+				 function,
+				 compressed_block_index );
+
+				return( -1 );
+			}
+			if( compressed_block_offset >= compressed_block->data_size )
+			{
+				break;
+			}
+			read_size = compressed_block->data_size - compressed_block_offset;
+
+			if( read_size > ( segment_data_size - (size_t) read_count ) )
+			{
+				read_size = segment_data_size - (size_t) read_count;
+			}
+			if( memory_copy(
+			     &( segment_data[ read_count ] ),
+			     &( ( compressed_block->data )[ compressed_block_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy cluster block data.",
+				 function );
+
+				return( -1 );
+			}
+			read_count += (ssize_t) read_size;
 		}
-		if( memory_copy(
-		     segment_data,
-		     &( ( compressed_block->data )[ segment_offset ] ),
-		     (size_t) read_count ) == NULL )
+	}
+	else if( data_handle->extent_table != NULL )
+	{
+		read_count = libfsntfs_cluster_block_stream_data_handle_read_extent_data(
+		              data_handle,
+		              file_io_handle,
+		              segment_data,
+		              segment_data_size,
+		              error );
+
+		if( read_count == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy cluster block data.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read extent data at offset: 0x%08" PRIx64 ".",
+			 function,
+			 data_handle->current_segment_offset );
 
 			return( -1 );
 		}
@@ -597,26 +729,12 @@ ssize_t libfsntfs_cluster_block_stream_data_handle_read_segment_data(
 	}
 	else
 	{
-		if( libbfio_handle_seek_offset(
-		     file_io_handle,
-		     data_handle->current_segment_offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek segment offset: 0x%08" PRIx64 ".",
-			 function,
-			 data_handle->current_segment_offset );
-
-			return( -1 );
-		}
-		read_count = libbfio_handle_read_buffer(
+		read_count = libfsntfs_io_handle_read_buffer_at_offset(
+		              data_handle->io_handle,
 		              file_io_handle,
 		              segment_data,
 		              segment_data_size,
+		              data_handle->current_segment_offset,
 		              error );
 
 		if( read_count != (ssize_t) segment_data_size )
@@ -625,8 +743,9 @@ ssize_t libfsntfs_cluster_block_stream_data_handle_read_segment_data(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read segment data.",
-			 function );
+			 "%s: unable to read segment data at offset: 0x%08" PRIx64 ".",
+			 function,
+			 data_handle->current_segment_offset );
 
 			return( -1 );
 		}
@@ -636,23 +755,33 @@ ssize_t libfsntfs_cluster_block_stream_data_handle_read_segment_data(
 	return( read_count );
 }
 
-/* Seeks a certain offset of the data
- * Callback for the cluster block stream
- * Returns the offset if seek is successful or -1 on error
+/* Reads uncompressed non-resident data from the current offset into a buffer
+ * The current offset is a data offset, which is mapped onto the volume using the extent table
+ * Data beyond the valid data size and sparse extents are read as zero bytes
+ * Returns the number of bytes read or -1 on error
  */
-off64_t libfsntfs_cluster_block_stream_data_handle_seek_segment_offset(
+ssize_t libfsntfs_cluster_block_stream_data_handle_read_extent_data(
          libfsntfs_cluster_block_stream_data_handle_t *data_handle,
-         intptr_t *file_io_handle LIBFSNTFS_ATTRIBUTE_UNUSED,
-         int segment_index LIBFSNTFS_ATTRIBUTE_UNUSED,
-         int segment_file_index LIBFSNTFS_ATTRIBUTE_UNUSED,
-         off64_t segment_offset,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *segment_data,
+         size_t segment_data_size,
          libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_cluster_block_stream_data_handle_seek_segment_offset";
-
-	LIBFSNTFS_UNREFERENCED_PARAMETER( file_io_handle )
-	LIBFSNTFS_UNREFERENCED_PARAMETER( segment_index )
-	LIBFSNTFS_UNREFERENCED_PARAMETER( segment_file_index )
+	static char *function       = "libfsntfs_cluster_block_stream_data_handle_read_extent_data";
+	off64_t cluster_offset      = 0;
+	off64_t data_offset         = 0;
+	off64_t volume_offset       = 0;
+	size64_t extent_data_size   = 0;
+	size_t buffer_offset        = 0;
+	size_t read_size            = 0;
+	ssize_t read_count          = 0;
+	uint64_t first_lcn          = 0;
+	uint64_t first_vcn          = 0;
+	uint64_t number_of_clusters = 0;
+	uint64_t vcn                = 0;
+	uint32_t range_flags        = 0;
+	int extent_index            = 0;
+	int result                  = 0;
 
 	if( data_handle == NULL )
 	{
@@ -665,800 +794,2886 @@ off64_t libfsntfs_cluster_block_stream_data_handle_seek_segment_offset(
 
 		return( -1 );
 	}
-	if( segment_offset < 0 )
+	if( data_handle->extent_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid segment offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing extent table.",
 		 function );
 
 		return( -1 );
 	}
-	data_handle->current_segment_offset = segment_offset;
-
-	return( segment_offset );
-}
+	if( data_handle->current_segment_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data handle - current segment offset value out of bounds.",
+		 function );
 
-/* Creates a cluster block stream
- * Make sure the value cluster_block_stream is referencing, is set to NULL
- * Returns 1 if successful or -1 on error
- */
-int libfsntfs_cluster_block_stream_initialize(
-     libfdata_stream_t **cluster_block_stream,
-     libfsntfs_io_handle_t *io_handle,
-     libfsntfs_attribute_t *attribute,
-     libcerror_error_t **error )
-{
-	libfsntfs_cluster_block_stream_data_handle_t *data_handle            = NULL;
-	libfsntfs_compressed_block_descriptor_t *compressed_block_descriptor = NULL;
-	libfsntfs_data_run_t *data_run                                       = NULL;
-	uint8_t *resident_data                                               = NULL;
-	static char *function                                                = "libfsntfs_cluster_block_stream_initialize";
-	off64_t attribute_data_vcn_offset                                    = 0;
-	off64_t calculated_attribute_data_vcn_offset                         = 0;
-	off64_t data_offset                                                  = 0;
-	off64_t data_run_offset                                              = 0;
-	size64_t attribute_data_size                                         = 0;
-	size64_t attribute_data_vcn_size                                     = 0;
-	size64_t data_run_size                                               = 0;
-	size64_t data_segment_size                                           = 0;
-	size64_t data_size                                                   = 0;
-	size64_t valid_data_size                                             = 0;
-	size_t compression_unit_size                                         = 0;
-	size_t remaining_compression_unit_size                               = 0;
-	uint16_t attribute_data_flags                                        = 0;
-	uint16_t data_flags                                                  = 0;
-	int attribute_index                                                  = 0;
-	int compressed_block_descriptor_index                                = 0;
-	int data_run_index                                                   = 0;
-	int element_index                                                    = 0;
-	int entry_index                                                      = 0;
-	int number_of_data_runs                                              = 0;
-	int result                                                           = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	char *compression_unit_data_type                                     = NULL;
-#endif
-
-	if( cluster_block_stream == NULL )
+		return( -1 );
+	}
+	if( segment_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid cluster block stream.",
+		 "%s: invalid segment data.",
 		 function );
 
 		return( -1 );
 	}
-	if( attribute == NULL )
+	if( segment_data_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid attribute.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment data size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfsntfs_attribute_get_data(
-	     attribute,
-	     &resident_data,
-	     &data_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve attribute data",
-		 function );
+	data_offset = data_handle->current_segment_offset;
 
-		goto on_error;
-	}
-	if( libfsntfs_attribute_get_valid_data_size(
-	     attribute,
-	     &valid_data_size,
-	     error ) != 1 )
+	if( (size64_t) data_offset >= data_handle->data_size )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve valid data size",
-		 function );
-
-		goto on_error;
+		return( 0 );
 	}
-	if( valid_data_size == 0 )
+	if( (size64_t) segment_data_size > ( data_handle->data_size - data_offset ) )
 	{
-		valid_data_size = data_size;
+		segment_data_size = (size_t) ( data_handle->data_size - data_offset );
 	}
-	if( libfsntfs_attribute_get_data_flags(
-	     attribute,
-	     &data_flags,
-	     error ) != 1 )
+	while( buffer_offset < segment_data_size )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve attribute data flags.",
-		 function );
+		read_size = segment_data_size - buffer_offset;
 
-		goto on_error;
-	}
-	if( ( ( data_flags & LIBFSNTFS_ATTRIBUTE_FLAG_COMPRESSION_MASK ) != 0 )
-	 || ( resident_data != NULL ) )
-	{
-		if( valid_data_size != data_size )
+		if( (size64_t) data_offset >= data_handle->valid_data_size )
+		{
+			if( memory_set(
+			     &( segment_data[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear segment data.",
+				 function );
+
+				return( -1 );
+			}
+			buffer_offset += read_size;
+
+			break;
+		}
+		if( (size64_t) read_size > ( data_handle->valid_data_size - data_offset ) )
+		{
+			read_size = (size_t) ( data_handle->valid_data_size - data_offset );
+		}
+		vcn            = (uint64_t) data_offset / data_handle->extent_table->cluster_block_size;
+		cluster_offset = data_offset % data_handle->extent_table->cluster_block_size;
+
+		/* Sequential reads mostly continue in the extent that was last read or the one after it
+		 */
+		extent_index = data_handle->current_extent_index;
+
+		if( ( extent_index >= 0 )
+		 && ( extent_index < data_handle->extent_table->number_of_extents )
+		 && ( vcn >= data_handle->extent_table->first_vcns[ extent_index ] )
+		 && ( ( vcn - data_handle->extent_table->first_vcns[ extent_index ] ) >= data_handle->extent_table->numbers_of_clusters[ extent_index ] ) )
+		{
+			extent_index++;
+		}
+		if( ( extent_index >= 0 )
+		 && ( extent_index < data_handle->extent_table->number_of_extents )
+		 && ( vcn >= data_handle->extent_table->first_vcns[ extent_index ] )
+		 && ( ( vcn - data_handle->extent_table->first_vcns[ extent_index ] ) < data_handle->extent_table->numbers_of_clusters[ extent_index ] ) )
+		{
+			result = 1;
+		}
+		else
+		{
+			result = libfsntfs_extent_table_get_extent_index_by_vcn(
+			          data_handle->extent_table,
+			          vcn,
+			          &extent_index,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent index for VCN: %" PRIu64 ".",
+				 function,
+				 vcn );
+
+				return( -1 );
+			}
+		}
+		if( result == 0 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: unuspported valid data size value out of bounds.",
-			 function );
+			 "%s: invalid data offset: 0x%08" PRIx64 " - no extent for VCN: %" PRIu64 ".",
+			 function,
+			 data_offset,
+			 vcn );
 
-			goto on_error;
+			return( -1 );
 		}
-	}
-	if( ( ( data_flags & LIBFSNTFS_ATTRIBUTE_FLAG_COMPRESSION_MASK ) != 0 )
-	 && ( resident_data == NULL ) )
-	{
-		if( libfsntfs_attribute_get_compression_unit_size(
-		     attribute,
-		     &compression_unit_size,
+		if( libfsntfs_extent_table_get_extent_by_index(
+		     data_handle->extent_table,
+		     extent_index,
+		     &first_vcn,
+		     &first_lcn,
+		     &number_of_clusters,
+		     &range_flags,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve compression unit size.",
-			 function );
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( ( compression_unit_size == 0 )
-		 || ( compression_unit_size > (size_t) SSIZE_MAX ) )
+		data_handle->current_extent_index = extent_index;
+
+		extent_data_size = ( ( first_vcn + number_of_clusters - vcn ) * data_handle->extent_table->cluster_block_size ) - cluster_offset;
+
+		if( (size64_t) read_size > extent_data_size )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid compression unit size value out of bounds.",
-			 function );
+			read_size = (size_t) extent_data_size;
+		}
+		if( ( range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			if( memory_set(
+			     &( segment_data[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear segment data.",
+				 function );
 
-			goto on_error;
+				return( -1 );
+			}
+		}
+		else
+		{
+			volume_offset = (off64_t) ( ( first_lcn + ( vcn - first_vcn ) ) * data_handle->extent_table->cluster_block_size ) + cluster_offset;
+
+			read_count = libfsntfs_io_handle_read_buffer_at_offset(
+			              data_handle->io_handle,
+			              file_io_handle,
+			              &( segment_data[ buffer_offset ] ),
+			              read_size,
+			              volume_offset,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read extent: %d data at offset: 0x%08" PRIx64 ".",
+				 function,
+				 extent_index,
+				 volume_offset );
+
+				return( -1 );
+			}
 		}
+		data_offset   += read_size;
+		buffer_offset += read_size;
 	}
-	if( libfsntfs_cluster_block_stream_data_handle_initialize(
-	     &data_handle,
-	     io_handle,
-	     data_size,
-	     resident_data,
-	     compression_unit_size,
-	     data_flags,
-	     error ) != 1 )
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads ahead the compression units that follow a specific compression unit
+ * When the compression units are read sequentially the cache is grown and
+ * the following compression units are decompressed into the cache, so that
+ * a stream read with small reads decompresses every compression unit once
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_block_stream_data_handle_read_ahead(
+     libfsntfs_cluster_block_stream_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     int segment_index,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfsntfs_compressed_block_t *compressed_block = NULL;
+	libcerror_error_t *read_ahead_error            = NULL;
+	static char *function                          = "libfsntfs_cluster_block_stream_data_handle_read_ahead";
+	int maximum_number_of_cache_entries            = 0;
+	int number_of_cache_entries                    = 0;
+	int number_of_read_ahead_segments              = 0;
+	int number_of_segments                         = 0;
+	int read_ahead_segment_index                   = 0;
+
+	if( data_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( data_handle == NULL )
+	if( data_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing data handle.",
+		 "%s: invalid data handle - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_stream_initialize(
-	     cluster_block_stream,
-	     (intptr_t *) data_handle,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_cluster_block_stream_data_handle_free,
-	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libfsntfs_cluster_block_stream_data_handle_clone,
-	     NULL,
-	     (ssize_t (*)(intptr_t *, intptr_t *, int, int, uint8_t *, size_t, uint32_t, uint8_t, libcerror_error_t **)) &libfsntfs_cluster_block_stream_data_handle_read_segment_data,
-	     NULL,
-	     (off64_t (*)(intptr_t *, intptr_t *, int, int, off64_t, libcerror_error_t **)) &libfsntfs_cluster_block_stream_data_handle_seek_segment_offset,
-	     LIBFDATA_DATA_HANDLE_FLAG_MANAGED,
+	if( ( data_handle->last_segment_index >= 0 )
+	 && ( segment_index == ( data_handle->last_segment_index + 1 ) ) )
+	{
+		if( data_handle->number_of_sequential_segments < LIBFSNTFS_MAXIMUM_READ_AHEAD_COMPRESSION_UNITS )
+		{
+			data_handle->number_of_sequential_segments += 1;
+		}
+	}
+	else
+	{
+		data_handle->number_of_sequential_segments = 0;
+	}
+	data_handle->last_segment_index = segment_index;
+
+	if( data_handle->number_of_sequential_segments == 0 )
+	{
+		return( 1 );
+	}
+	/* The read ahead window grows with the number of sequentially read compression units
+	 * the cache needs room for the current compression unit, the one before it and the window
+	 */
+	number_of_read_ahead_segments   = data_handle->number_of_sequential_segments;
+	number_of_cache_entries         = number_of_read_ahead_segments + 2;
+	maximum_number_of_cache_entries = data_handle->io_handle->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_COMPRESSION_UNITS ];
+
+	if( number_of_cache_entries > data_handle->number_of_cache_entries )
+	{
+		if( number_of_cache_entries < ( data_handle->number_of_cache_entries * 2 ) )
+		{
+			number_of_cache_entries = data_handle->number_of_cache_entries * 2;
+		}
+		if( number_of_cache_entries > maximum_number_of_cache_entries )
+		{
+			number_of_cache_entries = maximum_number_of_cache_entries;
+		}
+		if( number_of_cache_entries > data_handle->number_of_cache_entries )
+		{
+			if( libfcache_cache_resize(
+			     data_handle->cache,
+			     number_of_cache_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize cache.",
+				 function );
+
+				return( -1 );
+			}
+			data_handle->number_of_cache_entries = number_of_cache_entries;
+		}
+	}
+	if( number_of_read_ahead_segments > ( data_handle->number_of_cache_entries - 2 ) )
+	{
+		number_of_read_ahead_segments = data_handle->number_of_cache_entries - 2;
+	}
+	if( number_of_read_ahead_segments <= 0 )
+	{
+		return( 1 );
+	}
+	if( libfdata_vector_get_number_of_elements(
+	     data_handle->compressed_block_vector,
+	     &number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create stream.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of compressed blocks.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	while( attribute != NULL )
+	for( read_ahead_segment_index = segment_index + 1;
+	     read_ahead_segment_index <= ( segment_index + number_of_read_ahead_segments );
+	     read_ahead_segment_index++ )
 	{
-		if( ( attribute_index > 0 )
-		 && ( data_handle->resident_data != NULL ) )
+		if( read_ahead_segment_index >= number_of_segments )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid data handle - resident data already set.",
-			 function );
-
-			data_handle = NULL;
-
-			goto on_error;
+			break;
 		}
-		if( (size64_t) data_offset > valid_data_size )
+		/* Every probe is counted as a lookup since a compression unit that
+		 * is not cached is counted as a miss when it is read
+		 */
+		if( libfsntfs_io_handle_update_cache_statistics(
+		     data_handle->io_handle,
+		     LIBFSNTFS_CACHE_TYPE_COMPRESSION_UNITS,
+		     1,
+		     0,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid data offset value out of bounds.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update cache statistics.",
 			 function );
 
-			data_handle = NULL;
-
-			goto on_error;
+			return( -1 );
 		}
-		result = libfsntfs_attribute_get_data_vcn_range(
+		/* Compression units that are already cached are not decompressed again
+		 */
+		if( libfdata_vector_get_element_value_by_index(
+		     data_handle->compressed_block_vector,
+		     (intptr_t *) file_io_handle,
+		     data_handle->cache,
+		     read_ahead_segment_index,
+		     (intptr_t **) &compressed_block,
+		     read_flags,
+		     &read_ahead_error ) != 1 )
+		{
+			/* A compression unit that cannot be read ahead is reported
+			 * when it is read, hence the error is ignored here
+			 */
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to read ahead compressed block: %d.\n",
+				 function,
+				 read_ahead_segment_index );
+			}
+#endif
+			libcerror_error_free(
+			 &read_ahead_error );
+
+			break;
+		}
+	}
+	return( 1 );
+}
+
+/* Reads whole compression units directly into a buffer
+ * The compression units are decompressed into the buffer without using the cache.
+ * If the IO handle has a decompression pool the compressed data is read by the calling thread
+ * and decompressed by the worker threads, otherwise each compression unit is decompressed
+ * after it was read
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_cluster_block_stream_data_handle_read_compression_units(
+         libfsntfs_cluster_block_stream_data_handle_t *data_handle,
+         libbfio_handle_t *file_io_handle,
+         int compressed_block_index,
+         int number_of_compressed_blocks,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         libcerror_error_t **error )
+{
+	libfsntfs_compressed_block_descriptor_t *compressed_block_descriptor = NULL;
+	uint8_t *compressed_data                                             = NULL;
+	uint8_t *read_buffer                                                 = NULL;
+	static char *function                                                = "libfsntfs_cluster_block_stream_data_handle_read_compression_units";
+	size_t compressed_data_size                                          = 0;
+	size_t compression_unit_size                                         = 0;
+	size_t data_offset                                                   = 0;
+	size_t uncompressed_data_size                                        = 0;
+	ssize_t read_count                                                   = 0;
+	ssize_t total_read_count                                             = 0;
+	int block_index                                                      = 0;
+	int number_of_elements                                               = 0;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libfsntfs_decompression_pool_t *decompression_pool                   = NULL;
+	libfsntfs_decompression_task_t *tasks                                = NULL;
+	int number_of_tasks                                                  = 0;
+	int task_index                                                       = 0;
+#endif
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	compression_unit_size = data_handle->compression_unit_size;
+
+	if( compression_unit_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data handle - compression unit size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_vector_get_number_of_elements(
+	     data_handle->compressed_block_vector,
+	     &number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of compressed blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compressed_block_index < 0 )
+	 || ( compressed_block_index >= number_of_elements ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_compressed_blocks <= 0 )
+	 || ( number_of_compressed_blocks > ( number_of_elements - compressed_block_index ) )
+	 || ( (size_t) number_of_compressed_blocks > ( (size_t) SSIZE_MAX / compression_unit_size ) )
+	 || ( ( (size_t) number_of_compressed_blocks * compression_unit_size ) > segment_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of compressed blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Without a decompression pool the compressed data buffer is reused for every compression unit
+	 */
+	compressed_data_size = compression_unit_size;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	decompression_pool = data_handle->io_handle->decompression_pool;
+
+	if( decompression_pool != NULL )
+	{
+		compressed_data_size = (size_t) number_of_compressed_blocks * compression_unit_size;
+
+		tasks = (libfsntfs_decompression_task_t *) memory_allocate(
+		                                            sizeof( libfsntfs_decompression_task_t ) * number_of_compressed_blocks );
+
+		if( tasks == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create tasks.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     tasks,
+		     0,
+		     sizeof( libfsntfs_decompression_task_t ) * number_of_compressed_blocks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear tasks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	compressed_data = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * compressed_data_size );
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compressed data.",
+		 function );
+
+		goto on_error;
+	}
+	total_read_count = (ssize_t) number_of_compressed_blocks * (ssize_t) compression_unit_size;
+
+	for( block_index = 0;
+	     block_index < number_of_compressed_blocks;
+	     block_index++ )
+	{
+		data_offset = (size_t) block_index * compression_unit_size;
+
+		if( libfsntfs_cluster_block_stream_data_handle_get_compressed_block_descriptor(
+		     data_handle,
+		     compressed_block_index + block_index,
+		     &compressed_block_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve compressed block descriptor: %d.",
+			 function,
+			 compressed_block_index + block_index );
+
+			goto on_error;
+		}
+		/* Compression units that are not compressed are read directly into the buffer
+		 */
+		if( ( compressed_block_descriptor->data_range_flags & LIBFDATA_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+		{
+			read_buffer = &( segment_data[ data_offset ] );
+		}
+		else if( compressed_data_size > compression_unit_size )
+		{
+			read_buffer = &( compressed_data[ data_offset ] );
+		}
+		else
+		{
+			read_buffer = compressed_data;
+		}
+		/* The compressed block data stream seeks and reads the file IO handle
+		 * in separate callbacks
+		 */
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     data_handle->io_handle->file_io_handle_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab file IO handle mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		read_count = libfdata_stream_read_buffer(
+		              compressed_block_descriptor->data_stream,
+		              (intptr_t *) file_io_handle,
+		              read_buffer,
+		              compression_unit_size,
+		              0,
+		              error );
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     data_handle->io_handle->file_io_handle_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO handle mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( read_count != (ssize_t) compression_unit_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read compressed block: %d.",
+			 function,
+			 compressed_block_index + block_index );
+
+			goto on_error;
+		}
+		if( ( compressed_block_descriptor->data_range_flags & LIBFDATA_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		{
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+			if( decompression_pool != NULL )
+			{
+				tasks[ number_of_tasks ].compressed_data        = read_buffer;
+				tasks[ number_of_tasks ].compressed_data_size   = compression_unit_size;
+				tasks[ number_of_tasks ].uncompressed_data      = &( segment_data[ data_offset ] );
+				tasks[ number_of_tasks ].uncompressed_data_size = compression_unit_size;
+
+				number_of_tasks++;
+			}
+			else
+#endif
+			{
+				uncompressed_data_size = compression_unit_size;
+
+				if( libfsntfs_lznt1_decompress(
+				     read_buffer,
+				     compression_unit_size,
+				     &( segment_data[ data_offset ] ),
+				     &uncompressed_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+					 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+					 "%s: unable to decompress compressed block: %d.",
+					 function,
+					 compressed_block_index + block_index );
+
+					goto on_error;
+				}
+				/* As with a read of the cached compression units, the data ends
+				 * at the first compression unit that decompresses to less data
+				 */
+				if( uncompressed_data_size < compression_unit_size )
+				{
+					total_read_count = (ssize_t) ( data_offset + uncompressed_data_size );
+				}
+			}
+		}
+		if( libfsntfs_compressed_block_descriptor_free(
+		     &compressed_block_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compressed block descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		if( total_read_count < (ssize_t) ( data_offset + compression_unit_size ) )
+		{
+			break;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( decompression_pool != NULL )
+	{
+		if( libfsntfs_decompression_pool_decompress(
+		     decompression_pool,
+		     tasks,
+		     number_of_tasks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress compressed blocks: %d to %d.",
+			 function,
+			 compressed_block_index,
+			 compressed_block_index + number_of_compressed_blocks - 1 );
+
+			goto on_error;
+		}
+		for( task_index = 0;
+		     task_index < number_of_tasks;
+		     task_index++ )
+		{
+			if( tasks[ task_index ].uncompressed_data_size < compression_unit_size )
+			{
+				data_offset = (size_t) ( tasks[ task_index ].uncompressed_data - segment_data )
+				            + tasks[ task_index ].uncompressed_data_size;
+
+				if( (ssize_t) data_offset < total_read_count )
+				{
+					total_read_count = (ssize_t) data_offset;
+				}
+			}
+		}
+		memory_free(
+		 tasks );
+
+		tasks = NULL;
+	}
+#endif
+	memory_free(
+	 compressed_data );
+
+	if( block_index >= number_of_compressed_blocks )
+	{
+		block_index = number_of_compressed_blocks - 1;
+	}
+	data_handle->last_segment_index = compressed_block_index + block_index;
+
+	return( total_read_count );
+
+on_error:
+	if( compressed_block_descriptor != NULL )
+	{
+		libfsntfs_compressed_block_descriptor_free(
+		 &compressed_block_descriptor,
+		 NULL );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( tasks != NULL )
+	{
+		memory_free(
+		 tasks );
+	}
+#endif
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	return( -1 );
+}
+
+/* Seeks a certain offset of the data
+ * Callback for the cluster block stream
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libfsntfs_cluster_block_stream_data_handle_seek_segment_offset(
+         libfsntfs_cluster_block_stream_data_handle_t *data_handle,
+         intptr_t *file_io_handle LIBFSNTFS_ATTRIBUTE_UNUSED,
+         int segment_index LIBFSNTFS_ATTRIBUTE_UNUSED,
+         int segment_file_index LIBFSNTFS_ATTRIBUTE_UNUSED,
+         off64_t segment_offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_cluster_block_stream_data_handle_seek_segment_offset";
+
+	LIBFSNTFS_UNREFERENCED_PARAMETER( file_io_handle )
+	LIBFSNTFS_UNREFERENCED_PARAMETER( segment_index )
+	LIBFSNTFS_UNREFERENCED_PARAMETER( segment_file_index )
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_handle->current_segment_offset = segment_offset;
+
+	return( segment_offset );
+}
+
+/* Retrieves the compressed block descriptor of a specific compression unit
+ * The compressed block descriptor is created from the extent table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_block_stream_data_handle_get_compressed_block_descriptor(
+     libfsntfs_cluster_block_stream_data_handle_t *data_handle,
+     int compressed_block_index,
+     libfsntfs_compressed_block_descriptor_t **compressed_block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfsntfs_cluster_block_stream_data_handle_get_compressed_block_descriptor";
+	uint64_t first_vcn          = 0;
+	uint64_t number_of_clusters = 0;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->extent_table->cluster_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data handle - invalid extent table - cluster block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_block_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_clusters = (uint64_t) ( data_handle->compression_unit_size / data_handle->extent_table->cluster_block_size );
+	first_vcn          = (uint64_t) compressed_block_index * number_of_clusters;
+
+	if( libfsntfs_compressed_block_descriptor_initialize(
+	     compressed_block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compressed block descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_compressed_block_descriptor_append_extents(
+	     *compressed_block_descriptor,
+	     data_handle->extent_table,
+	     first_vcn,
+	     number_of_clusters,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append extents to compressed block descriptor: %d.",
+		 function,
+		 compressed_block_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( libfsntfs_compressed_block_descriptor_print(
+		     *compressed_block_descriptor,
+		     data_handle->io_handle,
+		     compressed_block_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print the compressed block descriptor: %d.",
+			 function,
+			 compressed_block_index );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *compressed_block_descriptor != NULL )
+	{
+		libfsntfs_compressed_block_descriptor_free(
+		 compressed_block_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a compressed block
+ * Callback function for the compressed block vector
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_block_stream_data_handle_read_compressed_block_element_data(
+     libfsntfs_cluster_block_stream_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfcache_cache_t *cache,
+     int element_index,
+     int element_data_file_index,
+     off64_t element_data_offset,
+     size64_t compressed_block_size,
+     uint32_t range_flags LIBFSNTFS_ATTRIBUTE_UNUSED,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libfsntfs_compressed_block_descriptor_t *compressed_block_descriptor = NULL;
+	static char *function                                                = "libfsntfs_cluster_block_stream_data_handle_read_compressed_block_element_data";
+
+	LIBFSNTFS_UNREFERENCED_PARAMETER( range_flags )
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_handle->extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data handle - missing extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( element_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid element index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     data_handle->io_handle,
+	     LIBFSNTFS_CACHE_TYPE_COMPRESSION_UNITS,
+	     0,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		return( -1 );
+	}
+	/* The compressed block descriptor is only needed to read the compression unit,
+	 * the decompressed data is kept in the cache instead
+	 */
+	if( libfsntfs_cluster_block_stream_data_handle_get_compressed_block_descriptor(
+	     data_handle,
+	     element_index,
+	     &compressed_block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compressed block descriptor: %d.",
+		 function,
+		 element_index );
+
+		goto on_error;
+	}
+	if( libfsntfs_compressed_block_read_element_data(
+	     compressed_block_descriptor,
+	     data_handle->io_handle,
+	     file_io_handle,
+	     vector,
+	     cache,
+	     element_index,
+	     element_data_file_index,
+	     element_data_offset,
+	     compressed_block_size,
+	     compressed_block_descriptor->data_range_flags,
+	     read_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read compressed block: %d.",
+		 function,
+		 element_index );
+
+		goto on_error;
+	}
+	if( libfsntfs_compressed_block_descriptor_free(
+	     &compressed_block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free compressed block descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( compressed_block_descriptor != NULL )
+	{
+		libfsntfs_compressed_block_descriptor_free(
+		 &compressed_block_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates a cluster block stream
+ * Make sure the value cluster_block_stream is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_block_stream_initialize(
+     libfdata_stream_t **cluster_block_stream,
+     libfsntfs_io_handle_t *io_handle,
+     libfsntfs_attribute_t *attribute,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_block_stream_data_handle_t *data_handle = NULL;
+	libfsntfs_extent_table_t *extent_table                    = NULL;
+	uint8_t *resident_data                                    = NULL;
+	static char *function                                     = "libfsntfs_cluster_block_stream_initialize";
+	off64_t attribute_data_vcn_offset                         = 0;
+	off64_t calculated_attribute_data_vcn_offset              = 0;
+	off64_t data_offset                                       = 0;
+	size64_t attribute_data_size                              = 0;
+	size64_t attribute_data_vcn_size                          = 0;
+	size64_t data_size                                        = 0;
+	size64_t number_of_compression_units                      = 0;
+	size64_t valid_data_size                                  = 0;
+	size_t compression_unit_size                              = 0;
+	uint16_t attribute_data_flags                             = 0;
+	uint16_t data_flags                                       = 0;
+	int attribute_index                                       = 0;
+	int element_index                                         = 0;
+	int number_of_data_runs                                   = 0;
+	int result                                                = 0;
+
+	if( cluster_block_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster block stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( attribute == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid attribute.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_attribute_get_data(
+	     attribute,
+	     &resident_data,
+	     &data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve attribute data",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_attribute_get_valid_data_size(
+	     attribute,
+	     &valid_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve valid data size",
+		 function );
+
+		goto on_error;
+	}
+	if( valid_data_size == 0 )
+	{
+		valid_data_size = data_size;
+	}
+	if( libfsntfs_attribute_get_data_flags(
+	     attribute,
+	     &data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve attribute data flags.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( ( data_flags & LIBFSNTFS_ATTRIBUTE_FLAG_COMPRESSION_MASK ) != 0 )
+	 || ( resident_data != NULL ) )
+	{
+		if( valid_data_size != data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: unuspported valid data size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( ( data_flags & LIBFSNTFS_ATTRIBUTE_FLAG_COMPRESSION_MASK ) != 0 )
+	 && ( resident_data == NULL ) )
+	{
+		if( libfsntfs_attribute_get_compression_unit_size(
+		     attribute,
+		     &compression_unit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve compression unit size.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( compression_unit_size == 0 )
+		 || ( compression_unit_size > (size_t) SSIZE_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid compression unit size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfsntfs_cluster_block_stream_data_handle_initialize(
+	     &data_handle,
+	     io_handle,
+	     data_size,
+	     resident_data,
+	     compression_unit_size,
+	     data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing data handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_stream_initialize(
+	     cluster_block_stream,
+	     (intptr_t *) data_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_cluster_block_stream_data_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libfsntfs_cluster_block_stream_data_handle_clone,
+	     NULL,
+	     (ssize_t (*)(intptr_t *, intptr_t *, int, int, uint8_t *, size_t, uint32_t, uint8_t, libcerror_error_t **)) &libfsntfs_cluster_block_stream_data_handle_read_segment_data,
+	     NULL,
+	     (off64_t (*)(intptr_t *, intptr_t *, int, int, off64_t, libcerror_error_t **)) &libfsntfs_cluster_block_stream_data_handle_seek_segment_offset,
+	     LIBFDATA_DATA_HANDLE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create stream.",
+		 function );
+
+		goto on_error;
+	}
+	while( attribute != NULL )
+	{
+		if( ( attribute_index > 0 )
+		 && ( data_handle->resident_data != NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid data handle - resident data already set.",
+			 function );
+
+			data_handle = NULL;
+
+			goto on_error;
+		}
+		if( (size64_t) data_offset > valid_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid data offset value out of bounds.",
+			 function );
+
+			data_handle = NULL;
+
+			goto on_error;
+		}
+		result = libfsntfs_attribute_get_data_vcn_range(
 		          attribute,
 		          (uint64_t *) &attribute_data_vcn_offset,
 		          (uint64_t *) &attribute_data_vcn_size,
 		          error );
 
-		if( result == -1 )
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve attribute data VCN range.",
+			 function );
+
+			data_handle = NULL;
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libfdata_stream_append_segment(
+			     *cluster_block_stream,
+			     &element_index,
+			     0,
+			     0,
+			     data_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append resident data as cluster block stream segment.",
+				 function );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+			data_offset += data_size;
+		}
+		else if( attribute_data_vcn_size == 0xffffffffffffffffULL )
+		{
+			if( libfsntfs_attribute_get_data_size(
+			     attribute,
+			     &attribute_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve attribute data size",
+				 function );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+			if( attribute_data_size != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid attribute data last VCN value out of bounds.",
+				 function );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+			break;
+		}
+		else
+		{
+			if( attribute_data_vcn_size > (size64_t) ( ( INT64_MAX / io_handle->cluster_block_size ) - 1 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid attribute data last VCN value out of bounds.",
+				 function );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+			if( attribute_data_vcn_offset > (off64_t) attribute_data_vcn_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid attribute data first VCN value out of bounds.",
+				 function );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+			attribute_data_vcn_size   += 1;
+			attribute_data_vcn_size   -= attribute_data_vcn_offset;
+			attribute_data_vcn_offset *= io_handle->cluster_block_size;
+			attribute_data_vcn_size   *= io_handle->cluster_block_size;
+
+			if( attribute_data_vcn_offset != calculated_attribute_data_vcn_offset )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid attribute data VCN offset value out of bounds.",
+				 function );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+			if( libfsntfs_attribute_get_data_flags(
+			     attribute,
+			     &attribute_data_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve attribute data flags.",
+				 function );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+			if( data_flags != attribute_data_flags )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid attribute data flags value out of bounds.",
+				 function );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+			if( libfsntfs_attribute_get_number_of_data_runs(
+			     attribute,
+			     &number_of_data_runs,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of data runs.",
+				 function );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+			if( libfsntfs_attribute_get_extent_table(
+			     attribute,
+			     &extent_table,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve attribute: %d extent table.",
+				 function,
+				 attribute_index );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+			if( extent_table != NULL )
+			{
+				if( data_handle->extent_table == NULL )
+				{
+					if( libfsntfs_extent_table_initialize(
+					     &( data_handle->extent_table ),
+					     io_handle->cluster_block_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create extent table.",
+						 function );
+
+						data_handle = NULL;
+
+						goto on_error;
+					}
+				}
+				if( libfsntfs_extent_table_append_extent_table(
+				     data_handle->extent_table,
+				     extent_table,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append attribute: %d extent table.",
+					 function,
+					 attribute_index );
+
+					data_handle = NULL;
+
+					goto on_error;
+				}
+			}
+			calculated_attribute_data_vcn_offset = attribute_data_vcn_offset + (off64_t) attribute_data_vcn_size;
+		}
+		if( libfsntfs_attribute_get_chained_attribute(
+		     attribute,
+		     &attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chained attribute: %d.",
+			 function,
+			 attribute_index );
+
+			data_handle = NULL;
+
+			goto on_error;
+		}
+		attribute_index++;
+	}
+	if( data_handle->extent_table != NULL )
+	{
+		data_handle->valid_data_size = valid_data_size;
+	}
+	if( ( data_handle->extent_table != NULL )
+	 && ( data_handle->compressed_block_vector != NULL ) )
+	{
+		/* The compressed data is mapped as a single segment of whole compression units,
+		 * the compression unit descriptors are created from the extent table when read
+		 */
+		number_of_compression_units = (size64_t) calculated_attribute_data_vcn_offset / compression_unit_size;
+
+		if( number_of_compression_units > (size64_t) INT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of compression units value exceeds maximum.",
+			 function );
+
+			data_handle = NULL;
+
+			goto on_error;
+		}
+		if( number_of_compression_units > 0 )
+		{
+			if( libfdata_vector_append_segment(
+			     data_handle->compressed_block_vector,
+			     &element_index,
+			     0,
+			     0,
+			     number_of_compression_units * compression_unit_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append compression units to compressed block vector.",
+				 function );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+			if( libfdata_stream_append_segment(
+			     *cluster_block_stream,
+			     &element_index,
+			     0,
+			     0,
+			     number_of_compression_units * compression_unit_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append compression units as cluster block stream segment.",
+				 function );
+
+				data_handle = NULL;
+
+				goto on_error;
+			}
+		}
+	}
+	else if( data_handle->extent_table != NULL )
+	{
+		/* The uncompressed data is mapped as a single segment, the data handle
+		 * maps the data offsets onto the volume with the extent table
+		 */
+		if( libfdata_stream_append_segment(
+		     *cluster_block_stream,
+		     &element_index,
+		     0,
+		     0,
+		     data_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent data as cluster block stream segment.",
+			 function );
+
+			data_handle = NULL;
+
+			goto on_error;
+		}
+	}
+	if( ( number_of_data_runs != 0 )
+	 || ( resident_data != NULL ) )
+	{
+		if( libfdata_stream_set_mapped_size(
+		     *cluster_block_stream,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set mapped cluster block stream size.",
+			 function );
+
+			data_handle = NULL;
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( ( ( data_flags & LIBFSNTFS_ATTRIBUTE_FLAG_COMPRESSION_MASK ) != 0 )
+	 && ( resident_data == NULL ) )
+	{
+		/* The cache grows up to the maximum number of cache entries when read sequentially
+		 */
+		data_handle->number_of_cache_entries = LIBFSNTFS_INITIAL_CACHE_ENTRIES_COMPRESSION_UNITS;
+
+		if( data_handle->number_of_cache_entries > io_handle->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_COMPRESSION_UNITS ] )
+		{
+			data_handle->number_of_cache_entries = io_handle->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_COMPRESSION_UNITS ];
+		}
+		if( libfcache_cache_initialize(
+		     &( data_handle->cache ),
+		     data_handle->number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create cache.",
+			 function );
+
+			data_handle = NULL;
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *cluster_block_stream != NULL )
+	{
+		libfdata_stream_free(
+		 cluster_block_stream,
+		 NULL );
+	}
+	if( data_handle != NULL )
+	{
+		libfsntfs_cluster_block_stream_data_handle_free(
+		 &data_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determines if the cluster block stream of an attribute maps its data with the extent table
+ * This is the case for non-resident data
+ * Returns 1 if the extent table is used, 0 if not or -1 on error
+ */
+int libfsntfs_cluster_block_stream_uses_extent_table(
+     libfsntfs_attribute_t *attribute,
+     libcerror_error_t **error )
+{
+	uint8_t *resident_data = NULL;
+	static char *function  = "libfsntfs_cluster_block_stream_uses_extent_table";
+	size64_t data_size     = 0;
+
+	if( libfsntfs_attribute_get_data(
+	     attribute,
+	     &resident_data,
+	     &data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve attribute data",
+		 function );
+
+		return( -1 );
+	}
+	if( resident_data != NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of extents
+ * For non-resident data the extents are the data runs of the attribute chain,
+ * otherwise they are the cluster block stream segments
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_block_stream_get_number_of_extents(
+     libfdata_stream_t *cluster_block_stream,
+     libfsntfs_attribute_t *attribute,
+     int *number_of_extents,
+     libcerror_error_t **error )
+{
+	static char *function   = "libfsntfs_cluster_block_stream_get_number_of_extents";
+	int attribute_index     = 0;
+	int number_of_data_runs = 0;
+	int result              = 0;
+
+	if( number_of_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_cluster_block_stream_uses_extent_table(
+	          attribute,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if cluster block stream uses extent table.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( libfdata_stream_get_number_of_segments(
+		     cluster_block_stream,
+		     number_of_extents,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cluster block stream number of segments.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	*number_of_extents = 0;
+
+	while( attribute != NULL )
+	{
+		if( libfsntfs_attribute_get_number_of_data_runs(
+		     attribute,
+		     &number_of_data_runs,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve attribute: %d number of data runs.",
+			 function,
+			 attribute_index );
+
+			return( -1 );
+		}
+		if( number_of_data_runs > ( INT_MAX - *number_of_extents ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of extents value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		*number_of_extents += number_of_data_runs;
+
+		if( libfsntfs_attribute_get_chained_attribute(
+		     attribute,
+		     &attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chained attribute: %d.",
+			 function,
+			 attribute_index );
+
+			return( -1 );
+		}
+		attribute_index++;
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific extent
+ * The extent offset and size are relative to the start of the data
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_cluster_block_stream_get_extent_by_index(
+     libfdata_stream_t *cluster_block_stream,
+     libfsntfs_attribute_t *attribute,
+     int extent_index,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libfsntfs_extent_table_t *extent_table = NULL;
+	static char *function                  = "libfsntfs_cluster_block_stream_get_extent_by_index";
+	uint64_t first_lcn                     = 0;
+	uint64_t first_vcn                     = 0;
+	uint64_t number_of_clusters            = 0;
+	uint16_t data_flags                    = 0;
+	int attribute_index                    = 0;
+	int number_of_data_runs                = 0;
+	int result                             = 0;
+	int segment_file_index                 = 0;
+
+	if( extent_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_cluster_block_stream_uses_extent_table(
+	          attribute,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if cluster block stream uses extent table.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( libfdata_stream_get_segment_by_index(
+		     cluster_block_stream,
+		     extent_index,
+		     &segment_file_index,
+		     extent_offset,
+		     extent_size,
+		     range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cluster block stream segment: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( libfdata_stream_get_segment_mapped_range(
+		     cluster_block_stream,
+		     extent_index,
+		     extent_offset,
+		     extent_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cluster block stream segment: %d mapped range.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	while( attribute != NULL )
+	{
+		if( libfsntfs_attribute_get_extent_table(
+		     attribute,
+		     &extent_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve attribute: %d extent table.",
+			 function,
+			 attribute_index );
+
+			return( -1 );
+		}
+		if( extent_table != NULL )
+		{
+			if( libfsntfs_extent_table_get_number_of_extents(
+			     extent_table,
+			     &number_of_data_runs,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve attribute: %d number of extents.",
+				 function,
+				 attribute_index );
+
+				return( -1 );
+			}
+			if( extent_index < number_of_data_runs )
+			{
+				if( libfsntfs_extent_table_get_extent_by_index(
+				     extent_table,
+				     extent_index,
+				     &first_vcn,
+				     &first_lcn,
+				     &number_of_clusters,
+				     range_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve attribute: %d extent: %d.",
+					 function,
+					 attribute_index,
+					 extent_index );
+
+					return( -1 );
+				}
+				if( libfsntfs_attribute_get_data_flags(
+				     attribute,
+				     &data_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve attribute: %d data flags.",
+					 function,
+					 attribute_index );
+
+					return( -1 );
+				}
+				/* The data runs of compressed data that are not sparse contain compression units
+				 */
+				if( ( ( data_flags & LIBFSNTFS_ATTRIBUTE_FLAG_COMPRESSION_MASK ) != 0 )
+				 && ( ( *range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) == 0 ) )
+				{
+					*range_flags |= LIBFDATA_RANGE_FLAG_IS_COMPRESSED;
+				}
+				*extent_offset = (off64_t) ( first_vcn * extent_table->cluster_block_size );
+				*extent_size   = (size64_t) ( number_of_clusters * extent_table->cluster_block_size );
+
+				return( 1 );
+			}
+			extent_index -= number_of_data_runs;
+		}
+		if( libfsntfs_attribute_get_chained_attribute(
+		     attribute,
+		     &attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chained attribute: %d.",
+			 function,
+			 attribute_index );
+
+			return( -1 );
+		}
+		attribute_index++;
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+	 "%s: invalid extent index value out of bounds.",
+	 function );
+
+	return( -1 );
+}
+
+/* Retrieves the offset of the next data or sparse hole at or after a specific offset
+ * Sparse data runs of compressed data are only considered a hole for the compression units
+ * they cover entirely. The end of the data is considered a hole
+ * Returns 1 if successful, 0 if there is no data at or after the offset or -1 on error
+ */
+int libfsntfs_cluster_block_stream_get_data_or_hole_offset(
+     libfsntfs_attribute_t *attribute,
+     size64_t data_size,
+     off64_t offset,
+     int whence,
+     off64_t *data_or_hole_offset,
+     libcerror_error_t **error )
+{
+	libfsntfs_extent_table_t *extent_table = NULL;
+	static char *function                  = "libfsntfs_cluster_block_stream_get_data_or_hole_offset";
+	off64_t current_offset                 = 0;
+	off64_t extent_end_offset              = 0;
+	off64_t extent_offset                  = 0;
+	off64_t hole_end_offset                = 0;
+	off64_t hole_offset                    = 0;
+	uint64_t first_lcn                     = 0;
+	uint64_t first_vcn                     = 0;
+	uint64_t number_of_clusters            = 0;
+	size_t compression_unit_size           = 0;
+	uint32_t range_flags                   = 0;
+	uint16_t data_flags                    = 0;
+	int attribute_index                    = 0;
+	int extent_index                       = 0;
+	int number_of_extents                  = 0;
+	int result                             = 0;
+
+	if( ( whence != LIBFSNTFS_SEEK_DATA )
+	 && ( whence != LIBFSNTFS_SEEK_HOLE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_or_hole_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data or hole offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_cluster_block_stream_uses_extent_table(
+	          attribute,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if cluster block stream uses extent table.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		/* Resident data does not contain holes
+		 */
+		if( whence == LIBFSNTFS_SEEK_DATA )
+		{
+			*data_or_hole_offset = offset;
+		}
+		else
+		{
+			*data_or_hole_offset = (off64_t) data_size;
+		}
+		return( 1 );
+	}
+	if( libfsntfs_attribute_get_data_flags(
+	     attribute,
+	     &data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve attribute data flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_flags & LIBFSNTFS_ATTRIBUTE_FLAG_COMPRESSION_MASK ) != 0 )
+	{
+		if( libfsntfs_attribute_get_compression_unit_size(
+		     attribute,
+		     &compression_unit_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve attribute data VCN range.",
+			 "%s: unable to retrieve compression unit size.",
 			 function );
 
-			data_handle = NULL;
+			return( -1 );
+		}
+	}
+	current_offset = offset;
 
-			goto on_error;
+	while( attribute != NULL )
+	{
+		if( libfsntfs_attribute_get_extent_table(
+		     attribute,
+		     &extent_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve attribute: %d extent table.",
+			 function,
+			 attribute_index );
+
+			return( -1 );
 		}
-		else if( result == 0 )
+		if( extent_table != NULL )
 		{
-			if( libfdata_stream_append_segment(
-			     *cluster_block_stream,
-			     &element_index,
-			     0,
-			     0,
-			     data_size,
-			     0,
+			if( libfsntfs_extent_table_get_number_of_extents(
+			     extent_table,
+			     &number_of_extents,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append resident data as cluster block stream segment.",
-				 function );
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve attribute: %d number of extents.",
+				 function,
+				 attribute_index );
+
+				return( -1 );
+			}
+			/* Find the extent that contains the current offset, if there is none
+			 * the extents are scanned from the start of the extent table
+			 */
+			result = libfsntfs_extent_table_get_extent_index_by_vcn(
+			          extent_table,
+			          (uint64_t) current_offset / extent_table->cluster_block_size,
+			          &extent_index,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve attribute: %d extent index of offset: %" PRIi64 ".",
+				 function,
+				 attribute_index,
+				 current_offset );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				extent_index = 0;
+			}
+			while( extent_index < number_of_extents )
+			{
+				if( libfsntfs_extent_table_get_extent_by_index(
+				     extent_table,
+				     extent_index,
+				     &first_vcn,
+				     &first_lcn,
+				     &number_of_clusters,
+				     &range_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve attribute: %d extent: %d.",
+					 function,
+					 attribute_index,
+					 extent_index );
+
+					return( -1 );
+				}
+				extent_index++;
+
+				extent_offset     = (off64_t) ( first_vcn * extent_table->cluster_block_size );
+				extent_end_offset = extent_offset + (off64_t) ( number_of_clusters * extent_table->cluster_block_size );
+
+				if( extent_end_offset <= current_offset )
+				{
+					continue;
+				}
+				hole_offset     = extent_end_offset;
+				hole_end_offset = extent_end_offset;
+
+				if( ( range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+				{
+					hole_offset     = extent_offset;
+					hole_end_offset = extent_end_offset;
+
+					/* A compression unit that is only partially sparse contains compressed data
+					 */
+					if( compression_unit_size != 0 )
+					{
+						hole_offset     += (off64_t) ( ( compression_unit_size - ( (size64_t) hole_offset % compression_unit_size ) ) % compression_unit_size );
+						hole_end_offset -= (off64_t) ( (size64_t) hole_end_offset % compression_unit_size );
+					}
+				}
+				if( whence == LIBFSNTFS_SEEK_DATA )
+				{
+					if( ( current_offset < hole_offset )
+					 || ( current_offset >= hole_end_offset ) )
+					{
+						*data_or_hole_offset = current_offset;
+
+						return( 1 );
+					}
+					current_offset = hole_end_offset;
+
+					if( (size64_t) current_offset >= data_size )
+					{
+						return( 0 );
+					}
+				}
+				else if( ( hole_offset < hole_end_offset )
+				      && ( current_offset < hole_end_offset ) )
+				{
+					if( current_offset < hole_offset )
+					{
+						current_offset = hole_offset;
+					}
+					if( (size64_t) current_offset > data_size )
+					{
+						current_offset = (off64_t) data_size;
+					}
+					*data_or_hole_offset = current_offset;
+
+					return( 1 );
+				}
+			}
+		}
+		if( libfsntfs_attribute_get_chained_attribute(
+		     attribute,
+		     &attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chained attribute: %d.",
+			 function,
+			 attribute_index );
+
+			return( -1 );
+		}
+		attribute_index++;
+	}
+	/* Data that is not covered by the extents is considered data
+	 */
+	if( whence == LIBFSNTFS_SEEK_DATA )
+	{
+		*data_or_hole_offset = current_offset;
+	}
+	else
+	{
+		*data_or_hole_offset = (off64_t) data_size;
+	}
+	return( 1 );
+}
+
+/* Compares the offsets of two read ranges
+ * Callback for qsort
+ * Returns -1 if the first range is before the second, 1 if after or 0 if equal
+ */
+int libfsntfs_cluster_block_stream_compare_read_ranges(
+     const void *first_read_range,
+     const void *second_read_range )
+{
+	const libfsntfs_read_range_t *first_range  = *( (libfsntfs_read_range_t * const *) first_read_range );
+	const libfsntfs_read_range_t *second_range = *( (libfsntfs_read_range_t * const *) second_read_range );
+
+	if( first_range->offset < second_range->offset )
+	{
+		return( -1 );
+	}
+	else if( first_range->offset > second_range->offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads multiple ranges of data from a cluster block stream
+ * The ranges are read in order of their offset, ranges that overlap or are
+ * separated by less than a cluster block are coalesced into a single read.
+ * The current offset of the cluster block stream is not changed, also not on error
+ * Returns the total number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_cluster_block_stream_read_vector(
+         libfdata_stream_t *cluster_block_stream,
+         libbfio_handle_t *file_io_handle,
+         libfsntfs_io_handle_t *io_handle,
+         libfsntfs_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error )
+{
+	libfsntfs_read_range_t **sorted_ranges = NULL;
+	libfsntfs_read_range_t *range          = NULL;
+	uint8_t *coalesced_data                = NULL;
+	static char *function                  = "libfsntfs_cluster_block_stream_read_vector";
+	off64_t current_offset                 = 0;
+	off64_t range_end_offset               = 0;
+	off64_t read_end_offset                = 0;
+	off64_t read_offset                    = 0;
+	size64_t data_size                     = 0;
+	size_t maximum_gap_size                = 0;
+	size_t range_read_count                = 0;
+	size_t total_size                      = 0;
+	ssize_t read_count                     = 0;
+	ssize_t total_read_count               = 0;
+	int first_range_index                  = 0;
+	int number_of_coalesced_ranges         = 0;
+	int range_index                        = 0;
+
+	if( cluster_block_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster block stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges == 0 )
+	{
+		return( 0 );
+	}
+	if( ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) number_of_ranges > ( (size_t) SSIZE_MAX / sizeof( libfsntfs_read_range_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of ranges value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		range = &( ranges[ range_index ] );
+
+		if( range->offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range: %d - offset value out of bounds.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		if( range->size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid range: %d - size value exceeds maximum.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		/* The total read count is returned as a ssize_t
+		 */
+		if( range->size > ( (size_t) SSIZE_MAX - total_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid ranges - total size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		total_size += range->size;
+
+		if( ( range->buffer == NULL )
+		 && ( range->size > 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid range: %d - missing buffer.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		range->read_count = 0;
+	}
+	if( libfdata_stream_get_size(
+	     cluster_block_stream,
+	     &data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster block stream size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_stream_get_offset(
+	     cluster_block_stream,
+	     &current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster block stream offset.",
+		 function );
+
+		return( -1 );
+	}
+	sorted_ranges = (libfsntfs_read_range_t **) memory_allocate(
+	                                             sizeof( libfsntfs_read_range_t * ) * number_of_ranges );
+
+	if( sorted_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sorted ranges.",
+		 function );
+
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		sorted_ranges[ range_index ] = &( ranges[ range_index ] );
+	}
+	qsort(
+	 sorted_ranges,
+	 (size_t) number_of_ranges,
+	 sizeof( libfsntfs_read_range_t * ),
+	 &libfsntfs_cluster_block_stream_compare_read_ranges );
 
-				data_handle = NULL;
+	/* Reading the data in a gap of less than a cluster block is cheaper
+	 * than an additional read
+	 */
+	maximum_gap_size = io_handle->cluster_block_size;
 
-				goto on_error;
-			}
-			data_offset += data_size;
-		}
-		else if( attribute_data_vcn_size == 0xffffffffffffffffULL )
-		{
-			if( libfsntfs_attribute_get_data_size(
-			     attribute,
-			     &attribute_data_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve attribute data size",
-				 function );
+	first_range_index = 0;
 
-				data_handle = NULL;
+	while( first_range_index < number_of_ranges )
+	{
+		range = sorted_ranges[ first_range_index ];
 
-				goto on_error;
-			}
-			if( attribute_data_size != 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid attribute data last VCN value out of bounds.",
-				 function );
+		if( ( range->size == 0 )
+		 || ( (size64_t) range->offset >= data_size ) )
+		{
+			first_range_index++;
 
-				data_handle = NULL;
+			continue;
+		}
+		read_offset = range->offset;
 
-				goto on_error;
-			}
-			break;
+		if( range->size > ( data_size - (size64_t) range->offset ) )
+		{
+			read_end_offset = (off64_t) data_size;
 		}
 		else
 		{
-			if( attribute_data_vcn_size > (size64_t) ( ( INT64_MAX / io_handle->cluster_block_size ) - 1 ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid attribute data last VCN value out of bounds.",
-				 function );
+			read_end_offset = range->offset + range->size;
+		}
+		number_of_coalesced_ranges = 1;
 
-				data_handle = NULL;
+		for( range_index = first_range_index + 1;
+		     range_index < number_of_ranges;
+		     range_index++ )
+		{
+			range = sorted_ranges[ range_index ];
 
-				goto on_error;
+			if( ( range->offset > read_end_offset )
+			 && ( (size_t) ( range->offset - read_end_offset ) > maximum_gap_size ) )
+			{
+				break;
 			}
-			if( attribute_data_vcn_offset > (off64_t) attribute_data_vcn_size )
+			if( (size64_t) range->offset >= data_size )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid attribute data first VCN value out of bounds.",
-				 function );
-
-				data_handle = NULL;
-
-				goto on_error;
+				range_end_offset = (off64_t) data_size;
 			}
-			attribute_data_vcn_size   += 1;
-			attribute_data_vcn_size   -= attribute_data_vcn_offset;
-			attribute_data_vcn_offset *= io_handle->cluster_block_size;
-			attribute_data_vcn_size   *= io_handle->cluster_block_size;
-
-			if( attribute_data_vcn_offset != calculated_attribute_data_vcn_offset )
+			else if( range->size > ( data_size - (size64_t) range->offset ) )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid attribute data VCN offset value out of bounds.",
-				 function );
+				range_end_offset = (off64_t) data_size;
+			}
+			else
+			{
+				range_end_offset = range->offset + range->size;
+			}
+			if( range_end_offset < read_end_offset )
+			{
+				range_end_offset = read_end_offset;
+			}
+			if( (size64_t) ( range_end_offset - read_offset ) > (size64_t) LIBFSNTFS_MAXIMUM_READ_VECTOR_BUFFER_SIZE )
+			{
+				break;
+			}
+			read_end_offset = range_end_offset;
 
-				data_handle = NULL;
+			number_of_coalesced_ranges++;
+		}
+		if( libfdata_stream_seek_offset(
+		     cluster_block_stream,
+		     read_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in cluster block stream.",
+			 function,
+			 read_offset,
+			 read_offset );
 
-				goto on_error;
-			}
-			if( libfsntfs_attribute_get_data_flags(
-			     attribute,
-			     &attribute_data_flags,
-			     error ) != 1 )
+			goto on_error;
+		}
+		if( number_of_coalesced_ranges == 1 )
+		{
+			range = sorted_ranges[ first_range_index ];
+
+			read_count = libfdata_stream_read_buffer(
+			              cluster_block_stream,
+			              (intptr_t *) file_io_handle,
+			              (uint8_t *) range->buffer,
+			              (size_t) ( read_end_offset - read_offset ),
+			              0,
+			              error );
+
+			if( read_count < 0 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve attribute data flags.",
-				 function );
-
-				data_handle = NULL;
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read range: %d from cluster block stream.",
+				 function,
+				 first_range_index );
 
 				goto on_error;
 			}
-			if( data_flags != attribute_data_flags )
+			range->read_count = (size_t) read_count;
+
+			total_read_count += read_count;
+		}
+		else
+		{
+			/* The ranges are read into an intermediate buffer and copied into the buffers of the ranges
+			 */
+			if( coalesced_data == NULL )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid attribute data flags value out of bounds.",
-				 function );
+				coalesced_data = (uint8_t *) memory_allocate(
+				                              sizeof( uint8_t ) * LIBFSNTFS_MAXIMUM_READ_VECTOR_BUFFER_SIZE );
 
-				data_handle = NULL;
+				if( coalesced_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create coalesced data.",
+					 function );
 
-				goto on_error;
+					goto on_error;
+				}
 			}
-			if( libfsntfs_attribute_get_number_of_data_runs(
-			     attribute,
-			     &number_of_data_runs,
-			     error ) != 1 )
+			read_count = libfdata_stream_read_buffer(
+			              cluster_block_stream,
+			              (intptr_t *) file_io_handle,
+			              coalesced_data,
+			              (size_t) ( read_end_offset - read_offset ),
+			              0,
+			              error );
+
+			if( read_count < 0 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve number of data runs.",
-				 function );
-
-				data_handle = NULL;
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read ranges: %d to %d from cluster block stream.",
+				 function,
+				 first_range_index,
+				 first_range_index + number_of_coalesced_ranges - 1 );
 
 				goto on_error;
 			}
-			for( data_run_index = 0;
-			     data_run_index < number_of_data_runs;
-			     data_run_index++ )
+			read_end_offset = read_offset + read_count;
+
+			for( range_index = first_range_index;
+			     range_index < ( first_range_index + number_of_coalesced_ranges );
+			     range_index++ )
 			{
-				if( libfsntfs_attribute_get_data_run_by_index(
-				     attribute,
-				     data_run_index,
-				     &data_run,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve data run: %d.",
-					 function,
-					 data_run_index );
+				range = sorted_ranges[ range_index ];
 
-					data_handle = NULL;
+				if( ( range->size == 0 )
+				 || ( range->offset >= read_end_offset ) )
+				{
+					continue;
+				}
+				range_read_count = (size_t) ( read_end_offset - range->offset );
 
-					goto on_error;
+				if( range_read_count > range->size )
+				{
+					range_read_count = range->size;
 				}
-				if( data_run == NULL )
+				if( memory_copy(
+				     range->buffer,
+				     &( coalesced_data[ range->offset - read_offset ] ),
+				     range_read_count ) == NULL )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing data run: %d.",
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy range: %d data.",
 					 function,
-					 data_run_index );
-
-					data_handle = NULL;
+					 range_index );
 
 					goto on_error;
 				}
-				data_run_offset = data_run->start_offset;
-				data_run_size   = data_run->size;
-
-				if( ( data_flags & LIBFSNTFS_ATTRIBUTE_FLAG_COMPRESSION_MASK ) == 0 )
-				{
-					if( data_run_size > ( valid_data_size - data_offset ) )
-					{
-						data_run_size = valid_data_size - data_offset;
-					}
-/* TODO what if data run size is 0 ? */
-					if( libfdata_stream_append_segment(
-					     *cluster_block_stream,
-					     &element_index,
-					     0,
-					     data_run_offset,
-					     data_run_size,
-					     data_run->range_flags,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-						 "%s: unable to append data run: %d as cluster block stream segment.",
-						 function,
-						 data_run_index );
-
-						data_handle = NULL;
+				range->read_count = range_read_count;
 
-						goto on_error;
-					}
-					data_offset += data_run_size;
-
-					if( ( valid_data_size != data_size )
-					 && ( (size64_t) data_offset >= valid_data_size ) )
-					{
-						if( libfdata_stream_append_segment(
-						     *cluster_block_stream,
-						     &element_index,
-						     0,
-						     data_offset,
-						     data_size - data_offset,
-						     LIBFDATA_RANGE_FLAG_IS_SPARSE,
-						     error ) != 1 )
-						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-							 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-							 "%s: unable to append data run: %d as cluster block stream segment.",
-							 function,
-							 data_run_index );
-
-							data_handle = NULL;
-
-							goto on_error;
-						}
-					}
-				}
-				else
-				{
-					while( data_run_size > 0 )
-					{
-						if( compressed_block_descriptor == NULL )
-						{
-							if( libfsntfs_compressed_block_descriptor_initialize(
-							     &compressed_block_descriptor,
-							     error ) != 1 )
-							{
-								libcerror_error_set(
-								 error,
-								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-								 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-								 "%s: unable to create compressed block descriptor.",
-								 function );
-
-								data_handle = NULL;
-
-								goto on_error;
-							}
-							remaining_compression_unit_size = compression_unit_size;
-						}
-						if( ( ( data_run->range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
-						 && ( remaining_compression_unit_size < compression_unit_size ) )
-						{
-							/* A sparse data run marks the end of a compression unit and
-							 * should be at minimum the size of the remaining data in the compression unit
-							 */
-							if( data_run_size < (size64_t) remaining_compression_unit_size )
-							{
-								libcerror_error_set(
-								 error,
-								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-								 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-								 "%s: invalid sparse data run: %d size value out of bounds.",
-								 function,
-								 data_run_index );
-
-								data_handle = NULL;
-
-								goto on_error;
-							}
-							compressed_block_descriptor->data_range_flags = LIBFDATA_RANGE_FLAG_IS_COMPRESSED;
-						}
-						else
-						{
-							compressed_block_descriptor->data_range_flags = data_run->range_flags;
-						}
-						if( data_run_size < remaining_compression_unit_size )
-						{
-							data_segment_size = data_run_size;
-						}
-						else
-						{
-							data_segment_size = (size64_t) remaining_compression_unit_size;
-						}
-#if defined( HAVE_DEBUG_OUTPUT )
-						if( libcnotify_verbose != 0 )
-						{
-							if( ( data_run->range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
-							{
-								compression_unit_data_type = "sparse ";
-							}
-							else
-							{
-								compression_unit_data_type = "";
-							}
-							libcnotify_printf(
-							 "%s: compression unit: %d %sdata segment offset: 0x%08" PRIx64 ", size: %" PRIu64 ".\n",
-							 function,
-							 compressed_block_descriptor_index,
-							 compression_unit_data_type,
-							 data_run_offset,
-							 data_segment_size );
-						}
-#endif
-						if( libfsntfs_compressed_block_descriptor_append_data_segment(
-						     compressed_block_descriptor,
-						     data_run_offset,
-						     data_segment_size,
-						     data_run->range_flags,
-						     error ) != 1 )
-						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-							 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-							 "%s: unable to append data segment to compressed block descriptor: %d.",
-							 function,
-							 compressed_block_descriptor_index );
-
-							data_handle = NULL;
-
-							goto on_error;
-						}
-						if( ( data_run->range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) == 0 )
-						{
-							data_run_offset += data_segment_size;
-						}
-						data_run_size                   -= data_segment_size;
-						remaining_compression_unit_size -= data_segment_size;
-
-						if( remaining_compression_unit_size == 0 )
-						{
-#if defined( HAVE_DEBUG_OUTPUT )
-							if( libcnotify_verbose != 0 )
-							{
-								if( libfsntfs_compressed_block_descriptor_print(
-								     compressed_block_descriptor,
-								     io_handle,
-								     compressed_block_descriptor_index,
-								     error ) != 1 )
-								{
-									libcerror_error_set(
-									 error,
-									 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-									 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-									 "%s: unable to print the compressed block descriptor: %d.",
-									 function,
-									 compressed_block_descriptor_index );
-
-									data_handle = NULL;
-
-									goto on_error;
-								}
-							}
-#endif
-							if( libfdata_vector_append_segment(
-							     data_handle->compressed_block_vector,
-							     &element_index,
-							     0,
-							     data_offset,
-							     compression_unit_size,
-							     compressed_block_descriptor->data_range_flags,
-							     error ) != 1 )
-							{
-								libcerror_error_set(
-								 error,
-								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-								 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-								 "%s: unable to append compression unit to compressed block vector: %d.",
-								 function,
-								 compressed_block_descriptor_index );
-
-								data_handle = NULL;
-
-								goto on_error;
-							}
-							if( libcdata_array_append_entry(
-							     data_handle->compressed_block_descriptors_array,
-							     &entry_index,
-							     (intptr_t *) compressed_block_descriptor,
-							     error ) != 1 )
-							{
-								libcerror_error_set(
-								 error,
-								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-								 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-								 "%s: unable to append compressed block descriptor: %d to array.",
-								 function,
-								 compressed_block_descriptor_index );
-
-								data_handle = NULL;
-
-								goto on_error;
-							}
-							compressed_block_descriptor = NULL;
-
-							/* The data stream segments are mapped directly to the vector elements to ease current offset calculation
-							 */
-							if( libfdata_stream_append_segment(
-							     *cluster_block_stream,
-							     &element_index,
-							     0,
-							     data_offset,
-							     compression_unit_size,
-							     0,
-							     error ) != 1 )
-							{
-								libcerror_error_set(
-								 error,
-								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-								 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-								 "%s: unable to append compressed block: %d as cluster block stream segment.",
-								 function,
-								 compressed_block_descriptor_index );
-
-								data_handle = NULL;
-
-								goto on_error;
-							}
-							compressed_block_descriptor_index++;
-
-							/* Make sure to give every segment a unique offset */
-							data_offset += compression_unit_size;
-						}
-					}
-				}
+				total_read_count += (ssize_t) range_read_count;
 			}
-			calculated_attribute_data_vcn_offset = attribute_data_vcn_offset + (off64_t) attribute_data_vcn_size;
-		}
-		if( libfsntfs_attribute_get_chained_attribute(
-		     attribute,
-		     &attribute,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chained attribute: %d.",
-			 function,
-			 attribute_index );
-
-			data_handle = NULL;
-
-			goto on_error;
-		}
-		attribute_index++;
-	}
-	if( ( number_of_data_runs != 0 )
-	 || ( resident_data != NULL ) )
-	{
-		if( libfdata_stream_set_mapped_size(
-		     *cluster_block_stream,
-		     data_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set mapped cluster block stream size.",
-			 function );
-
-			data_handle = NULL;
-
-			goto on_error;
 		}
+		first_range_index += number_of_coalesced_ranges;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( coalesced_data != NULL )
 	{
-		libcnotify_printf(
-		 "\n" );
+		memory_free(
+		 coalesced_data );
 	}
-#endif
-	if( ( ( data_flags & LIBFSNTFS_ATTRIBUTE_FLAG_COMPRESSION_MASK ) != 0 )
-	 && ( resident_data == NULL ) )
-	{
-		if( libfcache_cache_initialize(
-		     &( data_handle->cache ),
-		     LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_COMPRESSION_UNITS,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create cache.",
-			 function );
+	memory_free(
+	 sorted_ranges );
 
-			data_handle = NULL;
+	if( libfdata_stream_seek_offset(
+	     cluster_block_stream,
+	     current_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in cluster block stream.",
+		 function,
+		 current_offset,
+		 current_offset );
 
-			goto on_error;
-		}
+		return( -1 );
 	}
-	return( 1 );
+	return( total_read_count );
 
 on_error:
-	if( *cluster_block_stream != NULL )
+	libfdata_stream_seek_offset(
+	 cluster_block_stream,
+	 current_offset,
+	 SEEK_SET,
+	 NULL );
+
+	if( coalesced_data != NULL )
 	{
-		libfdata_stream_free(
-		 cluster_block_stream,
-		 NULL );
+		memory_free(
+		 coalesced_data );
 	}
-	if( data_handle != NULL )
+	if( sorted_ranges != NULL )
 	{
-		libfsntfs_cluster_block_stream_data_handle_free(
-		 &data_handle,
-		 NULL );
+		memory_free(
+		 sorted_ranges );
 	}
 	return( -1 );
 }
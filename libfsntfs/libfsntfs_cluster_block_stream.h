@@ -26,10 +26,14 @@
 #include <types.h>
 
 #include "libfsntfs_attribute.h"
+#include "libfsntfs_compressed_block_descriptor.h"
+#include "libfsntfs_extent_table.h"
 #include "libfsntfs_io_handle.h"
+#include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libfcache.h"
 #include "libfsntfs_libfdata.h"
+#include "libfsntfs_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -51,6 +55,10 @@ struct libfsntfs_cluster_block_stream_data_handle
 	 */
 	size64_t data_size;
 
+	/* The valid data size
+	 */
+	size64_t valid_data_size;
+
 	/* The compression unit size
 	 */
 	size_t compression_unit_size;
@@ -63,17 +71,34 @@ struct libfsntfs_cluster_block_stream_data_handle
 	 */
 	const uint8_t *resident_data;
 
-	/* The compressed block descriptors array
+	/* The extent table, used to map non-resident data
+	 */
+	libfsntfs_extent_table_t *extent_table;
+
+	/* The index of the extent that was last read
 	 */
-	libcdata_array_t *compressed_block_descriptors_array;
+	int current_extent_index;
 
-	/* The compressed block vector
+	/* The compressed block vector, the compression unit descriptors are created
+	 * from the extent table when a compression unit is read
 	 */
 	libfdata_vector_t *compressed_block_vector;
 
 	/* The cache
 	 */
 	libfcache_cache_t *cache;
+
+	/* The number of cache entries
+	 */
+	int number_of_cache_entries;
+
+	/* The index of the last compression unit that was read
+	 */
+	int last_segment_index;
+
+	/* The number of compression units that were read sequentially
+	 */
+	int number_of_sequential_segments;
 };
 
 int libfsntfs_cluster_block_stream_data_handle_initialize(
@@ -105,6 +130,29 @@ ssize_t libfsntfs_cluster_block_stream_data_handle_read_segment_data(
          uint8_t read_flags,
          libcerror_error_t **error );
 
+ssize_t libfsntfs_cluster_block_stream_data_handle_read_extent_data(
+         libfsntfs_cluster_block_stream_data_handle_t *data_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         libcerror_error_t **error );
+
+int libfsntfs_cluster_block_stream_data_handle_read_ahead(
+     libfsntfs_cluster_block_stream_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     int segment_index,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+ssize_t libfsntfs_cluster_block_stream_data_handle_read_compression_units(
+         libfsntfs_cluster_block_stream_data_handle_t *data_handle,
+         libbfio_handle_t *file_io_handle,
+         int compressed_block_index,
+         int number_of_compressed_blocks,
+         uint8_t *segment_data,
+         size_t segment_data_size,
+         libcerror_error_t **error );
+
 off64_t libfsntfs_cluster_block_stream_data_handle_seek_segment_offset(
          libfsntfs_cluster_block_stream_data_handle_t *data_handle,
          intptr_t *file_io_handle,
@@ -113,12 +161,70 @@ off64_t libfsntfs_cluster_block_stream_data_handle_seek_segment_offset(
          off64_t segment_offset,
          libcerror_error_t **error );
 
+int libfsntfs_cluster_block_stream_data_handle_get_compressed_block_descriptor(
+     libfsntfs_cluster_block_stream_data_handle_t *data_handle,
+     int compressed_block_index,
+     libfsntfs_compressed_block_descriptor_t **compressed_block_descriptor,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_block_stream_data_handle_read_compressed_block_element_data(
+     libfsntfs_cluster_block_stream_data_handle_t *data_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *vector,
+     libfcache_cache_t *cache,
+     int element_index,
+     int element_data_file_index,
+     off64_t element_data_offset,
+     size64_t compressed_block_size,
+     uint32_t range_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 int libfsntfs_cluster_block_stream_initialize(
      libfdata_stream_t **cluster_block_stream,
      libfsntfs_io_handle_t *io_handle,
      libfsntfs_attribute_t *attribute,
      libcerror_error_t **error );
 
+int libfsntfs_cluster_block_stream_uses_extent_table(
+     libfsntfs_attribute_t *attribute,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_block_stream_get_number_of_extents(
+     libfdata_stream_t *cluster_block_stream,
+     libfsntfs_attribute_t *attribute,
+     int *number_of_extents,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_block_stream_get_extent_by_index(
+     libfdata_stream_t *cluster_block_stream,
+     libfsntfs_attribute_t *attribute,
+     int extent_index,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_block_stream_get_data_or_hole_offset(
+     libfsntfs_attribute_t *attribute,
+     size64_t data_size,
+     off64_t offset,
+     int whence,
+     off64_t *data_or_hole_offset,
+     libcerror_error_t **error );
+
+int libfsntfs_cluster_block_stream_compare_read_ranges(
+     const void *first_read_range,
+     const void *second_read_range );
+
+ssize_t libfsntfs_cluster_block_stream_read_vector(
+         libfdata_stream_t *cluster_block_stream,
+         libbfio_handle_t *file_io_handle,
+         libfsntfs_io_handle_t *io_handle,
+         libfsntfs_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
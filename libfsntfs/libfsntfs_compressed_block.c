@@ -25,13 +25,14 @@
 
 #include "libfsntfs_compressed_block.h"
 #include "libfsntfs_compressed_block_descriptor.h"
+#include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
-#include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
 #include "libfsntfs_libcnotify.h"
 #include "libfsntfs_libfcache.h"
 #include "libfsntfs_libfdata.h"
-#include "libfsntfs_libfwnt.h"
+#include "libfsntfs_lznt1.h"
 #include "libfsntfs_types.h"
 #include "libfsntfs_unused.h"
 
@@ -183,7 +184,8 @@ int libfsntfs_compressed_block_free(
  * Returns 1 if successful or -1 on error
  */
 int libfsntfs_compressed_block_read_element_data(
-     libcdata_array_t *compressed_block_descriptors_array,
+     libfsntfs_compressed_block_descriptor_t *compressed_block_descriptor,
+     libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfdata_vector_t *vector,
      libfcache_cache_t *cache,
@@ -195,58 +197,51 @@ int libfsntfs_compressed_block_read_element_data(
      uint8_t read_flags LIBFSNTFS_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
-	libfsntfs_compressed_block_t *compressed_block                       = NULL;
-	libfsntfs_compressed_block_descriptor_t *compressed_block_descriptor = NULL;
-	uint8_t *compressed_data                                             = NULL;
-	uint8_t *compressed_block_data                                       = NULL;
-	static char *function                                                = "libfsntfs_compressed_block_read_element_data";
-	ssize_t read_count                                                   = 0;
-	int result                                                           = 0;
+	libfsntfs_compressed_block_t *compressed_block = NULL;
+	uint8_t *compressed_data                       = NULL;
+	uint8_t *compressed_block_data                 = NULL;
+	static char *function                          = "libfsntfs_compressed_block_read_element_data";
+	ssize_t read_count                             = 0;
+	int result                                     = 0;
 
 	LIBFSNTFS_UNREFERENCED_PARAMETER( element_data_file_index )
 	LIBFSNTFS_UNREFERENCED_PARAMETER( element_data_offset )
 	LIBFSNTFS_UNREFERENCED_PARAMETER( read_flags )
 
-	if( compressed_block_descriptors_array == NULL )
+	if( compressed_block_descriptor == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compressed block descriptors array.",
+		 "%s: invalid compressed block descriptor.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( compressed_block_size == 0 )
-	 || ( compressed_block_size > (size64_t) SSIZE_MAX ) )
+	if( io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid compressed block size value out of bounds.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     compressed_block_descriptors_array,
-	     element_index,
-	     (intptr_t **) &compressed_block_descriptor,
-	     error ) != 1 )
+	if( ( compressed_block_size == 0 )
+	 || ( compressed_block_size > (size64_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve compressed block descriptor: %d.",
-		 function,
-		 element_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed block size value out of bounds.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-/* TODO check compressed_block_descriptor == NULL */
 	if( libfsntfs_compressed_block_initialize(
 	     &compressed_block,
 	     compressed_block_size,
@@ -294,6 +289,24 @@ int libfsntfs_compressed_block_read_element_data(
 	{
 		compressed_block_data = compressed_block->data;
 	}
+	/* The compressed block data stream seeks and reads the file IO handle
+	 * in separate callbacks
+	 */
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->file_io_handle_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab file IO handle mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	read_count = libfdata_stream_read_buffer(
 	              compressed_block_descriptor->data_stream,
 		      (intptr_t *) file_io_handle,
@@ -302,6 +315,21 @@ int libfsntfs_compressed_block_read_element_data(
 		      0,
 		      error );
 
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->file_io_handle_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file IO handle mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	if( read_count != (ssize_t) compressed_block_size )
 	{
 		libcerror_error_set(
@@ -315,7 +343,7 @@ int libfsntfs_compressed_block_read_element_data(
 	}
 	if( ( range_flags & LIBFDATA_RANGE_FLAG_IS_COMPRESSED ) != 0 )
 	{
-		result = libfwnt_lznt1_decompress(
+		result = libfsntfs_lznt1_decompress(
 			  compressed_data,
 			  (size_t) compressed_block_size,
 			  compressed_block->data,
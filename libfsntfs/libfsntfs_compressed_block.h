@@ -25,8 +25,9 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_compressed_block_descriptor.h"
+#include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
-#include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libfcache.h"
 #include "libfsntfs_libfdata.h"
@@ -58,7 +59,8 @@ int libfsntfs_compressed_block_free(
      libcerror_error_t **error );
 
 int libfsntfs_compressed_block_read_element_data(
-     libcdata_array_t *compressed_block_descriptors_array,
+     libfsntfs_compressed_block_descriptor_t *compressed_block_descriptor,
+     libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfdata_vector_t *vector,
      libfcache_cache_t *cache,
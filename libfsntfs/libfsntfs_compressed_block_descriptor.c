@@ -24,6 +24,7 @@
 #include <types.h>
 
 #include "libfsntfs_compressed_block_descriptor.h"
+#include "libfsntfs_extent_table.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libcnotify.h"
@@ -220,8 +221,188 @@ int libfsntfs_compressed_block_descriptor_append_data_segment(
 	return( 1 );
 }
 
+/* Appends the data segments of a compression unit using an extent table
+ * The compression unit consists of the clusters from the first virtual cluster number (VCN)
+ * A sparse extent that follows data marks the compression unit as compressed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_compressed_block_descriptor_append_extents(
+     libfsntfs_compressed_block_descriptor_t *compressed_block_descriptor,
+     libfsntfs_extent_table_t *extent_table,
+     uint64_t first_vcn,
+     uint64_t number_of_clusters,
+     libcerror_error_t **error )
+{
+	static char *function               = "libfsntfs_compressed_block_descriptor_append_extents";
+	off64_t segment_offset              = 0;
+	size64_t segment_size               = 0;
+	uint64_t extent_first_lcn           = 0;
+	uint64_t extent_first_vcn           = 0;
+	uint64_t extent_number_of_clusters  = 0;
+	uint64_t number_of_segment_clusters = 0;
+	uint64_t vcn                        = 0;
+	uint32_t extent_range_flags         = 0;
+	int extent_index                    = 0;
+	int result                          = 0;
+
+	if( compressed_block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_extent_table_get_extent_index_by_vcn(
+	          extent_table,
+	          first_vcn,
+	          &extent_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent index for VCN: %" PRIu64 ".",
+		 function,
+		 first_vcn );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first VCN: %" PRIu64 " value out of bounds.",
+		 function,
+		 first_vcn );
+
+		return( -1 );
+	}
+	vcn = first_vcn;
+
+	while( number_of_clusters > 0 )
+	{
+		if( libfsntfs_extent_table_get_extent_by_index(
+		     extent_table,
+		     extent_index,
+		     &extent_first_vcn,
+		     &extent_first_lcn,
+		     &extent_number_of_clusters,
+		     &extent_range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( ( vcn < extent_first_vcn )
+		 || ( ( vcn - extent_first_vcn ) >= extent_number_of_clusters ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent: %d - missing VCN: %" PRIu64 ".",
+			 function,
+			 extent_index,
+			 vcn );
+
+			return( -1 );
+		}
+		number_of_segment_clusters = extent_first_vcn + extent_number_of_clusters - vcn;
+
+		if( number_of_segment_clusters > number_of_clusters )
+		{
+			number_of_segment_clusters = number_of_clusters;
+		}
+		segment_size = (size64_t) ( number_of_segment_clusters * extent_table->cluster_block_size );
+
+		if( ( extent_range_flags & LIBFDATA_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			if( compressed_block_descriptor->data_size > 0 )
+			{
+				/* A sparse extent marks the end of a compression unit and
+				 * should be at minimum the size of the remaining data in the compression unit
+				 */
+				if( number_of_segment_clusters < number_of_clusters )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid sparse extent: %d size value out of bounds.",
+					 function,
+					 extent_index );
+
+					return( -1 );
+				}
+				compressed_block_descriptor->data_range_flags = LIBFDATA_RANGE_FLAG_IS_COMPRESSED;
+			}
+			else
+			{
+				compressed_block_descriptor->data_range_flags = extent_range_flags;
+			}
+			segment_offset = 0;
+		}
+		else
+		{
+			compressed_block_descriptor->data_range_flags = extent_range_flags;
+
+			segment_offset = (off64_t) ( ( extent_first_lcn + ( vcn - extent_first_vcn ) ) * extent_table->cluster_block_size );
+		}
+		if( libfsntfs_compressed_block_descriptor_append_data_segment(
+		     compressed_block_descriptor,
+		     segment_offset,
+		     segment_size,
+		     extent_range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent: %d data segment.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		vcn                += number_of_segment_clusters;
+		number_of_clusters -= number_of_segment_clusters;
+
+		extent_index++;
+	}
+	return( 1 );
+}
+
 /* Reads data from the current offset into a buffer
  * Callback for the compressed block descriptor data stream
+ * The caller must hold the file IO handle mutex of the IO handle
  * Returns the number of bytes read or -1 on error
  */
 ssize_t libfsntfs_compressed_block_descriptor_read_segment_data(
@@ -308,6 +489,7 @@ ssize_t libfsntfs_compressed_block_descriptor_read_segment_data(
 
 /* Seeks a certain offset of the data
  * Callback for the cluster block stream
+ * The caller must hold the file IO handle mutex of the IO handle
  * Returns the offset if seek is successful or -1 on error
  */
 off64_t libfsntfs_compressed_block_descriptor_seek_segment_offset(
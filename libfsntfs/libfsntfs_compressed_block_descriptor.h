@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_extent_table.h"
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
@@ -66,6 +67,13 @@ int libfsntfs_compressed_block_descriptor_append_data_segment(
      uint32_t segment_flags,
      libcerror_error_t **error );
 
+int libfsntfs_compressed_block_descriptor_append_extents(
+     libfsntfs_compressed_block_descriptor_t *compressed_block_descriptor,
+     libfsntfs_extent_table_t *extent_table,
+     uint64_t first_vcn,
+     uint64_t number_of_clusters,
+     libcerror_error_t **error );
+
 ssize_t libfsntfs_compressed_block_descriptor_read_segment_data(
          intptr_t *data_handle,
          libbfio_handle_t *file_io_handle,
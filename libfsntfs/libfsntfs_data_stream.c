@@ -30,6 +30,7 @@
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
 #include "libfsntfs_libfdata.h"
 #include "libfsntfs_types.h"
 
@@ -70,6 +71,17 @@ int libfsntfs_data_stream_initialize(
 
 		return( -1 );
 	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( data_attribute == NULL )
 	{
 		libcerror_error_set(
@@ -112,6 +124,21 @@ int libfsntfs_data_stream_initialize(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_data_stream->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	if( libfsntfs_attribute_get_number_of_data_runs(
 	     data_attribute,
 	     &number_of_data_runs,
@@ -153,9 +180,10 @@ int libfsntfs_data_stream_initialize(
 		 "%s: unable to retrieve data attribute data size.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	internal_data_stream->file_io_handle = file_io_handle;
+	internal_data_stream->io_handle      = io_handle;
 	internal_data_stream->data_attribute = data_attribute;
 
 	*data_stream = (libfsntfs_data_stream_t *) internal_data_stream;
@@ -165,6 +193,20 @@ int libfsntfs_data_stream_initialize(
 on_error:
 	if( internal_data_stream != NULL )
 	{
+		if( internal_data_stream->data_cluster_block_stream != NULL )
+		{
+			libfdata_stream_free(
+			 &( internal_data_stream->data_cluster_block_stream ),
+			 NULL );
+		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( internal_data_stream->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_data_stream->read_write_lock ),
+			 NULL );
+		}
+#endif
 		memory_free(
 		 internal_data_stream );
 	}
@@ -216,6 +258,21 @@ int libfsntfs_data_stream_free(
 				result = -1;
 			}
 		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( internal_data_stream->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 internal_data_stream );
 	}
@@ -420,6 +477,21 @@ ssize_t libfsntfs_data_stream_read_buffer(
 	}
 	internal_data_stream = (libfsntfs_internal_data_stream_t *) data_stream;
 
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	read_count = libfdata_stream_read_buffer(
 	              internal_data_stream->data_cluster_block_stream,
 		      (intptr_t *) internal_data_stream->file_io_handle,
@@ -437,8 +509,23 @@ ssize_t libfsntfs_data_stream_read_buffer(
 		 "%s: unable to read from data cluster block stream.",
 		 function );
 
+		read_count = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
 		return( -1 );
 	}
+#endif
 	return( read_count );
 }
 
@@ -452,11 +539,40 @@ ssize_t libfsntfs_data_stream_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_data_stream_read_buffer_at_offset";
-	ssize_t read_count    = 0;
+	libfsntfs_internal_data_stream_t *internal_data_stream = NULL;
+	static char *function                                  = "libfsntfs_data_stream_read_buffer_at_offset";
+	ssize_t read_count                                     = 0;
 
-	if( libfsntfs_data_stream_seek_offset(
-	     data_stream,
+	if( data_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data stream.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_stream = (libfsntfs_internal_data_stream_t *) data_stream;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfdata_stream_seek_offset(
+	     internal_data_stream->data_cluster_block_stream,
 	     offset,
 	     SEEK_SET,
 	     error ) == -1 )
@@ -465,32 +581,133 @@ ssize_t libfsntfs_data_stream_read_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 "%s: unable to seek offset in data cluster block stream.",
+		 function );
+
+		read_count = -1;
+	}
+	else
+	{
+		read_count = libfdata_stream_read_buffer(
+		              internal_data_stream->data_cluster_block_stream,
+		              (intptr_t *) internal_data_stream->file_io_handle,
+		              buffer,
+		              buffer_size,
+		              0,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from data cluster block stream.",
+			 function );
+
+			read_count = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads multiple ranges of data
+ * The ranges are read in order of their offset and ranges that are close together
+ * are coalesced into a single read. The current offset is not changed
+ * Returns the total number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_data_stream_read_vector(
+         libfsntfs_data_stream_t *data_stream,
+         libfsntfs_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error )
+{
+	libfsntfs_internal_data_stream_t *internal_data_stream = NULL;
+	static char *function                                  = "libfsntfs_data_stream_read_vector";
+	ssize_t read_count                                     = 0;
+
+	if( data_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data stream.",
 		 function );
 
 		return( -1 );
 	}
-	read_count = libfsntfs_data_stream_read_buffer(
-	              data_stream,
-	              buffer,
-	              buffer_size,
+	internal_data_stream = (libfsntfs_internal_data_stream_t *) data_stream;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libfsntfs_cluster_block_stream_read_vector(
+	              internal_data_stream->data_cluster_block_stream,
+	              internal_data_stream->file_io_handle,
+	              internal_data_stream->io_handle,
+	              ranges,
+	              number_of_ranges,
 	              error );
 
-	if( read_count <= -1 )
+	if( read_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 "%s: unable to read ranges from data cluster block stream.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
+#endif
 	return( read_count );
 }
 
 /* Seeks a certain offset
+ * The whence LIBFSNTFS_SEEK_DATA and LIBFSNTFS_SEEK_HOLE seek to the next data or sparse hole
  * Returns the offset if seek is successful or -1 on error
  */
 off64_t libfsntfs_data_stream_seek_offset(
@@ -501,6 +718,7 @@ off64_t libfsntfs_data_stream_seek_offset(
 {
 	libfsntfs_internal_data_stream_t *internal_data_stream = NULL;
 	static char *function                                  = "libfsntfs_data_stream_seek_offset";
+	int result                                             = 1;
 
 	if( data_stream == NULL )
 	{
@@ -515,23 +733,93 @@ off64_t libfsntfs_data_stream_seek_offset(
 	}
 	internal_data_stream = (libfsntfs_internal_data_stream_t *) data_stream;
 
-	offset = libfdata_stream_seek_offset(
-	          internal_data_stream->data_cluster_block_stream,
-	          offset,
-	          whence,
-	          error );
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-	if( offset == -1 )
+		return( -1 );
+	}
+#endif
+	if( ( whence == LIBFSNTFS_SEEK_DATA )
+	 || ( whence == LIBFSNTFS_SEEK_HOLE ) )
+	{
+		result = libfsntfs_cluster_block_stream_get_data_or_hole_offset(
+		          internal_data_stream->data_attribute,
+		          internal_data_stream->data_size,
+		          offset,
+		          whence,
+		          &offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data or hole offset.",
+			 function );
+		}
+		else if( result == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset value out of bounds - no data at or after offset.",
+			 function );
+
+			result = -1;
+		}
+		whence = SEEK_SET;
+	}
+	if( result != 1 )
+	{
+		offset = -1;
+	}
+	else
+	{
+		offset = libfdata_stream_seek_offset(
+		          internal_data_stream->data_cluster_block_stream,
+		          offset,
+		          whence,
+		          error );
+
+		if( offset == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset in data cluster block stream.",
+			 function );
+
+			offset = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset in data cluster block stream.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
+#endif
 	return( offset );
 }
 
@@ -545,6 +833,7 @@ int libfsntfs_data_stream_get_offset(
 {
 	libfsntfs_internal_data_stream_t *internal_data_stream = NULL;
 	static char *function                                  = "libfsntfs_data_stream_get_offset";
+	int result                                             = 1;
 
 	if( data_stream == NULL )
 	{
@@ -559,6 +848,21 @@ int libfsntfs_data_stream_get_offset(
 	}
 	internal_data_stream = (libfsntfs_internal_data_stream_t *) data_stream;
 
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	if( libfdata_stream_get_offset(
 	     internal_data_stream->data_cluster_block_stream,
 	     offset,
@@ -571,9 +875,24 @@ int libfsntfs_data_stream_get_offset(
 		 "%s: unable to retrieve offset from data cluster block stream.",
 		 function );
 
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_data_stream->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
 		return( -1 );
 	}
-	return( 1 );
+#endif
+	return( result );
 }
 
 /* Retrieves the size
@@ -657,8 +976,9 @@ int libfsntfs_data_stream_get_number_of_extents(
 	}
 	else
 	{
-		if( libfdata_stream_get_number_of_segments(
+		if( libfsntfs_cluster_block_stream_get_number_of_extents(
 		     internal_data_stream->data_cluster_block_stream,
+		     internal_data_stream->data_attribute,
 		     number_of_extents,
 		     error ) != 1 )
 		{
@@ -666,7 +986,7 @@ int libfsntfs_data_stream_get_number_of_extents(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve data cluster block stream number of segments.",
+			 "%s: unable to retrieve data cluster block stream number of extents.",
 			 function );
 
 			return( -1 );
@@ -690,7 +1010,6 @@ int libfsntfs_data_stream_get_extent_by_index(
 	static char *function                                  = "libfsntfs_data_stream_get_extent_by_index";
 	size64_t data_size                                     = 0;
 	uint32_t range_flags                                   = 0;
-	int segment_file_index                                 = 0;
 
 	if( data_stream == NULL )
 	{
@@ -749,10 +1068,10 @@ int libfsntfs_data_stream_get_extent_by_index(
 
 		return( -1 );
 	}
-	if( libfdata_stream_get_segment_by_index(
+	if( libfsntfs_cluster_block_stream_get_extent_by_index(
 	     internal_data_stream->data_cluster_block_stream,
+	     internal_data_stream->data_attribute,
 	     extent_index,
-	     &segment_file_index,
 	     extent_offset,
 	     extent_size,
 	     &range_flags,
@@ -762,24 +1081,7 @@ int libfsntfs_data_stream_get_extent_by_index(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data cluster block stream segment: %d.",
-		 function,
-		 extent_index );
-
-		return( -1 );
-	}
-	if( libfdata_stream_get_segment_mapped_range(
-	     internal_data_stream->data_cluster_block_stream,
-	     extent_index,
-	     extent_offset,
-	     extent_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data cluster block stream segment: %d mapped range.",
+		 "%s: unable to retrieve data cluster block stream extent: %d.",
 		 function,
 		 extent_index );
 
@@ -30,6 +30,7 @@
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
 #include "libfsntfs_libfdata.h"
 #include "libfsntfs_types.h"
 
@@ -45,6 +46,10 @@ struct libfsntfs_internal_data_stream
 	 */
 	libbfio_handle_t *file_io_handle;
 
+	/* The IO handle
+	 */
+	libfsntfs_io_handle_t *io_handle;
+
 	/* The $DATA attribute
 	 */
 	libfsntfs_attribute_t *data_attribute;
@@ -56,6 +61,12 @@ struct libfsntfs_internal_data_stream
 	/* The data size
 	 */
 	size64_t data_size;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
 };
 
 int libfsntfs_data_stream_initialize(
@@ -111,6 +122,13 @@ ssize_t libfsntfs_data_stream_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+ssize_t libfsntfs_data_stream_read_vector(
+         libfsntfs_data_stream_t *data_stream,
+         libfsntfs_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 off64_t libfsntfs_data_stream_seek_offset(
          libfsntfs_data_stream_t *data_stream,
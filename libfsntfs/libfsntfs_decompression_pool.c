@@ -0,0 +1,460 @@
+/*
+ * Decompression pool functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_decompression_pool.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+#include "libfsntfs_lznt1.h"
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+/* Creates a decompression pool
+ * Make sure the value decompression_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_decompression_pool_initialize(
+     libfsntfs_decompression_pool_t **decompression_pool,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_decompression_pool_initialize";
+
+	if( decompression_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *decompression_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid decompression pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > ( INT_MAX / 4 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*decompression_pool = memory_allocate_structure(
+	                       libfsntfs_decompression_pool_t );
+
+	if( *decompression_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create decompression pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *decompression_pool,
+	     0,
+	     sizeof( libfsntfs_decompression_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear decompression pool.",
+		 function );
+
+		memory_free(
+		 *decompression_pool );
+
+		*decompression_pool = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *decompression_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *decompression_pool )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *decompression_pool )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     number_of_threads * 4,
+	     (int (*)(intptr_t *, void *)) &libfsntfs_decompression_pool_process_task,
+	     (void *) *decompression_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *decompression_pool )->number_of_threads = number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( *decompression_pool != NULL )
+	{
+		if( ( *decompression_pool )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *decompression_pool )->condition ),
+			 NULL );
+		}
+		if( ( *decompression_pool )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *decompression_pool )->mutex ),
+			 NULL );
+		}
+		memory_free(
+		 *decompression_pool );
+
+		*decompression_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a decompression pool
+ * The worker threads are joined before the pool is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_decompression_pool_free(
+     libfsntfs_decompression_pool_t **decompression_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_decompression_pool_free";
+	int result            = 1;
+
+	if( decompression_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *decompression_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( ( *decompression_pool )->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *decompression_pool )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *decompression_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *decompression_pool );
+
+		*decompression_pool = NULL;
+	}
+	return( result );
+}
+
+/* Processes a decompression task
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_decompression_pool_process_task(
+     libfsntfs_decompression_task_t *task,
+     libfsntfs_decompression_pool_t *decompression_pool )
+{
+	int *number_of_pending_tasks = NULL;
+	int result                   = 0;
+
+	if( ( task == NULL )
+	 || ( decompression_pool == NULL ) )
+	{
+		return( -1 );
+	}
+	result = libfsntfs_lznt1_decompress(
+	          task->compressed_data,
+	          task->compressed_data_size,
+	          task->uncompressed_data,
+	          &( task->uncompressed_data_size ),
+	          &( task->error ) );
+
+	if( libcthreads_mutex_grab(
+	     decompression_pool->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	/* The task can be freed by the waiting thread as soon as the number
+	 * of pending tasks reaches zero, hence it is not referenced afterwards
+	 */
+	number_of_pending_tasks = task->number_of_pending_tasks;
+
+	task->result = result;
+
+	*number_of_pending_tasks -= 1;
+
+	libcthreads_condition_broadcast(
+	 decompression_pool->condition,
+	 NULL );
+
+	if( libcthreads_mutex_release(
+	     decompression_pool->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decompresses the data of the tasks using the worker threads
+ * Waits until all the tasks were processed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_decompression_pool_decompress(
+     libfsntfs_decompression_pool_t *decompression_pool,
+     libfsntfs_decompression_task_t *tasks,
+     int number_of_tasks,
+     libcerror_error_t **error )
+{
+	static char *function        = "libfsntfs_decompression_pool_decompress";
+	int number_of_pending_tasks  = 0;
+	int number_of_unpushed_tasks = 0;
+	int result                   = 1;
+	int task_index               = 0;
+
+	if( decompression_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompression pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( tasks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tasks.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_tasks < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of tasks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( task_index = 0;
+	     task_index < number_of_tasks;
+	     task_index++ )
+	{
+		tasks[ task_index ].number_of_pending_tasks = &number_of_pending_tasks;
+		tasks[ task_index ].result                  = 0;
+		tasks[ task_index ].error                   = NULL;
+	}
+	/* All tasks are counted as pending before any is pushed, hence the worker
+	 * threads never see a number of pending tasks that is not yet complete
+	 */
+	number_of_pending_tasks = number_of_tasks;
+
+	for( task_index = 0;
+	     task_index < number_of_tasks;
+	     task_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     decompression_pool->thread_pool,
+		     (intptr_t *) &( tasks[ task_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push task: %d onto thread pool.",
+			 function,
+			 task_index );
+
+			number_of_unpushed_tasks = number_of_tasks - task_index;
+
+			result = -1;
+
+			break;
+		}
+	}
+	/* The tasks that were pushed reference the number of pending tasks,
+	 * hence wait for them also if not all tasks could be pushed
+	 */
+	if( libcthreads_mutex_grab(
+	     decompression_pool->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	number_of_pending_tasks -= number_of_unpushed_tasks;
+
+	while( number_of_pending_tasks > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     decompression_pool->condition,
+		     decompression_pool->mutex,
+		     NULL ) != 1 )
+		{
+			libcthreads_mutex_release(
+			 decompression_pool->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     decompression_pool->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	for( task_index = 0;
+	     task_index < number_of_tasks;
+	     task_index++ )
+	{
+		if( tasks[ task_index ].result == 1 )
+		{
+			continue;
+		}
+		if( result == 1 )
+		{
+			/* Pass the error of the worker thread to the caller
+			 */
+			if( ( error != NULL )
+			 && ( *error == NULL ) )
+			{
+				*error = tasks[ task_index ].error;
+
+				tasks[ task_index ].error = NULL;
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress data of task: %d.",
+			 function,
+			 task_index );
+
+			result = -1;
+		}
+		if( tasks[ task_index ].error != NULL )
+		{
+			libcerror_error_free(
+			 &( tasks[ task_index ].error ) );
+		}
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,118 @@
+/*
+ * Decompression pool functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_DECOMPRESSION_POOL_H )
+#define _LIBFSNTFS_DECOMPRESSION_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+typedef struct libfsntfs_decompression_pool libfsntfs_decompression_pool_t;
+
+struct libfsntfs_decompression_pool
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The mutex that protects the number of pending tasks
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a task was processed
+	 */
+	libcthreads_condition_t *condition;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+};
+
+typedef struct libfsntfs_decompression_task libfsntfs_decompression_task_t;
+
+struct libfsntfs_decompression_task
+{
+	/* The compressed data
+	 */
+	const uint8_t *compressed_data;
+
+	/* The compressed data size
+	 */
+	size_t compressed_data_size;
+
+	/* The uncompressed data
+	 */
+	uint8_t *uncompressed_data;
+
+	/* The uncompressed data size
+	 * On return contains the number of bytes decompressed
+	 */
+	size_t uncompressed_data_size;
+
+	/* The number of pending tasks of the batch the task is part of
+	 */
+	int *number_of_pending_tasks;
+
+	/* The result of processing the task
+	 */
+	int result;
+
+	/* The error of processing the task
+	 */
+	libcerror_error_t *error;
+};
+
+int libfsntfs_decompression_pool_initialize(
+     libfsntfs_decompression_pool_t **decompression_pool,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libfsntfs_decompression_pool_free(
+     libfsntfs_decompression_pool_t **decompression_pool,
+     libcerror_error_t **error );
+
+int libfsntfs_decompression_pool_process_task(
+     libfsntfs_decompression_task_t *task,
+     libfsntfs_decompression_pool_t *decompression_pool );
+
+int libfsntfs_decompression_pool_decompress(
+     libfsntfs_decompression_pool_t *decompression_pool,
+     libfsntfs_decompression_task_t *tasks,
+     int number_of_tasks,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -0,0 +1,920 @@
+/*
+ * Directory entries hash table functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_directory_entries_hash_table.h"
+#include "libfsntfs_directory_entry.h"
+#include "libfsntfs_file_name_values.h"
+#include "libfsntfs_libcdata.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libuna.h"
+#include "libfsntfs_upcase_table.h"
+
+/* Calculates the FNV-1a hash of an upper case name
+ * Returns the hash
+ */
+uint32_t libfsntfs_directory_entries_hash_table_key_get_hash(
+          const uint16_t *upcase_name,
+          size_t upcase_name_length )
+{
+	size_t upcase_name_index = 0;
+	uint32_t hash            = 0x811c9dc5UL;
+
+	for( upcase_name_index = 0;
+	     upcase_name_index < upcase_name_length;
+	     upcase_name_index++ )
+	{
+		hash ^= (uint32_t) upcase_name[ upcase_name_index ];
+		hash *= 0x01000193UL;
+	}
+	return( hash );
+}
+
+/* Sets a key from an UTF-16 little-endian encoded name
+ * Returns 1 if successful, 0 if the name is too long or -1 on error
+ */
+int libfsntfs_directory_entries_hash_table_key_set_from_utf16_stream(
+     libfsntfs_directory_entries_hash_table_key_t *key,
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *utf16_stream,
+     size_t utf16_stream_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libfsntfs_directory_entries_hash_table_key_set_from_utf16_stream";
+	size_t utf16_stream_index = 0;
+	uint16_t name_character   = 0;
+
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upcase table.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf16_stream_size > (size_t) SSIZE_MAX )
+	 || ( ( utf16_stream_size % 2 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid UTF-16 stream size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf16_stream_size / 2 ) > LIBFSNTFS_DIRECTORY_ENTRIES_HASH_TABLE_MAXIMUM_NAME_LENGTH )
+	{
+		return( 0 );
+	}
+	if( memory_copy(
+	     key->name,
+	     utf16_stream,
+	     utf16_stream_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	key->name_length = 0;
+
+	for( utf16_stream_index = 0;
+	     utf16_stream_index < utf16_stream_size;
+	     utf16_stream_index += 2 )
+	{
+		byte_stream_copy_to_uint16_little_endian(
+		 &( utf16_stream[ utf16_stream_index ] ),
+		 name_character );
+
+		key->upcase_name[ key->name_length++ ] = upcase_table->characters[ name_character ];
+	}
+	key->hash = libfsntfs_directory_entries_hash_table_key_get_hash(
+	             key->upcase_name,
+	             key->name_length );
+
+	return( 1 );
+}
+
+/* Sets a key from an UTF-8 encoded name
+ * Returns 1 if successful, 0 if the name is too long or -1 on error
+ */
+int libfsntfs_directory_entries_hash_table_key_set_from_utf8_string(
+     libfsntfs_directory_entries_hash_table_key_t *key,
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
+{
+	uint16_t name_characters[ 2 ];
+
+	libuna_unicode_character_t unicode_character = 0;
+	static char *function                        = "libfsntfs_directory_entries_hash_table_key_set_from_utf8_string";
+	size_t name_character_index                  = 0;
+	size_t number_of_name_characters             = 0;
+	size_t utf8_string_index                     = 0;
+
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upcase table.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Ignore the end of string character
+	 */
+	if( ( utf8_string_length > 0 )
+	 && ( utf8_string[ utf8_string_length - 1 ] == 0 ) )
+	{
+		utf8_string_length -= 1;
+	}
+	key->name_length = 0;
+
+	while( utf8_string_index < utf8_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf8(
+		     &unicode_character,
+		     utf8_string,
+		     utf8_string_length,
+		     &utf8_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy UTF-8 string to Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_name_characters = 0;
+
+		if( libuna_unicode_character_copy_to_utf16(
+		     unicode_character,
+		     name_characters,
+		     2,
+		     &number_of_name_characters,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy Unicode character to UTF-16.",
+			 function );
+
+			return( -1 );
+		}
+		for( name_character_index = 0;
+		     name_character_index < number_of_name_characters;
+		     name_character_index++ )
+		{
+			if( key->name_length >= LIBFSNTFS_DIRECTORY_ENTRIES_HASH_TABLE_MAXIMUM_NAME_LENGTH )
+			{
+				return( 0 );
+			}
+			byte_stream_copy_from_uint16_little_endian(
+			 &( key->name[ key->name_length * 2 ] ),
+			 name_characters[ name_character_index ] );
+
+			key->upcase_name[ key->name_length++ ] = upcase_table->characters[ name_characters[ name_character_index ] ];
+		}
+	}
+	key->hash = libfsntfs_directory_entries_hash_table_key_get_hash(
+	             key->upcase_name,
+	             key->name_length );
+
+	return( 1 );
+}
+
+/* Sets a key from an UTF-16 encoded name
+ * Returns 1 if successful, 0 if the name is too long or -1 on error
+ */
+int libfsntfs_directory_entries_hash_table_key_set_from_utf16_string(
+     libfsntfs_directory_entries_hash_table_key_t *key,
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error )
+{
+	static char *function     = "libfsntfs_directory_entries_hash_table_key_set_from_utf16_string";
+	size_t utf16_string_index = 0;
+
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upcase table.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Ignore the end of string character
+	 */
+	if( ( utf16_string_length > 0 )
+	 && ( utf16_string[ utf16_string_length - 1 ] == 0 ) )
+	{
+		utf16_string_length -= 1;
+	}
+	if( utf16_string_length > LIBFSNTFS_DIRECTORY_ENTRIES_HASH_TABLE_MAXIMUM_NAME_LENGTH )
+	{
+		return( 0 );
+	}
+	for( utf16_string_index = 0;
+	     utf16_string_index < utf16_string_length;
+	     utf16_string_index++ )
+	{
+		byte_stream_copy_from_uint16_little_endian(
+		 &( key->name[ utf16_string_index * 2 ] ),
+		 utf16_string[ utf16_string_index ] );
+
+		key->upcase_name[ utf16_string_index ] = upcase_table->characters[ utf16_string[ utf16_string_index ] ];
+	}
+	key->name_length = utf16_string_length;
+
+	key->hash = libfsntfs_directory_entries_hash_table_key_get_hash(
+	             key->upcase_name,
+	             key->name_length );
+
+	return( 1 );
+}
+
+/* Creates a directory entries hash table
+ * Make sure the value hash_table is referencing, is set to NULL
+ * The number of slots is chosen so that the table is at most half full
+ * when both the long and short name of every directory entry are inserted
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_directory_entries_hash_table_initialize(
+     libfsntfs_directory_entries_hash_table_t **hash_table,
+     libfsntfs_upcase_table_t *upcase_table,
+     int number_of_directory_entries,
+     libcerror_error_t **error )
+{
+	static char *function    = "libfsntfs_directory_entries_hash_table_initialize";
+	size_t slots_size        = 0;
+	uint64_t number_of_slots = 16;
+
+	if( hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upcase table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_directory_entries < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of directory entries value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	while( number_of_slots < ( (uint64_t) number_of_directory_entries * 4 ) )
+	{
+		number_of_slots *= 2;
+	}
+	if( number_of_slots > (uint64_t) ( SSIZE_MAX / sizeof( libfsntfs_directory_entries_hash_table_slot_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of slots value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	slots_size = sizeof( libfsntfs_directory_entries_hash_table_slot_t ) * (size_t) number_of_slots;
+
+	*hash_table = memory_allocate_structure(
+	               libfsntfs_directory_entries_hash_table_t );
+
+	if( *hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_table,
+	     0,
+	     sizeof( libfsntfs_directory_entries_hash_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash table.",
+		 function );
+
+		goto on_error;
+	}
+	( *hash_table )->slots = (libfsntfs_directory_entries_hash_table_slot_t *) memory_allocate(
+	                                                                            slots_size );
+
+	if( ( *hash_table )->slots == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slots.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *hash_table )->slots,
+	     0,
+	     slots_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear slots.",
+		 function );
+
+		goto on_error;
+	}
+	( *hash_table )->upcase_table    = upcase_table;
+	( *hash_table )->number_of_slots = (uint32_t) number_of_slots;
+
+	return( 1 );
+
+on_error:
+	if( *hash_table != NULL )
+	{
+		if( ( *hash_table )->slots != NULL )
+		{
+			memory_free(
+			 ( *hash_table )->slots );
+		}
+		memory_free(
+		 *hash_table );
+
+		*hash_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a directory entries hash table
+ * The directory entries are not freed, they are owned by the directory entries tree
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_directory_entries_hash_table_free(
+     libfsntfs_directory_entries_hash_table_t **hash_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_directory_entries_hash_table_free";
+
+	if( hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_table != NULL )
+	{
+		if( ( *hash_table )->upcase_names != NULL )
+		{
+			memory_free(
+			 ( *hash_table )->upcase_names );
+		}
+		if( ( *hash_table )->slots != NULL )
+		{
+			memory_free(
+			 ( *hash_table )->slots );
+		}
+		memory_free(
+		 *hash_table );
+
+		*hash_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Inserts a name of a directory entry
+ * Returns 1 if successful, 0 if the name is too long to be inserted or -1 on error
+ */
+int libfsntfs_directory_entries_hash_table_insert_name(
+     libfsntfs_directory_entries_hash_table_t *hash_table,
+     libfsntfs_directory_entry_t *directory_entry,
+     const uint8_t *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entries_hash_table_key_t key;
+
+	libfsntfs_directory_entries_hash_table_slot_t *slot = NULL;
+	uint16_t *upcase_names                              = NULL;
+	static char *function                               = "libfsntfs_directory_entries_hash_table_insert_name";
+	size_t allocated_number_of_upcase_name_characters   = 0;
+	uint32_t slot_index                                 = 0;
+	int result                                          = 0;
+
+	if( hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_table->number_of_names >= ( hash_table->number_of_slots / 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash table - number of names value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_directory_entries_hash_table_key_set_from_utf16_stream(
+	          &key,
+	          hash_table->upcase_table,
+	          name,
+	          name_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( hash_table->number_of_upcase_name_characters + key.name_length ) > hash_table->allocated_number_of_upcase_name_characters )
+	{
+		allocated_number_of_upcase_name_characters = hash_table->allocated_number_of_upcase_name_characters;
+
+		if( allocated_number_of_upcase_name_characters == 0 )
+		{
+			allocated_number_of_upcase_name_characters = 1024;
+		}
+		while( allocated_number_of_upcase_name_characters < ( hash_table->number_of_upcase_name_characters + key.name_length ) )
+		{
+			if( allocated_number_of_upcase_name_characters > (size_t) ( SSIZE_MAX / ( sizeof( uint16_t ) * 2 ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid allocated number of upper case name characters value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			allocated_number_of_upcase_name_characters *= 2;
+		}
+		upcase_names = (uint16_t *) memory_reallocate(
+		                             hash_table->upcase_names,
+		                             sizeof( uint16_t ) * allocated_number_of_upcase_name_characters );
+
+		if( upcase_names == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize upper case names.",
+			 function );
+
+			return( -1 );
+		}
+		hash_table->upcase_names                               = upcase_names;
+		hash_table->allocated_number_of_upcase_name_characters = allocated_number_of_upcase_name_characters;
+	}
+	if( key.name_length > 0 )
+	{
+		if( memory_copy(
+		     &( hash_table->upcase_names[ hash_table->number_of_upcase_name_characters ] ),
+		     key.upcase_name,
+		     sizeof( uint16_t ) * key.name_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy upper case name.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	slot_index = key.hash & ( hash_table->number_of_slots - 1 );
+
+	while( hash_table->slots[ slot_index ].directory_entry != NULL )
+	{
+		slot_index = ( slot_index + 1 ) & ( hash_table->number_of_slots - 1 );
+	}
+	slot = &( hash_table->slots[ slot_index ] );
+
+	slot->hash               = key.hash;
+	slot->upcase_name_length = (uint32_t) key.name_length;
+	slot->upcase_name_index  = hash_table->number_of_upcase_name_characters;
+	slot->name               = name;
+	slot->name_size          = name_size;
+	slot->directory_entry    = directory_entry;
+
+	hash_table->number_of_upcase_name_characters += key.name_length;
+	hash_table->number_of_names                  += 1;
+
+	return( 1 );
+}
+
+/* Inserts the names of the directory entries in a directory entries tree
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_directory_entries_hash_table_read_from_tree(
+     libfsntfs_directory_entries_hash_table_t *hash_table,
+     libcdata_btree_t *directory_entries_tree,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_t *directory_entry = NULL;
+	libfsntfs_file_name_values_t *name_values    = NULL;
+	static char *function                        = "libfsntfs_directory_entries_hash_table_read_from_tree";
+	int directory_entry_index                    = 0;
+	int name_values_index                        = 0;
+	int number_of_directory_entries              = 0;
+
+	if( hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_btree_get_number_of_values(
+	     directory_entries_tree,
+	     &number_of_directory_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of directory entries from tree.",
+		 function );
+
+		return( -1 );
+	}
+	for( directory_entry_index = 0;
+	     directory_entry_index < number_of_directory_entries;
+	     directory_entry_index++ )
+	{
+		if( libcdata_btree_get_value_by_index(
+		     directory_entries_tree,
+		     directory_entry_index,
+		     (intptr_t **) &directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory entry: %d from tree.",
+			 function,
+			 directory_entry_index );
+
+			return( -1 );
+		}
+		if( directory_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing directory entry: %d.",
+			 function,
+			 directory_entry_index );
+
+			return( -1 );
+		}
+		for( name_values_index = 0;
+		     name_values_index < 2;
+		     name_values_index++ )
+		{
+			if( name_values_index == 0 )
+			{
+				name_values = directory_entry->file_name_values;
+			}
+			else
+			{
+				name_values = directory_entry->short_file_name_values;
+			}
+			if( ( name_values == NULL )
+			 || ( name_values->name == NULL ) )
+			{
+				continue;
+			}
+			/* Ignore the file name with the . as its name
+			 */
+			if( ( name_values->name_size == 2 )
+			 && ( name_values->name[ 0 ] == 0x2e )
+			 && ( name_values->name[ 1 ] == 0x00 ) )
+			{
+				continue;
+			}
+			if( libfsntfs_directory_entries_hash_table_insert_name(
+			     hash_table,
+			     directory_entry,
+			     name_values->name,
+			     (size_t) name_values->name_size,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert name of directory entry: %d.",
+				 function,
+				 directory_entry_index );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the directory entry of a key
+ * The names are compared after they are mapped by the upcase table,
+ * a name that also matches the case of the key is preferred
+ * Returns 1 if successful, 0 if no such directory entry or -1 on error
+ */
+int libfsntfs_directory_entries_hash_table_get_directory_entry(
+     libfsntfs_directory_entries_hash_table_t *hash_table,
+     const libfsntfs_directory_entries_hash_table_key_t *key,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entries_hash_table_slot_t *slot = NULL;
+	static char *function                               = "libfsntfs_directory_entries_hash_table_get_directory_entry";
+	uint32_t slot_index                                 = 0;
+
+	if( hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	*directory_entry = NULL;
+
+	slot_index = key->hash & ( hash_table->number_of_slots - 1 );
+
+	while( hash_table->slots[ slot_index ].directory_entry != NULL )
+	{
+		slot = &( hash_table->slots[ slot_index ] );
+
+		if( ( slot->hash == key->hash )
+		 && ( slot->upcase_name_length == key->name_length )
+		 && ( memory_compare(
+		       &( hash_table->upcase_names[ slot->upcase_name_index ] ),
+		       key->upcase_name,
+		       sizeof( uint16_t ) * key->name_length ) == 0 ) )
+		{
+			if( memory_compare(
+			     slot->name,
+			     key->name,
+			     slot->name_size ) == 0 )
+			{
+				*directory_entry = slot->directory_entry;
+
+				return( 1 );
+			}
+			if( *directory_entry == NULL )
+			{
+				*directory_entry = slot->directory_entry;
+			}
+		}
+		slot_index = ( slot_index + 1 ) & ( hash_table->number_of_slots - 1 );
+	}
+	if( *directory_entry != NULL )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
@@ -0,0 +1,181 @@
+/*
+ * Directory entries hash table functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_DIRECTORY_ENTRIES_HASH_TABLE_H )
+#define _LIBFSNTFS_DIRECTORY_ENTRIES_HASH_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_directory_entry.h"
+#include "libfsntfs_libcdata.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_upcase_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_directory_entries_hash_table_key libfsntfs_directory_entries_hash_table_key_t;
+
+struct libfsntfs_directory_entries_hash_table_key
+{
+	/* The FNV-1a hash of the upper case name
+	 */
+	uint32_t hash;
+
+	/* The UTF-16 little-endian encoded name
+	 */
+	uint8_t name[ LIBFSNTFS_DIRECTORY_ENTRIES_HASH_TABLE_MAXIMUM_NAME_LENGTH * 2 ];
+
+	/* The upper case name
+	 */
+	uint16_t upcase_name[ LIBFSNTFS_DIRECTORY_ENTRIES_HASH_TABLE_MAXIMUM_NAME_LENGTH ];
+
+	/* The name length, in UTF-16 characters
+	 */
+	size_t name_length;
+};
+
+typedef struct libfsntfs_directory_entries_hash_table_slot libfsntfs_directory_entries_hash_table_slot_t;
+
+struct libfsntfs_directory_entries_hash_table_slot
+{
+	/* The FNV-1a hash of the upper case name
+	 */
+	uint32_t hash;
+
+	/* The upper case name length, in UTF-16 characters
+	 */
+	uint32_t upcase_name_length;
+
+	/* The index of the upper case name in the upper case names
+	 */
+	size_t upcase_name_index;
+
+	/* The UTF-16 little-endian encoded name
+	 * The name is owned by the directory entry
+	 */
+	const uint8_t *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* The directory entry, NULL if the slot is empty
+	 * The directory entry is owned by the directory entries tree
+	 */
+	libfsntfs_directory_entry_t *directory_entry;
+};
+
+typedef struct libfsntfs_directory_entries_hash_table libfsntfs_directory_entries_hash_table_t;
+
+struct libfsntfs_directory_entries_hash_table
+{
+	/* The upcase table
+	 */
+	libfsntfs_upcase_table_t *upcase_table;
+
+	/* The slots
+	 */
+	libfsntfs_directory_entries_hash_table_slot_t *slots;
+
+	/* The number of slots, which is a power of 2
+	 */
+	uint32_t number_of_slots;
+
+	/* The number of names
+	 */
+	uint32_t number_of_names;
+
+	/* The upper case names
+	 */
+	uint16_t *upcase_names;
+
+	/* The number of characters in the upper case names
+	 */
+	size_t number_of_upcase_name_characters;
+
+	/* The allocated number of characters in the upper case names
+	 */
+	size_t allocated_number_of_upcase_name_characters;
+};
+
+uint32_t libfsntfs_directory_entries_hash_table_key_get_hash(
+          const uint16_t *upcase_name,
+          size_t upcase_name_length );
+
+int libfsntfs_directory_entries_hash_table_key_set_from_utf16_stream(
+     libfsntfs_directory_entries_hash_table_key_t *key,
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *utf16_stream,
+     size_t utf16_stream_size,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_hash_table_key_set_from_utf8_string(
+     libfsntfs_directory_entries_hash_table_key_t *key,
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_hash_table_key_set_from_utf16_string(
+     libfsntfs_directory_entries_hash_table_key_t *key,
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_hash_table_initialize(
+     libfsntfs_directory_entries_hash_table_t **hash_table,
+     libfsntfs_upcase_table_t *upcase_table,
+     int number_of_directory_entries,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_hash_table_free(
+     libfsntfs_directory_entries_hash_table_t **hash_table,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_hash_table_insert_name(
+     libfsntfs_directory_entries_hash_table_t *hash_table,
+     libfsntfs_directory_entry_t *directory_entry,
+     const uint8_t *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_hash_table_read_from_tree(
+     libfsntfs_directory_entries_hash_table_t *hash_table,
+     libcdata_btree_t *directory_entries_tree,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entries_hash_table_get_directory_entry(
+     libfsntfs_directory_entries_hash_table_t *hash_table,
+     const libfsntfs_directory_entries_hash_table_key_t *key,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -30,6 +30,7 @@
 #include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libuna.h"
+#include "libfsntfs_upcase_table.h"
 
 /* Compares the directory entry name with an UTF-8 encoded string
  * Returns 1 if the strings are equal, 0 if not or -1 on error
@@ -136,10 +137,13 @@ int libfsntfs_directory_entries_tree_compare_name_with_utf8_string(
 }
 
 /* Retrieves the directory entry for an UTF-8 encoded name
+ * Names are compared case-insensitive if the upcase table is available,
+ * a name that also matches the case is preferred
  * Returns 1 if successful, 0 if no such directory entry or -1 on error
  */
 int libfsntfs_directory_entries_tree_get_directory_entry_by_utf8_name(
      libcdata_btree_t *directory_entries_tree,
+     libfsntfs_upcase_table_t *upcase_table,
      const uint8_t *utf8_string,
      size_t utf8_string_length,
      libfsntfs_directory_entry_t **directory_entry,
@@ -172,6 +176,32 @@ int libfsntfs_directory_entries_tree_get_directory_entry_by_utf8_name(
 
 		return( -1 );
 	}
+	if( upcase_table != NULL )
+	{
+		result = libfsntfs_directory_entries_tree_get_directory_entry_by_utf8_name(
+		          directory_entries_tree,
+		          NULL,
+		          utf8_string,
+		          utf8_string_length,
+		          directory_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory entry with name that matches the case.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+	}
 	if( libcdata_btree_get_number_of_values(
 	     directory_entries_tree,
 	     &number_of_directory_entries,
@@ -230,22 +260,35 @@ int libfsntfs_directory_entries_tree_get_directory_entry_by_utf8_name(
 
 				goto on_error;
 			}
+			if( upcase_table != NULL )
+			{
+				result = libfsntfs_upcase_table_compare_name_with_utf8_string(
+				          upcase_table,
+				          ( *directory_entry )->file_name_values->name,
+				          ( *directory_entry )->file_name_values->name_size,
+				          utf8_string,
+				          utf8_string_length,
+				          error );
+			}
+			else
+			{
 #ifdef TODO_CASE_INSENSITIVE
-			result = libfsntfs_directory_entries_tree_compare_name_with_utf8_string(
-				  ( *directory_entry )->file_name_values->name,
-				  ( *directory_entry )->file_name_values->name_size,
-				  utf8_string,
-				  utf8_string_length,
-				  error );
+				result = libfsntfs_directory_entries_tree_compare_name_with_utf8_string(
+					  ( *directory_entry )->file_name_values->name,
+					  ( *directory_entry )->file_name_values->name_size,
+					  utf8_string,
+					  utf8_string_length,
+					  error );
 #else
-			result = libuna_utf8_string_compare_with_utf16_stream(
-				  utf8_string,
-				  utf8_string_length,
-				  ( *directory_entry )->file_name_values->name,
-				  ( *directory_entry )->file_name_values->name_size,
-				  LIBUNA_ENDIAN_LITTLE,
-				  error );
+				result = libuna_utf8_string_compare_with_utf16_stream(
+					  utf8_string,
+					  utf8_string_length,
+					  ( *directory_entry )->file_name_values->name,
+					  ( *directory_entry )->file_name_values->name_size,
+					  LIBUNA_ENDIAN_LITTLE,
+					  error );
 #endif
+			}
 			if( result == -1 )
 			{
 				libcerror_error_set(
@@ -275,22 +318,35 @@ int libfsntfs_directory_entries_tree_get_directory_entry_by_utf8_name(
 
 				goto on_error;
 			}
+			if( upcase_table != NULL )
+			{
+				result = libfsntfs_upcase_table_compare_name_with_utf8_string(
+				          upcase_table,
+				          ( *directory_entry )->short_file_name_values->name,
+				          ( *directory_entry )->short_file_name_values->name_size,
+				          utf8_string,
+				          utf8_string_length,
+				          error );
+			}
+			else
+			{
 #ifdef TODO_CASE_INSENSITIVE
-			result = libfsntfs_directory_entries_tree_compare_name_with_utf8_string(
-				  ( *directory_entry )->short_file_name_values->name,
-				  ( *directory_entry )->short_file_name_values->name_size,
-				  utf8_string,
-				  utf8_string_length,
-				  error );
+				result = libfsntfs_directory_entries_tree_compare_name_with_utf8_string(
+					  ( *directory_entry )->short_file_name_values->name,
+					  ( *directory_entry )->short_file_name_values->name_size,
+					  utf8_string,
+					  utf8_string_length,
+					  error );
 #else
-			result = libuna_utf8_string_compare_with_utf16_stream(
-				  utf8_string,
-				  utf8_string_length,
-				  ( *directory_entry )->short_file_name_values->name,
-				  ( *directory_entry )->short_file_name_values->name_size,
-				  LIBUNA_ENDIAN_LITTLE,
-				  error );
+				result = libuna_utf8_string_compare_with_utf16_stream(
+					  utf8_string,
+					  utf8_string_length,
+					  ( *directory_entry )->short_file_name_values->name,
+					  ( *directory_entry )->short_file_name_values->name_size,
+					  LIBUNA_ENDIAN_LITTLE,
+					  error );
 #endif
+			}
 			if( result == -1 )
 			{
 				libcerror_error_set(
@@ -423,10 +479,13 @@ int libfsntfs_directory_entries_tree_compare_name_with_utf16_string(
 }
 
 /* Retrieves the directory entry for an UTF-16 encoded name
+ * Names are compared case-insensitive if the upcase table is available,
+ * a name that also matches the case is preferred
  * Returns 1 if successful, 0 if no such directory entry or -1 on error
  */
 int libfsntfs_directory_entries_tree_get_directory_entry_by_utf16_name(
      libcdata_btree_t *directory_entries_tree,
+     libfsntfs_upcase_table_t *upcase_table,
      const uint16_t *utf16_string,
      size_t utf16_string_length,
      libfsntfs_directory_entry_t **directory_entry,
@@ -459,6 +518,32 @@ int libfsntfs_directory_entries_tree_get_directory_entry_by_utf16_name(
 
 		return( -1 );
 	}
+	if( upcase_table != NULL )
+	{
+		result = libfsntfs_directory_entries_tree_get_directory_entry_by_utf16_name(
+		          directory_entries_tree,
+		          NULL,
+		          utf16_string,
+		          utf16_string_length,
+		          directory_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory entry with name that matches the case.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+	}
 	if( libcdata_btree_get_number_of_values(
 	     directory_entries_tree,
 	     &number_of_directory_entries,
@@ -517,22 +602,35 @@ int libfsntfs_directory_entries_tree_get_directory_entry_by_utf16_name(
 
 				goto on_error;
 			}
+			if( upcase_table != NULL )
+			{
+				result = libfsntfs_upcase_table_compare_name_with_utf16_string(
+				          upcase_table,
+				          ( *directory_entry )->file_name_values->name,
+				          ( *directory_entry )->file_name_values->name_size,
+				          utf16_string,
+				          utf16_string_length,
+				          error );
+			}
+			else
+			{
 #ifdef TODO_CASE_INSENSITIVE
-			result = libfsntfs_directory_entries_tree_compare_name_with_utf16_string(
-				  ( *directory_entry )->file_name_values->name,
-				  ( *directory_entry )->file_name_values->name_size,
-				  utf16_string,
-				  utf16_string_length,
-				  error );
+				result = libfsntfs_directory_entries_tree_compare_name_with_utf16_string(
+					  ( *directory_entry )->file_name_values->name,
+					  ( *directory_entry )->file_name_values->name_size,
+					  utf16_string,
+					  utf16_string_length,
+					  error );
 #else
-			result = libuna_utf16_string_compare_with_utf16_stream(
-				  utf16_string,
-				  utf16_string_length,
-				  ( *directory_entry )->file_name_values->name,
-				  ( *directory_entry )->file_name_values->name_size,
-				  LIBUNA_ENDIAN_LITTLE,
-				  error );
+				result = libuna_utf16_string_compare_with_utf16_stream(
+					  utf16_string,
+					  utf16_string_length,
+					  ( *directory_entry )->file_name_values->name,
+					  ( *directory_entry )->file_name_values->name_size,
+					  LIBUNA_ENDIAN_LITTLE,
+					  error );
 #endif
+			}
 			if( result == -1 )
 			{
 				libcerror_error_set(
@@ -562,22 +660,35 @@ int libfsntfs_directory_entries_tree_get_directory_entry_by_utf16_name(
 
 				goto on_error;
 			}
+			if( upcase_table != NULL )
+			{
+				result = libfsntfs_upcase_table_compare_name_with_utf16_string(
+				          upcase_table,
+				          ( *directory_entry )->short_file_name_values->name,
+				          ( *directory_entry )->short_file_name_values->name_size,
+				          utf16_string,
+				          utf16_string_length,
+				          error );
+			}
+			else
+			{
 #ifdef TODO_CASE_INSENSITIVE
-			result = libfsntfs_directory_entries_tree_compare_name_with_utf16_string(
-				  ( *directory_entry )->short_file_name_values->name,
-				  ( *directory_entry )->short_file_name_values->name_size,
-				  utf16_string,
-				  utf16_string_length,
-				  error );
+				result = libfsntfs_directory_entries_tree_compare_name_with_utf16_string(
+					  ( *directory_entry )->short_file_name_values->name,
+					  ( *directory_entry )->short_file_name_values->name_size,
+					  utf16_string,
+					  utf16_string_length,
+					  error );
 #else
-			result = libuna_utf16_string_compare_with_utf16_stream(
-				  utf16_string,
-				  utf16_string_length,
-				  ( *directory_entry )->short_file_name_values->name,
-				  ( *directory_entry )->short_file_name_values->name_size,
-				  LIBUNA_ENDIAN_LITTLE,
-				  error );
+				result = libuna_utf16_string_compare_with_utf16_stream(
+					  utf16_string,
+					  utf16_string_length,
+					  ( *directory_entry )->short_file_name_values->name,
+					  ( *directory_entry )->short_file_name_values->name_size,
+					  LIBUNA_ENDIAN_LITTLE,
+					  error );
 #endif
+			}
 			if( result == -1 )
 			{
 				libcerror_error_set(
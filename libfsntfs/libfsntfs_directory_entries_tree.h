@@ -28,6 +28,7 @@
 #include "libfsntfs_directory_entry.h"
 #include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
+#include "libfsntfs_upcase_table.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -42,6 +43,7 @@ int libfsntfs_directory_entries_tree_compare_name_with_utf8_string(
 
 int libfsntfs_directory_entries_tree_get_directory_entry_by_utf8_name(
      libcdata_btree_t *directory_entries_tree,
+     libfsntfs_upcase_table_t *upcase_table,
      const uint8_t *utf8_string,
      size_t utf8_string_length,
      libfsntfs_directory_entry_t **directory_entry,
@@ -56,6 +58,7 @@ int libfsntfs_directory_entries_tree_compare_name_with_utf16_string(
 
 int libfsntfs_directory_entries_tree_get_directory_entry_by_utf16_name(
      libcdata_btree_t *directory_entries_tree,
+     libfsntfs_upcase_table_t *upcase_table,
      const uint16_t *utf16_string,
      size_t utf16_string_length,
      libfsntfs_directory_entry_t **directory_entry,
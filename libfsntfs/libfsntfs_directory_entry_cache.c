@@ -0,0 +1,927 @@
+/*
+ * Directory entry cache functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_directory_entry.h"
+#include "libfsntfs_directory_entry_cache.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libuna.h"
+#include "libfsntfs_upcase_table.h"
+
+/* Adds the parent file reference to the FNV-1a hash of a key
+ * Returns the updated hash
+ */
+uint32_t libfsntfs_directory_entry_cache_key_hash_file_reference(
+          uint32_t hash,
+          uint64_t file_reference )
+{
+	int byte_index = 0;
+
+	for( byte_index = 0;
+	     byte_index < 8;
+	     byte_index++ )
+	{
+		hash ^= (uint32_t) ( file_reference & 0xff );
+		hash *= 0x01000193UL;
+
+		file_reference >>= 8;
+	}
+	return( hash );
+}
+
+/* Retrieves the upper case Unicode character
+ * The upcase table is used if available, which matches the name collation of Windows,
+ * otherwise only the ASCII characters are mapped
+ * Returns the upper case Unicode character
+ */
+libuna_unicode_character_t libfsntfs_directory_entry_cache_get_upcase_character(
+                            libfsntfs_upcase_table_t *upcase_table,
+                            libuna_unicode_character_t unicode_character )
+{
+	if( upcase_table != NULL )
+	{
+		if( unicode_character <= 0xffff )
+		{
+			unicode_character = (libuna_unicode_character_t) upcase_table->characters[ unicode_character ];
+		}
+	}
+	else if( ( unicode_character >= (libuna_unicode_character_t) 'a' )
+	      && ( unicode_character <= (libuna_unicode_character_t) 'z' ) )
+	{
+		unicode_character -= (libuna_unicode_character_t) 'a' - (libuna_unicode_character_t) 'A';
+	}
+	return( unicode_character );
+}
+
+/* Adds the upper case Unicode character to the FNV-1a hash of a key
+ * Returns the updated hash
+ */
+uint32_t libfsntfs_directory_entry_cache_key_hash_character(
+          uint32_t hash,
+          libfsntfs_upcase_table_t *upcase_table,
+          libuna_unicode_character_t unicode_character )
+{
+	unicode_character = libfsntfs_directory_entry_cache_get_upcase_character(
+	                     upcase_table,
+	                     unicode_character );
+
+	hash ^= (uint32_t) unicode_character;
+	hash *= 0x01000193UL;
+
+	return( hash );
+}
+
+/* Sets a key from an UTF-8 encoded name
+ * The upcase table should be the one of the directory entry cache
+ * Returns 1 if successful, 0 if the name is too long to be cached or -1 on error
+ */
+int libfsntfs_directory_entry_cache_key_set_from_utf8_string(
+     libfsntfs_directory_entry_cache_key_t *key,
+     libfsntfs_upcase_table_t *upcase_table,
+     uint64_t parent_file_reference,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libfsntfs_directory_entry_cache_key_set_from_utf8_string";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf8_string_index                     = 0;
+	uint32_t hash                                = 0x811c9dc5UL;
+
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	hash = libfsntfs_directory_entry_cache_key_hash_file_reference(
+	        hash,
+	        parent_file_reference );
+
+	key->name_length = 0;
+
+	while( utf8_string_index < utf8_string_length )
+	{
+		if( key->name_length >= LIBFSNTFS_DIRECTORY_ENTRY_CACHE_MAXIMUM_NAME_LENGTH )
+		{
+			return( 0 );
+		}
+		if( libuna_unicode_character_copy_from_utf8(
+		     &unicode_character,
+		     utf8_string,
+		     utf8_string_length,
+		     &utf8_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy UTF-8 string to Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+		hash = libfsntfs_directory_entry_cache_key_hash_character(
+		        hash,
+		        upcase_table,
+		        unicode_character );
+
+		key->name[ key->name_length++ ] = unicode_character;
+	}
+	key->parent_file_reference = parent_file_reference;
+	key->hash                  = hash;
+
+	return( 1 );
+}
+
+/* Sets a key from an UTF-16 encoded name
+ * The upcase table should be the one of the directory entry cache
+ * Returns 1 if successful, 0 if the name is too long to be cached or -1 on error
+ */
+int libfsntfs_directory_entry_cache_key_set_from_utf16_string(
+     libfsntfs_directory_entry_cache_key_t *key,
+     libfsntfs_upcase_table_t *upcase_table,
+     uint64_t parent_file_reference,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libfsntfs_directory_entry_cache_key_set_from_utf16_string";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf16_string_index                    = 0;
+	uint32_t hash                                = 0x811c9dc5UL;
+
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	hash = libfsntfs_directory_entry_cache_key_hash_file_reference(
+	        hash,
+	        parent_file_reference );
+
+	key->name_length = 0;
+
+	while( utf16_string_index < utf16_string_length )
+	{
+		if( key->name_length >= LIBFSNTFS_DIRECTORY_ENTRY_CACHE_MAXIMUM_NAME_LENGTH )
+		{
+			return( 0 );
+		}
+		if( libuna_unicode_character_copy_from_utf16(
+		     &unicode_character,
+		     utf16_string,
+		     utf16_string_length,
+		     &utf16_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy UTF-16 string to Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+		hash = libfsntfs_directory_entry_cache_key_hash_character(
+		        hash,
+		        upcase_table,
+		        unicode_character );
+
+		key->name[ key->name_length++ ] = unicode_character;
+	}
+	key->parent_file_reference = parent_file_reference;
+	key->hash                  = hash;
+
+	return( 1 );
+}
+
+/* Compares the name of a key with an UTF-16 little-endian encoded name
+ * Returns 1 if the names are equal, 0 if not or -1 on error
+ */
+int libfsntfs_directory_entry_cache_key_compare_with_name(
+     const libfsntfs_directory_entry_cache_key_t *key,
+     const uint8_t *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	static char *function                     = "libfsntfs_directory_entry_cache_key_compare_with_name";
+	libuna_unicode_character_t name_character = 0;
+	size_t key_name_index                     = 0;
+	size_t name_index                         = 0;
+
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		return( 0 );
+	}
+	while( name_index < name_size )
+	{
+		if( key_name_index >= key->name_length )
+		{
+			return( 0 );
+		}
+		if( libuna_unicode_character_copy_from_utf16_stream(
+		     &name_character,
+		     name,
+		     name_size,
+		     &name_index,
+		     LIBUNA_ENDIAN_LITTLE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy name to Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+		if( name_character != key->name[ key_name_index++ ] )
+		{
+			return( 0 );
+		}
+	}
+	if( key_name_index != key->name_length )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Creates a directory entry cache
+ * The upcase table is referenced and can be NULL if not available
+ * Make sure the value directory_entry_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_directory_entry_cache_initialize(
+     libfsntfs_directory_entry_cache_t **directory_entry_cache,
+     libfsntfs_upcase_table_t *upcase_table,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_directory_entry_cache_initialize";
+	size_t slots_size     = 0;
+
+	if( directory_entry_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_entry_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory entry cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid maximum number of entries value less than or equal to zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) maximum_number_of_entries > ( (size_t) SSIZE_MAX / sizeof( libfsntfs_directory_entry_cache_slot_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum number of entries value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*directory_entry_cache = memory_allocate_structure(
+	                          libfsntfs_directory_entry_cache_t );
+
+	if( *directory_entry_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create directory entry cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *directory_entry_cache,
+	     0,
+	     sizeof( libfsntfs_directory_entry_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear directory entry cache.",
+		 function );
+
+		memory_free(
+		 *directory_entry_cache );
+
+		*directory_entry_cache = NULL;
+
+		return( -1 );
+	}
+	slots_size = sizeof( libfsntfs_directory_entry_cache_slot_t ) * (size_t) maximum_number_of_entries;
+
+	( *directory_entry_cache )->slots = (libfsntfs_directory_entry_cache_slot_t *) memory_allocate(
+	                                                                                 slots_size );
+
+	if( ( *directory_entry_cache )->slots == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slots.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *directory_entry_cache )->slots,
+	     0,
+	     slots_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear slots.",
+		 function );
+
+		goto on_error;
+	}
+	( *directory_entry_cache )->upcase_table    = upcase_table;
+	( *directory_entry_cache )->number_of_slots = maximum_number_of_entries;
+
+	return( 1 );
+
+on_error:
+	if( *directory_entry_cache != NULL )
+	{
+		if( ( *directory_entry_cache )->slots != NULL )
+		{
+			memory_free(
+			 ( *directory_entry_cache )->slots );
+		}
+		memory_free(
+		 *directory_entry_cache );
+
+		*directory_entry_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a directory entry cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_directory_entry_cache_free(
+     libfsntfs_directory_entry_cache_t **directory_entry_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_directory_entry_cache_free";
+	int result            = 1;
+	int slot_index        = 0;
+
+	if( directory_entry_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_entry_cache != NULL )
+	{
+		for( slot_index = 0;
+		     slot_index < ( *directory_entry_cache )->number_of_slots;
+		     slot_index++ )
+		{
+			if( libfsntfs_directory_entry_cache_slot_clear(
+			     &( ( *directory_entry_cache )->slots[ slot_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to clear slot: %d.",
+				 function,
+				 slot_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *directory_entry_cache )->slots );
+
+		memory_free(
+		 *directory_entry_cache );
+
+		*directory_entry_cache = NULL;
+	}
+	return( result );
+}
+
+/* Clears a directory entry cache slot
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_directory_entry_cache_slot_clear(
+     libfsntfs_directory_entry_cache_slot_t *slot,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_directory_entry_cache_slot_clear";
+	int result            = 1;
+
+	if( slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid slot.",
+		 function );
+
+		return( -1 );
+	}
+	if( slot->directory_entry != NULL )
+	{
+		if( libfsntfs_directory_entry_free(
+		     &( slot->directory_entry ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory entry.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( slot->name != NULL )
+	{
+		memory_free(
+		 slot->name );
+
+		slot->name = NULL;
+	}
+	slot->parent_file_reference = 0;
+	slot->hash                  = 0;
+	slot->name_length           = 0;
+
+	return( result );
+}
+
+/* Retrieves the slot of a key
+ * The name of the key is compared case-insensitive with the name of the slot
+ * Returns 1 if the slot contains the key, 0 if not or -1 on error
+ */
+int libfsntfs_directory_entry_cache_get_slot(
+     libfsntfs_directory_entry_cache_t *directory_entry_cache,
+     const libfsntfs_directory_entry_cache_key_t *key,
+     libfsntfs_directory_entry_cache_slot_t **slot,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_cache_slot_t *safe_slot = NULL;
+	static char *function                             = "libfsntfs_directory_entry_cache_get_slot";
+	size_t name_index                                 = 0;
+	int is_exact_match                                = 1;
+	int result                                        = 0;
+
+	if( directory_entry_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( slot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid slot.",
+		 function );
+
+		return( -1 );
+	}
+	safe_slot = &( directory_entry_cache->slots[ key->hash % (uint32_t) directory_entry_cache->number_of_slots ] );
+
+	*slot = safe_slot;
+
+	if( ( safe_slot->directory_entry == NULL )
+	 || ( safe_slot->hash != key->hash )
+	 || ( safe_slot->parent_file_reference != key->parent_file_reference )
+	 || ( safe_slot->name_length != key->name_length ) )
+	{
+		return( 0 );
+	}
+	/* The names are compared after they are mapped by the upcase table,
+	 * which matches the case-insensitive lookup by name
+	 */
+	for( name_index = 0;
+	     name_index < key->name_length;
+	     name_index++ )
+	{
+		if( safe_slot->name[ name_index ] == key->name[ name_index ] )
+		{
+			continue;
+		}
+		is_exact_match = 0;
+
+		if( libfsntfs_directory_entry_cache_get_upcase_character(
+		     directory_entry_cache->upcase_table,
+		     safe_slot->name[ name_index ] ) != libfsntfs_directory_entry_cache_get_upcase_character(
+		                                         directory_entry_cache->upcase_table,
+		                                         key->name[ name_index ] ) )
+		{
+			return( 0 );
+		}
+	}
+	if( is_exact_match != 0 )
+	{
+		return( 1 );
+	}
+	/* If the key only differs in case from the cached key the lookup by name prefers
+	 * a directory entry with a name that matches the case of the key. The cached
+	 * directory entry is only the result of the lookup if its name matches the key exactly
+	 */
+	result = libfsntfs_directory_entry_cache_key_compare_with_name(
+	          key,
+	          safe_slot->directory_entry->file_name_values != NULL ? safe_slot->directory_entry->file_name_values->name : NULL,
+	          safe_slot->directory_entry->file_name_values != NULL ? (size_t) safe_slot->directory_entry->file_name_values->name_size : 0,
+	          error );
+
+	if( result == 0 )
+	{
+		result = libfsntfs_directory_entry_cache_key_compare_with_name(
+		          key,
+		          safe_slot->directory_entry->short_file_name_values != NULL ? safe_slot->directory_entry->short_file_name_values->name : NULL,
+		          safe_slot->directory_entry->short_file_name_values != NULL ? (size_t) safe_slot->directory_entry->short_file_name_values->name_size : 0,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare key with name of directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves a copy of the directory entry of a key
+ * A new directory_entry is allocated if a match is found
+ * Returns 1 if successful, 0 if not cached or -1 on error
+ */
+int libfsntfs_directory_entry_cache_get_directory_entry(
+     libfsntfs_directory_entry_cache_t *directory_entry_cache,
+     const libfsntfs_directory_entry_cache_key_t *key,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_cache_slot_t *slot = NULL;
+	static char *function                        = "libfsntfs_directory_entry_cache_get_directory_entry";
+	int result                                   = 0;
+
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_directory_entry_cache_get_slot(
+	          directory_entry_cache,
+	          key,
+	          &slot,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve slot.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libfsntfs_directory_entry_clone(
+		     directory_entry,
+		     slot->directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create directory entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Sets a copy of the directory entry of a key
+ * This replaces the entry that previously occupied the slot of the key
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_directory_entry_cache_set_directory_entry(
+     libfsntfs_directory_entry_cache_t *directory_entry_cache,
+     const libfsntfs_directory_entry_cache_key_t *key,
+     libfsntfs_directory_entry_t *directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_cache_slot_t *slot = NULL;
+	static char *function                        = "libfsntfs_directory_entry_cache_set_directory_entry";
+
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_directory_entry_cache_get_slot(
+	     directory_entry_cache,
+	     key,
+	     &slot,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve slot.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_directory_entry_cache_slot_clear(
+	     slot,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear slot.",
+		 function );
+
+		return( -1 );
+	}
+	if( key->name_length > 0 )
+	{
+		slot->name = (libuna_unicode_character_t *) memory_allocate(
+		                                             sizeof( libuna_unicode_character_t ) * key->name_length );
+
+		if( slot->name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     slot->name,
+		     key->name,
+		     sizeof( libuna_unicode_character_t ) * key->name_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy name.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfsntfs_directory_entry_clone(
+	     &( slot->directory_entry ),
+	     directory_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory entry.",
+		 function );
+
+		goto on_error;
+	}
+	slot->parent_file_reference = key->parent_file_reference;
+	slot->hash                  = key->hash;
+	slot->name_length           = key->name_length;
+
+	return( 1 );
+
+on_error:
+	libfsntfs_directory_entry_cache_slot_clear(
+	 slot,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Removes the directory entry of a key
+ * Returns 1 if successful, 0 if not cached or -1 on error
+ */
+int libfsntfs_directory_entry_cache_remove_directory_entry(
+     libfsntfs_directory_entry_cache_t *directory_entry_cache,
+     const libfsntfs_directory_entry_cache_key_t *key,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_cache_slot_t *slot = NULL;
+	static char *function                        = "libfsntfs_directory_entry_cache_remove_directory_entry";
+	int result                                   = 0;
+
+	result = libfsntfs_directory_entry_cache_get_slot(
+	          directory_entry_cache,
+	          key,
+	          &slot,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve slot.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libfsntfs_directory_entry_cache_slot_clear(
+		     slot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear slot.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
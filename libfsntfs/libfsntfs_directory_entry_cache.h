@@ -0,0 +1,178 @@
+/*
+ * Directory entry cache functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_DIRECTORY_ENTRY_CACHE_H )
+#define _LIBFSNTFS_DIRECTORY_ENTRY_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_directory_entry.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libuna.h"
+#include "libfsntfs_upcase_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_directory_entry_cache_key libfsntfs_directory_entry_cache_key_t;
+
+struct libfsntfs_directory_entry_cache_key
+{
+	/* The file reference of the parent directory
+	 */
+	uint64_t parent_file_reference;
+
+	/* The hash of the parent file reference and the upper case name
+	 */
+	uint32_t hash;
+
+	/* The name
+	 */
+	libuna_unicode_character_t name[ LIBFSNTFS_DIRECTORY_ENTRY_CACHE_MAXIMUM_NAME_LENGTH ];
+
+	/* The name length
+	 */
+	size_t name_length;
+};
+
+typedef struct libfsntfs_directory_entry_cache_slot libfsntfs_directory_entry_cache_slot_t;
+
+struct libfsntfs_directory_entry_cache_slot
+{
+	/* The file reference of the parent directory
+	 */
+	uint64_t parent_file_reference;
+
+	/* The hash of the parent file reference and the upper case name
+	 */
+	uint32_t hash;
+
+	/* The name
+	 */
+	libuna_unicode_character_t *name;
+
+	/* The name length
+	 */
+	size_t name_length;
+
+	/* The directory entry
+	 */
+	libfsntfs_directory_entry_t *directory_entry;
+};
+
+typedef struct libfsntfs_directory_entry_cache libfsntfs_directory_entry_cache_t;
+
+struct libfsntfs_directory_entry_cache
+{
+	/* The slots
+	 */
+	libfsntfs_directory_entry_cache_slot_t *slots;
+
+	/* The number of slots
+	 */
+	int number_of_slots;
+
+	/* The upcase table
+	 */
+	libfsntfs_upcase_table_t *upcase_table;
+};
+
+uint32_t libfsntfs_directory_entry_cache_key_hash_file_reference(
+          uint32_t hash,
+          uint64_t file_reference );
+
+libuna_unicode_character_t libfsntfs_directory_entry_cache_get_upcase_character(
+                            libfsntfs_upcase_table_t *upcase_table,
+                            libuna_unicode_character_t unicode_character );
+
+uint32_t libfsntfs_directory_entry_cache_key_hash_character(
+          uint32_t hash,
+          libfsntfs_upcase_table_t *upcase_table,
+          libuna_unicode_character_t unicode_character );
+
+int libfsntfs_directory_entry_cache_key_set_from_utf8_string(
+     libfsntfs_directory_entry_cache_key_t *key,
+     libfsntfs_upcase_table_t *upcase_table,
+     uint64_t parent_file_reference,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entry_cache_key_set_from_utf16_string(
+     libfsntfs_directory_entry_cache_key_t *key,
+     libfsntfs_upcase_table_t *upcase_table,
+     uint64_t parent_file_reference,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entry_cache_key_compare_with_name(
+     const libfsntfs_directory_entry_cache_key_t *key,
+     const uint8_t *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entry_cache_initialize(
+     libfsntfs_directory_entry_cache_t **directory_entry_cache,
+     libfsntfs_upcase_table_t *upcase_table,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entry_cache_free(
+     libfsntfs_directory_entry_cache_t **directory_entry_cache,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entry_cache_slot_clear(
+     libfsntfs_directory_entry_cache_slot_t *slot,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entry_cache_get_slot(
+     libfsntfs_directory_entry_cache_t *directory_entry_cache,
+     const libfsntfs_directory_entry_cache_key_t *key,
+     libfsntfs_directory_entry_cache_slot_t **slot,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entry_cache_get_directory_entry(
+     libfsntfs_directory_entry_cache_t *directory_entry_cache,
+     const libfsntfs_directory_entry_cache_key_t *key,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entry_cache_set_directory_entry(
+     libfsntfs_directory_entry_cache_t *directory_entry_cache,
+     const libfsntfs_directory_entry_cache_key_t *key,
+     libfsntfs_directory_entry_t *directory_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_directory_entry_cache_remove_directory_entry(
+     libfsntfs_directory_entry_cache_t *directory_entry_cache,
+     const libfsntfs_directory_entry_cache_key_t *key,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
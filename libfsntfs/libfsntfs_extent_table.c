@@ -0,0 +1,676 @@
+/*
+ * Extent table functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_extent_table.h"
+#include "libfsntfs_libcerror.h"
+
+/* Creates an extent table
+ * Make sure the value extent_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extent_table_initialize(
+     libfsntfs_extent_table_t **extent_table,
+     size_t cluster_block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_extent_table_initialize";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extent_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extent table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( cluster_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid cluster block size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	*extent_table = memory_allocate_structure(
+	                 libfsntfs_extent_table_t );
+
+	if( *extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *extent_table,
+	     0,
+	     sizeof( libfsntfs_extent_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extent table.",
+		 function );
+
+		goto on_error;
+	}
+	( *extent_table )->cluster_block_size = cluster_block_size;
+
+	return( 1 );
+
+on_error:
+	if( *extent_table != NULL )
+	{
+		memory_free(
+		 *extent_table );
+
+		*extent_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an extent table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extent_table_free(
+     libfsntfs_extent_table_t **extent_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_extent_table_free";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extent_table != NULL )
+	{
+		if( ( *extent_table )->range_flags != NULL )
+		{
+			memory_free(
+			 ( *extent_table )->range_flags );
+		}
+		if( ( *extent_table )->numbers_of_clusters != NULL )
+		{
+			memory_free(
+			 ( *extent_table )->numbers_of_clusters );
+		}
+		if( ( *extent_table )->first_lcns != NULL )
+		{
+			memory_free(
+			 ( *extent_table )->first_lcns );
+		}
+		if( ( *extent_table )->first_vcns != NULL )
+		{
+			memory_free(
+			 ( *extent_table )->first_vcns );
+		}
+		memory_free(
+		 *extent_table );
+
+		*extent_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Resizes the extent table to hold a specific maximum number of extents
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extent_table_resize(
+     libfsntfs_extent_table_t *extent_table,
+     int maximum_number_of_extents,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_extent_table_resize";
+	void *reallocation    = NULL;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_extents < extent_table->number_of_extents )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of extents value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) maximum_number_of_extents > ( (size_t) SSIZE_MAX / sizeof( uint64_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum number of extents value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_extents <= extent_table->maximum_number_of_extents )
+	{
+		return( 1 );
+	}
+	/* The maximum number of extents is only updated when all the arrays were resized
+	 */
+	reallocation = memory_reallocate(
+	                extent_table->first_vcns,
+	                sizeof( uint64_t ) * maximum_number_of_extents );
+
+	if( reallocation == NULL )
+	{
+		goto on_error;
+	}
+	extent_table->first_vcns = (uint64_t *) reallocation;
+
+	reallocation = memory_reallocate(
+	                extent_table->first_lcns,
+	                sizeof( uint64_t ) * maximum_number_of_extents );
+
+	if( reallocation == NULL )
+	{
+		goto on_error;
+	}
+	extent_table->first_lcns = (uint64_t *) reallocation;
+
+	reallocation = memory_reallocate(
+	                extent_table->numbers_of_clusters,
+	                sizeof( uint64_t ) * maximum_number_of_extents );
+
+	if( reallocation == NULL )
+	{
+		goto on_error;
+	}
+	extent_table->numbers_of_clusters = (uint64_t *) reallocation;
+
+	reallocation = memory_reallocate(
+	                extent_table->range_flags,
+	                sizeof( uint32_t ) * maximum_number_of_extents );
+
+	if( reallocation == NULL )
+	{
+		goto on_error;
+	}
+	extent_table->range_flags = (uint32_t *) reallocation;
+
+	extent_table->maximum_number_of_extents = maximum_number_of_extents;
+
+	return( 1 );
+
+on_error:
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_MEMORY,
+	 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+	 "%s: unable to resize extent table.",
+	 function );
+
+	return( -1 );
+}
+
+/* Appends an extent
+ * The extents must be appended in ascending order of their first VCN
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extent_table_append_extent(
+     libfsntfs_extent_table_t *extent_table,
+     uint64_t first_vcn,
+     uint64_t first_lcn,
+     uint64_t number_of_clusters,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	static char *function         = "libfsntfs_extent_table_append_extent";
+	int extent_index              = 0;
+	int maximum_number_of_extents = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_vcn > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first VCN value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_clusters > ( (uint64_t) INT64_MAX - first_vcn ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of clusters value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->number_of_extents > 0 )
+	{
+		extent_index = extent_table->number_of_extents - 1;
+
+		if( first_vcn < ( extent_table->first_vcns[ extent_index ] + extent_table->numbers_of_clusters[ extent_index ] ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid first VCN value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( extent_table->number_of_extents >= extent_table->maximum_number_of_extents )
+	{
+		if( extent_table->maximum_number_of_extents == 0 )
+		{
+			maximum_number_of_extents = 16;
+		}
+		else if( extent_table->maximum_number_of_extents <= ( INT_MAX / 2 ) )
+		{
+			maximum_number_of_extents = extent_table->maximum_number_of_extents * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of extents value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfsntfs_extent_table_resize(
+		     extent_table,
+		     maximum_number_of_extents,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize extent table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	extent_index = extent_table->number_of_extents;
+
+	extent_table->first_vcns[ extent_index ]          = first_vcn;
+	extent_table->first_lcns[ extent_index ]          = first_lcn;
+	extent_table->numbers_of_clusters[ extent_index ] = number_of_clusters;
+	extent_table->range_flags[ extent_index ]         = range_flags;
+
+	extent_table->number_of_extents += 1;
+
+	return( 1 );
+}
+
+/* Appends the extents of another extent table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extent_table_append_extent_table(
+     libfsntfs_extent_table_t *extent_table,
+     libfsntfs_extent_table_t *source_extent_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_extent_table_append_extent_table";
+	int extent_index      = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_extent_table->cluster_block_size != extent_table->cluster_block_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid source extent table - cluster block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_extent_table->number_of_extents > ( INT_MAX - extent_table->number_of_extents ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of extents value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_extent_table_resize(
+	     extent_table,
+	     extent_table->number_of_extents + source_extent_table->number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize extent table.",
+		 function );
+
+		return( -1 );
+	}
+	for( extent_index = 0;
+	     extent_index < source_extent_table->number_of_extents;
+	     extent_index++ )
+	{
+		if( libfsntfs_extent_table_append_extent(
+		     extent_table,
+		     source_extent_table->first_vcns[ extent_index ],
+		     source_extent_table->first_lcns[ extent_index ],
+		     source_extent_table->numbers_of_clusters[ extent_index ],
+		     source_extent_table->range_flags[ extent_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of extents
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extent_table_get_number_of_extents(
+     libfsntfs_extent_table_t *extent_table,
+     int *number_of_extents,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_extent_table_get_number_of_extents";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_extents = extent_table->number_of_extents;
+
+	return( 1 );
+}
+
+/* Retrieves a specific extent
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_extent_table_get_extent_by_index(
+     libfsntfs_extent_table_t *extent_table,
+     int extent_index,
+     uint64_t *first_vcn,
+     uint64_t *first_lcn,
+     uint64_t *number_of_clusters,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_extent_table_get_extent_by_index";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_index < 0 )
+	 || ( extent_index >= extent_table->number_of_extents ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_vcn == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first VCN.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_lcn == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first LCN.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_clusters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of clusters.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	*first_vcn          = extent_table->first_vcns[ extent_index ];
+	*first_lcn          = extent_table->first_lcns[ extent_index ];
+	*number_of_clusters = extent_table->numbers_of_clusters[ extent_index ];
+	*range_flags        = extent_table->range_flags[ extent_index ];
+
+	return( 1 );
+}
+
+/* Retrieves the index of the extent that contains a specific VCN
+ * The extent is searched for with a binary search
+ * Returns 1 if successful, 0 if no extent contains the VCN or -1 on error
+ */
+int libfsntfs_extent_table_get_extent_index_by_vcn(
+     libfsntfs_extent_table_t *extent_table,
+     uint64_t vcn,
+     int *extent_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_extent_table_get_extent_index_by_vcn";
+	int first_index       = 0;
+	int last_index        = 0;
+	int middle_index      = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->number_of_extents == 0 )
+	{
+		return( 0 );
+	}
+	if( vcn < extent_table->first_vcns[ 0 ] )
+	{
+		return( 0 );
+	}
+	/* Search for the last extent with a first VCN less than or equal to the VCN
+	 */
+	first_index = 0;
+	last_index  = extent_table->number_of_extents - 1;
+
+	while( first_index < last_index )
+	{
+		middle_index = first_index + ( ( last_index - first_index + 1 ) / 2 );
+
+		if( extent_table->first_vcns[ middle_index ] <= vcn )
+		{
+			first_index = middle_index;
+		}
+		else
+		{
+			last_index = middle_index - 1;
+		}
+	}
+	if( ( vcn - extent_table->first_vcns[ first_index ] ) >= extent_table->numbers_of_clusters[ first_index ] )
+	{
+		return( 0 );
+	}
+	*extent_index = first_index;
+
+	return( 1 );
+}
+
@@ -0,0 +1,121 @@
+/*
+ * Extent table functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_EXTENT_TABLE_H )
+#define _LIBFSNTFS_EXTENT_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_extent_table libfsntfs_extent_table_t;
+
+/* The extents are stored as parallel arrays, sorted by first virtual cluster number (VCN)
+ */
+struct libfsntfs_extent_table
+{
+	/* The first virtual cluster numbers (VCN)
+	 */
+	uint64_t *first_vcns;
+
+	/* The first logical cluster numbers (LCN), 0 for sparse extents
+	 */
+	uint64_t *first_lcns;
+
+	/* The numbers of clusters
+	 */
+	uint64_t *numbers_of_clusters;
+
+	/* The range flags
+	 */
+	uint32_t *range_flags;
+
+	/* The number of extents
+	 */
+	int number_of_extents;
+
+	/* The maximum number of extents
+	 */
+	int maximum_number_of_extents;
+
+	/* The cluster block size
+	 */
+	size_t cluster_block_size;
+};
+
+int libfsntfs_extent_table_initialize(
+     libfsntfs_extent_table_t **extent_table,
+     size_t cluster_block_size,
+     libcerror_error_t **error );
+
+int libfsntfs_extent_table_free(
+     libfsntfs_extent_table_t **extent_table,
+     libcerror_error_t **error );
+
+int libfsntfs_extent_table_resize(
+     libfsntfs_extent_table_t *extent_table,
+     int maximum_number_of_extents,
+     libcerror_error_t **error );
+
+int libfsntfs_extent_table_append_extent(
+     libfsntfs_extent_table_t *extent_table,
+     uint64_t first_vcn,
+     uint64_t first_lcn,
+     uint64_t number_of_clusters,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libfsntfs_extent_table_append_extent_table(
+     libfsntfs_extent_table_t *extent_table,
+     libfsntfs_extent_table_t *source_extent_table,
+     libcerror_error_t **error );
+
+int libfsntfs_extent_table_get_number_of_extents(
+     libfsntfs_extent_table_t *extent_table,
+     int *number_of_extents,
+     libcerror_error_t **error );
+
+int libfsntfs_extent_table_get_extent_by_index(
+     libfsntfs_extent_table_t *extent_table,
+     int extent_index,
+     uint64_t *first_vcn,
+     uint64_t *first_lcn,
+     uint64_t *number_of_clusters,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libfsntfs_extent_table_get_extent_index_by_vcn(
+     libfsntfs_extent_table_t *extent_table,
+     uint64_t vcn,
+     int *extent_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -27,6 +27,7 @@
 #include "libfsntfs_cluster_block_stream.h"
 #include "libfsntfs_data_stream.h"
 #include "libfsntfs_definitions.h"
+#include "libfsntfs_directory_entries_hash_table.h"
 #include "libfsntfs_directory_entries_tree.h"
 #include "libfsntfs_directory_entry.h"
 #include "libfsntfs_file_entry.h"
@@ -35,6 +36,7 @@
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
 #include "libfsntfs_libfdata.h"
 #include "libfsntfs_mft_entry.h"
 #include "libfsntfs_reparse_point_attribute.h"
@@ -145,43 +147,23 @@ int libfsntfs_file_entry_initialize(
 
 		return( -1 );
 	}
-	if( libcdata_btree_initialize(
-	     &( internal_file_entry->directory_entries_tree ),
-	     LIBFSNTFS_DIRECTORY_ENTRIES_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_file_entry->read_write_lock ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create directory entries tree.",
+		 "%s: unable to initialize read/write lock.",
 		 function );
 
 		goto on_error;
 	}
+#endif
 	if( mft_entry->base_record_file_reference == 0 )
 	{
-		if( mft_entry->i30_index != NULL )
-		{
-			if( libfsntfs_mft_entry_read_directory_entries_tree(
-			     mft_entry,
-			     io_handle,
-			     file_io_handle,
-			     internal_file_entry->directory_entries_tree,
-			     flags,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read MFT entry: %" PRIu32 " directory entries tree.",
-				 function,
-				 mft_entry->index );
-
-				goto on_error;
-			}
-		}
 		if( mft_entry->data_attribute != NULL )
 		{
 			if( libfsntfs_cluster_block_stream_initialize(
@@ -230,13 +212,20 @@ int libfsntfs_file_entry_initialize(
 on_error:
 	if( internal_file_entry != NULL )
 	{
-		if( internal_file_entry->directory_entries_tree != NULL )
+		if( internal_file_entry->data_cluster_block_stream != NULL )
 		{
-			libcdata_btree_free(
-			 &( internal_file_entry->directory_entries_tree ),
-			 NULL,
+			libfdata_stream_free(
+			 &( internal_file_entry->data_cluster_block_stream ),
 			 NULL );
 		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( internal_file_entry->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_file_entry->read_write_lock ),
+			 NULL );
+		}
+#endif
 		memory_free(
 		 internal_file_entry );
 	}
@@ -270,7 +259,7 @@ int libfsntfs_file_entry_free(
 		internal_file_entry = (libfsntfs_internal_file_entry_t *) *file_entry;
 		*file_entry         = NULL;
 
-		/* The file_io_handle, io_handle, mft and mft_entry references are freed elsewhere
+		/* The file_io_handle, io_handle and mft references are freed elsewhere
 		 */
 		if( internal_file_entry->data_cluster_block_stream != NULL )
 		{
@@ -288,6 +277,22 @@ int libfsntfs_file_entry_free(
 				result = -1;
 			}
 		}
+		if( internal_file_entry->directory_entries_hash_table != NULL )
+		{
+			if( libfsntfs_directory_entries_hash_table_free(
+			     &( internal_file_entry->directory_entries_hash_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free directory entries hash table.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( internal_file_entry->directory_entries_tree != NULL )
 		{
 			if( libcdata_btree_free(
@@ -321,6 +326,37 @@ int libfsntfs_file_entry_free(
 				result = -1;
 			}
 		}
+		if( internal_file_entry->mft_entry != NULL )
+		{
+			if( libfsntfs_mft_entry_free(
+			     &( internal_file_entry->mft_entry ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MFT entry.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( internal_file_entry->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 internal_file_entry );
 	}
@@ -2679,6 +2715,144 @@ int libfsntfs_file_entry_get_alternate_data_stream_by_utf16_name(
 	return( 1 );
 }
 
+/* Reads the directory entries tree if not already read
+ * The directory entries hash table is built with the tree if the volume has an upcase table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_file_entry_read_directory_entries_tree(
+     libfsntfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error )
+{
+	static char *function           = "libfsntfs_internal_file_entry_read_directory_entries_tree";
+	int number_of_directory_entries = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->directory_entries_tree != NULL )
+	{
+		return( 1 );
+	}
+	if( libcdata_btree_initialize(
+	     &( internal_file_entry->directory_entries_tree ),
+	     LIBFSNTFS_DIRECTORY_ENTRIES_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory entries tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( internal_file_entry->mft_entry->base_record_file_reference == 0 )
+	 && ( internal_file_entry->mft_entry->i30_index != NULL ) )
+	{
+		if( libfsntfs_mft_entry_read_directory_entries_tree(
+		     internal_file_entry->mft_entry,
+		     internal_file_entry->io_handle,
+		     internal_file_entry->file_io_handle,
+		     internal_file_entry->directory_entries_tree,
+		     internal_file_entry->flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read MFT entry: %" PRIu32 " directory entries tree.",
+			 function,
+			 internal_file_entry->mft_entry->index );
+
+			goto on_error;
+		}
+	}
+	if( internal_file_entry->io_handle->upcase_table != NULL )
+	{
+		if( libcdata_btree_get_number_of_values(
+		     internal_file_entry->directory_entries_tree,
+		     &number_of_directory_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of directory entries from tree.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_directory_entries_hash_table_initialize(
+		     &( internal_file_entry->directory_entries_hash_table ),
+		     internal_file_entry->io_handle->upcase_table,
+		     number_of_directory_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create directory entries hash table.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_directory_entries_hash_table_read_from_tree(
+		     internal_file_entry->directory_entries_hash_table,
+		     internal_file_entry->directory_entries_tree,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to insert directory entries into hash table.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( internal_file_entry->directory_entries_hash_table != NULL )
+	{
+		libfsntfs_directory_entries_hash_table_free(
+		 &( internal_file_entry->directory_entries_hash_table ),
+		 NULL );
+	}
+	if( internal_file_entry->directory_entries_tree != NULL )
+	{
+		libcdata_btree_free(
+		 &( internal_file_entry->directory_entries_tree ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_directory_entry_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Retrieves the number of sub file entries
  * Returns 1 if successful or -1 on error
  */
@@ -2689,6 +2863,7 @@ int libfsntfs_file_entry_get_number_of_sub_file_entries(
 {
 	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
 	static char *function                                = "libfsntfs_file_entry_get_number_of_sub_file_entries";
+	int result                                           = 1;
 
 	if( file_entry == NULL )
 	{
@@ -2703,10 +2878,38 @@ int libfsntfs_file_entry_get_number_of_sub_file_entries(
 	}
 	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
 
-	if( libcdata_btree_get_number_of_values(
-	     internal_file_entry->directory_entries_tree,
-	     number_of_sub_file_entries,
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_internal_file_entry_read_directory_entries_tree(
+	     internal_file_entry,
 	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory entries tree.",
+		 function );
+
+		result = -1;
+	}
+	else if( libcdata_btree_get_number_of_values(
+	          internal_file_entry->directory_entries_tree,
+	          number_of_sub_file_entries,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -2715,29 +2918,43 @@ int libfsntfs_file_entry_get_number_of_sub_file_entries(
 		 "%s: unable to retrieve number of directory entries from tree.",
 		 function );
 
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
 		return( -1 );
 	}
-	return( 1 );
+#endif
+	return( result );
 }
 
 
 /* Retrieves the sub file entry for the specific index
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_file_entry_get_sub_file_entry_by_index(
-     libfsntfs_file_entry_t *file_entry,
+int libfsntfs_internal_file_entry_get_sub_file_entry_by_index(
+     libfsntfs_internal_file_entry_t *internal_file_entry,
      int sub_file_entry_index,
      libfsntfs_file_entry_t **sub_file_entry,
      libcerror_error_t **error )
 {
-	libfsntfs_directory_entry_t *directory_entry         = NULL;
-	libfsntfs_directory_entry_t *sub_directory_entry     = NULL;
-	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
-	libfsntfs_mft_entry_t *mft_entry                     = NULL;
-	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_index";
-	uint64_t mft_entry_index                             = 0;
+	libfsntfs_directory_entry_t *directory_entry     = NULL;
+	libfsntfs_directory_entry_t *sub_directory_entry = NULL;
+	libfsntfs_mft_entry_t *mft_entry                 = NULL;
+	static char *function                            = "libfsntfs_internal_file_entry_get_sub_file_entry_by_index";
+	uint64_t mft_entry_index                         = 0;
 
-	if( file_entry == NULL )
+	if( internal_file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2748,8 +2965,6 @@ int libfsntfs_file_entry_get_sub_file_entry_by_index(
 
 		return( -1 );
 	}
-	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
-
 	if( sub_file_entry == NULL )
 	{
 		libcerror_error_set(
@@ -2772,6 +2987,19 @@ int libfsntfs_file_entry_get_sub_file_entry_by_index(
 
 		return( -1 );
 	}
+	if( libfsntfs_internal_file_entry_read_directory_entries_tree(
+	     internal_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory entries tree.",
+		 function );
+
+		goto on_error;
+	}
 	if( libcdata_btree_get_value_by_index(
 	     internal_file_entry->directory_entries_tree,
 	     sub_file_entry_index,
@@ -2802,8 +3030,9 @@ int libfsntfs_file_entry_get_sub_file_entry_by_index(
 
 		goto on_error;
 	}
-	if( libfsntfs_mft_get_mft_entry_by_index(
+	if( libfsntfs_mft_read_mft_entry_by_index(
 	     internal_file_entry->mft,
+	     internal_file_entry->io_handle,
 	     internal_file_entry->file_io_handle,
 	     mft_entry_index,
 	     &mft_entry,
@@ -2813,7 +3042,7 @@ int libfsntfs_file_entry_get_sub_file_entry_by_index(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+		 "%s: unable to read MFT entry: %" PRIu64 ".",
 		 function,
 		 mft_entry_index );
 
@@ -2833,7 +3062,7 @@ int libfsntfs_file_entry_get_sub_file_entry_by_index(
 
 		goto on_error;
 	}
-	/* libfsntfs_file_entry_initialize takes over management of sub_directory_entry
+	/* libfsntfs_file_entry_initialize takes over management of mft_entry and sub_directory_entry
 	 */
 	if( libfsntfs_file_entry_initialize(
 	     sub_file_entry,
@@ -2864,26 +3093,27 @@ on_error:
 		 &sub_directory_entry,
 		 NULL );
 	}
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
 	return( -1 );
 }
 
-/* Retrieves the sub file entry for an UTF-8 encoded name
- * Returns 1 if successful, 0 if no such file entry or -1 on error
+/* Retrieves the sub file entry for the specific index
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_file_entry_get_sub_file_entry_by_utf8_name(
+int libfsntfs_file_entry_get_sub_file_entry_by_index(
      libfsntfs_file_entry_t *file_entry,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
+     int sub_file_entry_index,
      libfsntfs_file_entry_t **sub_file_entry,
      libcerror_error_t **error )
 {
-	libfsntfs_directory_entry_t *directory_entry         = NULL;
-	libfsntfs_directory_entry_t *sub_directory_entry     = NULL;
 	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
-	libfsntfs_mft_entry_t *mft_entry                     = NULL;
-	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_utf8_name";
-	uint64_t mft_entry_index                             = 0;
-	int result                                           = 0;
+	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_index";
+	int result                                           = 1;
 
 	if( file_entry == NULL )
 	{
@@ -2898,96 +3128,229 @@ int libfsntfs_file_entry_get_sub_file_entry_by_utf8_name(
 	}
 	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
 
-	if( sub_file_entry == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid sub file entry.",
-		 function );
-
-		return( -1 );
-	}
-	if( *sub_file_entry != NULL )
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid sub file entry value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	result = libfsntfs_directory_entries_tree_get_directory_entry_by_utf8_name(
-	          internal_file_entry->directory_entries_tree,
-	          utf8_string,
-	          utf8_string_length,
-	          &directory_entry,
-	          error );
-
-	if( result == -1 )
+#endif
+	if( libfsntfs_internal_file_entry_get_sub_file_entry_by_index(
+	     internal_file_entry,
+	     sub_file_entry_index,
+	     sub_file_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve directory entry.",
-		 function );
+		 "%s: unable to retrieve sub file entry: %d.",
+		 function,
+		 sub_file_entry_index );
 
-		goto on_error;
+		result = -1;
 	}
-	else if( result == 0 )
-	{
-		return( 0 );
-	}
-	if( libfsntfs_directory_entry_get_mft_entry_index(
-	     directory_entry,
-	     &mft_entry_index,
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry index.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfsntfs_mft_get_mft_entry_by_index(
-	     internal_file_entry->mft,
-	     internal_file_entry->file_io_handle,
-	     mft_entry_index,
-	     &mft_entry,
-	     error ) != 1 )
+#endif
+	return( result );
+}
+
+/* Retrieves the sub file entry for an UTF-8 encoded name
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
+ */
+int libfsntfs_internal_file_entry_get_sub_file_entry_by_utf8_name(
+     libfsntfs_internal_file_entry_t *internal_file_entry,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libfsntfs_file_entry_t **sub_file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entries_hash_table_key_t key;
+
+	libfsntfs_directory_entry_t *directory_entry     = NULL;
+	libfsntfs_directory_entry_t *sub_directory_entry = NULL;
+	libfsntfs_mft_entry_t *mft_entry                 = NULL;
+	static char *function                            = "libfsntfs_internal_file_entry_get_sub_file_entry_by_utf8_name";
+	uint64_t mft_entry_index                         = 0;
+	int result                                       = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sub_file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sub file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* If the directory entries tree was already read the name is looked up
+	 * in the directory entries hash table instead of the $I30 index
+	 */
+	if( internal_file_entry->directory_entries_hash_table != NULL )
+	{
+		result = libfsntfs_directory_entries_hash_table_key_set_from_utf8_string(
+		          &key,
+		          internal_file_entry->directory_entries_hash_table->upcase_table,
+		          utf8_string,
+		          utf8_string_length,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set directory entries hash table key.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			result = libfsntfs_directory_entries_hash_table_get_directory_entry(
+			          internal_file_entry->directory_entries_hash_table,
+			          &key,
+			          &directory_entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry from hash table.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				if( libfsntfs_directory_entry_clone(
+				     &sub_directory_entry,
+				     directory_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create sub directory entry.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+	}
+	else
+	{
+		result = libfsntfs_mft_entry_get_directory_entry_by_utf8_name(
+		          internal_file_entry->mft_entry,
+		          internal_file_entry->io_handle,
+		          internal_file_entry->file_io_handle,
+		          utf8_string,
+		          utf8_string_length,
+		          internal_file_entry->flags,
+		          &sub_directory_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libfsntfs_directory_entry_get_mft_entry_index(
+	     sub_directory_entry,
+	     &mft_entry_index,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
-		 function,
-		 mft_entry_index );
+		 "%s: unable to retrieve MFT entry index.",
+		 function );
 
 		goto on_error;
 	}
-	if( libfsntfs_directory_entry_clone(
-	     &sub_directory_entry,
-	     directory_entry,
+	if( libfsntfs_mft_read_mft_entry_by_index(
+	     internal_file_entry->mft,
+	     internal_file_entry->io_handle,
+	     internal_file_entry->file_io_handle,
+	     mft_entry_index,
+	     &mft_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sub directory entry.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
 
 		goto on_error;
 	}
-	/* libfsntfs_file_entry_initialize takes over management of sub_directory_entry
+	/* libfsntfs_file_entry_initialize takes over management of mft_entry and sub_directory_entry
 	 */
 	if( libfsntfs_file_entry_initialize(
 	     sub_file_entry,
@@ -3017,25 +3380,27 @@ on_error:
 		 &sub_directory_entry,
 		 NULL );
 	}
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
 	return( -1 );
 }
 
-/* Retrieves the sub file entry for an UTF-16 encoded name
+/* Retrieves the sub file entry for an UTF-8 encoded name
  * Returns 1 if successful, 0 if no such file entry or -1 on error
  */
-int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
+int libfsntfs_file_entry_get_sub_file_entry_by_utf8_name(
      libfsntfs_file_entry_t *file_entry,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
      libfsntfs_file_entry_t **sub_file_entry,
      libcerror_error_t **error )
 {
-	libfsntfs_directory_entry_t *directory_entry         = NULL;
-	libfsntfs_directory_entry_t *sub_directory_entry     = NULL;
 	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
-	libfsntfs_mft_entry_t *mft_entry                     = NULL;
-	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_utf16_name";
-	uint64_t mft_entry_index                             = 0;
+	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_utf8_name";
 	int result                                           = 0;
 
 	if( file_entry == NULL )
@@ -3051,6 +3416,85 @@ int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
 	}
 	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
 
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsntfs_internal_file_entry_get_sub_file_entry_by_utf8_name(
+	          internal_file_entry,
+	          utf8_string,
+	          utf8_string_length,
+	          sub_file_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry.",
+		 function );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the sub file entry for an UTF-16 encoded name
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
+ */
+int libfsntfs_internal_file_entry_get_sub_file_entry_by_utf16_name(
+     libfsntfs_internal_file_entry_t *internal_file_entry,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsntfs_file_entry_t **sub_file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entries_hash_table_key_t key;
+
+	libfsntfs_directory_entry_t *directory_entry     = NULL;
+	libfsntfs_directory_entry_t *sub_directory_entry = NULL;
+	libfsntfs_mft_entry_t *mft_entry                 = NULL;
+	static char *function                            = "libfsntfs_internal_file_entry_get_sub_file_entry_by_utf16_name";
+	uint64_t mft_entry_index                         = 0;
+	int result                                       = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
 	if( sub_file_entry == NULL )
 	{
 		libcerror_error_set(
@@ -3073,30 +3517,97 @@ int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
 
 		return( -1 );
 	}
-	result = libfsntfs_directory_entries_tree_get_directory_entry_by_utf16_name(
-	          internal_file_entry->directory_entries_tree,
-	          utf16_string,
-	          utf16_string_length,
-	          &directory_entry,
-	          error );
+	/* If the directory entries tree was already read the name is looked up
+	 * in the directory entries hash table instead of the $I30 index
+	 */
+	if( internal_file_entry->directory_entries_hash_table != NULL )
+	{
+		result = libfsntfs_directory_entries_hash_table_key_set_from_utf16_string(
+		          &key,
+		          internal_file_entry->directory_entries_hash_table->upcase_table,
+		          utf16_string,
+		          utf16_string_length,
+		          error );
 
-	if( result == -1 )
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set directory entries hash table key.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			result = libfsntfs_directory_entries_hash_table_get_directory_entry(
+			          internal_file_entry->directory_entries_hash_table,
+			          &key,
+			          &directory_entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry from hash table.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				if( libfsntfs_directory_entry_clone(
+				     &sub_directory_entry,
+				     directory_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create sub directory entry.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+	}
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve directory entry.",
-		 function );
+		result = libfsntfs_mft_entry_get_directory_entry_by_utf16_name(
+		          internal_file_entry->mft_entry,
+		          internal_file_entry->io_handle,
+		          internal_file_entry->file_io_handle,
+		          utf16_string,
+		          utf16_string_length,
+		          internal_file_entry->flags,
+		          &sub_directory_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory entry.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	else if( result == 0 )
+	if( result == 0 )
 	{
 		return( 0 );
 	}
 	if( libfsntfs_directory_entry_get_mft_entry_index(
-	     directory_entry,
+	     sub_directory_entry,
 	     &mft_entry_index,
 	     error ) != 1 )
 	{
@@ -3109,8 +3620,9 @@ int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
 
 		goto on_error;
 	}
-	if( libfsntfs_mft_get_mft_entry_by_index(
+	if( libfsntfs_mft_read_mft_entry_by_index(
 	     internal_file_entry->mft,
+	     internal_file_entry->io_handle,
 	     internal_file_entry->file_io_handle,
 	     mft_entry_index,
 	     &mft_entry,
@@ -3120,27 +3632,13 @@ int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+		 "%s: unable to read MFT entry: %" PRIu64 ".",
 		 function,
 		 mft_entry_index );
 
 		goto on_error;
 	}
-	if( libfsntfs_directory_entry_clone(
-	     &sub_directory_entry,
-	     directory_entry,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sub directory entry.",
-		 function );
-
-		goto on_error;
-	}
-	/* libfsntfs_file_entry_initialize takes over management of sub_directory_entry
+	/* libfsntfs_file_entry_initialize takes over management of mft_entry and sub_directory_entry
 	 */
 	if( libfsntfs_file_entry_initialize(
 	     sub_file_entry,
@@ -3170,9 +3668,91 @@ on_error:
 		 &sub_directory_entry,
 		 NULL );
 	}
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
 	return( -1 );
 }
 
+/* Retrieves the sub file entry for an UTF-16 encoded name
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
+ */
+int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
+     libfsntfs_file_entry_t *file_entry,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsntfs_file_entry_t **sub_file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsntfs_file_entry_get_sub_file_entry_by_utf16_name";
+	int result                                           = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsntfs_internal_file_entry_get_sub_file_entry_by_utf16_name(
+	          internal_file_entry,
+	          utf16_string,
+	          utf16_string_length,
+	          sub_file_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry.",
+		 function );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Reads data at the current offset from the default data stream (nameless $DATA attribute)
  * Returns the number of bytes read or -1 on error
  */
@@ -3214,6 +3794,21 @@ ssize_t libfsntfs_file_entry_read_buffer(
 	{
 		return( 0 );
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	read_count = libfdata_stream_read_buffer(
 		      internal_file_entry->data_cluster_block_stream,
 		      (intptr_t *) internal_file_entry->file_io_handle,
@@ -3231,8 +3826,23 @@ ssize_t libfsntfs_file_entry_read_buffer(
 		 "%s: unable to read from data cluster block stream.",
 		 function );
 
+		read_count = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
 		return( -1 );
 	}
+#endif
 	return( read_count );
 }
 
@@ -3246,11 +3856,55 @@ ssize_t libfsntfs_file_entry_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_file_entry_read_buffer_at_offset";
-	ssize_t read_count    = 0;
+	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsntfs_file_entry_read_buffer_at_offset";
+	ssize_t read_count                                   = 0;
 
-	if( libfsntfs_file_entry_seek_offset(
-	     file_entry,
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
+
+	if( internal_file_entry->data_attribute == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing data attribute.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->data_cluster_block_stream == NULL )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfdata_stream_seek_offset(
+	     internal_file_entry->data_cluster_block_stream,
 	     offset,
 	     SEEK_SET,
 	     error ) == -1 )
@@ -3259,32 +3913,148 @@ ssize_t libfsntfs_file_entry_read_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 "%s: unable to seek offset in data cluster block stream.",
+		 function );
+
+		read_count = -1;
+	}
+	else
+	{
+		read_count = libfdata_stream_read_buffer(
+		              internal_file_entry->data_cluster_block_stream,
+		              (intptr_t *) internal_file_entry->file_io_handle,
+		              buffer,
+		              buffer_size,
+		              0,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from data cluster block stream.",
+			 function );
+
+			read_count = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads multiple ranges of data from the default data stream (nameless $DATA attribute)
+ * The ranges are read in order of their offset and ranges that are close together
+ * are coalesced into a single read. The current offset is not changed
+ * Returns the total number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_file_entry_read_vector(
+         libfsntfs_file_entry_t *file_entry,
+         libfsntfs_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error )
+{
+	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                                = "libfsntfs_file_entry_read_vector";
+	ssize_t read_count                                   = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
+
+	if( internal_file_entry->data_attribute == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing data attribute.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->data_cluster_block_stream == NULL )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	read_count = libfsntfs_file_entry_read_buffer(
-	              file_entry,
-	              buffer,
-	              buffer_size,
+#endif
+	read_count = libfsntfs_cluster_block_stream_read_vector(
+	              internal_file_entry->data_cluster_block_stream,
+	              internal_file_entry->file_io_handle,
+	              internal_file_entry->io_handle,
+	              ranges,
+	              number_of_ranges,
 	              error );
 
-	if( read_count <= -1 )
+	if( read_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 "%s: unable to read ranges from data cluster block stream.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
+#endif
 	return( read_count );
 }
 
 /* Seeks a certain offset in the default data stream (nameless $DATA attribute)
+ * The whence LIBFSNTFS_SEEK_DATA and LIBFSNTFS_SEEK_HOLE seek to the next data or sparse hole
  * Returns the offset if seek is successful or -1 on error
  */
 off64_t libfsntfs_file_entry_seek_offset(
@@ -3295,6 +4065,7 @@ off64_t libfsntfs_file_entry_seek_offset(
 {
 	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
 	static char *function                                = "libfsntfs_file_entry_seek_offset";
+	int result                                           = 1;
 
 	if( file_entry == NULL )
 	{
@@ -3320,23 +4091,93 @@ off64_t libfsntfs_file_entry_seek_offset(
 
 		return( -1 );
 	}
-	offset = libfdata_stream_seek_offset(
-	          internal_file_entry->data_cluster_block_stream,
-	          offset,
-	          whence,
-	          error );
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-	if( offset == -1 )
+		return( -1 );
+	}
+#endif
+	if( ( whence == LIBFSNTFS_SEEK_DATA )
+	 || ( whence == LIBFSNTFS_SEEK_HOLE ) )
+	{
+		result = libfsntfs_cluster_block_stream_get_data_or_hole_offset(
+		          internal_file_entry->data_attribute,
+		          internal_file_entry->data_size,
+		          offset,
+		          whence,
+		          &offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data or hole offset.",
+			 function );
+		}
+		else if( result == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset value out of bounds - no data at or after offset.",
+			 function );
+
+			result = -1;
+		}
+		whence = SEEK_SET;
+	}
+	if( result != 1 )
+	{
+		offset = -1;
+	}
+	else
+	{
+		offset = libfdata_stream_seek_offset(
+		          internal_file_entry->data_cluster_block_stream,
+		          offset,
+		          whence,
+		          error );
+
+		if( offset == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset in data cluster block stream.",
+			 function );
+
+			offset = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset in data cluster block stream.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
+#endif
 	return( offset );
 }
 
@@ -3350,6 +4191,7 @@ int libfsntfs_file_entry_get_offset(
 {
 	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
 	static char *function                                = "libfsntfs_file_entry_get_offset";
+	int result                                           = 1;
 
 	if( file_entry == NULL )
 	{
@@ -3375,6 +4217,21 @@ int libfsntfs_file_entry_get_offset(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	if( libfdata_stream_get_offset(
 	     internal_file_entry->data_cluster_block_stream,
 	     offset,
@@ -3387,9 +4244,24 @@ int libfsntfs_file_entry_get_offset(
 		 "%s: unable to retrieve offset from data cluster block stream.",
 		 function );
 
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
 		return( -1 );
 	}
-	return( 1 );
+#endif
+	return( result );
 }
 
 /* Retrieves the size of the default data stream (nameless $DATA attribute)
@@ -3484,8 +4356,9 @@ int libfsntfs_file_entry_get_number_of_extents(
 	}
 	else
 	{
-		if( libfdata_stream_get_number_of_segments(
+		if( libfsntfs_cluster_block_stream_get_number_of_extents(
 		     internal_file_entry->data_cluster_block_stream,
+		     internal_file_entry->data_attribute,
 		     number_of_extents,
 		     error ) != 1 )
 		{
@@ -3493,7 +4366,7 @@ int libfsntfs_file_entry_get_number_of_extents(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve data cluster block stream number of segments.",
+			 "%s: unable to retrieve data cluster block stream number of extents.",
 			 function );
 
 			return( -1 );
@@ -3517,7 +4390,6 @@ int libfsntfs_file_entry_get_extent_by_index(
 	static char *function                                = "libfsntfs_file_entry_get_extent_by_index";
 	size64_t data_size                                   = 0;
 	uint32_t range_flags                                 = 0;
-	int segment_file_index                               = 0;
 
 	if( file_entry == NULL )
 	{
@@ -3576,10 +4448,10 @@ int libfsntfs_file_entry_get_extent_by_index(
 
 		return( -1 );
 	}
-	if( libfdata_stream_get_segment_by_index(
+	if( libfsntfs_cluster_block_stream_get_extent_by_index(
 	     internal_file_entry->data_cluster_block_stream,
+	     internal_file_entry->data_attribute,
 	     extent_index,
-	     &segment_file_index,
 	     extent_offset,
 	     extent_size,
 	     &range_flags,
@@ -3589,24 +4461,7 @@ int libfsntfs_file_entry_get_extent_by_index(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data cluster block stream segment: %d.",
-		 function,
-		 extent_index );
-
-		return( -1 );
-	}
-	if( libfdata_stream_get_segment_mapped_range(
-	     internal_file_entry->data_cluster_block_stream,
-	     extent_index,
-	     extent_offset,
-	     extent_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve data cluster block stream segment: %d mapped range.",
+		 "%s: unable to retrieve data cluster block stream extent: %d.",
 		 function,
 		 extent_index );
 
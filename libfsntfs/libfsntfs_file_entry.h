@@ -25,12 +25,14 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_directory_entries_hash_table.h"
 #include "libfsntfs_directory_entry.h"
 #include "libfsntfs_extern.h"
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
 #include "libfsntfs_libfdata.h"
 #include "libfsntfs_mft.h"
 #include "libfsntfs_mft_entry.h"
@@ -58,6 +60,7 @@ struct libfsntfs_internal_file_entry
 	libfsntfs_mft_t *mft;
 
 	/* The MFT entry
+	 * The file entry owns this copy, it is not shared with the MFT entry cache
 	 */
 	libfsntfs_mft_entry_t *mft_entry;
 
@@ -78,12 +81,24 @@ struct libfsntfs_internal_file_entry
 	libfdata_stream_t *data_cluster_block_stream;
 
 	/* The directory entries tree
+	 * The tree is read on demand by libfsntfs_internal_file_entry_read_directory_entries_tree
 	 */
 	libcdata_btree_t *directory_entries_tree;
 
+	/* The directory entries hash table
+	 * The table is built with the directory entries tree if the volume has an upcase table
+	 */
+	libfsntfs_directory_entries_hash_table_t *directory_entries_hash_table;
+
 	/* The flags
 	 */
 	uint8_t flags;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
 };
 
 int libfsntfs_file_entry_initialize(
@@ -352,12 +367,22 @@ int libfsntfs_file_entry_get_alternate_data_stream_by_utf16_name(
      libfsntfs_data_stream_t **alternate_data_stream,
      libcerror_error_t **error );
 
+int libfsntfs_internal_file_entry_read_directory_entries_tree(
+     libfsntfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_file_entry_get_number_of_sub_file_entries(
      libfsntfs_file_entry_t *file_entry,
      int *number_of_sub_entries,
      libcerror_error_t **error );
 
+int libfsntfs_internal_file_entry_get_sub_file_entry_by_index(
+     libfsntfs_internal_file_entry_t *internal_file_entry,
+     int sub_file_entry_index,
+     libfsntfs_file_entry_t **sub_file_entry,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_file_entry_get_sub_file_entry_by_index(
      libfsntfs_file_entry_t *file_entry,
@@ -365,6 +390,13 @@ int libfsntfs_file_entry_get_sub_file_entry_by_index(
      libfsntfs_file_entry_t **sub_file_entry,
      libcerror_error_t **error );
 
+int libfsntfs_internal_file_entry_get_sub_file_entry_by_utf8_name(
+     libfsntfs_internal_file_entry_t *internal_file_entry,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libfsntfs_file_entry_t **sub_file_entry,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_file_entry_get_sub_file_entry_by_utf8_name(
      libfsntfs_file_entry_t *file_entry,
@@ -373,6 +405,13 @@ int libfsntfs_file_entry_get_sub_file_entry_by_utf8_name(
      libfsntfs_file_entry_t **sub_file_entry,
      libcerror_error_t **error );
 
+int libfsntfs_internal_file_entry_get_sub_file_entry_by_utf16_name(
+     libfsntfs_internal_file_entry_t *internal_file_entry,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsntfs_file_entry_t **sub_file_entry,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_file_entry_get_sub_file_entry_by_utf16_name(
      libfsntfs_file_entry_t *file_entry,
@@ -396,6 +435,13 @@ ssize_t libfsntfs_file_entry_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+ssize_t libfsntfs_file_entry_read_vector(
+         libfsntfs_file_entry_t *file_entry,
+         libfsntfs_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 off64_t libfsntfs_file_entry_seek_offset(
          libfsntfs_file_entry_t *file_entry,
@@ -24,9 +24,11 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsntfs_arena.h"
 #include "libfsntfs_debug.h"
 #include "libfsntfs_file_name_values.h"
 #include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libcnotify.h"
 #include "libfsntfs_libcstring.h"
@@ -37,10 +39,12 @@
 
 /* Creates file name values
  * Make sure the value file_name_values is referencing, is set to NULL
+ * If an arena is provided the values and name are allocated from the arena
  * Returns 1 if successful or -1 on error
  */
 int libfsntfs_file_name_values_initialize(
      libfsntfs_file_name_values_t **file_name_values,
+     libfsntfs_arena_t *arena,
      libcerror_error_t **error )
 {
 	static char *function = "libfsntfs_file_name_values_initialize";
@@ -67,19 +71,40 @@ int libfsntfs_file_name_values_initialize(
 
 		return( -1 );
 	}
-	*file_name_values = memory_allocate_structure(
-	                     libfsntfs_file_name_values_t );
+	if( arena != NULL )
+	{
+		if( libfsntfs_arena_allocate(
+		     arena,
+		     sizeof( libfsntfs_file_name_values_t ),
+		     (uint8_t **) file_name_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create file name values.",
+			 function );
 
-	if( *file_name_values == NULL )
+			goto on_error;
+		}
+	}
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create file name values.",
-		 function );
+		*file_name_values = memory_allocate_structure(
+		                     libfsntfs_file_name_values_t );
 
-		goto on_error;
+		if( *file_name_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create file name values.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	if( memory_set(
 	     *file_name_values,
@@ -95,14 +120,18 @@ int libfsntfs_file_name_values_initialize(
 
 		goto on_error;
 	}
+	( *file_name_values )->arena = arena;
+
 	return( 1 );
 
 on_error:
 	if( *file_name_values != NULL )
 	{
-		memory_free(
-		 *file_name_values );
-
+		if( arena == NULL )
+		{
+			memory_free(
+			 *file_name_values );
+		}
 		*file_name_values = NULL;
 	}
 	return( -1 );
@@ -130,14 +159,18 @@ int libfsntfs_file_name_values_free(
 	}
 	if( *file_name_values != NULL )
 	{
-		if( ( *file_name_values )->name != NULL )
+		/* File name values allocated from the arena are freed together with the arena
+		 */
+		if( ( *file_name_values )->arena == NULL )
 		{
+			if( ( *file_name_values )->name != NULL )
+			{
+				memory_free(
+				 ( *file_name_values )->name );
+			}
 			memory_free(
-			 ( *file_name_values )->name );
+			 *file_name_values );
 		}
-		memory_free(
-		 *file_name_values );
-
 		*file_name_values = NULL;
 	}
 	return( 1 );
@@ -209,6 +242,11 @@ int libfsntfs_file_name_values_clone(
 
 		goto on_error;
 	}
+	/* The destination file name values are allocated on the heap
+	 */
+	( *destination_file_name_values )->arena = NULL;
+	( *destination_file_name_values )->name  = NULL;
+
 	if( libfsntfs_file_name_values_set_name(
 	     *destination_file_name_values,
 	     source_file_name_values->name,
@@ -745,9 +783,11 @@ on_error:
 #endif
 	if( file_name_values->name != NULL )
 	{
-		memory_free(
-		 file_name_values->name );
-
+		if( file_name_values->arena == NULL )
+		{
+			memory_free(
+			 file_name_values->name );
+		}
 		file_name_values->name = NULL;
 	}
 	file_name_values->name_size = 0;
@@ -1168,19 +1208,40 @@ int libfsntfs_file_name_values_set_name(
 
 		return( -1 );
 	}
-	file_name_values->name = (uint8_t *) memory_allocate(
-	                                      sizeof( uint8_t ) * (size_t) name_size );
+	if( file_name_values->arena != NULL )
+	{
+		if( libfsntfs_arena_allocate(
+		     file_name_values->arena,
+		     sizeof( uint8_t ) * (size_t) name_size,
+		     &( file_name_values->name ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
 
-	if( file_name_values->name == NULL )
+			goto on_error;
+		}
+	}
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create name.",
-		 function );
+		file_name_values->name = (uint8_t *) memory_allocate(
+		                                      sizeof( uint8_t ) * (size_t) name_size );
 
-		goto on_error;
+		if( file_name_values->name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	if( memory_copy(
 	     file_name_values->name,
@@ -1203,9 +1264,11 @@ int libfsntfs_file_name_values_set_name(
 on_error:
 	if( file_name_values->name != NULL )
 	{
-		memory_free(
-		 file_name_values->name );
-
+		if( file_name_values->arena == NULL )
+		{
+			memory_free(
+			 file_name_values->name );
+		}
 		file_name_values->name = NULL;
 	}
 	file_name_values->name_size = 0;
@@ -1213,6 +1276,272 @@ on_error:
 	return( -1 );
 }
 
+/* Compares the name with an UTF-8 encoded string using the collation of the $I30 index
+ * Only the ASCII characters a - z are upper cased, other characters are compared by value
+ * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
+ */
+int libfsntfs_file_name_values_compare_name_with_utf8_string(
+     libfsntfs_file_name_values_t *file_name_values,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
+{
+	static char *function                       = "libfsntfs_file_name_values_compare_name_with_utf8_string";
+	libuna_unicode_character_t name_character   = 0;
+	libuna_unicode_character_t string_character = 0;
+	size_t name_index                           = 0;
+	size_t utf8_string_index                    = 0;
+
+	if( file_name_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file name values.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_name_values->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file name values - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Ignore the end of string character
+	 */
+	if( ( utf8_string_length > 0 )
+	 && ( utf8_string[ utf8_string_length - 1 ] == 0 ) )
+	{
+		utf8_string_length -= 1;
+	}
+	while( ( name_index < (size_t) file_name_values->name_size )
+	    && ( utf8_string_index < utf8_string_length ) )
+	{
+		if( libuna_unicode_character_copy_from_utf16_stream(
+		     &name_character,
+		     file_name_values->name,
+		     (size_t) file_name_values->name_size,
+		     &name_index,
+		     LIBUNA_ENDIAN_LITTLE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy name to Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+		if( libuna_unicode_character_copy_from_utf8(
+		     &string_character,
+		     utf8_string,
+		     utf8_string_length,
+		     &utf8_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy UTF-8 string to Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( name_character >= (libuna_unicode_character_t) 'a' )
+		 && ( name_character <= (libuna_unicode_character_t) 'z' ) )
+		{
+			name_character -= (libuna_unicode_character_t) 'a' - 'A';
+		}
+		if( ( string_character >= (libuna_unicode_character_t) 'a' )
+		 && ( string_character <= (libuna_unicode_character_t) 'z' ) )
+		{
+			string_character -= (libuna_unicode_character_t) 'a' - 'A';
+		}
+		if( name_character < string_character )
+		{
+			return( LIBCDATA_COMPARE_LESS );
+		}
+		else if( name_character > string_character )
+		{
+			return( LIBCDATA_COMPARE_GREATER );
+		}
+	}
+	if( name_index < (size_t) file_name_values->name_size )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	else if( utf8_string_index < utf8_string_length )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	return( LIBCDATA_COMPARE_EQUAL );
+}
+
+/* Compares the name with an UTF-16 encoded string using the collation of the $I30 index
+ * Only the ASCII characters a - z are upper cased, other characters are compared by value
+ * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
+ */
+int libfsntfs_file_name_values_compare_name_with_utf16_string(
+     libfsntfs_file_name_values_t *file_name_values,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error )
+{
+	static char *function                       = "libfsntfs_file_name_values_compare_name_with_utf16_string";
+	libuna_unicode_character_t name_character   = 0;
+	libuna_unicode_character_t string_character = 0;
+	size_t name_index                           = 0;
+	size_t utf16_string_index                   = 0;
+
+	if( file_name_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file name values.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_name_values->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file name values - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Ignore the end of string character
+	 */
+	if( ( utf16_string_length > 0 )
+	 && ( utf16_string[ utf16_string_length - 1 ] == 0 ) )
+	{
+		utf16_string_length -= 1;
+	}
+	while( ( name_index < (size_t) file_name_values->name_size )
+	    && ( utf16_string_index < utf16_string_length ) )
+	{
+		if( libuna_unicode_character_copy_from_utf16_stream(
+		     &name_character,
+		     file_name_values->name,
+		     (size_t) file_name_values->name_size,
+		     &name_index,
+		     LIBUNA_ENDIAN_LITTLE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy name to Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+		if( libuna_unicode_character_copy_from_utf16(
+		     &string_character,
+		     utf16_string,
+		     utf16_string_length,
+		     &utf16_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy UTF-16 string to Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( name_character >= (libuna_unicode_character_t) 'a' )
+		 && ( name_character <= (libuna_unicode_character_t) 'z' ) )
+		{
+			name_character -= (libuna_unicode_character_t) 'a' - 'A';
+		}
+		if( ( string_character >= (libuna_unicode_character_t) 'a' )
+		 && ( string_character <= (libuna_unicode_character_t) 'z' ) )
+		{
+			string_character -= (libuna_unicode_character_t) 'a' - 'A';
+		}
+		if( name_character < string_character )
+		{
+			return( LIBCDATA_COMPARE_LESS );
+		}
+		else if( name_character > string_character )
+		{
+			return( LIBCDATA_COMPARE_GREATER );
+		}
+	}
+	if( name_index < (size_t) file_name_values->name_size )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	else if( utf16_string_index < utf16_string_length )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	return( LIBCDATA_COMPARE_EQUAL );
+}
+
 /* Compares a (long-named) file name values with a short-named file name values
  * Returns 1 if (possibly) equal, 0 if not or -1 on error
  */
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_arena.h"
 #include "libfsntfs_libcerror.h"
 
 #if defined( __cplusplus )
@@ -35,6 +36,11 @@ typedef struct libfsntfs_file_name_values libfsntfs_file_name_values_t;
 
 struct libfsntfs_file_name_values
 {
+	/* The arena the values and name are allocated from
+	 * NULL if they are allocated on the heap
+	 */
+	libfsntfs_arena_t *arena;
+
 	/* The parent file reference
 	 */
 	uint64_t parent_file_reference;
@@ -74,6 +80,7 @@ struct libfsntfs_file_name_values
 
 int libfsntfs_file_name_values_initialize(
      libfsntfs_file_name_values_t **file_name_values,
+     libfsntfs_arena_t *arena,
      libcerror_error_t **error );
 
 int libfsntfs_file_name_values_free(
@@ -154,6 +161,18 @@ int libfsntfs_file_name_values_set_name(
      uint16_t name_size,
      libcerror_error_t **error );
 
+int libfsntfs_file_name_values_compare_name_with_utf8_string(
+     libfsntfs_file_name_values_t *file_name_values,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error );
+
+int libfsntfs_file_name_values_compare_name_with_utf16_string(
+     libfsntfs_file_name_values_t *file_name_values,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error );
+
 int libfsntfs_file_name_values_compare_short_name(
      libfsntfs_file_name_values_t *file_name_values,
      libfsntfs_file_name_values_t *short_file_name_values,
@@ -433,6 +433,17 @@ int libfsntfs_index_read(
 
 		return( -1 );
 	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( index->is_read != 0 )
 	{
 		return( 1 );
@@ -459,6 +470,8 @@ int libfsntfs_index_read(
 
 		return( -1 );
 	}
+	index->io_handle = io_handle;
+
 	if( index->index_root_attribute == NULL )
 	{
 		return( 1 );
@@ -484,7 +497,7 @@ int libfsntfs_index_read(
 	}
 	if( libfcache_cache_initialize(
 	     &( index->index_value_cache ),
-	     LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_INDEX_VALUES,
+	     io_handle->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_INDEX_VALUES ],
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -496,7 +509,7 @@ int libfsntfs_index_read(
 
 		goto on_error;
 	}
-	if( libfsntfs_index_read_root(
+	if( libfsntfs_index_read_root_node(
 	     index,
 	     io_handle,
 	     error ) != 1 )
@@ -505,7 +518,7 @@ int libfsntfs_index_read(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read index root.",
+		 "%s: unable to read index root node.",
 		 function );
 
 		goto on_error;
@@ -534,6 +547,95 @@ int libfsntfs_index_read(
 		}
 	}
 #endif
+	if( libfsntfs_index_read_sub_nodes(
+	     index,
+	     io_handle,
+	     file_io_handle,
+	     index->root_values_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub nodes.",
+		 function );
+
+		goto on_error;
+	}
+	index->is_read = 1;
+
+	return( 1 );
+
+on_error:
+	if( index->index_value_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( index->index_value_cache ),
+		 NULL );
+	}
+	if( index->index_value_list != NULL )
+	{
+		libfdata_list_free(
+		 &( index->index_value_list ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the index root node
+ * Also prepares the index entry vector so that the sub nodes can be read on demand
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_index_read_root_node(
+     libfsntfs_index_t *index,
+     libfsntfs_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_index_read_root_node";
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( index->root_node_is_read != 0 )
+	{
+		return( 1 );
+	}
+	index->io_handle = io_handle;
+
+	if( libfsntfs_index_read_root(
+	     index,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index root.",
+		 function );
+
+		goto on_error;
+	}
 	/* The index does not necessarily have an $INDEX_ALLOCATION attribute
 	 */
 	if( index->index_allocation_attribute != NULL )
@@ -556,7 +658,7 @@ int libfsntfs_index_read(
 		}
 		if( libfcache_cache_initialize(
 		     &( index->index_entry_cache ),
-		     LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_INDEX_ENTRIES,
+		     io_handle->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_INDEX_ENTRIES ],
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -569,23 +671,7 @@ int libfsntfs_index_read(
 			goto on_error;
 		}
 	}
-	if( libfsntfs_index_read_sub_nodes(
-	     index,
-	     io_handle,
-	     file_io_handle,
-	     index->root_values_array,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read sub nodes.",
-		 function );
-
-		goto on_error;
-	}
-	index->is_read = 1;
+	index->root_node_is_read = 1;
 
 	return( 1 );
 
@@ -602,18 +688,11 @@ on_error:
 		 &( index->index_entry_vector ),
 		 NULL );
 	}
-	if( index->index_value_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &( index->index_value_cache ),
-		 NULL );
-	}
-	if( index->index_value_list != NULL )
-	{
-		libfdata_list_free(
-		 &( index->index_value_list ),
-		 NULL );
-	}
+	libcdata_array_empty(
+	 index->root_values_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_index_value_free,
+	 NULL );
+
 	return( -1 );
 }
 
@@ -1064,6 +1143,128 @@ int libfsntfs_index_read_bitmap(
 	return( 1 );
 }
 
+/* Reads the index values of the sub node with a specific virtual cluster number (VCN)
+ * Make sure the value index_values_array is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_index_read_sub_node(
+     libfsntfs_index_t *index,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint64_t sub_node_vcn,
+     libcdata_array_t **index_values_array,
+     libcerror_error_t **error )
+{
+	libfsntfs_index_entry_t *index_entry = NULL;
+	static char *function                = "libfsntfs_index_read_sub_node";
+	off64_t element_data_offset          = 0;
+	off64_t index_entry_offset           = 0;
+	int index_value_entry                = 0;
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( index->index_entry_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid index - missing index entry vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_node_vcn > (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sub node VCN value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	index_entry_offset = (off64_t) ( sub_node_vcn * io_handle->cluster_block_size );
+
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     io_handle,
+	     LIBFSNTFS_CACHE_TYPE_INDEX_ENTRIES,
+	     1,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_vector_get_element_value_at_offset(
+	     index->index_entry_vector,
+	     (intptr_t *) file_io_handle,
+	     index->index_entry_cache,
+	     index_entry_offset,
+	     &element_data_offset,
+	     (intptr_t **) &index_entry,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index entry with VCN: %d at offset: 0x%08" PRIx64 ".",
+		 function,
+		 (int) sub_node_vcn,
+		 index_entry_offset );
+
+		return( -1 );
+	}
+	if( libfsntfs_index_entry_read_index_values(
+	     index_entry,
+	     index_entry_offset,
+	     &index_value_entry,
+	     index_values_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index values array from index entry with VCN: %d at offset: 0x%08" PRIx64 ".",
+		 function,
+		 (int) sub_node_vcn,
+		 index_entry_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Reads the index sub nodes
  * Returns 1 if successful or -1 on error
  */
@@ -1075,15 +1276,11 @@ int libfsntfs_index_read_sub_nodes(
      libcerror_error_t **error )
 {
 	libcdata_array_t *index_values_array      = NULL;
-	libfsntfs_index_entry_t *index_entry      = NULL;
 	libfsntfs_index_value_t *node_index_value = NULL;
 	static char *function                     = "libfsntfs_index_read_sub_nodes";
-	off64_t element_data_offset               = 0;
-	off64_t index_entry_offset                = 0;
 	uint32_t index_value_flags                = 0;
 	int element_index                         = 0;
 	int element_file_index                    = 0;
-	int index_value_entry                     = 0;
 	int number_of_node_index_values           = 0;
 	int node_index_value_entry                = 0;
 
@@ -1163,45 +1360,11 @@ int libfsntfs_index_read_sub_nodes(
 #endif
 		if( ( node_index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_HAS_SUB_NODE ) != 0 )
 		{
-			if( node_index_value->sub_node_vcn > (uint64_t) INT_MAX )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: node index value: %d sub node VCN value out of bounds.",
-				 function,
-				 node_index_value_entry );
-
-				goto on_error;
-			}
-			index_entry_offset = (off64_t) ( node_index_value->sub_node_vcn * io_handle->cluster_block_size );
-
-			if( libfdata_vector_get_element_value_at_offset(
-			     index->index_entry_vector,
-			     (intptr_t *) file_io_handle,
-			     index->index_entry_cache,
-			     index_entry_offset,
-			     &element_data_offset,
-			     (intptr_t **) &index_entry,
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve index entry with VCN: %d at offset: 0x%08" PRIx64 ".",
-				 function,
-				 (int) node_index_value->sub_node_vcn,
-				 index_entry_offset );
-
-				goto on_error;
-			}
-			if( libfsntfs_index_entry_read_index_values(
-			     index_entry,
-			     index_entry_offset,
-			     &index_value_entry,
+			if( libfsntfs_index_read_sub_node(
+			     index,
+			     io_handle,
+			     file_io_handle,
+			     node_index_value->sub_node_vcn,
 			     &index_values_array,
 			     error ) != 1 )
 			{
@@ -1209,10 +1372,9 @@ int libfsntfs_index_read_sub_nodes(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
 				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read index values array from index entry with VCN: %d at offset: 0x%08" PRIx64 ".",
+				 "%s: unable to read sub node of node index value: %d.",
 				 function,
-				 (int) node_index_value->sub_node_vcn,
-				 index_entry_offset );
+				 node_index_value_entry );
 
 				goto on_error;
 			}
@@ -1227,10 +1389,9 @@ int libfsntfs_index_read_sub_nodes(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
 				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read sub nodes of index entry with VCN: %d at offset: 0x%08" PRIx64 ".",
+				 "%s: unable to read sub nodes of node index value: %d.",
 				 function,
-				 (int) node_index_value->sub_node_vcn,
-				 index_entry_offset );
+				 node_index_value_entry );
 
 				goto on_error;
 			}
@@ -1338,6 +1499,33 @@ int libfsntfs_index_read_index_value_element_data(
 
 		return( -1 );
 	}
+	if( index->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid index - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     index->io_handle,
+	     LIBFSNTFS_CACHE_TYPE_INDEX_VALUES,
+	     0,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_list_element_get_element_index(
 	     element,
 	     &index_value_entry,
@@ -1389,6 +1577,22 @@ int libfsntfs_index_read_index_value_element_data(
 	}
 	else
 	{
+		if( libfsntfs_io_handle_update_cache_statistics(
+		     index->io_handle,
+		     LIBFSNTFS_CACHE_TYPE_INDEX_ENTRIES,
+		     1,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update cache statistics.",
+			 function );
+
+			goto on_error;
+		}
 		if( libfdata_vector_get_element_value_at_offset(
 		     index->index_entry_vector,
 		     (intptr_t *) file_io_handle,
@@ -1577,6 +1781,33 @@ int libfsntfs_index_get_index_value_by_index(
 
 		return( -1 );
 	}
+	if( index->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid index - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     index->io_handle,
+	     LIBFSNTFS_CACHE_TYPE_INDEX_VALUES,
+	     1,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_list_get_element_value_by_index(
 	     index->index_value_list,
 	     (intptr_t *) file_io_handle,
@@ -42,6 +42,10 @@ typedef struct libfsntfs_index libfsntfs_index_t;
 
 struct libfsntfs_index
 {
+	/* The IO handle
+	 */
+	libfsntfs_io_handle_t *io_handle;
+
 	/* The index entry size
 	 */
 	uint32_t index_entry_size;
@@ -94,6 +98,10 @@ struct libfsntfs_index
 	 */
 	libfcache_cache_t *index_value_cache;
 
+	/* Value to indicate the index root node was read
+	 */
+	uint8_t root_node_is_read;
+
 	/* Value to indicate the index was read
 	 */
 	uint8_t is_read;
@@ -131,6 +139,11 @@ int libfsntfs_index_read(
      uint8_t flags,
      libcerror_error_t **error );
 
+int libfsntfs_index_read_root_node(
+     libfsntfs_index_t *index,
+     libfsntfs_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
 int libfsntfs_index_read_root(
      libfsntfs_index_t *index,
      libfsntfs_io_handle_t *io_handle,
@@ -143,6 +156,14 @@ int libfsntfs_index_read_bitmap(
      uint8_t flags,
      libcerror_error_t **error );
 
+int libfsntfs_index_read_sub_node(
+     libfsntfs_index_t *index,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint64_t sub_node_vcn,
+     libcdata_array_t **index_values_array,
+     libcerror_error_t **error );
+
 int libfsntfs_index_read_sub_nodes(
      libfsntfs_index_t *index,
      libfsntfs_io_handle_t *io_handle,
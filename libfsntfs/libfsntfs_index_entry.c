@@ -24,7 +24,6 @@
 #include <memory.h>
 #include <types.h>
 
-#include "libfsntfs_data_run.h"
 #include "libfsntfs_debug.h"
 #include "libfsntfs_definitions.h"
 #include "libfsntfs_index_entry.h"
@@ -244,22 +243,6 @@ int libfsntfs_index_entry_read(
 		 file_offset );
 	}
 #endif
-	if( libbfio_handle_seek_offset(
-	     file_io_handle,
-	     file_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek index entry offset: 0x%08" PRIx64 ".",
-		 function,
-		 file_offset );
-
-		goto on_error;
-	}
 	index_entry->data = (uint8_t *) memory_allocate(
 	                                 sizeof( uint8_t ) * index_entry_size );
 
@@ -276,10 +259,12 @@ int libfsntfs_index_entry_read(
 	}
 	index_entry->data_size = (size_t) index_entry_size;
 
-	read_count = libbfio_handle_read_buffer(
+	read_count = libfsntfs_io_handle_read_buffer_at_offset(
+	              io_handle,
 	              file_io_handle,
 	              index_entry->data,
 	              index_entry->data_size,
+	              file_offset,
 	              error );
 
 	if( read_count != (ssize_t) index_entry->data_size )
@@ -288,8 +273,9 @@ int libfsntfs_index_entry_read(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read index entry data.",
-		 function );
+		 "%s: unable to read index entry data at offset: 0x%08" PRIx64 ".",
+		 function,
+		 file_offset );
 
 		goto on_error;
 	}
@@ -792,6 +778,17 @@ int libfsntfs_index_entry_read_element_data(
 	LIBFSNTFS_UNREFERENCED_PARAMETER( element_flags )
 	LIBFSNTFS_UNREFERENCED_PARAMETER( read_flags )
 
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( (uint64_t) element_index > (uint64_t) UINT32_MAX )
 	{
 		libcerror_error_set(
@@ -803,6 +800,22 @@ int libfsntfs_index_entry_read_element_data(
 
 		return( -1 );
 	}
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     io_handle,
+	     LIBFSNTFS_CACHE_TYPE_INDEX_ENTRIES,
+	     0,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfsntfs_index_entry_initialize(
 	     &index_entry,
 	     error ) != 1 )
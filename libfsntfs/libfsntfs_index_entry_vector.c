@@ -23,7 +23,6 @@
 #include <types.h>
 
 #include "libfsntfs_attribute.h"
-#include "libfsntfs_data_run.h"
 #include "libfsntfs_definitions.h"
 #include "libfsntfs_index_entry.h"
 #include "libfsntfs_index_entry_vector.h"
@@ -45,13 +44,15 @@ int libfsntfs_index_entry_vector_initialize(
      uint32_t index_entry_size,
      libcerror_error_t **error )
 {
-	libfsntfs_data_run_t *data_run = NULL;
-	static char *function          = "libfsntfs_index_entry_vector_initialize";
-	int attribute_index            = 0;
-	int entry_index                = 0;
-	int number_of_entries          = 0;
-	int segment_index              = 0;
-	uint16_t attribute_data_flags  = 0;
+	static char *function         = "libfsntfs_index_entry_vector_initialize";
+	off64_t data_run_offset       = 0;
+	size64_t data_run_size        = 0;
+	uint32_t data_run_flags       = 0;
+	int attribute_index           = 0;
+	int entry_index               = 0;
+	int number_of_entries         = 0;
+	int segment_index             = 0;
+	uint16_t attribute_data_flags = 0;
 
 	if( index_entry_vector == NULL )
 	{
@@ -156,7 +157,9 @@ int libfsntfs_index_entry_vector_initialize(
 			if( libfsntfs_attribute_get_data_run_by_index(
 			     attribute,
 			     entry_index,
-			     &data_run,
+			     &data_run_offset,
+			     &data_run_size,
+			     &data_run_flags,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -170,25 +173,12 @@ int libfsntfs_index_entry_vector_initialize(
 
 				goto on_error;
 			}
-			if( data_run == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing attribute: %d data run: %d.",
-				 function,
-				 attribute_index,
-				 entry_index );
-
-				goto on_error;
-			}
 			if( libfdata_vector_append_segment(
 			     *index_entry_vector,
 			     &segment_index,
 			     0,
-			     data_run->start_offset,
-			     data_run->size,
+			     data_run_offset,
+			     data_run_size,
 			     0,
 			     error ) != 1 )
 			{
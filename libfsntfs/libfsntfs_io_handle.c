@@ -24,10 +24,14 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsntfs_decompression_pool.h"
+#include "libfsntfs_definitions.h"
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libcnotify.h"
+#include "libfsntfs_libcthreads.h"
+#include "libfsntfs_upcase_table.h"
 
 #include "fsntfs_volume_header.h"
 
@@ -93,11 +97,91 @@ int libfsntfs_io_handle_initialize(
 
 		goto on_error;
 	}
+	( *io_handle )->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES ]       = LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_MFT_ENTRIES;
+	( *io_handle )->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_INDEX_ENTRIES ]     = LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_INDEX_ENTRIES;
+	( *io_handle )->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_INDEX_VALUES ]      = LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_INDEX_VALUES;
+	( *io_handle )->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_COMPRESSION_UNITS ] = LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_COMPRESSION_UNITS;
+	( *io_handle )->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_DIRECTORY_ENTRIES ] = LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_DIRECTORY_ENTRIES;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *io_handle )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_handle )->cache_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_handle )->file_io_handle_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_handle )->cache_statistics_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize cache statistics mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *io_handle != NULL )
 	{
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( ( *io_handle )->file_io_handle_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *io_handle )->file_io_handle_mutex ),
+			 NULL );
+		}
+		if( ( *io_handle )->cache_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *io_handle )->cache_mutex ),
+			 NULL );
+		}
+		if( ( *io_handle )->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( ( *io_handle )->read_write_lock ),
+			 NULL );
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
@@ -129,6 +213,92 @@ int libfsntfs_io_handle_free(
 	}
 	if( *io_handle != NULL )
 	{
+		if( ( *io_handle )->upcase_table != NULL )
+		{
+			if( libfsntfs_upcase_table_free(
+			     &( ( *io_handle )->upcase_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free upcase table.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( ( *io_handle )->decompression_pool != NULL )
+		{
+			if( libfsntfs_decompression_pool_free(
+			     &( ( *io_handle )->decompression_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free decompression pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_read_write_lock_free(
+		     &( ( *io_handle )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *io_handle )->cache_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *io_handle )->file_io_handle_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *io_handle )->cache_statistics_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache statistics mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
@@ -144,7 +314,18 @@ int libfsntfs_io_handle_clear(
      libfsntfs_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libfsntfs_io_handle_clear";
+	int maximum_number_of_cache_entries[ LIBFSNTFS_NUMBER_OF_CACHE_TYPES ];
+
+	static char *function                              = "libfsntfs_io_handle_clear";
+	int number_of_decompression_threads                = 0;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libfsntfs_decompression_pool_t *decompression_pool = NULL;
+	libcthreads_read_write_lock_t *read_write_lock     = NULL;
+	libcthreads_mutex_t *cache_mutex                   = NULL;
+	libcthreads_mutex_t *cache_statistics_mutex        = NULL;
+	libcthreads_mutex_t *file_io_handle_mutex          = NULL;
+#endif
 
 	if( io_handle == NULL )
 	{
@@ -157,6 +338,48 @@ int libfsntfs_io_handle_clear(
 
 		return( -1 );
 	}
+	/* The cache limits, the decompression pool, the read/write lock and the mutexes
+	 * are retained when the IO handle is cleared, the upcase table is freed
+	 */
+	if( memory_copy(
+	     maximum_number_of_cache_entries,
+	     io_handle->maximum_number_of_cache_entries,
+	     sizeof( int ) * LIBFSNTFS_NUMBER_OF_CACHE_TYPES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy maximum number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_decompression_threads = io_handle->number_of_decompression_threads;
+
+	if( io_handle->upcase_table != NULL )
+	{
+		if( libfsntfs_upcase_table_free(
+		     &( io_handle->upcase_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free upcase table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	decompression_pool     = io_handle->decompression_pool;
+	read_write_lock        = io_handle->read_write_lock;
+	cache_mutex            = io_handle->cache_mutex;
+	cache_statistics_mutex = io_handle->cache_statistics_mutex;
+	file_io_handle_mutex   = io_handle->file_io_handle_mutex;
+#endif
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -171,9 +394,324 @@ int libfsntfs_io_handle_clear(
 
 		return( -1 );
 	}
+	if( memory_copy(
+	     io_handle->maximum_number_of_cache_entries,
+	     maximum_number_of_cache_entries,
+	     sizeof( int ) * LIBFSNTFS_NUMBER_OF_CACHE_TYPES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy maximum number of cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->number_of_decompression_threads = number_of_decompression_threads;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	io_handle->decompression_pool     = decompression_pool;
+	io_handle->read_write_lock        = read_write_lock;
+	io_handle->cache_mutex            = cache_mutex;
+	io_handle->cache_statistics_mutex = cache_statistics_mutex;
+	io_handle->file_io_handle_mutex   = file_io_handle_mutex;
+#endif
+	return( 1 );
+}
+
+/* Updates the number of lookups and misses of a specific cache type
+ * A miss is counted together with or after the lookup it belongs to,
+ * so that the number of misses never exceeds the number of lookups
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_io_handle_update_cache_statistics(
+     libfsntfs_io_handle_t *io_handle,
+     int cache_type,
+     uint64_t number_of_lookups,
+     uint64_t number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_io_handle_update_cache_statistics";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( cache_type < 0 )
+	 || ( cache_type >= LIBFSNTFS_NUMBER_OF_CACHE_TYPES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported cache type.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->cache_statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	io_handle->number_of_cache_lookups[ cache_type ] += number_of_lookups;
+	io_handle->number_of_cache_misses[ cache_type ]  += number_of_misses;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->cache_statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	return( 1 );
 }
 
+/* Retrieves the number of lookups and misses of a specific cache type
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_io_handle_get_cache_statistics(
+     libfsntfs_io_handle_t *io_handle,
+     int cache_type,
+     uint64_t *number_of_lookups,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_io_handle_get_cache_statistics";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( cache_type < 0 )
+	 || ( cache_type >= LIBFSNTFS_NUMBER_OF_CACHE_TYPES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported cache type.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_lookups == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of lookups.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->cache_statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_lookups = io_handle->number_of_cache_lookups[ cache_type ];
+	*number_of_misses  = io_handle->number_of_cache_misses[ cache_type ];
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->cache_statistics_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache statistics mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads a buffer at a specific offset from the file IO handle
+ * The file IO handle mutex is held so that the seek and the read are not separated
+ * by a seek of another thread that shares the file IO handle
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfsntfs_io_handle_read_buffer_at_offset(
+         libfsntfs_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_io_handle_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->file_io_handle_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab file IO handle mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->file_io_handle_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file IO handle mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 io_handle->file_io_handle_mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
 /* Reads the volume header
  * Returns 1 if successful or -1 on error
  */
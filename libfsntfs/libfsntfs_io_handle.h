@@ -25,8 +25,12 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_decompression_pool.h"
+#include "libfsntfs_definitions.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+#include "libfsntfs_upcase_table.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -70,9 +74,58 @@ struct libfsntfs_io_handle
 	 */
 	off64_t mirror_mft_offset;
 
+	/* The maximum number of cache entries per cache type
+	 */
+	int maximum_number_of_cache_entries[ LIBFSNTFS_NUMBER_OF_CACHE_TYPES ];
+
+	/* The number of cache lookups per cache type
+	 */
+	uint64_t number_of_cache_lookups[ LIBFSNTFS_NUMBER_OF_CACHE_TYPES ];
+
+	/* The number of cache misses per cache type
+	 */
+	uint64_t number_of_cache_misses[ LIBFSNTFS_NUMBER_OF_CACHE_TYPES ];
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The number of threads used to decompress compression units
+	 */
+	int number_of_decompression_threads;
+
+	/* The upcase table, read from $UpCase when the volume is opened
+	 * NULL if the volume has no usable $UpCase
+	 */
+	libfsntfs_upcase_table_t *upcase_table;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 * This lock is grabbed for reading by the volume functions that only retrieve values
+	 * and for writing by the functions that open, close or (re)configure the volume
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The cache mutex
+	 * This mutex protects the MFT entry vector, the MFT entry cache and the directory entry cache
+	 * that are shared by the volume, its file entries and the MFT scanner
+	 */
+	libcthreads_mutex_t *cache_mutex;
+
+	/* The file IO handle mutex
+	 * This mutex keeps a seek and the subsequent read on the shared file IO handle together
+	 */
+	libcthreads_mutex_t *file_io_handle_mutex;
+
+	/* The cache statistics mutex
+	 * This mutex protects the number of cache lookups and misses
+	 */
+	libcthreads_mutex_t *cache_statistics_mutex;
+
+	/* The decompression pool, used to decompress the compression units of large reads
+	 */
+	libfsntfs_decompression_pool_t *decompression_pool;
+#endif
 };
 
 int libfsntfs_io_handle_initialize(
@@ -87,6 +140,28 @@ int libfsntfs_io_handle_clear(
      libfsntfs_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libfsntfs_io_handle_update_cache_statistics(
+     libfsntfs_io_handle_t *io_handle,
+     int cache_type,
+     uint64_t number_of_lookups,
+     uint64_t number_of_misses,
+     libcerror_error_t **error );
+
+int libfsntfs_io_handle_get_cache_statistics(
+     libfsntfs_io_handle_t *io_handle,
+     int cache_type,
+     uint64_t *number_of_lookups,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+ssize_t libfsntfs_io_handle_read_buffer_at_offset(
+         libfsntfs_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 int libfsntfs_io_handle_read_volume_header(
      libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
@@ -0,0 +1,454 @@
+/*
+ * LZNT1 decompression functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_lznt1.h"
+
+/* Decompresses a LZNT1 compressed chunk
+ * The chunk data is decompressed at the uncompressed data offset, which is updated
+ * A flag byte without compression tuples is copied as 8 literals at once and
+ * compression tuples are copied 16 or 8 bytes at a time when the match offset allows it
+ * Returns 1 on success or -1 on error
+ */
+int libfsntfs_lznt1_decompress_chunk(
+     const uint8_t *chunk_data,
+     size_t chunk_data_size,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     size_t *uncompressed_data_offset,
+     libcerror_error_t **error )
+{
+	static char *function      = "libfsntfs_lznt1_decompress_chunk";
+	size_t chunk_data_offset   = 0;
+	size_t chunk_start_offset  = 0;
+	size_t copy_size           = 0;
+	size_t match_data_offset   = 0;
+	size_t match_end_offset    = 0;
+	size_t match_offset        = 0;
+	size_t match_size          = 0;
+	size_t output_offset       = 0;
+	size_t position_index      = 0;
+	uint16_t compression_tuple = 0;
+	uint8_t flag_bit_index     = 0;
+	uint8_t flag_byte          = 0;
+	uint8_t offset_shift       = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( *uncompressed_data_offset > uncompressed_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid uncompressed data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	output_offset      = *uncompressed_data_offset;
+	chunk_start_offset = output_offset;
+
+	while( chunk_data_offset < chunk_data_size )
+	{
+		flag_byte = chunk_data[ chunk_data_offset++ ];
+
+		if( ( flag_byte == 0 )
+		 && ( ( chunk_data_size - chunk_data_offset ) >= 8 )
+		 && ( ( uncompressed_data_size - output_offset ) >= 8 ) )
+		{
+			memory_copy(
+			 &( uncompressed_data[ output_offset ] ),
+			 &( chunk_data[ chunk_data_offset ] ),
+			 8 );
+
+			chunk_data_offset += 8;
+			output_offset     += 8;
+
+			continue;
+		}
+		for( flag_bit_index = 0;
+		     flag_bit_index < 8;
+		     flag_bit_index++ )
+		{
+			if( chunk_data_offset >= chunk_data_size )
+			{
+				break;
+			}
+			if( ( flag_byte & 0x01 ) == 0 )
+			{
+				if( output_offset >= uncompressed_data_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+					 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+					 "%s: uncompressed data too small.",
+					 function );
+
+					return( -1 );
+				}
+				uncompressed_data[ output_offset++ ] = chunk_data[ chunk_data_offset++ ];
+			}
+			else
+			{
+				if( ( chunk_data_size - chunk_data_offset ) < 2 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+					 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+					 "%s: chunk data too small.",
+					 function );
+
+					return( -1 );
+				}
+				byte_stream_copy_to_uint16_little_endian(
+				 &( chunk_data[ chunk_data_offset ] ),
+				 compression_tuple );
+
+				chunk_data_offset += 2;
+
+				/* The number of bits of the match offset depends on
+				 * the position in the uncompressed chunk
+				 */
+				position_index = output_offset - chunk_start_offset;
+
+				if( ( position_index == 0 )
+				 || ( position_index > LIBFSNTFS_LZNT1_MAXIMUM_CHUNK_SIZE ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid compression tuple position value out of bounds.",
+					 function );
+
+					return( -1 );
+				}
+				offset_shift = 12;
+
+				for( position_index -= 1;
+				     position_index >= 0x10;
+				     position_index >>= 1 )
+				{
+					offset_shift--;
+				}
+				match_offset = (size_t) ( compression_tuple >> offset_shift ) + 1;
+				match_size   = (size_t) ( compression_tuple & ( ( 1 << offset_shift ) - 1 ) ) + 3;
+
+				if( match_offset > ( output_offset - chunk_start_offset ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid compression tuple offset value out of bounds.",
+					 function );
+
+					return( -1 );
+				}
+				if( match_size > ( uncompressed_data_size - output_offset ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+					 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+					 "%s: uncompressed data too small.",
+					 function );
+
+					return( -1 );
+				}
+				match_data_offset = output_offset - match_offset;
+				match_end_offset  = output_offset + match_size;
+
+				/* The wide moves can write up to 15 bytes beyond the end of the match,
+				 * which are overwritten by the data that follows
+				 */
+				if( ( match_offset >= 16 )
+				 && ( ( uncompressed_data_size - match_end_offset ) >= 16 ) )
+				{
+					while( output_offset < match_end_offset )
+					{
+						memory_copy(
+						 &( uncompressed_data[ output_offset ] ),
+						 &( uncompressed_data[ match_data_offset ] ),
+						 16 );
+
+						match_data_offset += 16;
+						output_offset     += 16;
+					}
+				}
+				else if( ( match_offset >= 8 )
+				      && ( ( uncompressed_data_size - match_end_offset ) >= 8 ) )
+				{
+					while( output_offset < match_end_offset )
+					{
+						memory_copy(
+						 &( uncompressed_data[ output_offset ] ),
+						 &( uncompressed_data[ match_data_offset ] ),
+						 8 );
+
+						match_data_offset += 8;
+						output_offset     += 8;
+					}
+				}
+				else
+				{
+					/* The match overlaps the data it is copied to, the copied data
+					 * repeats every match offset bytes hence the non-overlapping part
+					 * doubles with every move
+					 */
+					while( output_offset < match_end_offset )
+					{
+						copy_size = output_offset - match_data_offset;
+
+						if( copy_size > ( match_end_offset - output_offset ) )
+						{
+							copy_size = match_end_offset - output_offset;
+						}
+						memory_copy(
+						 &( uncompressed_data[ output_offset ] ),
+						 &( uncompressed_data[ match_data_offset ] ),
+						 copy_size );
+
+						output_offset += copy_size;
+					}
+				}
+				output_offset = match_end_offset;
+			}
+			flag_byte >>= 1;
+		}
+	}
+	*uncompressed_data_offset = output_offset;
+
+	return( 1 );
+}
+
+/* Decompresses LZNT1 compressed data
+ * Chunks that are stored uncompressed are copied as a whole
+ * Returns 1 on success or -1 on error
+ */
+int libfsntfs_lznt1_decompress(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function           = "libfsntfs_lznt1_decompress";
+	size_t chunk_size               = 0;
+	size_t compressed_data_offset   = 0;
+	size_t uncompressed_data_offset = 0;
+	uint16_t chunk_header           = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *uncompressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( compressed_data_size - compressed_data_offset ) >= 2 )
+	{
+		if( uncompressed_data_offset >= *uncompressed_data_size )
+		{
+			break;
+		}
+		byte_stream_copy_to_uint16_little_endian(
+		 &( compressed_data[ compressed_data_offset ] ),
+		 chunk_header );
+
+		compressed_data_offset += 2;
+
+		/* A chunk header of 0 marks the end of the compressed data
+		 */
+		if( chunk_header == 0 )
+		{
+			break;
+		}
+		chunk_size = (size_t) ( chunk_header & 0x0fff ) + 1;
+
+		if( chunk_size > ( compressed_data_size - compressed_data_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( chunk_header & 0x8000 ) != 0 )
+		{
+			if( libfsntfs_lznt1_decompress_chunk(
+			     &( compressed_data[ compressed_data_offset ] ),
+			     chunk_size,
+			     uncompressed_data,
+			     *uncompressed_data_size,
+			     &uncompressed_data_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+				 "%s: unable to decompress chunk at offset: %" PRIzd ".",
+				 function,
+				 compressed_data_offset - 2 );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			if( chunk_size > ( *uncompressed_data_size - uncompressed_data_offset ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: uncompressed data too small.",
+				 function );
+
+				return( -1 );
+			}
+			memory_copy(
+			 &( uncompressed_data[ uncompressed_data_offset ] ),
+			 &( compressed_data[ compressed_data_offset ] ),
+			 chunk_size );
+
+			uncompressed_data_offset += chunk_size;
+		}
+		compressed_data_offset += chunk_size;
+	}
+	*uncompressed_data_size = uncompressed_data_offset;
+
+	return( 1 );
+}
+
@@ -24,12 +24,13 @@
 #include <types.h>
 
 #include "libfsntfs_attribute.h"
-#include "libfsntfs_data_run.h"
 #include "libfsntfs_definitions.h"
 #include "libfsntfs_file_entry.h"
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcnotify.h"
+#include "libfsntfs_libcthreads.h"
 #include "libfsntfs_libfcache.h"
 #include "libfsntfs_libfdata.h"
 #include "libfsntfs_mft.h"
@@ -160,7 +161,7 @@ int libfsntfs_mft_initialize(
 	}
 	if( libfcache_cache_initialize(
 	     &( ( *mft )->mft_entry_cache ),
-	     LIBFSNTFS_MAXIMUM_CACHE_ENTRIES_MFT_ENTRIES,
+	     io_handle->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES ],
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -172,6 +173,8 @@ int libfsntfs_mft_initialize(
 
 		goto on_error;
 	}
+	( *mft )->io_handle = io_handle;
+
 	return( 1 );
 
 on_error:
@@ -257,10 +260,12 @@ int libfsntfs_mft_set_data_runs(
      libcerror_error_t **error )
 {
 	libfsntfs_internal_attribute_t *data_attribute = NULL;
-	libfsntfs_data_run_t *data_run                 = NULL;
 	static char *function                          = "libfsntfs_mft_set_data_runs";
+	off64_t data_run_offset                        = 0;
+	size64_t data_run_size                         = 0;
 	size64_t mft_data_size                         = 0;
 	size64_t mft_entry_size                        = 0;
+	uint32_t data_run_flags                        = 0;
 	int data_run_index                             = 0;
 	int number_of_data_runs                        = 0;
 	int segment_index                              = 0;
@@ -403,7 +408,9 @@ int libfsntfs_mft_set_data_runs(
 			if( libfsntfs_attribute_get_data_run_by_index(
 			     (libfsntfs_attribute_t *) data_attribute,
 			     data_run_index,
-			     &data_run,
+			     &data_run_offset,
+			     &data_run_size,
+			     &data_run_flags,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -416,17 +423,6 @@ int libfsntfs_mft_set_data_runs(
 
 				return( -1 );
 			}
-			if( data_run == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing MFT entry: 0 data run: %d.",
-				 function );
-
-				return( -1 );
-			}
 			if( ( data_run_index == 0 )
 			 && ( data_attribute == (libfsntfs_internal_attribute_t *) mft_entry->data_attribute ) )
 			{
@@ -434,8 +430,8 @@ int libfsntfs_mft_set_data_runs(
 				     mft->mft_entry_vector,
 				     0,
 				     0,
-				     data_run->start_offset,
-				     data_run->size,
+				     data_run_offset,
+				     data_run_size,
 				     0,
 				     error ) != 1 )
 				{
@@ -455,8 +451,8 @@ int libfsntfs_mft_set_data_runs(
 				     mft->mft_entry_vector,
 				     &segment_index,
 				     0,
-				     data_run->start_offset,
-				     data_run->size,
+				     data_run_offset,
+				     data_run_size,
 				     0,
 				     error ) != 1 )
 				{
@@ -508,6 +504,7 @@ int libfsntfs_mft_read_mft_entry(
 	     io_handle,
 	     file_io_handle,
 	     mft->mft_entry_vector,
+	     mft->mft_entry_cache,
 	     file_offset,
 	     mft_entry_index,
 	     flags,
@@ -551,6 +548,37 @@ int libfsntfs_mft_get_utf8_volume_name_size(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mft->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     mft->io_handle,
+	     LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	     1,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_vector_get_element_value_by_index(
 	     mft->mft_entry_vector,
 	     (intptr_t *) file_io_handle,
@@ -567,7 +595,7 @@ int libfsntfs_mft_get_utf8_volume_name_size(
 		 "%s: unable to retrieve MFT entry: 3.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( mft_entry == NULL )
 	{
@@ -578,7 +606,7 @@ int libfsntfs_mft_get_utf8_volume_name_size(
 		 "%s: missing MFT entry: 3.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( libfsntfs_volume_name_attribute_get_utf8_name_size(
 	     mft_entry->volume_name_attibute,
@@ -592,9 +620,32 @@ int libfsntfs_mft_get_utf8_volume_name_size(
 		 "%s: unable to retrieve size of UTF-8 name from volume name attribute.",
 		 function );
 
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mft->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
 		return( -1 );
 	}
+#endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 mft->io_handle->cache_mutex,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Retrieves the UTF-8 encoded volume name
@@ -623,6 +674,37 @@ int libfsntfs_mft_get_utf8_volume_name(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mft->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     mft->io_handle,
+	     LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	     1,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_vector_get_element_value_by_index(
 	     mft->mft_entry_vector,
 	     (intptr_t *) file_io_handle,
@@ -639,7 +721,7 @@ int libfsntfs_mft_get_utf8_volume_name(
 		 "%s: unable to retrieve MFT entry: 3.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( mft_entry == NULL )
 	{
@@ -650,7 +732,7 @@ int libfsntfs_mft_get_utf8_volume_name(
 		 "%s: missing MFT entry: 3.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( libfsntfs_volume_name_attribute_get_utf8_name(
 	     mft_entry->volume_name_attibute,
@@ -665,9 +747,32 @@ int libfsntfs_mft_get_utf8_volume_name(
 		 "%s: unable to retrieve UTF-8 name from volume name attribute.",
 		 function );
 
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mft->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
 		return( -1 );
 	}
+#endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 mft->io_handle->cache_mutex,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Retrieves the size of the UTF-16 encoded volume name
@@ -695,6 +800,37 @@ int libfsntfs_mft_get_utf16_volume_name_size(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mft->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     mft->io_handle,
+	     LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	     1,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_vector_get_element_value_by_index(
 	     mft->mft_entry_vector,
 	     (intptr_t *) file_io_handle,
@@ -711,7 +847,7 @@ int libfsntfs_mft_get_utf16_volume_name_size(
 		 "%s: unable to retrieve MFT entry: 3.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( mft_entry == NULL )
 	{
@@ -722,7 +858,7 @@ int libfsntfs_mft_get_utf16_volume_name_size(
 		 "%s: missing MFT entry: 3.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( libfsntfs_volume_name_attribute_get_utf16_name_size(
 	     mft_entry->volume_name_attibute,
@@ -736,9 +872,32 @@ int libfsntfs_mft_get_utf16_volume_name_size(
 		 "%s: unable to retrieve size of UTF-16 name from volume name attribute.",
 		 function );
 
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mft->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
 		return( -1 );
 	}
+#endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 mft->io_handle->cache_mutex,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Retrieves the UTF-16 encoded volume name
@@ -767,6 +926,37 @@ int libfsntfs_mft_get_utf16_volume_name(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mft->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     mft->io_handle,
+	     LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	     1,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_vector_get_element_value_by_index(
 	     mft->mft_entry_vector,
 	     (intptr_t *) file_io_handle,
@@ -783,7 +973,7 @@ int libfsntfs_mft_get_utf16_volume_name(
 		 "%s: unable to retrieve MFT entry: 3.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( mft_entry == NULL )
 	{
@@ -794,7 +984,7 @@ int libfsntfs_mft_get_utf16_volume_name(
 		 "%s: missing MFT entry: 3.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( libfsntfs_volume_name_attribute_get_utf16_name(
 	     mft_entry->volume_name_attibute,
@@ -809,9 +999,32 @@ int libfsntfs_mft_get_utf16_volume_name(
 		 "%s: unable to retrieve UTF-16 name from volume name attribute.",
 		 function );
 
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mft->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
 		return( -1 );
 	}
+#endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 mft->io_handle->cache_mutex,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Retrieves the volume version
@@ -838,6 +1051,37 @@ int libfsntfs_mft_get_volume_version(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     mft->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     mft->io_handle,
+	     LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	     1,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_vector_get_element_value_by_index(
 	     mft->mft_entry_vector,
 	     (intptr_t *) file_io_handle,
@@ -854,7 +1098,7 @@ int libfsntfs_mft_get_volume_version(
 		 "%s: unable to retrieve MFT entry: 3.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( mft_entry == NULL )
 	{
@@ -865,7 +1109,7 @@ int libfsntfs_mft_get_volume_version(
 		 "%s: missing MFT entry: 3.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( libfsntfs_volume_information_attribute_get_version(
 	     mft_entry->volume_information_attribute,
@@ -880,9 +1124,32 @@ int libfsntfs_mft_get_volume_version(
 		 "%s: unable to retrieve version from volume information attribute.",
 		 function );
 
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     mft->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
 		return( -1 );
 	}
+#endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 mft->io_handle->cache_mutex,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Retrieves the number of MFT entries
@@ -923,6 +1190,8 @@ int libfsntfs_mft_get_number_of_entries(
 }
 
 /* Retrieves the MFT entry for a specific index
+ * The MFT entry is owned by the MFT entry cache, the caller must hold the cache mutex
+ * of the IO handle for as long as the MFT entry is used
  * Returns 1 if successful or -1 on error
  */
 int libfsntfs_mft_get_mft_entry_by_index(
@@ -956,6 +1225,22 @@ int libfsntfs_mft_get_mft_entry_by_index(
 
 		return( -1 );
 	}
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     mft->io_handle,
+	     LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	     1,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfdata_vector_get_element_value_by_index(
 	     mft->mft_entry_vector,
 	     (intptr_t *) file_io_handle,
@@ -978,3 +1263,822 @@ int libfsntfs_mft_get_mft_entry_by_index(
 	return( 1 );
 }
 
+/* Reads the MFT entry for a specific index
+ * Unlike libfsntfs_mft_get_mft_entry_by_index the MFT entry is not stored in the MFT entry cache
+ * and the caller is responsible for freeing the MFT entry
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_read_mft_entry_by_index(
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint64_t mft_entry_index,
+     libfsntfs_mft_entry_t **mft_entry,
+     libcerror_error_t **error )
+{
+	static char *function   = "libfsntfs_mft_read_mft_entry_by_index";
+	size64_t mft_entry_size = 0;
+	size64_t segment_size   = 0;
+	off64_t mft_offset      = 0;
+	off64_t segment_offset  = 0;
+	uint32_t segment_flags  = 0;
+	uint8_t flags           = 0;
+	int number_of_segments  = 0;
+	int result              = 0;
+	int segment_file_index  = 0;
+	int segment_index       = 0;
+
+	if( mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry_index >= mft->number_of_mft_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mft_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid MFT entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_vector_get_element_data_size(
+	     mft->mft_entry_vector,
+	     &mft_entry_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_get_number_of_segments(
+	     mft->mft_entry_vector,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of MFT entry vector segments.",
+		 function );
+
+		goto on_error;
+	}
+	/* Map the MFT entry index onto the data runs of the MFT
+	 */
+	mft_offset = (off64_t) ( mft_entry_index * mft_entry_size );
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libfdata_vector_get_segment_by_index(
+		     mft->mft_entry_vector,
+		     segment_index,
+		     &segment_file_index,
+		     &segment_offset,
+		     &segment_size,
+		     &segment_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry vector segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( (size64_t) mft_offset < segment_size )
+		{
+			break;
+		}
+		mft_offset -= (off64_t) segment_size;
+	}
+	if( segment_index >= number_of_segments )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry: %" PRIu64 " offset value out of bounds.",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	if( ( segment_flags & LIBFSNTFS_MFT_ENTRY_FLAG_MFT_ONLY ) != 0 )
+	{
+		flags = LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY;
+	}
+	if( libfsntfs_mft_entry_initialize(
+	     mft_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create MFT entry.",
+		 function );
+
+		goto on_error;
+	}
+	/* Extension MFT entries of an attribute list are read through the MFT entry cache
+	 */
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	result = libfsntfs_mft_entry_read(
+	          *mft_entry,
+	          io_handle,
+	          file_io_handle,
+	          mft->mft_entry_vector,
+	          mft->mft_entry_cache,
+	          segment_offset + mft_offset,
+	          (uint32_t) mft_entry_index,
+	          flags,
+	          error );
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 mft_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads MFT data at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_read_data_at_offset(
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_read_data_at_offset";
+	ssize_t read_count    = 0;
+
+	if( mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libfsntfs_io_handle_read_buffer_at_offset(
+	              io_handle,
+	              file_io_handle,
+	              data,
+	              data_size,
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT data at offset: %" PRIi64 ".",
+		 function,
+		 file_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads a file entry from MFT entry data
+ * Returns 1 if successful, 0 if the MFT entry is empty or -1 on error
+ */
+int libfsntfs_mft_read_file_entry_from_data(
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t mft_entry_index,
+     uint8_t mft_entry_flags,
+     uint8_t file_entry_flags,
+     libfsntfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_mft_entry_t *mft_entry = NULL;
+	static char *function            = "libfsntfs_mft_read_file_entry_from_data";
+	int result                       = 0;
+
+	if( mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_mft_entry_initialize(
+	     &mft_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create MFT entry.",
+		 function );
+
+		goto on_error;
+	}
+	/* Extension MFT entries of an attribute list are read through the MFT entry cache
+	 */
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	result = libfsntfs_mft_entry_read_data(
+	          mft_entry,
+	          io_handle,
+	          file_io_handle,
+	          mft->mft_entry_vector,
+	          mft->mft_entry_cache,
+	          data,
+	          data_size,
+	          (uint32_t) mft_entry_index,
+	          mft_entry_flags,
+	          error );
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	if( mft_entry->is_empty != 0 )
+	{
+		if( libfsntfs_mft_entry_free(
+		     &mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free MFT entry.",
+			 function );
+
+			goto on_error;
+		}
+		result = 0;
+	}
+	else
+	{
+		/* libfsntfs_file_entry_initialize takes over management of mft_entry
+		 */
+		if( libfsntfs_file_entry_initialize(
+		     file_entry,
+		     io_handle,
+		     file_io_handle,
+		     mft,
+		     mft_entry,
+		     NULL,
+		     file_entry_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file entry.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
+	}
+	return( result );
+
+on_error:
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Scans the MFT entries in large sequential reads
+ * The callback function is called for every MFT entry that is not empty,
+ * the file entry is freed after the callback function returns.
+ * MFT entries that cannot be read, e.g. due to corruption, are skipped
+ * The callback function should return 1 to continue, 0 to stop or -1 on error
+ * No locks are held while the callback function is called
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
+ */
+int libfsntfs_mft_scan(
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint8_t flags,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *file_entry_error = NULL;
+	libfsntfs_file_entry_t *file_entry  = NULL;
+	uint8_t *buffer                     = NULL;
+	static char *function               = "libfsntfs_mft_scan";
+	size64_t mft_entry_size             = 0;
+	size64_t segment_data_offset        = 0;
+	size64_t segment_size               = 0;
+	size_t buffer_data_offset           = 0;
+	size_t buffer_data_size             = 0;
+	size_t buffer_size                  = 0;
+	size_t read_size                    = 0;
+	off64_t segment_offset              = 0;
+	uint64_t mft_entry_index            = 0;
+	uint32_t segment_flags              = 0;
+	uint8_t mft_entry_flags             = 0;
+	int number_of_segments              = 0;
+	int result                          = 1;
+	int segment_file_index              = 0;
+	int segment_index                   = 0;
+
+	if( mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_vector_get_element_data_size(
+	     mft->mft_entry_vector,
+	     &mft_entry_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( mft_entry_size == 0 )
+	 || ( mft_entry_size > (size64_t) LIBFSNTFS_MFT_SCAN_READ_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_get_number_of_segments(
+	     mft->mft_entry_vector,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of MFT entry vector segments.",
+		 function );
+
+		goto on_error;
+	}
+	/* The buffer contains a whole number of MFT entries
+	 */
+	buffer_size = (size_t) ( LIBFSNTFS_MFT_SCAN_READ_SIZE - ( LIBFSNTFS_MFT_SCAN_READ_SIZE % mft_entry_size ) );
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( mft_entry_index >= mft->number_of_mft_entries )
+		{
+			break;
+		}
+		if( libfdata_vector_get_segment_by_index(
+		     mft->mft_entry_vector,
+		     segment_index,
+		     &segment_file_index,
+		     &segment_offset,
+		     &segment_size,
+		     &segment_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry vector segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		mft_entry_flags = 0;
+
+		if( ( segment_flags & LIBFSNTFS_MFT_ENTRY_FLAG_MFT_ONLY ) != 0 )
+		{
+			mft_entry_flags = LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY;
+		}
+		segment_data_offset = 0;
+
+		while( segment_data_offset < segment_size )
+		{
+			if( mft_entry_index >= mft->number_of_mft_entries )
+			{
+				break;
+			}
+			/* An MFT entry can be split over multiple segments if the cluster
+			 * block size is smaller than the MFT entry size
+			 */
+			read_size = buffer_size - buffer_data_size;
+
+			if( (size64_t) read_size > ( segment_size - segment_data_offset ) )
+			{
+				read_size = (size_t) ( segment_size - segment_data_offset );
+			}
+			if( libfsntfs_mft_read_data_at_offset(
+			     mft,
+			     io_handle,
+			     file_io_handle,
+			     segment_offset + (off64_t) segment_data_offset,
+			     &( buffer[ buffer_data_size ] ),
+			     read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read MFT data from segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			segment_data_offset += read_size;
+			buffer_data_size    += read_size;
+			buffer_data_offset   = 0;
+
+			while( ( buffer_data_size - buffer_data_offset ) >= (size_t) mft_entry_size )
+			{
+				if( mft_entry_index >= mft->number_of_mft_entries )
+				{
+					break;
+				}
+				result = libfsntfs_mft_read_file_entry_from_data(
+				          mft,
+				          io_handle,
+				          file_io_handle,
+				          &( buffer[ buffer_data_offset ] ),
+				          (size_t) mft_entry_size,
+				          mft_entry_index,
+				          mft_entry_flags,
+				          flags,
+				          &file_entry,
+				          &file_entry_error );
+
+				if( result == -1 )
+				{
+					/* A corrupted MFT entry does not prevent the remaining MFT entries from being scanned
+					 */
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						libcnotify_printf(
+						 "%s: unable to read file entry: %" PRIu64 ".\n",
+						 function,
+						 mft_entry_index );
+					}
+#endif
+					libcerror_error_free(
+					 &file_entry_error );
+
+					result = 1;
+				}
+				else if( result != 0 )
+				{
+					result = callback_function(
+					          file_entry,
+					          callback_data,
+					          error );
+
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GENERIC,
+						 "%s: callback function failed for MFT entry: %" PRIu64 ".",
+						 function,
+						 mft_entry_index );
+
+						goto on_error;
+					}
+					if( libfsntfs_file_entry_free(
+					     &file_entry,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free file entry.",
+						 function );
+
+						goto on_error;
+					}
+					if( result == 0 )
+					{
+						break;
+					}
+				}
+				else
+				{
+					result = 1;
+				}
+				buffer_data_offset += (size_t) mft_entry_size;
+
+				mft_entry_index++;
+			}
+			if( result == 0 )
+			{
+				break;
+			}
+			/* Move the remainder of a split MFT entry to the start of the buffer
+			 */
+			buffer_data_size -= buffer_data_offset;
+
+			if( ( buffer_data_size > 0 )
+			 && ( buffer_data_offset > 0 ) )
+			{
+				if( memory_copy(
+				     buffer,
+				     &( buffer[ buffer_data_offset ] ),
+				     buffer_data_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy remainder of MFT entry.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( result == 0 )
+		{
+			break;
+		}
+	}
+	memory_free(
+	 buffer );
+
+	return( result );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		libfsntfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
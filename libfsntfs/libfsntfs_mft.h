@@ -41,6 +41,10 @@ typedef struct libfsntfs_mft libfsntfs_mft_t;
 
 struct libfsntfs_mft
 {
+	/* The IO handle
+	 */
+	libfsntfs_io_handle_t *io_handle;
+
 	/* The number of MFT entries
 	 */
 	uint64_t number_of_mft_entries;
@@ -127,6 +131,47 @@ int libfsntfs_mft_get_mft_entry_by_index(
      libfsntfs_mft_entry_t **mft_entry,
      libcerror_error_t **error );
 
+int libfsntfs_mft_read_mft_entry_by_index(
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint64_t mft_entry_index,
+     libfsntfs_mft_entry_t **mft_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_read_data_at_offset(
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_read_file_entry_from_data(
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t mft_entry_index,
+     uint8_t mft_entry_flags,
+     uint8_t file_entry_flags,
+     libfsntfs_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scan(
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint8_t flags,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
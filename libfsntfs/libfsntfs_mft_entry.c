@@ -24,10 +24,12 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsntfs_arena.h"
 #include "libfsntfs_attribute.h"
 #include "libfsntfs_attribute_list.h"
 #include "libfsntfs_debug.h"
 #include "libfsntfs_definitions.h"
+#include "libfsntfs_directory_entries_tree.h"
 #include "libfsntfs_directory_entry.h"
 #include "libfsntfs_file_name_values.h"
 #include "libfsntfs_index.h"
@@ -42,7 +44,9 @@
 #include "libfsntfs_mft_entry.h"
 #include "libfsntfs_types.h"
 #include "libfsntfs_unused.h"
+#include "libfsntfs_upcase_table.h"
 
+#include "fsntfs_mft_attribute.h"
 #include "fsntfs_mft_entry.h"
 
 const char fsntfs_mft_entry_signature[ 4 ] = "FILE";
@@ -247,6 +251,20 @@ int libfsntfs_mft_entry_initialize(
 
 		goto on_error;
 	}
+	if( libfsntfs_arena_initialize(
+	     &( ( *mft_entry )->arena ),
+	     LIBFSNTFS_MFT_ENTRY_ARENA_BLOCK_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create arena.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -304,11 +322,6 @@ int libfsntfs_mft_entry_free(
 	}
 	if( *mft_entry != NULL )
 	{
-		if( ( *mft_entry )->data != NULL )
-		{
-			memory_free(
-			 ( *mft_entry )->data );
-		}
 		/* The specific attribute references point to attributes in the array
 		 * and are freed by freeing the array and its values
 		 */
@@ -361,6 +374,30 @@ int libfsntfs_mft_entry_free(
 
 			result = -1;
 		}
+		/* The arena is freed last since the attributes in the attributes array
+		 * can be allocated from it
+		 */
+		if( ( *mft_entry )->arena != NULL )
+		{
+			if( libfsntfs_arena_free(
+			     &( ( *mft_entry )->arena ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free arena.",
+				 function );
+
+				result = -1;
+			}
+		}
+		else if( ( *mft_entry )->data != NULL )
+		{
+			memory_free(
+			 ( *mft_entry )->data );
+		}
 		memory_free(
 		 *mft_entry );
 
@@ -377,6 +414,7 @@ int libfsntfs_mft_entry_read(
      libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfdata_vector_t *mft_entry_vector,
+     libfcache_cache_t *mft_entry_cache,
      off64_t file_offset,
      uint32_t mft_entry_index,
      uint8_t flags,
@@ -424,6 +462,7 @@ int libfsntfs_mft_entry_read(
 		     io_handle,
 		     file_io_handle,
 		     mft_entry_vector,
+		     mft_entry_cache,
 		     flags,
 		     error ) != 1 )
 		{
@@ -440,33 +479,17 @@ int libfsntfs_mft_entry_read(
 	return( 1 );
 }
 
-/* Reads the MFT entry header
- * Returns 1 if successful, 0 if empty or -1 on error
+/* Sets the MFT entry data
+ * The data is copied into the MFT entry
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_mft_entry_read_header(
+int libfsntfs_mft_entry_set_data(
      libfsntfs_mft_entry_t *mft_entry,
-     libfsntfs_io_handle_t *io_handle,
-     libbfio_handle_t *file_io_handle,
-     off64_t file_offset,
-     uint32_t mft_entry_index,
+     const uint8_t *data,
+     size_t data_size,
      libcerror_error_t **error )
 {
-	static char *function                     = "libfsntfs_mft_entry_read_header";
-	size_t mft_entry_data_offset              = 0;
-	size_t mft_entry_fixup_offset             = 0;
-	size_t mft_entry_fixup_placeholder_offset = 0;
-	size_t unknown_data_size                  = 0;
-	ssize_t read_count                        = 0;
-	uint16_t fixup_value_index                = 0;
-	uint16_t fixup_values_offset              = 0;
-	uint16_t number_of_fixup_values           = 0;
-	uint16_t total_entry_size                 = 0;
-	int result                                = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	size_t read_size                          = 0;
-	uint16_t value_16bit                      = 0;
-#endif
+	static char *function = "libfsntfs_mft_entry_set_data";
 
 	if( mft_entry == NULL )
 	{
@@ -479,513 +502,2873 @@ int libfsntfs_mft_entry_read_header(
 
 		return( -1 );
 	}
-	if( io_handle == NULL )
+	if( mft_entry->data != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid MFT entry - data already set.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( data == NULL )
 	{
-		libcnotify_printf(
-		 "%s: reading MFT entry at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-		 function,
-		 file_offset,
-		 file_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
 	}
-#endif
-	if( libbfio_handle_seek_offset(
-	     file_io_handle,
-	     file_offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek MFT entry offset: %" PRIi64 ".",
-		 function,
-		 file_offset );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	mft_entry->data = (uint8_t *) memory_allocate(
-	                               io_handle->mft_entry_size );
+	if( mft_entry->arena != NULL )
+	{
+		if( libfsntfs_arena_allocate(
+		     mft_entry->arena,
+		     data_size,
+		     &( mft_entry->data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create MFT entry data.",
+			 function );
 
-	if( mft_entry->data == NULL )
+			goto on_error;
+		}
+	}
+	else
+	{
+		mft_entry->data = (uint8_t *) memory_allocate(
+		                               data_size );
+
+		if( mft_entry->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create MFT entry data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( memory_copy(
+	     mft_entry->data,
+	     data,
+	     data_size ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create MFT entry data.",
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy MFT entry data.",
 		 function );
 
 		goto on_error;
 	}
-	mft_entry->data_size = io_handle->mft_entry_size;
+	mft_entry->data_size = data_size;
 
-	read_count = libbfio_handle_read_buffer(
-	              file_io_handle,
-	              mft_entry->data,
-	              mft_entry->data_size,
-	              error );
+	return( 1 );
 
-	if( read_count != (ssize_t) mft_entry->data_size )
+on_error:
+	if( mft_entry->data != NULL )
+	{
+		/* Data allocated from the arena is freed together with the arena
+		 */
+		if( mft_entry->arena == NULL )
+		{
+			memory_free(
+			 mft_entry->data );
+		}
+		mft_entry->data = NULL;
+	}
+	return( -1 );
+}
+
+/* Reads a specific MFT entry from data
+ * The data is copied into the MFT entry
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_entry_read_data(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *mft_entry_vector,
+     libfcache_cache_t *mft_entry_cache,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t mft_entry_index,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_entry_read_data";
+	int result            = 0;
+
+	if( mft_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read MFT entry data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	result = libfsntfs_mft_entry_check_for_empty_block(
-	          mft_entry->data,
-	          mft_entry->data_size,
-	          error );
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
 
-	if( result == -1 )
+		return( -1 );
+	}
+	if( data_size != (size_t) io_handle->mft_entry_size )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if MFT entry is empty.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	else if( result != 0 )
+	if( libfsntfs_mft_entry_set_data(
+	     mft_entry,
+	     data,
+	     data_size,
+	     error ) != 1 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set MFT entry data.",
+		 function );
+
+		return( -1 );
 	}
-	byte_stream_copy_to_uint16_little_endian(
-	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->fixup_values_offset,
-	 fixup_values_offset );
+	result = libfsntfs_mft_entry_read_header_data(
+	          mft_entry,
+	          io_handle,
+	          mft_entry_index,
+	          error );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( result == -1 )
 	{
-		if( fixup_values_offset > 42 )
-		{
-			read_size = sizeof( fsntfs_mft_entry_header_t );
-		}
-		else
-		{
-			read_size = 42;
-		}
-		libcnotify_printf(
-		 "%s: MFT entry header data:\n",
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry header data.",
 		 function );
-		libcnotify_print_data(
-		 mft_entry->data,
-		 read_size,
-		 0 );
+
+		goto on_error;
 	}
-#endif
-	if( memory_compare(
-	     ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature,
-	     "BAAD",
-	     4 ) == 0 )
+	else if( result == 0 )
 	{
-/* TODO do empty block check on the remainder of the MFT entry? */
-		return( 0 );
+		mft_entry->is_empty = 1;
 	}
-	if( memory_compare(
-	     ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature,
-	     fsntfs_mft_entry_signature,
-	     4 ) != 0 )
+	else
 	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( libfsntfs_mft_entry_read_attributes(
+		     mft_entry,
+		     io_handle,
+		     file_io_handle,
+		     mft_entry_vector,
+		     mft_entry_cache,
+		     flags,
+		     error ) != 1 )
 		{
-			libcnotify_printf(
-			 "%s: invalid MFT entry signature.\n",
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read attributes.",
 			 function );
+
+			return( -1 );
 		}
-#endif
-		mft_entry->is_corrupted = 1;
+	}
+	return( 1 );
 
-/* TODO handle corruption */
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid MFT entry signature.",
-		 function );
-
-		goto on_error;
+on_error:
+	if( mft_entry->data != NULL )
+	{
+		/* Data allocated from the arena is freed together with the arena
+		 */
+		if( mft_entry->arena == NULL )
+		{
+			memory_free(
+			 mft_entry->data );
+		}
+		mft_entry->data = NULL;
 	}
-	byte_stream_copy_to_uint16_little_endian(
-	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->number_of_fixup_values,
-	 number_of_fixup_values );
-
-	byte_stream_copy_to_uint64_little_endian(
-	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->journal_sequence_number,
-	 mft_entry->journal_sequence_number );
-
-	byte_stream_copy_to_uint16_little_endian(
-	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->sequence,
-	 mft_entry->sequence );
-
-	byte_stream_copy_to_uint16_little_endian(
-	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->reference_count,
-	 mft_entry->reference_count );
-
-	byte_stream_copy_to_uint16_little_endian(
-	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->attributes_offset,
-	 mft_entry->attributes_offset );
-
-	byte_stream_copy_to_uint16_little_endian(
-	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->flags,
-	 mft_entry->flags );
+	mft_entry->data_size = 0;
 
-	byte_stream_copy_to_uint16_little_endian(
-	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->used_entry_size,
-	 mft_entry->used_entry_size );
+	return( -1 );
+}
 
-	byte_stream_copy_to_uint16_little_endian(
-	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->total_entry_size,
-	 total_entry_size );
+/* Reads the MFT entry header
+ * Returns 1 if successful, 0 if empty or -1 on error
+ */
+int libfsntfs_mft_entry_read_header(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     uint32_t mft_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_entry_read_header";
+	ssize_t read_count    = 0;
+	int result            = 0;
 
-	byte_stream_copy_to_uint64_little_endian(
-	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->base_record_file_reference,
-	 mft_entry->base_record_file_reference );
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
 
-	if( fixup_values_offset > 42 )
+		return( -1 );
+	}
+	if( io_handle == NULL )
 	{
-		byte_stream_copy_to_uint32_little_endian(
-		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->index,
-		 mft_entry->index );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
 		libcnotify_printf(
-		 "%s: signature\t\t\t\t\t: %c%c%c%c\n",
+		 "%s: reading MFT entry at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
 		 function,
-		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature[ 0 ],
-		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature[ 1 ],
-		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature[ 2 ],
-		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature[ 3 ] );
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	if( mft_entry->arena != NULL )
+	{
+		if( libfsntfs_arena_allocate(
+		     mft_entry->arena,
+		     (size_t) io_handle->mft_entry_size,
+		     &( mft_entry->data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create MFT entry data.",
+			 function );
 
-		libcnotify_printf(
-		 "%s: fixup values offset\t\t\t\t: %" PRIu16 "\n",
-		 function,
-		 fixup_values_offset );
+			goto on_error;
+		}
+	}
+	else
+	{
+		mft_entry->data = (uint8_t *) memory_allocate(
+		                               io_handle->mft_entry_size );
 
-		libcnotify_printf(
-		 "%s: number of fixup values\t\t\t\t: %" PRIu16 "\n",
-		 function,
-		 number_of_fixup_values );
+		if( mft_entry->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create MFT entry data.",
+			 function );
 
-		libcnotify_printf(
-		 "%s: journal sequence number\t\t\t: %" PRIu64 "\n",
-		 function,
-		 mft_entry->journal_sequence_number );
+			goto on_error;
+		}
+	}
+	mft_entry->data_size = io_handle->mft_entry_size;
 
-		libcnotify_printf(
-		 "%s: sequence\t\t\t\t\t: %" PRIu16 "\n",
-		 function,
-		 mft_entry->sequence );
+	read_count = libfsntfs_io_handle_read_buffer_at_offset(
+	              io_handle,
+	              file_io_handle,
+	              mft_entry->data,
+	              mft_entry->data_size,
+	              file_offset,
+	              error );
 
-		libcnotify_printf(
-		 "%s: reference count\t\t\t\t: %" PRIu16 "\n",
+	if( read_count != (ssize_t) mft_entry->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry data at offset: %" PRIi64 ".",
 		 function,
-		 mft_entry->reference_count );
+		 file_offset );
 
-		libcnotify_printf(
-		 "%s: attributes offset\t\t\t\t: %" PRIu16 "\n",
-		 function,
-		 mft_entry->attributes_offset );
+		goto on_error;
+	}
+	result = libfsntfs_mft_entry_read_header_data(
+	          mft_entry,
+	          io_handle,
+	          mft_entry_index,
+	          error );
 
-		libcnotify_printf(
-		 "%s: flags\t\t\t\t\t\t: 0x%04" PRIx16 "\n",
-		 function,
-		 mft_entry->flags );
-		libfsntfs_debug_print_mft_entry_flags(
-		 mft_entry->flags );
-		libcnotify_printf(
-		 "\n" );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry header data.",
+		 function );
 
-		libcnotify_printf(
-		 "%s: used entry size\t\t\t\t: %" PRIu16 "\n",
-		 function,
-		 mft_entry->used_entry_size );
+		goto on_error;
+	}
+	return( result );
 
-		libcnotify_printf(
-		 "%s: total entry size\t\t\t\t: %" PRIu16 "\n",
-		 function,
-		 total_entry_size );
+on_error:
+	if( mft_entry->data != NULL )
+	{
+		/* Data allocated from the arena is freed together with the arena
+		 */
+		if( mft_entry->arena == NULL )
+		{
+			memory_free(
+			 mft_entry->data );
+		}
+		mft_entry->data = NULL;
+	}
+	mft_entry->data_size = 0;
 
-		libcnotify_printf(
-		 "%s: base record file reference\t\t\t: MFT entry: %" PRIu64 ", sequence: %" PRIu64 "\n",
-		 function,
-		 mft_entry->base_record_file_reference & 0xffffffffffffUL,
-		 mft_entry->base_record_file_reference >> 48 );
+	return( -1 );
+}
 
-		byte_stream_copy_to_uint16_little_endian(
-		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->first_available_attribute_identifier,
-		 value_16bit );
-		libcnotify_printf(
-		 "%s: first available attribute identifier\t\t: %" PRIu16 "\n",
-		 function,
-		 value_16bit );
+/* Reads the MFT entry header from the MFT entry data
+ * The fixup values are applied to the MFT entry data
+ * Returns 1 if successful, 0 if empty or -1 on error
+ */
+int libfsntfs_mft_entry_read_header_data(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     uint32_t mft_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function                     = "libfsntfs_mft_entry_read_header_data";
+	size_t mft_entry_data_offset              = 0;
+	size_t mft_entry_fixup_offset             = 0;
+	size_t mft_entry_fixup_placeholder_offset = 0;
+	size_t unknown_data_size                  = 0;
+	uint16_t fixup_value_index                = 0;
+	uint16_t fixup_values_offset              = 0;
+	uint16_t number_of_fixup_values           = 0;
+	uint16_t total_entry_size                 = 0;
+	int result                                = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	size_t read_size                          = 0;
+	uint16_t value_16bit                      = 0;
+#endif
+
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT entry - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry->data_size < sizeof( fsntfs_mft_entry_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_mft_entry_check_for_empty_block(
+	          mft_entry->data,
+	          mft_entry->data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if MFT entry is empty.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->fixup_values_offset,
+	 fixup_values_offset );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( fixup_values_offset > 42 )
+		{
+			read_size = sizeof( fsntfs_mft_entry_header_t );
+		}
+		else
+		{
+			read_size = 42;
+		}
+		libcnotify_printf(
+		 "%s: MFT entry header data:\n",
+		 function );
+		libcnotify_print_data(
+		 mft_entry->data,
+		 read_size,
+		 0 );
+	}
+#endif
+	if( memory_compare(
+	     ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature,
+	     "BAAD",
+	     4 ) == 0 )
+	{
+/* TODO do empty block check on the remainder of the MFT entry? */
+		return( 0 );
+	}
+	if( memory_compare(
+	     ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature,
+	     fsntfs_mft_entry_signature,
+	     4 ) != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: invalid MFT entry signature.\n",
+			 function );
+		}
+#endif
+		mft_entry->is_corrupted = 1;
+
+/* TODO handle corruption */
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid MFT entry signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->number_of_fixup_values,
+	 number_of_fixup_values );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->journal_sequence_number,
+	 mft_entry->journal_sequence_number );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->sequence,
+	 mft_entry->sequence );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->reference_count,
+	 mft_entry->reference_count );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->attributes_offset,
+	 mft_entry->attributes_offset );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->flags,
+	 mft_entry->flags );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->used_entry_size,
+	 mft_entry->used_entry_size );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->total_entry_size,
+	 total_entry_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->base_record_file_reference,
+	 mft_entry->base_record_file_reference );
+
+	if( fixup_values_offset > 42 )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->index,
+		 mft_entry->index );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: signature\t\t\t\t\t: %c%c%c%c\n",
+		 function,
+		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature[ 0 ],
+		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature[ 1 ],
+		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature[ 2 ],
+		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->signature[ 3 ] );
+
+		libcnotify_printf(
+		 "%s: fixup values offset\t\t\t\t: %" PRIu16 "\n",
+		 function,
+		 fixup_values_offset );
+
+		libcnotify_printf(
+		 "%s: number of fixup values\t\t\t\t: %" PRIu16 "\n",
+		 function,
+		 number_of_fixup_values );
+
+		libcnotify_printf(
+		 "%s: journal sequence number\t\t\t: %" PRIu64 "\n",
+		 function,
+		 mft_entry->journal_sequence_number );
+
+		libcnotify_printf(
+		 "%s: sequence\t\t\t\t\t: %" PRIu16 "\n",
+		 function,
+		 mft_entry->sequence );
+
+		libcnotify_printf(
+		 "%s: reference count\t\t\t\t: %" PRIu16 "\n",
+		 function,
+		 mft_entry->reference_count );
+
+		libcnotify_printf(
+		 "%s: attributes offset\t\t\t\t: %" PRIu16 "\n",
+		 function,
+		 mft_entry->attributes_offset );
+
+		libcnotify_printf(
+		 "%s: flags\t\t\t\t\t\t: 0x%04" PRIx16 "\n",
+		 function,
+		 mft_entry->flags );
+		libfsntfs_debug_print_mft_entry_flags(
+		 mft_entry->flags );
+		libcnotify_printf(
+		 "\n" );
+
+		libcnotify_printf(
+		 "%s: used entry size\t\t\t\t: %" PRIu16 "\n",
+		 function,
+		 mft_entry->used_entry_size );
+
+		libcnotify_printf(
+		 "%s: total entry size\t\t\t\t: %" PRIu16 "\n",
+		 function,
+		 total_entry_size );
+
+		libcnotify_printf(
+		 "%s: base record file reference\t\t\t: MFT entry: %" PRIu64 ", sequence: %" PRIu64 "\n",
+		 function,
+		 mft_entry->base_record_file_reference & 0xffffffffffffUL,
+		 mft_entry->base_record_file_reference >> 48 );
+
+		byte_stream_copy_to_uint16_little_endian(
+		 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->first_available_attribute_identifier,
+		 value_16bit );
+		libcnotify_printf(
+		 "%s: first available attribute identifier\t\t: %" PRIu16 "\n",
+		 function,
+		 value_16bit );
+
+		if( fixup_values_offset > 42 )
+		{
+			byte_stream_copy_to_uint16_little_endian(
+			 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->unknown1,
+			 value_16bit );
+			libcnotify_printf(
+			 "%s: unknown1\t\t\t\t\t: 0x%04" PRIu16 "\n",
+			 function,
+			 value_16bit );
+
+			libcnotify_printf(
+			 "%s: index\t\t\t\t\t\t: %" PRIu32 "\n",
+			 function,
+			 mft_entry->index );
+		}
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( fixup_values_offset > 42 )
+	{
+		mft_entry_data_offset += sizeof( fsntfs_mft_entry_header_t );
+	}
+	else
+	{
+		mft_entry_data_offset += 42;
+	}
+	if( mft_entry->index != mft_entry_index )
+	{
+		mft_entry->index = mft_entry_index;
+	}
+	if( ( mft_entry->attributes_offset < sizeof( fsntfs_mft_entry_header_t ) )
+	 || ( mft_entry->attributes_offset >= mft_entry->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: attributes offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( mft_entry->data_size != (size_t) total_entry_size )
+		{
+			libcnotify_printf(
+			 "%s: mismatch in total MFT entry size (calculated: %" PRIzd ", stored: %" PRIu16 ").\n",
+			 function,
+			 mft_entry->data_size,
+			 total_entry_size );
+		}
+	}
+#endif
+	if( number_of_fixup_values > 0 )
+	{
+		/* In NT4 the fixup values offset can point to wfixupPattern
+		 */
+		if( ( fixup_values_offset < 42 )
+		 || ( fixup_values_offset >= mft_entry->data_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: fixup values offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( fixup_values_offset > mft_entry->attributes_offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: fixup values offset exceeds attributes offset.",
+			 function );
+
+			return( -1 );
+		}
+		if( mft_entry_data_offset < fixup_values_offset )
+		{
+			unknown_data_size = (size_t) fixup_values_offset - mft_entry_data_offset;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unknown data:\n",
+				 function );
+				libcnotify_print_data(
+				 &( mft_entry->data[ mft_entry_data_offset ] ),
+				 unknown_data_size,
+				 0 );
+			}
+#endif
+			mft_entry_data_offset += unknown_data_size;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: fixup values data:\n",
+			 function );
+			libcnotify_print_data(
+			 &( mft_entry->data[ mft_entry_data_offset ] ),
+			 2 + ( number_of_fixup_values * 2 ),
+			 0 );
+		}
+#endif
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			byte_stream_copy_to_uint16_little_endian(
+			 &( mft_entry->data[ mft_entry_data_offset ] ),
+			 value_16bit );
+			libcnotify_printf(
+			 "%s: fixup placeholder value\t\t\t: 0x%04" PRIx16 "\n",
+			 function,
+			 value_16bit );
+		}
+#endif
+		mft_entry_fixup_placeholder_offset = mft_entry_data_offset;
+
+		mft_entry_data_offset += 2;
+
+		mft_entry_fixup_offset = io_handle->bytes_per_sector - 2;
+
+		for( fixup_value_index = 0;
+		     fixup_value_index < number_of_fixup_values;
+		     fixup_value_index++ )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				byte_stream_copy_to_uint16_little_endian(
+				 &( mft_entry->data[ mft_entry_data_offset ] ),
+				 value_16bit );
+				libcnotify_printf(
+				 "%s: fixup value: %" PRIu16 "\t\t\t\t\t: 0x%04" PRIx16 "\n",
+				 function,
+				 fixup_value_index,
+				 value_16bit );
+			}
+#endif
+			if( mft_entry_fixup_offset < mft_entry->data_size )
+			{
+				if( ( mft_entry->data[ mft_entry_fixup_offset ] != mft_entry->data[ mft_entry_fixup_placeholder_offset ] )
+				 && ( mft_entry->data[ mft_entry_fixup_offset + 1 ] != mft_entry->data[ mft_entry_fixup_placeholder_offset + 1 ] ) )
+				{
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						byte_stream_copy_to_uint16_little_endian(
+						 &( mft_entry->data[ mft_entry_fixup_offset ] ),
+						 value_16bit );
+						libcnotify_printf(
+						 "%s: corruption detected - mismatch between placeholder and value at offset: %" PRIzd " (0x%04" PRIx16 ")\n",
+						 function,
+						 mft_entry_fixup_offset,
+						 value_16bit );
+					}
+#endif
+/* TODO handle error */
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: applying fixup value: %" PRIu16 "\t\t\t: (offset: %" PRIzd ") 0x%02" PRIx8 "%02" PRIx8 " => (offset: %" PRIzd ") 0x%02" PRIx8 "%02" PRIx8 "\n",
+					 function,
+					 fixup_value_index,
+					 mft_entry_fixup_offset,
+					 mft_entry->data[ mft_entry_fixup_offset + 1 ],
+					 mft_entry->data[ mft_entry_fixup_offset ],
+					 mft_entry_data_offset,
+					 mft_entry->data[ mft_entry_data_offset + 1 ],
+					 mft_entry->data[ mft_entry_data_offset ] );
+				}
+#endif
+				mft_entry->data[ mft_entry_fixup_offset ]     = mft_entry->data[ mft_entry_data_offset ];
+				mft_entry->data[ mft_entry_fixup_offset + 1 ] = mft_entry->data[ mft_entry_data_offset + 1 ];
+			}
+			mft_entry_data_offset  += 2;
+			mft_entry_fixup_offset += io_handle->bytes_per_sector;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( mft_entry_data_offset < mft_entry->attributes_offset )
+		{
+			libcnotify_printf(
+			 "%s: unknown data:\n",
+			 function );
+			libcnotify_print_data(
+			 &( mft_entry->data[ mft_entry_data_offset ] ),
+			 (size_t) mft_entry->attributes_offset - mft_entry_data_offset,
+			 0 );
+		}
+	}
+#endif
+	return( 1 );
+}
+
+/* Determines if reading the attributes of the MFT entry can require file IO
+ * This is the case for attribute lists and non-resident attribute values that are read
+ * when the attributes are read. Should be called after the header was read
+ * Returns 1 if file IO can be required, 0 if not or -1 on error
+ */
+int libfsntfs_mft_entry_attributes_require_file_io(
+     libfsntfs_mft_entry_t *mft_entry,
+     libcerror_error_t **error )
+{
+	static char *function         = "libfsntfs_mft_entry_attributes_require_file_io";
+	size_t attributes_data_offset = 0;
+	uint32_t attribute_size       = 0;
+	uint32_t attribute_type       = 0;
+	uint8_t non_resident_flag     = 0;
+
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT entry - missing data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	/* The debug output reads the values of additional attributes
+	 */
+	if( libcnotify_verbose != 0 )
+	{
+		return( 1 );
+	}
+#endif
+	attributes_data_offset = (size_t) mft_entry->attributes_offset;
+
+	while( ( attributes_data_offset + sizeof( fsntfs_mft_attribute_header_t ) ) <= mft_entry->data_size )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fsntfs_mft_attribute_header_t *) &( mft_entry->data[ attributes_data_offset ] ) )->type,
+		 attribute_type );
+
+		if( attribute_type == LIBFSNTFS_ATTRIBUTE_TYPE_END_OF_ATTRIBUTES )
+		{
+			return( 0 );
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fsntfs_mft_attribute_header_t *) &( mft_entry->data[ attributes_data_offset ] ) )->size,
+		 attribute_size );
+
+		non_resident_flag = ( (fsntfs_mft_attribute_header_t *) &( mft_entry->data[ attributes_data_offset ] ) )->non_resident_flag;
+
+		if( attribute_type == LIBFSNTFS_ATTRIBUTE_TYPE_ATTRIBUTE_LIST )
+		{
+			return( 1 );
+		}
+		if( ( ( non_resident_flag & 0x01 ) != 0 )
+		 && ( attribute_type != LIBFSNTFS_ATTRIBUTE_TYPE_BITMAP )
+		 && ( attribute_type != LIBFSNTFS_ATTRIBUTE_TYPE_DATA )
+		 && ( attribute_type != LIBFSNTFS_ATTRIBUTE_TYPE_INDEX_ALLOCATION ) )
+		{
+			return( 1 );
+		}
+		/* Leave corrupted attributes to libfsntfs_mft_entry_read_attributes
+		 */
+		if( ( attribute_size < sizeof( fsntfs_mft_attribute_header_t ) )
+		 || ( attribute_size > ( mft_entry->data_size - attributes_data_offset ) ) )
+		{
+			return( 1 );
+		}
+		attributes_data_offset += attribute_size;
+	}
+	return( 1 );
+}
+
+/* Reads attributes
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_entry_read_attributes(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *mft_entry_vector,
+     libfcache_cache_t *mft_entry_cache,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *attribute_list = NULL;
+	libfsntfs_attribute_t *attribute = NULL;
+	static char *function            = "libfsntfs_mft_entry_read_attributes";
+	size_t attributes_data_offset    = 0;
+	ssize_t read_count               = 0;
+	uint32_t attribute_type          = 0;
+
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT entry - missing data.",
+		 function );
+
+		goto on_error;
+	}
+	if( mft_entry->data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mft_entry->attributes_offset < sizeof( fsntfs_mft_entry_header_t ) )
+	 || ( mft_entry->attributes_offset >= mft_entry->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry - attributes offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	attributes_data_offset = mft_entry->attributes_offset;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( mft_entry->data[ attributes_data_offset ] ),
+	 attribute_type );
+
+	while( attribute_type != LIBFSNTFS_ATTRIBUTE_TYPE_END_OF_ATTRIBUTES )
+	{
+		if( libfsntfs_attribute_initialize(
+		     &attribute,
+		     mft_entry->arena,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create attribute.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libfsntfs_attribute_read_from_mft(
+			      attribute,
+			      io_handle,
+			      mft_entry->data,
+			      mft_entry->data_size,
+			      attributes_data_offset,
+			      flags,
+			      error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read attribute.",
+			 function );
+
+			goto on_error;
+		}
+		attributes_data_offset += read_count;
+
+		if( libfsntfs_attribute_get_type(
+		     attribute,
+		     &attribute_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve attribute type.",
+			 function );
+
+			goto on_error;
+		}
+		if( attribute_type == LIBFSNTFS_ATTRIBUTE_TYPE_ATTRIBUTE_LIST )
+		{
+			if( libcdata_array_initialize(
+			     &attribute_list,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create attribute list array.",
+				 function );
+
+				goto on_error;
+			}
+/* TODO if flag is set mark file entry as in complete ? */
+			if( ( flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) == 0 )
+			{
+				if( libfsntfs_attribute_list_read_from_attribute(
+				     attribute_list,
+				     io_handle,
+				     file_io_handle,
+				     attribute,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read attribute list.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( libfsntfs_mft_entry_append_attribute(
+		     mft_entry,
+		     io_handle,
+		     file_io_handle,
+		     attribute,
+		     flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append attribute.",
+			 function );
+
+			/* Prevent a double free of the attribute */
+			attribute = NULL;
+
+			goto on_error;
+		}
+		attribute = NULL;
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( mft_entry->data[ attributes_data_offset ] ),
+		 attribute_type );
+	}
+	attributes_data_offset += 4;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( attributes_data_offset != (size_t) mft_entry->used_entry_size )
+		{
+			libcnotify_printf(
+			 "%s: mismatch in used MFT entry size (calculated: %" PRIzd ", stored: %" PRIu16 ").\n",
+			 function,
+			 attributes_data_offset,
+			 mft_entry->used_entry_size );
+		}
+	}
+#endif
+	if( attribute_list != NULL )
+	{
+		if( libfsntfs_mft_entry_read_attributes_from_attribute_list(
+		     mft_entry,
+		     io_handle,
+		     file_io_handle,
+		     mft_entry_vector,
+		     mft_entry_cache,
+		     attribute_list,
+		     flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read attributes from attribute list.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_free(
+		     &attribute_list,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_internal_attribute_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free attribute list array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( attribute_list != NULL )
+	{
+		libcdata_array_free(
+		 &attribute_list,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_internal_attribute_free,
+		 NULL );
+	}
+	if( attribute != NULL )
+	{
+		libfsntfs_internal_attribute_free(
+		 (libfsntfs_internal_attribute_t **) &attribute,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 mft_entry->index_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_index_free,
+	 NULL );
+
+	mft_entry->i30_index = NULL;
+	mft_entry->sii_index = NULL;
+
+	libcdata_array_empty(
+	 mft_entry->alternate_data_attributes_array,
+	 NULL,
+	 NULL );
+
+	libcdata_array_empty(
+	 mft_entry->attributes_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_internal_attribute_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads the attributes of an extension MFT entry into its base MFT entry
+ * The attributes are read from the data of the extension MFT entry, since the
+ * extension MFT entry can be shared by the MFT entry cache it is not changed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_entry_read_attributes_from_extension_entry(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_mft_entry_t *extension_mft_entry,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	libfsntfs_attribute_t *attribute = NULL;
+	static char *function            = "libfsntfs_mft_entry_read_attributes_from_extension_entry";
+	size_t attributes_data_offset    = 0;
+	ssize_t read_count               = 0;
+	uint32_t attribute_type          = 0;
+
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( extension_mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extension MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( extension_mft_entry->is_empty != 0 )
+	{
+		return( 1 );
+	}
+	if( extension_mft_entry->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extension MFT entry - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extension_mft_entry->attributes_offset < sizeof( fsntfs_mft_entry_header_t ) )
+	 || ( extension_mft_entry->attributes_offset >= extension_mft_entry->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extension MFT entry - attributes offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	attributes_data_offset = extension_mft_entry->attributes_offset;
+
+	while( ( attributes_data_offset + 4 ) <= extension_mft_entry->data_size )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( extension_mft_entry->data[ attributes_data_offset ] ),
+		 attribute_type );
+
+		if( attribute_type == LIBFSNTFS_ATTRIBUTE_TYPE_END_OF_ATTRIBUTES )
+		{
+			break;
+		}
+		if( libfsntfs_attribute_initialize(
+		     &attribute,
+		     mft_entry->arena,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create attribute.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libfsntfs_attribute_read_from_mft(
+			      attribute,
+			      io_handle,
+			      extension_mft_entry->data,
+			      extension_mft_entry->data_size,
+			      attributes_data_offset,
+			      flags,
+			      error );
+
+		if( read_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read attribute.",
+			 function );
+
+			goto on_error;
+		}
+		attributes_data_offset += read_count;
+
+/* TODO convert attribute list attributes into readable attributes */
+		if( libfsntfs_mft_entry_append_attribute(
+		     mft_entry,
+		     io_handle,
+		     file_io_handle,
+		     attribute,
+		     flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append attribute.",
+			 function );
+
+			/* Prevent a double free of the attribute */
+			attribute = NULL;
+
+			goto on_error;
+		}
+		attribute = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( attribute != NULL )
+	{
+		libfsntfs_internal_attribute_free(
+		 (libfsntfs_internal_attribute_t **) &attribute,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads consecutive extension MFT entries with a single read
+ * The attributes of the extension MFT entries are read into the base MFT entry
+ * and the extension MFT entries are stored in the MFT entry cache
+ * Only the MFT entries stored in the same MFT data run as the first MFT entry are read
+ * No MFT entries are read if the first MFT entry is already stored in the MFT entry cache
+ * Returns the number of MFT entries read or -1 on error
+ */
+int libfsntfs_mft_entry_read_extension_entries(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *mft_entry_vector,
+     libfcache_cache_t *mft_entry_cache,
+     uint64_t first_mft_entry_index,
+     int number_of_mft_entries,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value       = NULL;
+	libfsntfs_mft_entry_t *extension_mft_entry = NULL;
+	uint8_t *data                              = NULL;
+	static char *function                      = "libfsntfs_mft_entry_read_extension_entries";
+	size64_t mft_entry_size                    = 0;
+	size64_t segment_size                      = 0;
+	size_t data_offset                         = 0;
+	size_t data_size                           = 0;
+	ssize_t read_count                         = 0;
+	time_t cache_value_timestamp               = 0;
+	off64_t cache_value_offset                 = 0;
+	off64_t mft_offset                         = 0;
+	off64_t segment_offset                     = 0;
+	uint64_t mft_entry_index                   = 0;
+	uint32_t segment_flags                     = 0;
+	int cache_value_file_index                 = -1;
+	int entry_index                            = 0;
+	int number_of_cache_entries                = 0;
+	int number_of_segments                     = 0;
+	int segment_file_index                     = 0;
+	int segment_index                          = 0;
+
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_mft_entries <= 0 )
+	 || ( number_of_mft_entries > LIBFSNTFS_MAXIMUM_NUMBER_OF_EXTENSION_MFT_ENTRIES_PER_READ ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of MFT entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_mft_entry_index > (uint64_t) ( INT_MAX - number_of_mft_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first MFT entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_vector_get_element_data_size(
+	     mft_entry_vector,
+	     &mft_entry_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( mft_entry_size == 0 )
+	 || ( mft_entry_size != (size64_t) io_handle->mft_entry_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_get_number_of_segments(
+	     mft_entry_vector,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of MFT entry vector segments.",
+		 function );
+
+		goto on_error;
+	}
+	/* Map the first MFT entry index onto the data runs of the MFT
+	 */
+	mft_offset = (off64_t) ( first_mft_entry_index * mft_entry_size );
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libfdata_vector_get_segment_by_index(
+		     mft_entry_vector,
+		     segment_index,
+		     &segment_file_index,
+		     &segment_offset,
+		     &segment_size,
+		     &segment_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry vector segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( (size64_t) mft_offset < segment_size )
+		{
+			break;
+		}
+		mft_offset -= (off64_t) segment_size;
+	}
+	if( segment_index >= number_of_segments )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry: %" PRIu64 " offset value out of bounds.",
+		 function,
+		 first_mft_entry_index );
+
+		goto on_error;
+	}
+	if( ( (size64_t) number_of_mft_entries * mft_entry_size ) > ( segment_size - (size64_t) mft_offset ) )
+	{
+		number_of_mft_entries = (int) ( ( segment_size - (size64_t) mft_offset ) / mft_entry_size );
+	}
+	if( number_of_mft_entries == 0 )
+	{
+		return( 0 );
+	}
+	/* The MFT entry vector stores an element in the cache entry of its element index
+	 * identified by the offset of its data, this is checked without counting a lookup
+	 */
+	if( libfcache_cache_get_number_of_entries(
+	     mft_entry_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of MFT entry cache entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_cache_entries > 0 )
+	{
+		if( libfcache_cache_get_value_by_index(
+		     mft_entry_cache,
+		     (int) ( first_mft_entry_index % (uint64_t) number_of_cache_entries ),
+		     &cache_value,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry cache value.",
+			 function );
+
+			goto on_error;
+		}
+		if( cache_value != NULL )
+		{
+			if( libfcache_cache_value_get_identifier(
+			     cache_value,
+			     &cache_value_file_index,
+			     &cache_value_offset,
+			     &cache_value_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve MFT entry cache value identifier.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( cache_value_file_index == segment_file_index )
+			 && ( cache_value_offset == ( segment_offset + mft_offset ) ) )
+			{
+				return( 0 );
+			}
+		}
+	}
+	data_size = (size_t) number_of_mft_entries * (size_t) mft_entry_size;
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading %d extension MFT entries at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 number_of_mft_entries,
+		 segment_offset + mft_offset,
+		 segment_offset + mft_offset );
+	}
+#endif
+	read_count = libfsntfs_io_handle_read_buffer_at_offset(
+	              io_handle,
+	              file_io_handle,
+	              data,
+	              data_size,
+	              segment_offset + mft_offset,
+	              error );
+
+	if( read_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entries data.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_mft_entries;
+	     entry_index++ )
+	{
+		mft_entry_index = first_mft_entry_index + entry_index;
+
+		if( libfsntfs_io_handle_update_cache_statistics(
+		     io_handle,
+		     LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+		     1,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update cache statistics.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_mft_entry_initialize(
+		     &extension_mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create extension MFT entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_mft_entry_read_data(
+		     extension_mft_entry,
+		     io_handle,
+		     file_io_handle,
+		     mft_entry_vector,
+		     mft_entry_cache,
+		     &( data[ data_offset ] ),
+		     (size_t) mft_entry_size,
+		     (uint32_t) mft_entry_index,
+		     flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		data_offset += (size_t) mft_entry_size;
+
+		if( libfsntfs_mft_entry_read_attributes_from_extension_entry(
+		     mft_entry,
+		     io_handle,
+		     file_io_handle,
+		     extension_mft_entry,
+		     flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read attributes from MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		if( libfdata_vector_set_element_value_by_index(
+		     mft_entry_vector,
+		     (intptr_t *) file_io_handle,
+		     mft_entry_cache,
+		     (int) mft_entry_index,
+		     (intptr_t *) extension_mft_entry,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_mft_entry_free,
+		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set MFT entry: %" PRIu64 " in cache.",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		extension_mft_entry = NULL;
+	}
+	memory_free(
+	 data );
+
+	return( number_of_mft_entries );
+
+on_error:
+	if( extension_mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &extension_mft_entry,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Reads attributes from an attribute list
+ * The extension MFT entries are retrieved in ascending MFT entry index order using the MFT entry cache.
+ * Consecutive extension MFT entries are read with a single read, unless the first one is already cached.
+ * The caller must hold the cache mutex of the IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_entry_read_attributes_from_attribute_list(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *mft_entry_vector,
+     libfcache_cache_t *mft_entry_cache,
+     libcdata_array_t *attribute_list,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *list_mft_entry_array   = NULL;
+	libfsntfs_attribute_t *list_attribute    = NULL;
+	libfsntfs_mft_entry_t *list_mft_entry    = NULL;
+	static char *function                    = "libfsntfs_mft_entry_read_attributes_from_attribute_list";
+	uint64_t consecutive_mft_entry_index     = 0;
+	uint64_t list_mft_entry_index            = 0;
+	uint64_t next_mft_entry_index            = 0;
+	uint16_t sequence_number                 = 0;
+	int entry_index                          = 0;
+	int list_attribute_index                 = 0;
+	int number_of_consecutive_entries        = 0;
+	int number_of_list_attributes            = 0;
+	int read_count                           = 0;
+
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     attribute_list,
+	     &number_of_list_attributes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of attribute list entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &list_mft_entry_array,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list MFT entry array.",
+		 function );
+
+		goto on_error;
+	}
+	for( list_attribute_index = 0;
+	     list_attribute_index < number_of_list_attributes;
+	     list_attribute_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     attribute_list,
+		     list_attribute_index,
+		     (intptr_t **) &list_attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve attribute list entry: %d.",
+			 function,
+			 list_attribute_index );
+
+			goto on_error;
+		}
+		if( libfsntfs_attribute_get_file_reference(
+		     list_attribute,
+		     &list_mft_entry_index,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve attribute list entry: %d file reference.",
+			 function,
+			 list_attribute_index );
+
+			goto on_error;
+		}
+		/* Ignore the current MFT entry
+		 */
+		if( list_mft_entry_index == (uint64_t) mft_entry->index )
+		{
+			continue;
+		}
+		if( libcdata_array_insert_entry(
+		     list_mft_entry_array,
+		     &entry_index,
+		     (intptr_t *) list_attribute,
+		     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libfsntfs_attribute_compare_by_file_reference,
+		     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert list attribute in list MFT entry array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Read the list MFT entries
+	 */
+	if( libcdata_array_get_number_of_entries(
+	     list_mft_entry_array,
+	     &number_of_list_attributes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of list MFT entries.",
+		 function );
+
+		goto on_error;
+	}
+	list_attribute_index = 0;
+
+	while( list_attribute_index < number_of_list_attributes )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     list_mft_entry_array,
+		     list_attribute_index,
+		     (intptr_t **) &list_attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve list attribute: %d.",
+			 function,
+			 list_attribute_index );
+
+			goto on_error;
+		}
+		if( libfsntfs_attribute_get_file_reference(
+		     list_attribute,
+		     &list_mft_entry_index,
+		     &sequence_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve list attribute: %d file reference.",
+			 function,
+			 list_attribute_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: data file reference: MFT entry: %" PRIu64 ", sequence: %" PRIu16 "\n",
+			 function,
+			 list_mft_entry_index,
+			 sequence_number );
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+		if( list_mft_entry_index > (uint64_t) INT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: list MFT entry reference value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		/* Extension MFT entries are commonly allocated consecutively, the consecutive
+		 * MFT entries are read with a single read unless the first one is cached
+		 */
+		next_mft_entry_index          = list_mft_entry_index + 1;
+		number_of_consecutive_entries = 1;
+
+		while( ( ( list_attribute_index + number_of_consecutive_entries ) < number_of_list_attributes )
+		    && ( number_of_consecutive_entries < LIBFSNTFS_MAXIMUM_NUMBER_OF_EXTENSION_MFT_ENTRIES_PER_READ ) )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     list_mft_entry_array,
+			     list_attribute_index + number_of_consecutive_entries,
+			     (intptr_t **) &list_attribute,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve list attribute: %d.",
+				 function,
+				 list_attribute_index + number_of_consecutive_entries );
+
+				goto on_error;
+			}
+			if( libfsntfs_attribute_get_file_reference(
+			     list_attribute,
+			     &consecutive_mft_entry_index,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve list attribute: %d file reference.",
+				 function,
+				 list_attribute_index + number_of_consecutive_entries );
+
+				goto on_error;
+			}
+			if( consecutive_mft_entry_index != next_mft_entry_index )
+			{
+				break;
+			}
+			next_mft_entry_index++;
+
+			number_of_consecutive_entries++;
+		}
+		if( number_of_consecutive_entries > 1 )
+		{
+			read_count = libfsntfs_mft_entry_read_extension_entries(
+			              mft_entry,
+			              io_handle,
+			              file_io_handle,
+			              mft_entry_vector,
+			              mft_entry_cache,
+			              list_mft_entry_index,
+			              number_of_consecutive_entries,
+			              flags,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read extension MFT entries.",
+				 function );
+
+				goto on_error;
+			}
+			if( read_count > 0 )
+			{
+				list_attribute_index += read_count;
+
+				continue;
+			}
+		}
+		if( libfsntfs_io_handle_update_cache_statistics(
+		     io_handle,
+		     LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+		     1,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update cache statistics.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_vector_get_element_value_by_index(
+		     mft_entry_vector,
+		     (intptr_t *) file_io_handle,
+		     mft_entry_cache,
+		     (int) list_mft_entry_index,
+		     (intptr_t **) &list_mft_entry,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+			 function,
+			 list_mft_entry_index );
+
+			goto on_error;
+		}
+		if( list_mft_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing MFT entry: %" PRIu64 ".",
+			 function,
+			 list_mft_entry_index );
+
+			goto on_error;
+		}
+		/* The list MFT entry is owned by the MFT entry cache and can be evicted
+		 * by the next read, hence its attributes are read before continuing
+		 */
+		if( libfsntfs_mft_entry_read_attributes_from_extension_entry(
+		     mft_entry,
+		     io_handle,
+		     file_io_handle,
+		     list_mft_entry,
+		     flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read attributes from MFT entry: %" PRIu64 ".",
+			 function,
+			 list_mft_entry_index );
+
+			goto on_error;
+		}
+		list_mft_entry = NULL;
+
+		list_attribute_index++;
+	}
+	if( libcdata_array_free(
+	     &list_mft_entry_array,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free list MFT entry array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( list_mft_entry_array != NULL )
+	{
+		libcdata_array_free(
+		 &list_mft_entry_array,
+		 NULL,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the MFT entry directory entry index if available
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_entry_read_directory_entries_tree(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcdata_btree_t *directory_entries_tree,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *upper_node                      = NULL;
+	libfsntfs_directory_entry_t *directory_entry          = NULL;
+	libfsntfs_directory_entry_t *existing_directory_entry = NULL;
+	libfsntfs_file_name_values_t *file_name_values        = NULL;
+	libfsntfs_index_value_t *index_value                  = NULL;
+	static char *function                                 = "libfsntfs_mft_entry_read_directory_entries_tree";
+	uint8_t file_name_namespace                           = 0;
+	int index_value_entry                                 = 0;
+	int number_of_index_values                            = 0;
+	int result                                            = 0;
+	int value_index                                       = 0;
+
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) != 0 )
+	{
+		return( 1 );
+	}
+	if( mft_entry->i30_index == NULL )
+	{
+		return( 1 );
+	}
+	if( libfsntfs_index_read(
+	     mft_entry->i30_index,
+	     io_handle,
+	     file_io_handle,
+	     flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read $I30 index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_index_get_number_of_index_values(
+	     mft_entry->i30_index,
+	     &number_of_index_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of $I30 index values.",
+		 function );
+
+		goto on_error;
+	}
+	for( index_value_entry = 0;
+	     index_value_entry < number_of_index_values;
+	     index_value_entry++ )
+	{
+		if( libfsntfs_index_get_index_value_by_index(
+		     mft_entry->i30_index,
+		     file_io_handle,
+		     index_value_entry,
+		     &index_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve $I30 index value: %d.",
+			 function,
+			 index_value_entry );
+
+			goto on_error;
+		}
+		if( libfsntfs_file_name_values_initialize(
+		     &file_name_values,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file name values.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: index value: %03d file reference: MFT entry: %" PRIu64 ", sequence: %" PRIu64 "\n",
+			 function,
+			 index_value_entry,
+			 index_value->file_reference & 0xffffffffffffUL,
+			 index_value->file_reference >> 48 );
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+		if( libfsntfs_file_name_values_read(
+		     file_name_values,
+		     index_value->data,
+		     (size_t) index_value->data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file name values.",
+			 function );
+
+			goto on_error;
+		}
+		if( file_name_values->name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid file name values - missing name.",
+			 function );
+
+			goto on_error;
+		}
+		/* Ignore the file name with the . as its name
+		 */
+		if( ( file_name_values->name_size == 2 )
+		 && ( file_name_values->name[ 0 ] == 0x2e )
+		 && ( file_name_values->name[ 1 ] == 0x00 ) )
+		{
+			if( libfsntfs_file_name_values_free(
+			     &file_name_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file name values.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		file_name_namespace = file_name_values->name_namespace;
+
+		if( libfsntfs_directory_entry_initialize(
+		     &directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create directory entry.",
+			 function );
+
+			goto on_error;
+		}
+		directory_entry->file_reference = index_value->file_reference;
+
+		if( file_name_namespace == LIBFSNTFS_FILE_NAME_NAMESPACE_DOS )
+		{
+			directory_entry->short_file_name_values = file_name_values;
+		}
+		else
+		{
+			directory_entry->file_name_values = file_name_values;
+		}
+		file_name_values = NULL;
+
+		result = libcdata_btree_insert_value(
+			  directory_entries_tree,
+			  &value_index,
+			  (intptr_t *) directory_entry,
+			  (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libfsntfs_directory_entry_compare,
+			  &upper_node,
+			  (intptr_t **) &existing_directory_entry,
+			  error ) ;
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert directory entry into tree.",
+			 function );
 
-		if( fixup_values_offset > 42 )
+			goto on_error;
+		}
+		else if( result == 0 )
 		{
-			byte_stream_copy_to_uint16_little_endian(
-			 ( (fsntfs_mft_entry_header_t *) mft_entry->data )->unknown1,
-			 value_16bit );
-			libcnotify_printf(
-			 "%s: unknown1\t\t\t\t\t: 0x%04" PRIu16 "\n",
-			 function,
-			 value_16bit );
+			if( existing_directory_entry == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing existing directory entry.",
+				 function );
 
-			libcnotify_printf(
-			 "%s: index\t\t\t\t\t\t: %" PRIu32 "\n",
-			 function,
-			 mft_entry->index );
+				goto on_error;
+			}
+			if( file_name_namespace == LIBFSNTFS_FILE_NAME_NAMESPACE_DOS )
+			{
+				if( existing_directory_entry->short_file_name_values == NULL )
+				{
+					existing_directory_entry->short_file_name_values = directory_entry->short_file_name_values;
+					directory_entry->short_file_name_values          = NULL;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				else if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: short file name of existing directory entry already set.\n",
+					 function );
+				}
+#endif
+			}
+			else
+			{
+				if( existing_directory_entry->file_name_values == NULL )
+				{
+					existing_directory_entry->file_name_values = directory_entry->file_name_values;
+					directory_entry->file_name_values          = NULL;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				else if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: file name of existing directory entry already set.\n",
+					 function );
+				}
+#endif
+			}
+			if( libfsntfs_directory_entry_free(
+			     &directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free directory entry.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		libcnotify_printf(
-		 "\n" );
+		directory_entry = NULL;
 	}
-#endif
-	if( fixup_values_offset > 42 )
+	return( 1 );
+
+on_error:
+	if( directory_entry != NULL )
 	{
-		mft_entry_data_offset += sizeof( fsntfs_mft_entry_header_t );
+		libfsntfs_directory_entry_free(
+		 &directory_entry,
+		 NULL );
 	}
-	else
+	if( file_name_values != NULL )
 	{
-		mft_entry_data_offset += 42;
+		libfsntfs_file_name_values_free(
+		 &file_name_values,
+		 NULL );
 	}
-	if( mft_entry->index != mft_entry_index )
+	return( -1 );
+}
+
+/* Retrieves the directory entry for an UTF-8 encoded name from an $I30 index node
+ * Only the sub nodes that can contain the name are read
+ * Names are compared case-insensitive if the upcase table is available. The first
+ * directory entry whose name only differs in case is kept in directory_entry,
+ * while the search continues for a name that also matches the case
+ * Returns 1 if a name that matches the case was found, 0 if not or -1 on error
+ */
+int libfsntfs_mft_entry_get_directory_entry_by_utf8_name_from_index_node(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcdata_array_t *node_index_values_array,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     int recursion_depth,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *sub_node_index_values_array  = NULL;
+	libfsntfs_file_name_values_t *file_name_values = NULL;
+	libfsntfs_index_value_t *index_value           = NULL;
+	static char *function                          = "libfsntfs_mft_entry_get_directory_entry_by_utf8_name_from_index_node";
+	int compare_result                             = 0;
+	int index_value_entry                          = 0;
+	int is_exact_match                             = 0;
+	int number_of_index_values                     = 0;
+	int result                                     = 0;
+
+	if( mft_entry == NULL )
 	{
-		mft_entry->index = mft_entry_index;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
 	}
-	if( ( mft_entry->attributes_offset < sizeof( fsntfs_mft_entry_header_t ) )
-	 || ( mft_entry->attributes_offset >= mft_entry->data_size ) )
+	if( directory_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: attributes offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( ( recursion_depth < 0 )
+	 || ( recursion_depth > LIBFSNTFS_MAXIMUM_RECURSION_DEPTH ) )
 	{
-		if( mft_entry->data_size != (size_t) total_entry_size )
-		{
-			libcnotify_printf(
-			 "%s: mismatch in total MFT entry size (calculated: %" PRIzd ", stored: %" PRIu16 ").\n",
-			 function,
-			 mft_entry->data_size,
-			 total_entry_size );
-		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid recursion depth value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-#endif
-	if( number_of_fixup_values > 0 )
+	if( libcdata_array_get_number_of_entries(
+	     node_index_values_array,
+	     &number_of_index_values,
+	     error ) != 1 )
 	{
-		/* In NT4 the fixup values offset can point to wfixupPattern
-		 */
-		if( ( fixup_values_offset < 42 )
-		 || ( fixup_values_offset >= mft_entry->data_size ) )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of node index values.",
+		 function );
+
+		goto on_error;
+	}
+	for( index_value_entry = 0;
+	     index_value_entry < number_of_index_values;
+	     index_value_entry++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     node_index_values_array,
+		     index_value_entry,
+		     (intptr_t **) &index_value,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: fixup values offset value out of bounds.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve node index value: %d.",
+			 function,
+			 index_value_entry );
 
 			goto on_error;
 		}
-		if( fixup_values_offset > mft_entry->attributes_offset )
+		if( index_value == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: fixup values offset exceeds attributes offset.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing node index value: %d.",
+			 function,
+			 index_value_entry );
 
 			goto on_error;
 		}
-		if( mft_entry_data_offset < fixup_values_offset )
+		/* The last index value does not contain a name but refers to the sub node
+		 * that contains the names greater than the preceding name
+		 */
+		if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_IS_LAST ) != 0 )
 		{
-			unknown_data_size = (size_t) fixup_values_offset - mft_entry_data_offset;
+			compare_result = LIBCDATA_COMPARE_GREATER;
+		}
+		else
+		{
+			if( libfsntfs_file_name_values_initialize(
+			     &file_name_values,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create file name values.",
+				 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
+				goto on_error;
+			}
+			if( libfsntfs_file_name_values_read(
+			     file_name_values,
+			     index_value->data,
+			     (size_t) index_value->data_size,
+			     error ) != 1 )
 			{
-				libcnotify_printf(
-				 "%s: unknown data:\n",
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read file name values.",
 				 function );
-				libcnotify_print_data(
-				 &( mft_entry->data[ mft_entry_data_offset ] ),
-				 unknown_data_size,
-				 0 );
+
+				goto on_error;
+			}
+			compare_result = libfsntfs_file_name_values_compare_name_with_utf8_string(
+			                  file_name_values,
+			                  utf8_string,
+			                  utf8_string_length,
+			                  error );
+
+			if( compare_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare UTF-8 string with file name values.",
+				 function );
+
+				goto on_error;
+			}
+			else if( compare_result == LIBCDATA_COMPARE_EQUAL )
+			{
+				if( io_handle->upcase_table != NULL )
+				{
+					result = libfsntfs_upcase_table_compare_name_with_utf8_string(
+					          io_handle->upcase_table,
+					          file_name_values->name,
+					          file_name_values->name_size,
+					          utf8_string,
+					          utf8_string_length,
+					          error );
+				}
+				else
+				{
+					result = libuna_utf8_string_compare_with_utf16_stream(
+					          utf8_string,
+					          utf8_string_length,
+					          file_name_values->name,
+					          file_name_values->name_size,
+					          LIBUNA_ENDIAN_LITTLE,
+					          error );
+				}
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to compare UTF-8 string with file name values.",
+					 function );
+
+					goto on_error;
+				}
+				/* Ignore the file name with the . as its name
+				 */
+				if( ( file_name_values->name_size == 2 )
+				 && ( file_name_values->name[ 0 ] == 0x2e )
+				 && ( file_name_values->name[ 1 ] == 0x00 ) )
+				{
+					result = 0;
+				}
+				if( result != 0 )
+				{
+					/* The upcase table comparison ignores case, a name that also
+					 * matches the case is preferred
+					 */
+					is_exact_match = 1;
+
+					if( io_handle->upcase_table != NULL )
+					{
+						is_exact_match = libuna_utf8_string_compare_with_utf16_stream(
+						                  utf8_string,
+						                  utf8_string_length,
+						                  file_name_values->name,
+						                  file_name_values->name_size,
+						                  LIBUNA_ENDIAN_LITTLE,
+						                  error );
+
+						if( is_exact_match == -1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_GENERIC,
+							 "%s: unable to compare UTF-8 string with file name values.",
+							 function );
+
+							goto on_error;
+						}
+					}
+					if( ( is_exact_match != 0 )
+					 || ( *directory_entry == NULL ) )
+					{
+						if( *directory_entry != NULL )
+						{
+							if( libfsntfs_directory_entry_free(
+							     directory_entry,
+							     error ) != 1 )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+								 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+								 "%s: unable to free directory entry.",
+								 function );
+
+								goto on_error;
+							}
+						}
+						if( libfsntfs_directory_entry_initialize(
+						     directory_entry,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+							 "%s: unable to create directory entry.",
+							 function );
+
+							goto on_error;
+						}
+						( *directory_entry )->file_reference = index_value->file_reference;
+
+						if( file_name_values->name_namespace == LIBFSNTFS_FILE_NAME_NAMESPACE_DOS )
+						{
+							( *directory_entry )->short_file_name_values = file_name_values;
+						}
+						else
+						{
+							( *directory_entry )->file_name_values = file_name_values;
+						}
+						file_name_values = NULL;
+
+						if( is_exact_match != 0 )
+						{
+							return( 1 );
+						}
+					}
+				}
+			}
+			if( libfsntfs_file_name_values_free(
+			     &file_name_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file name values.",
+				 function );
+
+				goto on_error;
 			}
-#endif
-			mft_entry_data_offset += unknown_data_size;
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( compare_result == LIBCDATA_COMPARE_LESS )
 		{
-			libcnotify_printf(
-			 "%s: fixup values data:\n",
-			 function );
-			libcnotify_print_data(
-			 &( mft_entry->data[ mft_entry_data_offset ] ),
-			 2 + ( number_of_fixup_values * 2 ),
-			 0 );
+			continue;
 		}
-#endif
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_HAS_SUB_NODE ) != 0 )
 		{
-			byte_stream_copy_to_uint16_little_endian(
-			 &( mft_entry->data[ mft_entry_data_offset ] ),
-			 value_16bit );
-			libcnotify_printf(
-			 "%s: fixup placeholder value\t\t\t: 0x%04" PRIx16 "\n",
-			 function,
-			 value_16bit );
-		}
-#endif
-		mft_entry_fixup_placeholder_offset = mft_entry_data_offset;
-
-		mft_entry_data_offset += 2;
-
-		mft_entry_fixup_offset = io_handle->bytes_per_sector - 2;
+			if( libfsntfs_index_read_sub_node(
+			     mft_entry->i30_index,
+			     io_handle,
+			     file_io_handle,
+			     index_value->sub_node_vcn,
+			     &sub_node_index_values_array,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sub node of node index value: %d.",
+				 function,
+				 index_value_entry );
 
-		for( fixup_value_index = 0;
-		     fixup_value_index < number_of_fixup_values;
-		     fixup_value_index++ )
-		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
+				goto on_error;
+			}
+			result = libfsntfs_mft_entry_get_directory_entry_by_utf8_name_from_index_node(
+			          mft_entry,
+			          io_handle,
+			          file_io_handle,
+			          sub_node_index_values_array,
+			          utf8_string,
+			          utf8_string_length,
+			          recursion_depth + 1,
+			          directory_entry,
+			          error );
+
+			if( result == -1 )
 			{
-				byte_stream_copy_to_uint16_little_endian(
-				 &( mft_entry->data[ mft_entry_data_offset ] ),
-				 value_16bit );
-				libcnotify_printf(
-				 "%s: fixup value: %" PRIu16 "\t\t\t\t\t: 0x%04" PRIx16 "\n",
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry from sub node of node index value: %d.",
 				 function,
-				 fixup_value_index,
-				 value_16bit );
+				 index_value_entry );
+
+				goto on_error;
 			}
-#endif
-			if( mft_entry_fixup_offset < mft_entry->data_size )
+			if( libcdata_array_free(
+			     &sub_node_index_values_array,
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_index_value_free,
+			     error ) != 1 )
 			{
-				if( ( mft_entry->data[ mft_entry_fixup_offset ] != mft_entry->data[ mft_entry_fixup_placeholder_offset ] )
-				 && ( mft_entry->data[ mft_entry_fixup_offset + 1 ] != mft_entry->data[ mft_entry_fixup_placeholder_offset + 1 ] ) )
-				{
-#if defined( HAVE_DEBUG_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						byte_stream_copy_to_uint16_little_endian(
-						 &( mft_entry->data[ mft_entry_fixup_offset ] ),
-						 value_16bit );
-						libcnotify_printf(
-						 "%s: corruption detected - mismatch between placeholder and value at offset: %" PRIzd " (0x%04" PRIx16 ")\n",
-						 function,
-						 mft_entry_fixup_offset,
-						 value_16bit );
-					}
-#endif
-/* TODO handle error */
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: applying fixup value: %" PRIu16 "\t\t\t: (offset: %" PRIzd ") 0x%02" PRIx8 "%02" PRIx8 " => (offset: %" PRIzd ") 0x%02" PRIx8 "%02" PRIx8 "\n",
-					 function,
-					 fixup_value_index,
-					 mft_entry_fixup_offset,
-					 mft_entry->data[ mft_entry_fixup_offset + 1 ],
-					 mft_entry->data[ mft_entry_fixup_offset ],
-					 mft_entry_data_offset,
-					 mft_entry->data[ mft_entry_data_offset + 1 ],
-					 mft_entry->data[ mft_entry_data_offset ] );
-				}
-#endif
-				mft_entry->data[ mft_entry_fixup_offset ]     = mft_entry->data[ mft_entry_data_offset ];
-				mft_entry->data[ mft_entry_fixup_offset + 1 ] = mft_entry->data[ mft_entry_data_offset + 1 ];
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub node index values array.",
+				 function );
+
+				goto on_error;
+			}
+			if( result != 0 )
+			{
+				return( 1 );
 			}
-			mft_entry_data_offset  += 2;
-			mft_entry_fixup_offset += io_handle->bytes_per_sector;
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "\n" );
 		}
-#endif
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		if( mft_entry_data_offset < mft_entry->attributes_offset )
+		/* Names that only differ in case can be stored on both sides of the index value
+		 */
+		if( compare_result == LIBCDATA_COMPARE_GREATER )
 		{
-			libcnotify_printf(
-			 "%s: unknown data:\n",
-			 function );
-			libcnotify_print_data(
-			 &( mft_entry->data[ mft_entry_data_offset ] ),
-			 (size_t) mft_entry->attributes_offset - mft_entry_data_offset,
-			 0 );
+			break;
 		}
 	}
-#endif
-	return( 1 );
+	return( 0 );
 
 on_error:
-	if( mft_entry->data != NULL )
+	if( *directory_entry != NULL )
 	{
-		memory_free(
-		 mft_entry->data );
-
-		mft_entry->data = NULL;
+		libfsntfs_directory_entry_free(
+		 directory_entry,
+		 NULL );
+	}
+	if( sub_node_index_values_array != NULL )
+	{
+		libcdata_array_free(
+		 &sub_node_index_values_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_index_value_free,
+		 NULL );
+	}
+	if( file_name_values != NULL )
+	{
+		libfsntfs_file_name_values_free(
+		 &file_name_values,
+		 NULL );
 	}
-	mft_entry->data_size = 0;
-
 	return( -1 );
 }
 
-/* Reads attributes
- * Returns 1 if successful or -1 on error
+/* Retrieves the directory entry for an UTF-8 encoded name from the $I30 index
+ * Only the index nodes that can contain the name are read instead of the entire index.
+ * The directory entries tree is read instead if the name matches a short (DOS) name,
+ * which does not have the corresponding long name, or if the name contains non-ASCII
+ * characters and was not found, since their collation depends on the $UpCase table
+ * Returns 1 if successful, 0 if no such directory entry or -1 on error
  */
-int libfsntfs_mft_entry_read_attributes(
+int libfsntfs_mft_entry_get_directory_entry_by_utf8_name(
      libfsntfs_mft_entry_t *mft_entry,
      libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
-     libfdata_vector_t *mft_entry_vector,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
      uint8_t flags,
+     libfsntfs_directory_entry_t **directory_entry,
      libcerror_error_t **error )
 {
-	libcdata_array_t *attribute_list = NULL;
-	libfsntfs_attribute_t *attribute = NULL;
-	static char *function            = "libfsntfs_mft_entry_read_attributes";
-	size_t attributes_data_offset    = 0;
-	ssize_t read_count               = 0;
-	uint32_t attribute_type          = 0;
+	libcdata_btree_t *directory_entries_tree          = NULL;
+	libfsntfs_directory_entry_t *tree_directory_entry = NULL;
+	static char *function                             = "libfsntfs_mft_entry_get_directory_entry_by_utf8_name";
+	size_t utf8_string_index                          = 0;
+	uint8_t read_tree                                 = 0;
+	int result                                        = 0;
 
 	if( mft_entry == NULL )
 	{
@@ -998,272 +3381,269 @@ int libfsntfs_mft_entry_read_attributes(
 
 		return( -1 );
 	}
-	if( mft_entry->data == NULL )
+	if( utf8_string == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid MFT entry - missing data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( mft_entry->data_size > (size_t) SSIZE_MAX )
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_entry != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid MFT entry - data size value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory entry value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( mft_entry->attributes_offset < sizeof( fsntfs_mft_entry_header_t ) )
-	 || ( mft_entry->attributes_offset >= mft_entry->data_size ) )
+	if( ( flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) != 0 )
+	{
+		return( 0 );
+	}
+	if( mft_entry->i30_index == NULL )
+	{
+		return( 0 );
+	}
+	if( mft_entry->i30_index->index_root_attribute == NULL )
+	{
+		return( 0 );
+	}
+	if( libfsntfs_index_read_root_node(
+	     mft_entry->i30_index,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read $I30 index root node.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfsntfs_mft_entry_get_directory_entry_by_utf8_name_from_index_node(
+	          mft_entry,
+	          io_handle,
+	          file_io_handle,
+	          mft_entry->i30_index->root_values_array,
+	          utf8_string,
+	          utf8_string_length,
+	          0,
+	          directory_entry,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid MFT entry - attributes offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve directory entry from $I30 index.",
 		 function );
 
 		goto on_error;
 	}
-	attributes_data_offset = mft_entry->attributes_offset;
+	/* Only a name that differs in case was found
+	 */
+	if( ( result == 0 )
+	 && ( *directory_entry != NULL ) )
+	{
+		result = 1;
+	}
+	if( result != 0 )
+	{
+		if( ( *directory_entry )->file_name_values == NULL )
+		{
+			if( libfsntfs_directory_entry_free(
+			     directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free directory entry.",
+				 function );
 
-	byte_stream_copy_to_uint32_little_endian(
-	 &( mft_entry->data[ attributes_data_offset ] ),
-	 attribute_type );
+				goto on_error;
+			}
+			read_tree = 1;
+		}
+	}
+	else
+	{
+		for( utf8_string_index = 0;
+		     utf8_string_index < utf8_string_length;
+		     utf8_string_index++ )
+		{
+			if( utf8_string[ utf8_string_index ] >= 0x80 )
+			{
+				read_tree = 1;
 
-	while( attribute_type != LIBFSNTFS_ATTRIBUTE_TYPE_END_OF_ATTRIBUTES )
+				break;
+			}
+		}
+	}
+	if( read_tree != 0 )
 	{
-		if( libfsntfs_attribute_initialize(
-		     &attribute,
+		if( libcdata_btree_initialize(
+		     &directory_entries_tree,
+		     LIBFSNTFS_DIRECTORY_ENTRIES_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create attribute.",
+			 "%s: unable to create directory entries tree.",
 			 function );
 
 			goto on_error;
 		}
-		read_count = libfsntfs_attribute_read_from_mft(
-			      attribute,
-			      io_handle,
-			      mft_entry->data,
-			      mft_entry->data_size,
-			      attributes_data_offset,
-			      flags,
-			      error );
-
-		if( read_count < 0 )
+		if( libfsntfs_mft_entry_read_directory_entries_tree(
+		     mft_entry,
+		     io_handle,
+		     file_io_handle,
+		     directory_entries_tree,
+		     flags,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read attribute.",
+			 "%s: unable to read directory entries tree.",
 			 function );
 
 			goto on_error;
 		}
-		attributes_data_offset += read_count;
+		result = libfsntfs_directory_entries_tree_get_directory_entry_by_utf8_name(
+		          directory_entries_tree,
+		          io_handle->upcase_table,
+		          utf8_string,
+		          utf8_string_length,
+		          &tree_directory_entry,
+		          error );
 
-		if( libfsntfs_attribute_get_type(
-		     attribute,
-		     &attribute_type,
-		     error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve attribute type.",
+			 "%s: unable to retrieve directory entry from tree.",
 			 function );
 
 			goto on_error;
 		}
-		if( attribute_type == LIBFSNTFS_ATTRIBUTE_TYPE_ATTRIBUTE_LIST )
+		else if( result != 0 )
 		{
-			if( libcdata_array_initialize(
-			     &attribute_list,
-			     0,
+			if( libfsntfs_directory_entry_clone(
+			     directory_entry,
+			     tree_directory_entry,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create attribute list array.",
+				 "%s: unable to create directory entry.",
 				 function );
 
 				goto on_error;
 			}
-/* TODO if flag is set mark file entry as in complete ? */
-			if( ( flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) == 0 )
-			{
-				if( libfsntfs_attribute_list_read_from_attribute(
-				     attribute_list,
-				     io_handle,
-				     file_io_handle,
-				     attribute,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read attribute list.",
-					 function );
-
-					goto on_error;
-				}
-			}
-		}
-		if( libfsntfs_mft_entry_append_attribute(
-		     mft_entry,
-		     io_handle,
-		     file_io_handle,
-		     attribute,
-		     flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append attribute.",
-			 function );
-
-			/* Prevent a double free of the attribute */
-			attribute = NULL;
-
-			goto on_error;
-		}
-		attribute = NULL;
-
-		byte_stream_copy_to_uint32_little_endian(
-		 &( mft_entry->data[ attributes_data_offset ] ),
-		 attribute_type );
-	}
-	attributes_data_offset += 4;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		if( attributes_data_offset != (size_t) mft_entry->used_entry_size )
-		{
-			libcnotify_printf(
-			 "%s: mismatch in used MFT entry size (calculated: %" PRIzd ", stored: %" PRIu16 ").\n",
-			 function,
-			 attributes_data_offset,
-			 mft_entry->used_entry_size );
 		}
-	}
-#endif
-	if( attribute_list != NULL )
-	{
-		if( libfsntfs_mft_entry_read_attributes_from_attribute_list(
-		     mft_entry,
-		     io_handle,
-		     file_io_handle,
-		     mft_entry_vector,
-		     attribute_list,
-		     flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read attributes from attribute list.",
-			 function );
-
-			goto on_error;
-		}
-		if( libcdata_array_free(
-		     &attribute_list,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_internal_attribute_free,
+		if( libcdata_btree_free(
+		     &directory_entries_tree,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_directory_entry_free,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free attribute list array.",
+			 "%s: unable to free directory entries tree.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	return( 1 );
+	return( result );
 
 on_error:
-	if( attribute_list != NULL )
+	if( directory_entries_tree != NULL )
 	{
-		libcdata_array_free(
-		 &attribute_list,
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_internal_attribute_free,
+		libcdata_btree_free(
+		 &directory_entries_tree,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_directory_entry_free,
 		 NULL );
 	}
-	if( attribute != NULL )
+	if( *directory_entry != NULL )
 	{
-		libfsntfs_internal_attribute_free(
-		 (libfsntfs_internal_attribute_t **) &attribute,
+		libfsntfs_directory_entry_free(
+		 directory_entry,
 		 NULL );
 	}
-	libcdata_array_empty(
-	 mft_entry->index_array,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_index_free,
-	 NULL );
-
-	mft_entry->i30_index = NULL;
-	mft_entry->sii_index = NULL;
-
-	libcdata_array_empty(
-	 mft_entry->alternate_data_attributes_array,
-	 NULL,
-	 NULL );
-
-	libcdata_array_empty(
-	 mft_entry->attributes_array,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_internal_attribute_free,
-	 NULL );
-
 	return( -1 );
 }
 
-/* Reads attributes from an attribute list
- * Returns 1 if successful or -1 on error
+/* Retrieves the directory entry for an UTF-16 encoded name from an $I30 index node
+ * Only the sub nodes that can contain the name are read
+ * Names are compared case-insensitive if the upcase table is available. The first
+ * directory entry whose name only differs in case is kept in directory_entry,
+ * while the search continues for a name that also matches the case
+ * Returns 1 if a name that matches the case was found, 0 if not or -1 on error
  */
-int libfsntfs_mft_entry_read_attributes_from_attribute_list(
+int libfsntfs_mft_entry_get_directory_entry_by_utf16_name_from_index_node(
      libfsntfs_mft_entry_t *mft_entry,
      libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
-     libfdata_vector_t *mft_entry_vector,
-     libcdata_array_t *attribute_list,
-     uint8_t flags,
+     libcdata_array_t *node_index_values_array,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     int recursion_depth,
+     libfsntfs_directory_entry_t **directory_entry,
      libcerror_error_t **error )
 {
-	libcdata_array_t *list_mft_entry_array = NULL;
-	libfcache_cache_t *mft_entry_cache     = NULL;
-	libfsntfs_attribute_t *attribute       = NULL;
-	libfsntfs_attribute_t *list_attribute  = NULL;
-	libfsntfs_mft_entry_t *list_mft_entry  = NULL;
-	static char *function                  = "libfsntfs_mft_entry_read_attributes_from_attribute_list";
-	uint64_t list_mft_entry_index          = 0;
-	uint16_t sequence_number               = 0;
-	int attribute_index                    = 0;
-	int entry_index                        = 0;
-	int list_attribute_index               = 0;
-	int number_of_attributes               = 0;
-	int number_of_list_attributes          = 0;
+	libcdata_array_t *sub_node_index_values_array  = NULL;
+	libfsntfs_file_name_values_t *file_name_values = NULL;
+	libfsntfs_index_value_t *index_value           = NULL;
+	static char *function                          = "libfsntfs_mft_entry_get_directory_entry_by_utf16_name_from_index_node";
+	int compare_result                             = 0;
+	int index_value_entry                          = 0;
+	int is_exact_match                             = 0;
+	int number_of_index_values                     = 0;
+	int result                                     = 0;
 
 	if( mft_entry == NULL )
 	{
@@ -1276,631 +3656,630 @@ int libfsntfs_mft_entry_read_attributes_from_attribute_list(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_number_of_entries(
-	     attribute_list,
-	     &number_of_list_attributes,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of attribute list entries.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcdata_array_initialize(
-	     &list_mft_entry_array,
-	     0,
-	     error ) != 1 )
+	if( directory_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create list MFT entry array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
 		 function );
 
-		goto on_error;
-	}
-	for( list_attribute_index = 0;
-	     list_attribute_index < number_of_list_attributes;
-	     list_attribute_index++ )
-	{
-		if( libcdata_array_get_entry_by_index(
-		     attribute_list,
-		     list_attribute_index,
-		     (intptr_t **) &list_attribute,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve attribute list entry: %d.",
-			 function,
-			 list_attribute_index );
-
-			goto on_error;
-		}
-		if( libfsntfs_attribute_get_file_reference(
-		     list_attribute,
-		     &list_mft_entry_index,
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve attribute list entry: %d file reference.",
-			 function,
-			 list_attribute_index );
-
-			goto on_error;
-		}
-		/* Ignore the current MFT entry
-		 */
-		if( list_mft_entry_index == (uint64_t) mft_entry->index )
-		{
-			continue;
-		}
-		if( libcdata_array_insert_entry(
-		     list_mft_entry_array,
-		     &entry_index,
-		     (intptr_t *) list_attribute,
-		     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libfsntfs_attribute_compare_by_file_reference,
-		     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to insert list attribute in list MFT entry array.",
-			 function );
-
-			goto on_error;
-		}
+		return( -1 );
 	}
-	/* Use a local cache to prevent cache outs
-	 */
-	if( libfcache_cache_initialize(
-	     &mft_entry_cache,
-	     8,
-	     error ) != 1 )
+	if( ( recursion_depth < 0 )
+	 || ( recursion_depth > LIBFSNTFS_MAXIMUM_RECURSION_DEPTH ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create MFT entry cache.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid recursion depth value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	/* Read the list MFT entries
-	 */
 	if( libcdata_array_get_number_of_entries(
-	     list_mft_entry_array,
-	     &number_of_list_attributes,
+	     node_index_values_array,
+	     &number_of_index_values,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of list MFT entries.",
+		 "%s: unable to retrieve number of node index values.",
 		 function );
 
 		goto on_error;
 	}
-	for( list_attribute_index = 0;
-	     list_attribute_index < number_of_list_attributes;
-	     list_attribute_index++ )
+	for( index_value_entry = 0;
+	     index_value_entry < number_of_index_values;
+	     index_value_entry++ )
 	{
 		if( libcdata_array_get_entry_by_index(
-		     list_mft_entry_array,
-		     list_attribute_index,
-		     (intptr_t **) &list_attribute,
+		     node_index_values_array,
+		     index_value_entry,
+		     (intptr_t **) &index_value,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve list attribute: %d.",
+			 "%s: unable to retrieve node index value: %d.",
 			 function,
-			 list_attribute_index );
+			 index_value_entry );
 
 			goto on_error;
 		}
-		if( libfsntfs_attribute_get_file_reference(
-		     list_attribute,
-		     &list_mft_entry_index,
-		     &sequence_number,
-		     error ) != 1 )
+		if( index_value == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve list attribute: %d file reference.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing node index value: %d.",
 			 function,
-			 list_attribute_index );
+			 index_value_entry );
 
 			goto on_error;
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		/* The last index value does not contain a name but refers to the sub node
+		 * that contains the names greater than the preceding name
+		 */
+		if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_IS_LAST ) != 0 )
 		{
-			libcnotify_printf(
-			 "%s: data file reference: MFT entry: %" PRIu64 ", sequence: %" PRIu16 "\n",
-			 function,
-			 list_mft_entry_index,
-			 sequence_number );
-			libcnotify_printf(
-			 "\n" );
+			compare_result = LIBCDATA_COMPARE_GREATER;
 		}
-#endif
-		if( list_mft_entry_index > (uint64_t) INT_MAX )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: list MFT entry reference value out of bounds.",
-			 function );
+			if( libfsntfs_file_name_values_initialize(
+			     &file_name_values,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create file name values.",
+				 function );
 
-			goto on_error;
-		}
-		if( libfdata_vector_get_element_value_by_index(
-		     mft_entry_vector,
-		     (intptr_t *) file_io_handle,
-		     mft_entry_cache,
-		     (int) list_mft_entry_index,
-		     (intptr_t **) &list_mft_entry,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
-			 function,
-			 list_mft_entry_index );
+				goto on_error;
+			}
+			if( libfsntfs_file_name_values_read(
+			     file_name_values,
+			     index_value->data,
+			     (size_t) index_value->data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read file name values.",
+				 function );
 
-			goto on_error;
-		}
-		if( list_mft_entry == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing MFT entry: %" PRIu64 ".",
-			 function,
-			 list_mft_entry_index );
+				goto on_error;
+			}
+			compare_result = libfsntfs_file_name_values_compare_name_with_utf16_string(
+			                  file_name_values,
+			                  utf16_string,
+			                  utf16_string_length,
+			                  error );
 
-			goto on_error;
-		}
-		if( libfsntfs_mft_entry_get_number_of_attributes(
-		     list_mft_entry,
-		     &number_of_attributes,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of attributes.",
-			 function );
+			if( compare_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare UTF-16 string with file name values.",
+				 function );
 
-			goto on_error;
-		}
-		for( attribute_index = 0;
-		     attribute_index < number_of_attributes;
-		     attribute_index++ )
-		{
-			if( libfsntfs_mft_entry_get_attribute_by_index(
-			     list_mft_entry,
-			     attribute_index,
-			     &attribute,
+				goto on_error;
+			}
+			else if( compare_result == LIBCDATA_COMPARE_EQUAL )
+			{
+				if( io_handle->upcase_table != NULL )
+				{
+					result = libfsntfs_upcase_table_compare_name_with_utf16_string(
+					          io_handle->upcase_table,
+					          file_name_values->name,
+					          file_name_values->name_size,
+					          utf16_string,
+					          utf16_string_length,
+					          error );
+				}
+				else
+				{
+					result = libuna_utf16_string_compare_with_utf16_stream(
+					          utf16_string,
+					          utf16_string_length,
+					          file_name_values->name,
+					          file_name_values->name_size,
+					          LIBUNA_ENDIAN_LITTLE,
+					          error );
+				}
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to compare UTF-16 string with file name values.",
+					 function );
+
+					goto on_error;
+				}
+				/* Ignore the file name with the . as its name
+				 */
+				if( ( file_name_values->name_size == 2 )
+				 && ( file_name_values->name[ 0 ] == 0x2e )
+				 && ( file_name_values->name[ 1 ] == 0x00 ) )
+				{
+					result = 0;
+				}
+				if( result != 0 )
+				{
+					/* The upcase table comparison ignores case, a name that also
+					 * matches the case is preferred
+					 */
+					is_exact_match = 1;
+
+					if( io_handle->upcase_table != NULL )
+					{
+						is_exact_match = libuna_utf16_string_compare_with_utf16_stream(
+						                  utf16_string,
+						                  utf16_string_length,
+						                  file_name_values->name,
+						                  file_name_values->name_size,
+						                  LIBUNA_ENDIAN_LITTLE,
+						                  error );
+
+						if( is_exact_match == -1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_GENERIC,
+							 "%s: unable to compare UTF-16 string with file name values.",
+							 function );
+
+							goto on_error;
+						}
+					}
+					if( ( is_exact_match != 0 )
+					 || ( *directory_entry == NULL ) )
+					{
+						if( *directory_entry != NULL )
+						{
+							if( libfsntfs_directory_entry_free(
+							     directory_entry,
+							     error ) != 1 )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+								 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+								 "%s: unable to free directory entry.",
+								 function );
+
+								goto on_error;
+							}
+						}
+						if( libfsntfs_directory_entry_initialize(
+						     directory_entry,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+							 "%s: unable to create directory entry.",
+							 function );
+
+							goto on_error;
+						}
+						( *directory_entry )->file_reference = index_value->file_reference;
+
+						if( file_name_values->name_namespace == LIBFSNTFS_FILE_NAME_NAMESPACE_DOS )
+						{
+							( *directory_entry )->short_file_name_values = file_name_values;
+						}
+						else
+						{
+							( *directory_entry )->file_name_values = file_name_values;
+						}
+						file_name_values = NULL;
+
+						if( is_exact_match != 0 )
+						{
+							return( 1 );
+						}
+					}
+				}
+			}
+			if( libfsntfs_file_name_values_free(
+			     &file_name_values,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve attribute: %d.",
-				 function,
-				 attribute_index );
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file name values.",
+				 function );
 
 				goto on_error;
 			}
-			if( attribute == NULL )
+		}
+		if( compare_result == LIBCDATA_COMPARE_LESS )
+		{
+			continue;
+		}
+		if( ( index_value->flags & LIBFSNTFS_INDEX_VALUE_FLAG_HAS_SUB_NODE ) != 0 )
+		{
+			if( libfsntfs_index_read_sub_node(
+			     mft_entry->i30_index,
+			     io_handle,
+			     file_io_handle,
+			     index_value->sub_node_vcn,
+			     &sub_node_index_values_array,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing attribute: %d.",
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sub node of node index value: %d.",
 				 function,
-				 attribute_index );
+				 index_value_entry );
 
 				goto on_error;
 			}
-			if( libcdata_array_set_entry_by_index(
-			     list_mft_entry->attributes_array,
-			     attribute_index,
-			     NULL,
-			     error ) != 1 )
+			result = libfsntfs_mft_entry_get_directory_entry_by_utf16_name_from_index_node(
+			          mft_entry,
+			          io_handle,
+			          file_io_handle,
+			          sub_node_index_values_array,
+			          utf16_string,
+			          utf16_string_length,
+			          recursion_depth + 1,
+			          directory_entry,
+			          error );
+
+			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set entry: %d in attributes array.",
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry from sub node of node index value: %d.",
 				 function,
-				 attribute_index );
+				 index_value_entry );
 
 				goto on_error;
 			}
-/* TODO convert attribute list attributes into readable attributes */
-			if( libfsntfs_mft_entry_append_attribute(
-			     mft_entry,
-			     io_handle,
-			     file_io_handle,
-			     attribute,
-			     flags,
+			if( libcdata_array_free(
+			     &sub_node_index_values_array,
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_index_value_free,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append attribute.",
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub node index values array.",
 				 function );
 
 				goto on_error;
 			}
+			if( result != 0 )
+			{
+				return( 1 );
+			}
+		}
+		/* Names that only differ in case can be stored on both sides of the index value
+		 */
+		if( compare_result == LIBCDATA_COMPARE_GREATER )
+		{
+			break;
 		}
 	}
-	if( libfcache_cache_free(
-	     &mft_entry_cache,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free MFT entry cache.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcdata_array_free(
-	     &list_mft_entry_array,
-	     NULL,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free list MFT entry array.",
-		 function );
-
-		goto on_error;
-	}
-	return( 1 );
+	return( 0 );
 
 on_error:
-	if( mft_entry_cache != NULL )
+	if( *directory_entry != NULL )
 	{
-		libfcache_cache_free(
-		 &mft_entry_cache,
+		libfsntfs_directory_entry_free(
+		 directory_entry,
 		 NULL );
 	}
-	if( list_mft_entry_array != NULL )
+	if( sub_node_index_values_array != NULL )
 	{
 		libcdata_array_free(
-		 &list_mft_entry_array,
-		 NULL,
+		 &sub_node_index_values_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_index_value_free,
+		 NULL );
+	}
+	if( file_name_values != NULL )
+	{
+		libfsntfs_file_name_values_free(
+		 &file_name_values,
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Reads the MFT entry directory entry index if available
- * Returns 1 if successful or -1 on error
+/* Retrieves the directory entry for an UTF-16 encoded name from the $I30 index
+ * Only the index nodes that can contain the name are read instead of the entire index.
+ * The directory entries tree is read instead if the name matches a short (DOS) name,
+ * which does not have the corresponding long name, or if the name contains non-ASCII
+ * characters and was not found, since their collation depends on the $UpCase table
+ * Returns 1 if successful, 0 if no such directory entry or -1 on error
  */
-int libfsntfs_mft_entry_read_directory_entries_tree(
+int libfsntfs_mft_entry_get_directory_entry_by_utf16_name(
      libfsntfs_mft_entry_t *mft_entry,
      libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
-     libcdata_btree_t *directory_entries_tree,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
      uint8_t flags,
+     libfsntfs_directory_entry_t **directory_entry,
      libcerror_error_t **error )
 {
-	libcdata_tree_node_t *upper_node                      = NULL;
-	libfsntfs_directory_entry_t *directory_entry          = NULL;
-	libfsntfs_directory_entry_t *existing_directory_entry = NULL;
-	libfsntfs_file_name_values_t *file_name_values        = NULL;
-	libfsntfs_index_value_t *index_value                  = NULL;
-	static char *function                                 = "libfsntfs_mft_entry_read_directory_entries_tree";
-	uint8_t file_name_namespace                           = 0;
-	int index_value_entry                                 = 0;
-	int number_of_index_values                            = 0;
-	int result                                            = 0;
-	int value_index                                       = 0;
+	libcdata_btree_t *directory_entries_tree          = NULL;
+	libfsntfs_directory_entry_t *tree_directory_entry = NULL;
+	static char *function                             = "libfsntfs_mft_entry_get_directory_entry_by_utf16_name";
+	size_t utf16_string_index                         = 0;
+	uint8_t read_tree                                 = 0;
+	int result                                        = 0;
+
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 string length value exceeds maximum.",
+		 function );
 
-	if( mft_entry == NULL )
+		return( -1 );
+	}
+	if( directory_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid MFT entry.",
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory entry value already set.",
 		 function );
 
 		return( -1 );
 	}
 	if( ( flags & LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY ) != 0 )
 	{
-		return( 1 );
+		return( 0 );
 	}
 	if( mft_entry->i30_index == NULL )
 	{
-		return( 1 );
+		return( 0 );
 	}
-	if( libfsntfs_index_read(
+	if( mft_entry->i30_index->index_root_attribute == NULL )
+	{
+		return( 0 );
+	}
+	if( libfsntfs_index_read_root_node(
 	     mft_entry->i30_index,
 	     io_handle,
-	     file_io_handle,
-	     flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read $I30 index.",
+		 "%s: unable to read $I30 index root node.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfsntfs_index_get_number_of_index_values(
-	     mft_entry->i30_index,
-	     &number_of_index_values,
-	     error ) != 1 )
+	result = libfsntfs_mft_entry_get_directory_entry_by_utf16_name_from_index_node(
+	          mft_entry,
+	          io_handle,
+	          file_io_handle,
+	          mft_entry->i30_index->root_values_array,
+	          utf16_string,
+	          utf16_string_length,
+	          0,
+	          directory_entry,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of $I30 index values.",
+		 "%s: unable to retrieve directory entry from $I30 index.",
 		 function );
 
 		goto on_error;
 	}
-	for( index_value_entry = 0;
-	     index_value_entry < number_of_index_values;
-	     index_value_entry++ )
+	/* Only a name that differs in case was found
+	 */
+	if( ( result == 0 )
+	 && ( *directory_entry != NULL ) )
 	{
-		if( libfsntfs_index_get_index_value_by_index(
-		     mft_entry->i30_index,
-		     file_io_handle,
-		     index_value_entry,
-		     &index_value,
-		     error ) != 1 )
+		result = 1;
+	}
+	if( result != 0 )
+	{
+		if( ( *directory_entry )->file_name_values == NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve $I30 index value: %d.",
-			 function,
-			 index_value_entry );
+			if( libfsntfs_directory_entry_free(
+			     directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free directory entry.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
+			read_tree = 1;
 		}
-		if( libfsntfs_file_name_values_initialize(
-		     &file_name_values,
+	}
+	else
+	{
+		for( utf16_string_index = 0;
+		     utf16_string_index < utf16_string_length;
+		     utf16_string_index++ )
+		{
+			if( utf16_string[ utf16_string_index ] >= 0x80 )
+			{
+				read_tree = 1;
+
+				break;
+			}
+		}
+	}
+	if( read_tree != 0 )
+	{
+		if( libcdata_btree_initialize(
+		     &directory_entries_tree,
+		     LIBFSNTFS_DIRECTORY_ENTRIES_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create file name values.",
+			 "%s: unable to create directory entries tree.",
 			 function );
 
 			goto on_error;
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: index value: %03d file reference: MFT entry: %" PRIu64 ", sequence: %" PRIu64 "\n",
-			 function,
-			 index_value_entry,
-			 index_value->file_reference & 0xffffffffffffUL,
-			 index_value->file_reference >> 48 );
-			libcnotify_printf(
-			 "\n" );
-		}
-#endif
-		if( libfsntfs_file_name_values_read(
-		     file_name_values,
-		     index_value->data,
-		     (size_t) index_value->data_size,
+		if( libfsntfs_mft_entry_read_directory_entries_tree(
+		     mft_entry,
+		     io_handle,
+		     file_io_handle,
+		     directory_entries_tree,
+		     flags,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read file name values.",
+			 "%s: unable to read directory entries tree.",
 			 function );
 
 			goto on_error;
 		}
-		if( file_name_values->name == NULL )
+		result = libfsntfs_directory_entries_tree_get_directory_entry_by_utf16_name(
+		          directory_entries_tree,
+		          io_handle->upcase_table,
+		          utf16_string,
+		          utf16_string_length,
+		          &tree_directory_entry,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid file name values - missing name.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory entry from tree.",
 			 function );
 
 			goto on_error;
 		}
-		/* Ignore the file name with the . as its name
-		 */
-		if( ( file_name_values->name_size == 2 )
-		 && ( file_name_values->name[ 0 ] == 0x2e )
-		 && ( file_name_values->name[ 1 ] == 0x00 ) )
+		else if( result != 0 )
 		{
-			if( libfsntfs_file_name_values_free(
-			     &file_name_values,
+			if( libfsntfs_directory_entry_clone(
+			     directory_entry,
+			     tree_directory_entry,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free file name values.",
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create directory entry.",
 				 function );
 
 				goto on_error;
 			}
-			continue;
 		}
-		file_name_namespace = file_name_values->name_namespace;
-
-		if( libfsntfs_directory_entry_initialize(
-		     &directory_entry,
+		if( libcdata_btree_free(
+		     &directory_entries_tree,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_directory_entry_free,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create directory entry.",
-			 function );
-
-			goto on_error;
-		}
-		directory_entry->file_reference = index_value->file_reference;
-
-		if( file_name_namespace == LIBFSNTFS_FILE_NAME_NAMESPACE_DOS )
-		{
-			directory_entry->short_file_name_values = file_name_values;
-		}
-		else
-		{
-			directory_entry->file_name_values = file_name_values;
-		}
-		file_name_values = NULL;
-
-		result = libcdata_btree_insert_value(
-			  directory_entries_tree,
-			  &value_index,
-			  (intptr_t *) directory_entry,
-			  (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libfsntfs_directory_entry_compare,
-			  &upper_node,
-			  (intptr_t **) &existing_directory_entry,
-			  error ) ;
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to insert directory entry into tree.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory entries tree.",
 			 function );
 
 			goto on_error;
 		}
-		else if( result == 0 )
-		{
-			if( existing_directory_entry == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing existing directory entry.",
-				 function );
-
-				goto on_error;
-			}
-			if( file_name_namespace == LIBFSNTFS_FILE_NAME_NAMESPACE_DOS )
-			{
-				if( existing_directory_entry->short_file_name_values == NULL )
-				{
-					existing_directory_entry->short_file_name_values = directory_entry->short_file_name_values;
-					directory_entry->short_file_name_values          = NULL;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				else if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: short file name of existing directory entry already set.\n",
-					 function );
-				}
-#endif
-			}
-			else
-			{
-				if( existing_directory_entry->file_name_values == NULL )
-				{
-					existing_directory_entry->file_name_values = directory_entry->file_name_values;
-					directory_entry->file_name_values          = NULL;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				else if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: file name of existing directory entry already set.\n",
-					 function );
-				}
-#endif
-			}
-			if( libfsntfs_directory_entry_free(
-			     &directory_entry,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free directory entry.",
-				 function );
-
-				goto on_error;
-			}
-		}
-		directory_entry = NULL;
 	}
-	return( 1 );
+	return( result );
 
 on_error:
-	if( directory_entry != NULL )
+	if( directory_entries_tree != NULL )
 	{
-		libfsntfs_directory_entry_free(
-		 &directory_entry,
+		libcdata_btree_free(
+		 &directory_entries_tree,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_directory_entry_free,
 		 NULL );
 	}
-	if( file_name_values != NULL )
+	if( *directory_entry != NULL )
 	{
-		libfsntfs_file_name_values_free(
-		 &file_name_values,
+		libfsntfs_directory_entry_free(
+		 directory_entry,
 		 NULL );
 	}
 	return( -1 );
@@ -3666,6 +6045,17 @@ int libfsntfs_mft_entry_read_element_data(
 	LIBFSNTFS_UNREFERENCED_PARAMETER( element_data_size )
 	LIBFSNTFS_UNREFERENCED_PARAMETER( read_flags )
 
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( (uint64_t) element_index > (uint64_t) UINT32_MAX )
 	{
 		libcerror_error_set(
@@ -3677,6 +6067,22 @@ int libfsntfs_mft_entry_read_element_data(
 
 		return( -1 );
 	}
+	if( libfsntfs_io_handle_update_cache_statistics(
+	     io_handle,
+	     LIBFSNTFS_CACHE_TYPE_MFT_ENTRIES,
+	     0,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update cache statistics.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfsntfs_mft_entry_initialize(
 	     &mft_entry,
 	     error ) != 1 )
@@ -3699,6 +6105,7 @@ int libfsntfs_mft_entry_read_element_data(
 	     io_handle,
 	     file_io_handle,
 	     vector,
+	     cache,
 	     element_data_offset,
 	     (uint32_t) element_index,
 	     flags,
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_arena.h"
 #include "libfsntfs_attribute.h"
 #include "libfsntfs_directory_entry.h"
 #include "libfsntfs_index.h"
@@ -43,6 +44,11 @@ typedef struct libfsntfs_mft_entry libfsntfs_mft_entry_t;
 
 struct libfsntfs_mft_entry
 {
+	/* The arena the data, the attributes and their values are allocated from
+	 * NULL if they are allocated on the heap
+	 */
+	libfsntfs_arena_t *arena;
+
 	/* The data
 	 */
 	uint8_t *data;
@@ -149,16 +155,35 @@ int libfsntfs_mft_entry_free(
      libfsntfs_mft_entry_t **mft_entry,
      libcerror_error_t **error );
 
+int libfsntfs_mft_entry_set_data(
+     libfsntfs_mft_entry_t *mft_entry,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
 int libfsntfs_mft_entry_read(
      libfsntfs_mft_entry_t *mft_entry,
      libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfdata_vector_t *mft_entry_vector,
+     libfcache_cache_t *mft_entry_cache,
      off64_t file_offset,
      uint32_t mft_entry_index,
      uint8_t flags,
      libcerror_error_t **error );
 
+int libfsntfs_mft_entry_read_data(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *mft_entry_vector,
+     libfcache_cache_t *mft_entry_cache,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t mft_entry_index,
+     uint8_t flags,
+     libcerror_error_t **error );
+
 int libfsntfs_mft_entry_read_header(
      libfsntfs_mft_entry_t *mft_entry,
      libfsntfs_io_handle_t *io_handle,
@@ -167,11 +192,41 @@ int libfsntfs_mft_entry_read_header(
      uint32_t mft_entry_index,
      libcerror_error_t **error );
 
+int libfsntfs_mft_entry_read_header_data(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     uint32_t mft_entry_index,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_entry_attributes_require_file_io(
+     libfsntfs_mft_entry_t *mft_entry,
+     libcerror_error_t **error );
+
 int libfsntfs_mft_entry_read_attributes(
      libfsntfs_mft_entry_t *mft_entry,
      libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfdata_vector_t *mft_entry_vector,
+     libfcache_cache_t *mft_entry_cache,
+     uint8_t flags,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_entry_read_attributes_from_extension_entry(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfsntfs_mft_entry_t *extension_mft_entry,
+     uint8_t flags,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_entry_read_extension_entries(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *mft_entry_vector,
+     libfcache_cache_t *mft_entry_cache,
+     uint64_t first_mft_entry_index,
+     int number_of_mft_entries,
      uint8_t flags,
      libcerror_error_t **error );
 
@@ -180,6 +235,7 @@ int libfsntfs_mft_entry_read_attributes_from_attribute_list(
      libfsntfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfdata_vector_t *mft_entry_vector,
+     libfcache_cache_t *mft_entry_cache,
      libcdata_array_t *attribute_list,
      uint8_t flags,
      libcerror_error_t **error );
@@ -192,6 +248,48 @@ int libfsntfs_mft_entry_read_directory_entries_tree(
      uint8_t flags,
      libcerror_error_t **error );
 
+int libfsntfs_mft_entry_get_directory_entry_by_utf8_name_from_index_node(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcdata_array_t *node_index_values_array,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     int recursion_depth,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_entry_get_directory_entry_by_utf8_name(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint8_t flags,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_entry_get_directory_entry_by_utf16_name_from_index_node(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcdata_array_t *node_index_values_array,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     int recursion_depth,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_entry_get_directory_entry_by_utf16_name(
+     libfsntfs_mft_entry_t *mft_entry,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint8_t flags,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
 int libfsntfs_mft_entry_read_security_identifiers(
      libfsntfs_mft_entry_t *mft_entry,
      libfsntfs_io_handle_t *io_handle,
@@ -29,9 +29,11 @@
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libcnotify.h"
+#include "libfsntfs_libcthreads.h"
 #include "libfsntfs_libcstring.h"
 #include "libfsntfs_libuna.h"
 #include "libfsntfs_mft_entry.h"
+#include "libfsntfs_mft_scanner.h"
 #include "libfsntfs_mft_metadata_file.h"
 
 /* Creates a MFT metadata file
@@ -1256,8 +1258,24 @@ int libfsntfs_mft_metadata_file_get_file_entry_by_index(
 
 		return( -1 );
 	}
-	if( libfsntfs_mft_get_mft_entry_by_index(
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_mft_metadata_file->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_mft_read_mft_entry_by_index(
 	     internal_mft_metadata_file->mft,
+	     internal_mft_metadata_file->io_handle,
 	     internal_mft_metadata_file->file_io_handle,
 	     mft_entry_index,
 	     &mft_entry,
@@ -1267,12 +1285,14 @@ int libfsntfs_mft_metadata_file_get_file_entry_by_index(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+		 "%s: unable to read MFT entry: %" PRIu64 ".",
 		 function,
 		 mft_entry_index );
 
-		return( -1 );
+		goto on_error;
 	}
+	/* libfsntfs_file_entry_initialize takes over management of mft_entry
+	 */
 	if( libfsntfs_file_entry_initialize(
 	     file_entry,
 	     internal_mft_metadata_file->io_handle,
@@ -1290,8 +1310,177 @@ int libfsntfs_mft_metadata_file_get_file_entry_by_index(
 		 "%s: unable to create file entry.",
 		 function );
 
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_mft_metadata_file->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
 		return( -1 );
 	}
+#endif
 	return( 1 );
+
+on_error:
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_mft_metadata_file->io_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Scans the file entries of all MFT entries that are not empty
+ * The MFT is read in large sequential reads and every file entry is passed to the callback function.
+ * The file entry is freed after the callback function returns.
+ * MFT entries that cannot be read, e.g. due to corruption, are skipped.
+ * The callback function should return 1 to continue, 0 to stop or -1 on error
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
+ */
+int libfsntfs_mft_metadata_file_scan(
+     libfsntfs_mft_metadata_file_t *mft_metadata_file,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_mft_metadata_file_t *internal_mft_metadata_file = NULL;
+	static char *function                                              = "libfsntfs_mft_metadata_file_scan";
+	int result                                                         = 0;
+
+	if( mft_metadata_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT metadata file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_mft_metadata_file = (libfsntfs_internal_mft_metadata_file_t *) mft_metadata_file;
+
+	if( internal_mft_metadata_file->mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT metadata file - missing MFT.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_mft_scan(
+	          internal_mft_metadata_file->mft,
+	          internal_mft_metadata_file->io_handle,
+	          internal_mft_metadata_file->file_io_handle,
+	          LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY,
+	          callback_function,
+	          callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to scan MFT.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Scans the file entries of all MFT entries that are not empty using multiple threads
+ * The MFT is read in large sequential reads by the calling thread and parsed by number_of_threads worker threads.
+ * The callbacks are delivered in MFT order by the calling thread, unless LIBFSNTFS_SCAN_FLAG_UNORDERED
+ * is set in which case the callback function is called concurrently by the worker threads.
+ * The file entry is freed after the callback function returns.
+ * MFT entries that cannot be read, e.g. due to corruption, are skipped.
+ * The callback function should return 1 to continue, 0 to stop or -1 on error
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
+ */
+int libfsntfs_mft_metadata_file_scan_parallel(
+     libfsntfs_mft_metadata_file_t *mft_metadata_file,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_mft_metadata_file_t *internal_mft_metadata_file = NULL;
+	static char *function                                              = "libfsntfs_mft_metadata_file_scan_parallel";
+	int result                                                         = 0;
+
+	if( mft_metadata_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT metadata file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_mft_metadata_file = (libfsntfs_internal_mft_metadata_file_t *) mft_metadata_file;
+
+	if( internal_mft_metadata_file->mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT metadata file - missing MFT.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_mft_scan_parallel(
+	          internal_mft_metadata_file->mft,
+	          internal_mft_metadata_file->io_handle,
+	          internal_mft_metadata_file->file_io_handle,
+	          LIBFSNTFS_FILE_ENTRY_FLAGS_MFT_ONLY,
+	          number_of_threads,
+	          scan_flags,
+	          callback_function,
+	          callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to scan MFT.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
 }
 
@@ -155,6 +155,28 @@ int libfsntfs_mft_metadata_file_get_file_entry_by_index(
      libfsntfs_file_entry_t **file_entry,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_mft_metadata_file_scan(
+     libfsntfs_mft_metadata_file_t *mft_metadata_file,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_mft_metadata_file_scan_parallel(
+     libfsntfs_mft_metadata_file_t *mft_metadata_file,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1411 @@
+/*
+ * MFT scanner functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_file_entry.h"
+#include "libfsntfs_io_handle.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcnotify.h"
+#include "libfsntfs_libfdata.h"
+#include "libfsntfs_mft.h"
+#include "libfsntfs_mft_entry.h"
+#include "libfsntfs_mft_scanner.h"
+#include "libfsntfs_types.h"
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+/* Creates a MFT scanner
+ * Make sure the value mft_scanner is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_scanner_initialize(
+     libfsntfs_mft_scanner_t **mft_scanner,
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint8_t flags,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_scanner_initialize";
+
+	if( mft_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mft_scanner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid MFT scanner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	*mft_scanner = memory_allocate_structure(
+	                libfsntfs_mft_scanner_t );
+
+	if( *mft_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create MFT scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *mft_scanner,
+	     0,
+	     sizeof( libfsntfs_mft_scanner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear MFT scanner.",
+		 function );
+
+		memory_free(
+		 *mft_scanner );
+
+		*mft_scanner = NULL;
+
+		return( -1 );
+	}
+	( *mft_scanner )->mft               = mft;
+	( *mft_scanner )->io_handle         = io_handle;
+	( *mft_scanner )->file_io_handle    = file_io_handle;
+	( *mft_scanner )->flags             = flags;
+	( *mft_scanner )->scan_flags        = scan_flags;
+	( *mft_scanner )->callback_function = callback_function;
+	( *mft_scanner )->callback_data     = callback_data;
+
+	return( 1 );
+}
+
+/* Frees a MFT scanner
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_scanner_free(
+     libfsntfs_mft_scanner_t **mft_scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_scanner_free";
+
+	if( mft_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mft_scanner != NULL )
+	{
+		/* The mft, io_handle and file_io_handle references are freed elsewhere
+		 */
+		memory_free(
+		 *mft_scanner );
+
+		*mft_scanner = NULL;
+	}
+	return( 1 );
+}
+
+/* Creates a MFT scanner chunk
+ * Make sure the value chunk is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_scanner_chunk_initialize(
+     libfsntfs_mft_scanner_chunk_t **chunk,
+     libfsntfs_mft_scanner_t *mft_scanner,
+     size_t data_size,
+     uint64_t first_mft_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_scanner_chunk_initialize";
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk = memory_allocate_structure(
+	          libfsntfs_mft_scanner_chunk_t );
+
+	if( *chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk,
+	     0,
+	     sizeof( libfsntfs_mft_scanner_chunk_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk.",
+		 function );
+
+		memory_free(
+		 *chunk );
+
+		*chunk = NULL;
+
+		return( -1 );
+	}
+	( *chunk )->data = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * data_size );
+
+	if( ( *chunk )->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk )->scanner               = mft_scanner;
+	( *chunk )->data_size             = data_size;
+	( *chunk )->first_mft_entry_index = first_mft_entry_index;
+
+	return( 1 );
+
+on_error:
+	if( *chunk != NULL )
+	{
+		memory_free(
+		 *chunk );
+
+		*chunk = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a MFT scanner chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_mft_scanner_chunk_free(
+     libfsntfs_mft_scanner_chunk_t **chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_mft_scanner_chunk_free";
+	int file_entry_index  = 0;
+	int result            = 1;
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk != NULL )
+	{
+		/* The scanner reference is freed elsewhere
+		 */
+		if( ( *chunk )->file_entries != NULL )
+		{
+			for( file_entry_index = 0;
+			     file_entry_index < ( *chunk )->number_of_file_entries;
+			     file_entry_index++ )
+			{
+				if( ( *chunk )->file_entries[ file_entry_index ] == NULL )
+				{
+					continue;
+				}
+				if( libfsntfs_file_entry_free(
+				     &( ( *chunk )->file_entries[ file_entry_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free file entry: %d.",
+					 function,
+					 file_entry_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *chunk )->file_entries );
+		}
+		if( ( *chunk )->data != NULL )
+		{
+			memory_free(
+			 ( *chunk )->data );
+		}
+		memory_free(
+		 *chunk );
+
+		*chunk = NULL;
+	}
+	return( result );
+}
+
+/* Reads a file entry from MFT entry data
+ * The cache mutex is only grabbed when reading the file entry can require the MFT entry cache
+ * Returns 1 if successful, 0 if the MFT entry is empty or -1 on error
+ */
+int libfsntfs_mft_scanner_read_file_entry(
+     libfsntfs_mft_scanner_t *mft_scanner,
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t mft_entry_index,
+     libfsntfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_mft_entry_t *mft_entry = NULL;
+	static char *function            = "libfsntfs_mft_scanner_read_file_entry";
+	int is_locked                    = 0;
+	int result                       = 0;
+
+	if( mft_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_scanner->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT scanner - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size != (size_t) mft_scanner->io_handle->mft_entry_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_mft_entry_initialize(
+	     &mft_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create MFT entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_entry_set_data(
+	     mft_entry,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set MFT entry data.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfsntfs_mft_entry_read_header_data(
+	          mft_entry,
+	          mft_scanner->io_handle,
+	          (uint32_t) mft_entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry: %" PRIu64 " header data.",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libfsntfs_mft_entry_free(
+		     &mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free MFT entry.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	/* Parsing the attributes only requires exclusive access to the MFT entry vector
+	 * and the MFT entry cache if attribute lists or non-resident values are read,
+	 * the file IO handle is protected by its own mutex
+	 */
+	result = libfsntfs_mft_entry_attributes_require_file_io(
+	          mft_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if MFT entry: %" PRIu64 " attributes require file IO.",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     mft_scanner->io_handle->cache_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab cache mutex.",
+			 function );
+
+			goto on_error;
+		}
+		is_locked = 1;
+	}
+	if( libfsntfs_mft_entry_read_attributes(
+	     mft_entry,
+	     mft_scanner->io_handle,
+	     mft_scanner->file_io_handle,
+	     mft_scanner->mft->mft_entry_vector,
+	     mft_scanner->mft->mft_entry_cache,
+	     mft_scanner->flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read MFT entry: %" PRIu64 " attributes.",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	if( is_locked != 0 )
+	{
+		is_locked = 0;
+
+		if( libcthreads_mutex_release(
+		     mft_scanner->io_handle->cache_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release cache mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* libfsntfs_file_entry_initialize takes over management of mft_entry
+	 */
+	if( libfsntfs_file_entry_initialize(
+	     file_entry,
+	     mft_scanner->io_handle,
+	     mft_scanner->file_io_handle,
+	     mft_scanner->mft,
+	     mft_entry,
+	     NULL,
+	     mft_scanner->flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry.",
+		 function );
+
+		goto on_error;
+	}
+	mft_entry = NULL;
+
+	return( 1 );
+
+on_error:
+	if( is_locked != 0 )
+	{
+		libcthreads_mutex_release(
+		 mft_scanner->io_handle->cache_mutex,
+		 NULL );
+	}
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the file entries of a MFT scanner chunk
+ * If the callbacks are not delivered in MFT order the callback function is called
+ * for every file entry, otherwise the file entries are stored in the chunk
+ * Process callback function for the ordered queue, called by the worker threads
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int libfsntfs_mft_scanner_chunk_read_file_entries(
+     libfsntfs_mft_scanner_chunk_t *chunk,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *file_entry_error  = NULL;
+	libfsntfs_file_entry_t *file_entry   = NULL;
+	libfsntfs_mft_scanner_t *mft_scanner = NULL;
+	static char *function                = "libfsntfs_mft_scanner_chunk_read_file_entries";
+	size_t data_offset                   = 0;
+	size_t mft_entry_size                = 0;
+	int abort                            = 0;
+	int file_entry_index                 = 0;
+	int number_of_file_entries           = 0;
+	int result                           = 0;
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk->scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk - missing scanner.",
+		 function );
+
+		return( -1 );
+	}
+	mft_scanner = chunk->scanner;
+
+	if( mft_scanner->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT scanner - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	mft_entry_size = (size_t) mft_scanner->io_handle->mft_entry_size;
+
+	if( mft_entry_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT scanner - MFT entry size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk->data_size / mft_entry_size ) > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_file_entries = (int) ( chunk->data_size / mft_entry_size );
+
+	if( ( mft_scanner->scan_flags & LIBFSNTFS_SCAN_FLAG_UNORDERED ) == 0 )
+	{
+		chunk->file_entries = (libfsntfs_file_entry_t **) memory_allocate(
+		                                                   sizeof( libfsntfs_file_entry_t * ) * number_of_file_entries );
+
+		if( chunk->file_entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create file entries.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     chunk->file_entries,
+		     0,
+		     sizeof( libfsntfs_file_entry_t * ) * number_of_file_entries ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear file entries.",
+			 function );
+
+			goto on_error;
+		}
+		chunk->number_of_file_entries = number_of_file_entries;
+	}
+	for( file_entry_index = 0;
+	     file_entry_index < number_of_file_entries;
+	     file_entry_index++ )
+	{
+		if( libfsntfs_ordered_queue_get_abort(
+		     mft_scanner->queue,
+		     &abort,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve abort.",
+			 function );
+
+			goto on_error;
+		}
+		if( abort != 0 )
+		{
+			return( 0 );
+		}
+		result = libfsntfs_mft_scanner_read_file_entry(
+		          mft_scanner,
+		          &( chunk->data[ data_offset ] ),
+		          mft_entry_size,
+		          chunk->first_mft_entry_index + file_entry_index,
+		          &file_entry,
+		          &file_entry_error );
+
+		if( result == -1 )
+		{
+			/* A corrupted MFT entry does not prevent the remaining MFT entries from being scanned,
+			 * its file entry is left empty
+			 */
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to read file entry: %" PRIu64 ".\n",
+				 function,
+				 chunk->first_mft_entry_index + file_entry_index );
+			}
+#endif
+			libcerror_error_free(
+			 &file_entry_error );
+		}
+		else if( result != 0 )
+		{
+			if( chunk->file_entries != NULL )
+			{
+				chunk->file_entries[ file_entry_index ] = file_entry;
+
+				file_entry = NULL;
+			}
+			else
+			{
+				result = mft_scanner->callback_function(
+				          file_entry,
+				          mft_scanner->callback_data,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: callback function failed for MFT entry: %" PRIu64 ".",
+					 function,
+					 chunk->first_mft_entry_index + file_entry_index );
+
+					goto on_error;
+				}
+				if( libfsntfs_file_entry_free(
+				     &file_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free file entry.",
+					 function );
+
+					goto on_error;
+				}
+				if( result == 0 )
+				{
+					if( libfsntfs_ordered_queue_set_abort(
+					     mft_scanner->queue,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to set abort.",
+						 function );
+
+						goto on_error;
+					}
+					return( 0 );
+				}
+			}
+		}
+		data_offset += mft_entry_size;
+	}
+	return( 1 );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		libfsntfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Delivers the file entries of a processed MFT scanner chunk in MFT order
+ * Deliver callback function for the ordered queue, called by the calling thread
+ * Returns 1 if successful, 0 if stopped or -1 on error
+ */
+int libfsntfs_mft_scanner_chunk_deliver(
+     libfsntfs_mft_scanner_chunk_t *chunk,
+     libcerror_error_t **error )
+{
+	libfsntfs_mft_scanner_t *mft_scanner = NULL;
+	static char *function                = "libfsntfs_mft_scanner_chunk_deliver";
+	int file_entry_index                 = 0;
+	int result                           = 0;
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk->scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk - missing scanner.",
+		 function );
+
+		return( -1 );
+	}
+	mft_scanner = chunk->scanner;
+
+	for( file_entry_index = 0;
+	     file_entry_index < chunk->number_of_file_entries;
+	     file_entry_index++ )
+	{
+		if( chunk->file_entries[ file_entry_index ] == NULL )
+		{
+			continue;
+		}
+		result = mft_scanner->callback_function(
+		          chunk->file_entries[ file_entry_index ],
+		          mft_scanner->callback_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: callback function failed for MFT entry: %" PRIu64 ".",
+			 function,
+			 chunk->first_mft_entry_index + file_entry_index );
+
+			return( -1 );
+		}
+		if( libfsntfs_file_entry_free(
+		     &( chunk->file_entries[ file_entry_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file entry: %d.",
+			 function,
+			 file_entry_index );
+
+			return( -1 );
+		}
+		if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Scans the MFT entries using a pool of worker threads
+ * The calling thread reads the MFT data in chunks that are parsed by the worker threads.
+ * The callbacks are delivered in MFT order by the calling thread unless
+ * LIBFSNTFS_SCAN_FLAG_UNORDERED is set, in which case the worker threads
+ * call the callback function concurrently
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
+ */
+int libfsntfs_mft_scanner_scan(
+     libfsntfs_mft_scanner_t *mft_scanner,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libfsntfs_mft_scanner_chunk_t *chunk = NULL;
+	static char *function                = "libfsntfs_mft_scanner_scan";
+	size64_t mft_entry_size              = 0;
+	size64_t segment_data_offset         = 0;
+	size64_t segment_size                = 0;
+	size_t chunk_data_size               = 0;
+	size_t chunk_size                    = 0;
+	size_t maximum_chunk_data_size       = 0;
+	size_t read_size                     = 0;
+	off64_t segment_offset               = 0;
+	uint64_t mft_entry_index             = 0;
+	uint32_t segment_flags               = 0;
+	int number_of_segments               = 0;
+	int result                           = 1;
+	int segment_file_index               = 0;
+	int segment_index                    = 0;
+
+	if( mft_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_scanner->mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT scanner - missing MFT.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_scanner->queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid MFT scanner - queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_vector_get_element_data_size(
+	     mft_scanner->mft->mft_entry_vector,
+	     &mft_entry_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( mft_entry_size == 0 )
+	 || ( mft_entry_size > (size64_t) LIBFSNTFS_MFT_SCANNER_CHUNK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_get_number_of_segments(
+	     mft_scanner->mft->mft_entry_vector,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of MFT entry vector segments.",
+		 function );
+
+		goto on_error;
+	}
+	/* A chunk contains a whole number of MFT entries
+	 */
+	chunk_size = (size_t) ( LIBFSNTFS_MFT_SCANNER_CHUNK_SIZE - ( LIBFSNTFS_MFT_SCANNER_CHUNK_SIZE % mft_entry_size ) );
+
+	if( libfsntfs_ordered_queue_initialize(
+	     &( mft_scanner->queue ),
+	     number_of_threads,
+	     (int (*)(intptr_t *, libcerror_error_t **)) &libfsntfs_mft_scanner_chunk_read_file_entries,
+	     (int (*)(intptr_t *, libcerror_error_t **)) &libfsntfs_mft_scanner_chunk_deliver,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_mft_scanner_chunk_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create queue.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( ( chunk == NULL )
+		 && ( mft_entry_index >= mft_scanner->mft->number_of_mft_entries ) )
+		{
+			break;
+		}
+		if( libfdata_vector_get_segment_by_index(
+		     mft_scanner->mft->mft_entry_vector,
+		     segment_index,
+		     &segment_file_index,
+		     &segment_offset,
+		     &segment_size,
+		     &segment_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry vector segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		segment_data_offset = 0;
+
+		/* An MFT entry can be split over multiple segments if the cluster block size
+		 * is smaller than the MFT entry size, the chunk data is contiguous MFT data
+		 */
+		while( segment_data_offset < segment_size )
+		{
+			if( chunk == NULL )
+			{
+				if( mft_entry_index >= mft_scanner->mft->number_of_mft_entries )
+				{
+					break;
+				}
+				if( libfsntfs_mft_scanner_chunk_initialize(
+				     &chunk,
+				     mft_scanner,
+				     chunk_size,
+				     mft_entry_index,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create chunk.",
+					 function );
+
+					goto on_error;
+				}
+				chunk_data_size         = 0;
+				maximum_chunk_data_size = chunk_size;
+
+				if( (uint64_t) ( chunk_size / mft_entry_size ) > ( mft_scanner->mft->number_of_mft_entries - mft_entry_index ) )
+				{
+					maximum_chunk_data_size = (size_t) ( ( mft_scanner->mft->number_of_mft_entries - mft_entry_index ) * mft_entry_size );
+				}
+			}
+			read_size = maximum_chunk_data_size - chunk_data_size;
+
+			if( (size64_t) read_size > ( segment_size - segment_data_offset ) )
+			{
+				read_size = (size_t) ( segment_size - segment_data_offset );
+			}
+			if( libfsntfs_mft_read_data_at_offset(
+			     mft_scanner->mft,
+			     mft_scanner->io_handle,
+			     mft_scanner->file_io_handle,
+			     segment_offset + (off64_t) segment_data_offset,
+			     &( chunk->data[ chunk_data_size ] ),
+			     read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read MFT data from segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			segment_data_offset += read_size;
+			chunk_data_size     += read_size;
+
+			if( chunk_data_size < maximum_chunk_data_size )
+			{
+				continue;
+			}
+			mft_entry_index += chunk_data_size / mft_entry_size;
+
+			result = libfsntfs_ordered_queue_push(
+			          mft_scanner->queue,
+			          (intptr_t *) chunk,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push chunk.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			chunk = NULL;
+		}
+		if( result == 0 )
+		{
+			break;
+		}
+	}
+	/* Process the whole MFT entries of the last chunk
+	 */
+	if( ( result != 0 )
+	 && ( chunk != NULL ) )
+	{
+		chunk->data_size = chunk_data_size - ( chunk_data_size % (size_t) mft_entry_size );
+
+		if( chunk->data_size > 0 )
+		{
+			result = libfsntfs_ordered_queue_push(
+			          mft_scanner->queue,
+			          (intptr_t *) chunk,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push chunk.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				chunk = NULL;
+			}
+		}
+	}
+	if( chunk != NULL )
+	{
+		if( libfsntfs_mft_scanner_chunk_free(
+		     &chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Once stopped the queued chunks are not delivered
+	 */
+	result = libfsntfs_ordered_queue_join(
+	          mft_scanner->queue,
+	          (uint8_t) ( result != 0 ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to join queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_ordered_queue_free(
+	     &( mft_scanner->queue ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free queue.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( mft_scanner->queue != NULL )
+	{
+		/* Freeing the queue stops the worker threads before the queued chunks are freed
+		 */
+		libfsntfs_ordered_queue_free(
+		 &( mft_scanner->queue ),
+		 NULL );
+	}
+	if( chunk != NULL )
+	{
+		libfsntfs_mft_scanner_chunk_free(
+		 &chunk,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+/* Scans the MFT entries using multiple threads
+ * Falls back to a sequential scan if multi-threading support is not available
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
+ */
+int libfsntfs_mft_scan_parallel(
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint8_t flags,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libfsntfs_mft_scanner_t *mft_scanner = NULL;
+#endif
+	static char *function                = "libfsntfs_mft_scan_parallel";
+	int result                           = 0;
+
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( scan_flags & ~( LIBFSNTFS_SCAN_FLAG_UNORDERED ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported scan flags: 0x%02" PRIx8 ".",
+		 function,
+		 scan_flags );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libfsntfs_mft_scanner_initialize(
+	     &mft_scanner,
+	     mft,
+	     io_handle,
+	     file_io_handle,
+	     flags,
+	     scan_flags,
+	     callback_function,
+	     callback_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create MFT scanner.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_mft_scanner_scan(
+	          mft_scanner,
+	          number_of_threads,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to scan MFT.",
+		 function );
+
+		libfsntfs_mft_scanner_free(
+		 &mft_scanner,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libfsntfs_mft_scanner_free(
+	     &mft_scanner,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free MFT scanner.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	result = libfsntfs_mft_scan(
+	          mft,
+	          io_handle,
+	          file_io_handle,
+	          flags,
+	          callback_function,
+	          callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to scan MFT.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
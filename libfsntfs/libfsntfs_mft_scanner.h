@@ -0,0 +1,181 @@
+/*
+ * MFT scanner functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_MFT_SCANNER_H )
+#define _LIBFSNTFS_MFT_SCANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_io_handle.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_mft.h"
+#include "libfsntfs_ordered_queue.h"
+#include "libfsntfs_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+typedef struct libfsntfs_mft_scanner libfsntfs_mft_scanner_t;
+
+struct libfsntfs_mft_scanner
+{
+	/* The MFT
+	 */
+	libfsntfs_mft_t *mft;
+
+	/* The IO handle
+	 */
+	libfsntfs_io_handle_t *io_handle;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The file entry flags
+	 */
+	uint8_t flags;
+
+	/* The scan flags
+	 */
+	uint8_t scan_flags;
+
+	/* The callback function
+	 */
+	int (*callback_function)(
+	       libfsntfs_file_entry_t *file_entry,
+	       void *callback_data,
+	       libcerror_error_t **error );
+
+	/* The callback data
+	 */
+	void *callback_data;
+
+	/* The ordered queue of chunks
+	 */
+	libfsntfs_ordered_queue_t *queue;
+};
+
+typedef struct libfsntfs_mft_scanner_chunk libfsntfs_mft_scanner_chunk_t;
+
+struct libfsntfs_mft_scanner_chunk
+{
+	/* The scanner
+	 */
+	libfsntfs_mft_scanner_t *scanner;
+
+	/* The MFT entries data
+	 */
+	uint8_t *data;
+
+	/* The MFT entries data size
+	 */
+	size_t data_size;
+
+	/* The index of the first MFT entry in the data
+	 */
+	uint64_t first_mft_entry_index;
+
+	/* The file entries, used when the callbacks are delivered in MFT order
+	 */
+	libfsntfs_file_entry_t **file_entries;
+
+	/* The number of file entries
+	 */
+	int number_of_file_entries;
+};
+
+int libfsntfs_mft_scanner_initialize(
+     libfsntfs_mft_scanner_t **mft_scanner,
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint8_t flags,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scanner_free(
+     libfsntfs_mft_scanner_t **mft_scanner,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scanner_chunk_initialize(
+     libfsntfs_mft_scanner_chunk_t **chunk,
+     libfsntfs_mft_scanner_t *mft_scanner,
+     size_t data_size,
+     uint64_t first_mft_entry_index,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scanner_chunk_free(
+     libfsntfs_mft_scanner_chunk_t **chunk,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scanner_read_file_entry(
+     libfsntfs_mft_scanner_t *mft_scanner,
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t mft_entry_index,
+     libfsntfs_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scanner_chunk_read_file_entries(
+     libfsntfs_mft_scanner_chunk_t *chunk,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scanner_chunk_deliver(
+     libfsntfs_mft_scanner_chunk_t *chunk,
+     libcerror_error_t **error );
+
+int libfsntfs_mft_scanner_scan(
+     libfsntfs_mft_scanner_t *mft_scanner,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+int libfsntfs_mft_scan_parallel(
+     libfsntfs_mft_t *mft,
+     libfsntfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     uint8_t flags,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -0,0 +1,1155 @@
+/*
+ * Ordered queue functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+#include "libfsntfs_ordered_queue.h"
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+/* Creates an ordered queue
+ * The values pushed onto the queue are processed by a pool of worker threads
+ * and delivered by the calling thread in the order they were pushed
+ * Make sure the value ordered_queue is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_ordered_queue_initialize(
+     libfsntfs_ordered_queue_t **ordered_queue,
+     int number_of_threads,
+     int (*process_function)(
+            intptr_t *value,
+            libcerror_error_t **error ),
+     int (*deliver_function)(
+            intptr_t *value,
+            libcerror_error_t **error ),
+     int (*free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_ordered_queue_initialize";
+
+	if( ordered_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ordered queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ordered_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid ordered queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > ( INT_MAX / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process function.",
+		 function );
+
+		return( -1 );
+	}
+	if( deliver_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid deliver function.",
+		 function );
+
+		return( -1 );
+	}
+	if( free_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid free function.",
+		 function );
+
+		return( -1 );
+	}
+	*ordered_queue = memory_allocate_structure(
+	                  libfsntfs_ordered_queue_t );
+
+	if( *ordered_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ordered queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *ordered_queue,
+	     0,
+	     sizeof( libfsntfs_ordered_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ordered queue.",
+		 function );
+
+		memory_free(
+		 *ordered_queue );
+
+		*ordered_queue = NULL;
+
+		return( -1 );
+	}
+	/* Limit the number of entries that are queued ahead of the worker threads
+	 */
+	( *ordered_queue )->maximum_number_of_entries = number_of_threads * 2;
+
+	( *ordered_queue )->entries = (libfsntfs_ordered_queue_entry_t **) memory_allocate(
+	                                                                    sizeof( libfsntfs_ordered_queue_entry_t * ) * ( *ordered_queue )->maximum_number_of_entries );
+
+	if( ( *ordered_queue )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *ordered_queue )->entries,
+	     0,
+	     sizeof( libfsntfs_ordered_queue_entry_t * ) * ( *ordered_queue )->maximum_number_of_entries ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *ordered_queue )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *ordered_queue )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *ordered_queue )->process_function = process_function;
+	( *ordered_queue )->deliver_function = deliver_function;
+	( *ordered_queue )->free_function    = free_function;
+
+	if( libcthreads_thread_pool_create(
+	     &( ( *ordered_queue )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     ( *ordered_queue )->maximum_number_of_entries,
+	     (int (*)(intptr_t *, void *)) &libfsntfs_ordered_queue_process_entry,
+	     (void *) *ordered_queue,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *ordered_queue != NULL )
+	{
+		if( ( *ordered_queue )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *ordered_queue )->condition ),
+			 NULL );
+		}
+		if( ( *ordered_queue )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *ordered_queue )->mutex ),
+			 NULL );
+		}
+		if( ( *ordered_queue )->entries != NULL )
+		{
+			memory_free(
+			 ( *ordered_queue )->entries );
+		}
+		memory_free(
+		 *ordered_queue );
+
+		*ordered_queue = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an ordered queue
+ * If the worker threads were not joined the queued entries are freed without being delivered
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_ordered_queue_free(
+     libfsntfs_ordered_queue_t **ordered_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_ordered_queue_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( ordered_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ordered queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ordered_queue != NULL )
+	{
+		if( ( *ordered_queue )->thread_pool != NULL )
+		{
+			/* Make sure the worker threads stop processing before the entries are freed
+			 */
+			libfsntfs_ordered_queue_set_abort(
+			 *ordered_queue,
+			 NULL );
+
+			while( ( *ordered_queue )->number_of_entries > 0 )
+			{
+				if( libfsntfs_ordered_queue_complete_entry(
+				     *ordered_queue,
+				     0,
+				     NULL ) == -1 )
+				{
+					break;
+				}
+			}
+			if( libcthreads_thread_pool_join(
+			     &( ( *ordered_queue )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( entry_index = 0;
+		     entry_index < ( *ordered_queue )->maximum_number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *ordered_queue )->entries[ entry_index ] != NULL )
+			{
+				if( libfsntfs_ordered_queue_entry_free(
+				     &( ( *ordered_queue )->entries[ entry_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free entry: %d.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 ( *ordered_queue )->entries );
+
+		if( libcthreads_condition_free(
+		     &( ( *ordered_queue )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *ordered_queue )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *ordered_queue );
+
+		*ordered_queue = NULL;
+	}
+	return( result );
+}
+
+/* Creates an ordered queue entry
+ * Make sure the value entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_ordered_queue_entry_initialize(
+     libfsntfs_ordered_queue_entry_t **entry,
+     libfsntfs_ordered_queue_t *ordered_queue,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_ordered_queue_entry_initialize";
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ordered_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ordered queue.",
+		 function );
+
+		return( -1 );
+	}
+	*entry = memory_allocate_structure(
+	          libfsntfs_ordered_queue_entry_t );
+
+	if( *entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *entry,
+	     0,
+	     sizeof( libfsntfs_ordered_queue_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entry.",
+		 function );
+
+		memory_free(
+		 *entry );
+
+		*entry = NULL;
+
+		return( -1 );
+	}
+	( *entry )->queue = ordered_queue;
+	( *entry )->value = value;
+
+	return( 1 );
+}
+
+/* Frees an ordered queue entry and its value
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_ordered_queue_entry_free(
+     libfsntfs_ordered_queue_entry_t **entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_ordered_queue_entry_free";
+	int result            = 1;
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *entry != NULL )
+	{
+		/* The queue reference is freed elsewhere
+		 */
+		if( ( *entry )->value != NULL )
+		{
+			if( ( *entry )->queue->free_function(
+			     &( ( *entry )->value ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free value.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *entry )->error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *entry )->error ) );
+		}
+		memory_free(
+		 *entry );
+
+		*entry = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the abort value of the ordered queue
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_ordered_queue_get_abort(
+     libfsntfs_ordered_queue_t *ordered_queue,
+     int *abort,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_ordered_queue_get_abort";
+
+	if( ordered_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ordered queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( abort == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid abort.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     ordered_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*abort = ordered_queue->abort;
+
+	if( libcthreads_mutex_release(
+	     ordered_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Signals the ordered queue to abort
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_ordered_queue_set_abort(
+     libfsntfs_ordered_queue_t *ordered_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_ordered_queue_set_abort";
+
+	if( ordered_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ordered queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     ordered_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	ordered_queue->abort = 1;
+
+	if( libcthreads_mutex_release(
+	     ordered_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Processes an ordered queue entry
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_ordered_queue_process_entry(
+     libfsntfs_ordered_queue_entry_t *entry,
+     libfsntfs_ordered_queue_t *ordered_queue )
+{
+	int result = 0;
+
+	if( ( entry == NULL )
+	 || ( ordered_queue == NULL ) )
+	{
+		return( -1 );
+	}
+	result = ordered_queue->process_function(
+	          entry->value,
+	          &( entry->error ) );
+
+	if( result == -1 )
+	{
+		/* Make sure the other entries are not processed
+		 */
+		libfsntfs_ordered_queue_set_abort(
+		 ordered_queue,
+		 NULL );
+	}
+	if( libcthreads_mutex_grab(
+	     ordered_queue->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	entry->result       = result;
+	entry->is_processed = 1;
+
+	libcthreads_condition_broadcast(
+	 ordered_queue->condition,
+	 NULL );
+
+	if( libcthreads_mutex_release(
+	     ordered_queue->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits until an ordered queue entry was processed
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_ordered_queue_entry_wait(
+     libfsntfs_ordered_queue_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_ordered_queue_entry_wait";
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid entry - missing queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     entry->queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( entry->is_processed == 0 )
+	{
+		if( libcthreads_condition_wait(
+		     entry->queue->condition,
+		     entry->queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 entry->queue->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     entry->queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Delivers the value of a processed ordered queue entry
+ * Returns 1 if successful, 0 if stopped or -1 on error
+ */
+int libfsntfs_ordered_queue_entry_deliver(
+     libfsntfs_ordered_queue_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_ordered_queue_entry_deliver";
+	int result            = 0;
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid entry - missing queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->result == -1 )
+	{
+		/* Pass the error of the worker thread to the caller
+		 */
+		if( ( error != NULL )
+		 && ( *error == NULL ) )
+		{
+			*error = entry->error;
+
+			entry->error = NULL;
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process entry.",
+		 function );
+
+		return( -1 );
+	}
+	else if( entry->result == 0 )
+	{
+		return( 0 );
+	}
+	result = entry->queue->deliver_function(
+	          entry->value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to deliver value.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Waits until the oldest queued entry was processed, delivers its value and frees it
+ * Returns 1 if successful, 0 if stopped or -1 on error
+ */
+int libfsntfs_ordered_queue_complete_entry(
+     libfsntfs_ordered_queue_t *ordered_queue,
+     uint8_t deliver,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_ordered_queue_complete_entry";
+	int result            = 1;
+
+	if( ordered_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ordered queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( ordered_queue->number_of_entries == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid ordered queue - number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_ordered_queue_entry_wait(
+	     ordered_queue->entries[ ordered_queue->first_entry_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to wait for entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( deliver != 0 )
+	{
+		result = libfsntfs_ordered_queue_entry_deliver(
+		          ordered_queue->entries[ ordered_queue->first_entry_index ],
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to deliver entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libfsntfs_ordered_queue_entry_free(
+	     &( ordered_queue->entries[ ordered_queue->first_entry_index ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free entry.",
+		 function );
+
+		return( -1 );
+	}
+	ordered_queue->first_entry_index = ( ordered_queue->first_entry_index + 1 ) % ordered_queue->maximum_number_of_entries;
+
+	ordered_queue->number_of_entries -= 1;
+
+	return( result );
+}
+
+/* Queues a value to be processed by the thread pool
+ * If the maximum number of queued entries was reached the oldest entry is completed first
+ * The queue takes over management of the value if successful
+ * Returns 1 if successful, 0 if stopped or -1 on error
+ */
+int libfsntfs_ordered_queue_push(
+     libfsntfs_ordered_queue_t *ordered_queue,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	libfsntfs_ordered_queue_entry_t *entry = NULL;
+	static char *function                  = "libfsntfs_ordered_queue_push";
+	int entry_index                        = 0;
+	int result                             = 0;
+
+	if( ordered_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ordered queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( ordered_queue->thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid ordered queue - missing thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ordered_queue->number_of_entries == ordered_queue->maximum_number_of_entries )
+	{
+		result = libfsntfs_ordered_queue_complete_entry(
+		          ordered_queue,
+		          1,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to complete entry.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	if( libfsntfs_ordered_queue_entry_initialize(
+	     &entry,
+	     ordered_queue,
+	     value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create entry.",
+		 function );
+
+		return( -1 );
+	}
+	entry_index = ( ordered_queue->first_entry_index + ordered_queue->number_of_entries ) % ordered_queue->maximum_number_of_entries;
+
+	ordered_queue->entries[ entry_index ] = entry;
+	ordered_queue->number_of_entries     += 1;
+
+	if( libcthreads_thread_pool_push(
+	     ordered_queue->thread_pool,
+	     (intptr_t *) entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push entry onto thread pool.",
+		 function );
+
+		/* The entry was not queued, the value remains managed by the caller
+		 */
+		ordered_queue->entries[ entry_index ] = NULL;
+		ordered_queue->number_of_entries     -= 1;
+
+		entry->value = NULL;
+
+		libfsntfs_ordered_queue_entry_free(
+		 &entry,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Completes the queued entries in queue order and joins the worker threads
+ * If deliver is 0 the queued entries are freed without being delivered
+ * Returns 1 if successful, 0 if stopped or -1 on error
+ */
+int libfsntfs_ordered_queue_join(
+     libfsntfs_ordered_queue_t *ordered_queue,
+     uint8_t deliver,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_ordered_queue_join";
+	int result            = 0;
+
+	if( ordered_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ordered queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( ordered_queue->thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid ordered queue - missing thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( deliver != 0 )
+	{
+		result = 1;
+	}
+	else
+	{
+		/* Make sure the worker threads stop processing the queued entries
+		 */
+		if( libfsntfs_ordered_queue_set_abort(
+		     ordered_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( ordered_queue->number_of_entries > 0 )
+	{
+		/* Once stopped the remaining entries are not delivered
+		 */
+		deliver = (uint8_t) ( result != 0 );
+
+		result = libfsntfs_ordered_queue_complete_entry(
+		          ordered_queue,
+		          deliver,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to complete entry.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			if( libfsntfs_ordered_queue_set_abort(
+			     ordered_queue,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set abort.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( deliver == 0 )
+		{
+			result = 0;
+		}
+	}
+	if( libcthreads_thread_pool_join(
+	     &( ordered_queue->thread_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
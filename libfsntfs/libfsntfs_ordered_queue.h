@@ -0,0 +1,188 @@
+/*
+ * Ordered queue functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_ORDERED_QUEUE_H )
+#define _LIBFSNTFS_ORDERED_QUEUE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+typedef struct libfsntfs_ordered_queue libfsntfs_ordered_queue_t;
+
+struct libfsntfs_ordered_queue
+{
+	/* The process function, called by the worker threads
+	 */
+	int (*process_function)(
+	       intptr_t *value,
+	       libcerror_error_t **error );
+
+	/* The deliver function, called by the calling thread in queue order
+	 */
+	int (*deliver_function)(
+	       intptr_t *value,
+	       libcerror_error_t **error );
+
+	/* The value free function
+	 */
+	int (*free_function)(
+	       intptr_t **value,
+	       libcerror_error_t **error );
+
+	/* The mutex that protects the entry states and the abort value
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when an entry was processed
+	 */
+	libcthreads_condition_t *condition;
+
+	/* Value to indicate the processing should abort
+	 */
+	int abort;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The queued entries, in queue order
+	 */
+	struct libfsntfs_ordered_queue_entry **entries;
+
+	/* The maximum number of queued entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The index of the first queued entry
+	 */
+	int first_entry_index;
+
+	/* The number of queued entries
+	 */
+	int number_of_entries;
+};
+
+typedef struct libfsntfs_ordered_queue_entry libfsntfs_ordered_queue_entry_t;
+
+struct libfsntfs_ordered_queue_entry
+{
+	/* The queue
+	 */
+	libfsntfs_ordered_queue_t *queue;
+
+	/* The value
+	 */
+	intptr_t *value;
+
+	/* Value to indicate the entry was processed
+	 */
+	int is_processed;
+
+	/* The result of processing the entry
+	 */
+	int result;
+
+	/* The error of processing the entry
+	 */
+	libcerror_error_t *error;
+};
+
+int libfsntfs_ordered_queue_initialize(
+     libfsntfs_ordered_queue_t **ordered_queue,
+     int number_of_threads,
+     int (*process_function)(
+            intptr_t *value,
+            libcerror_error_t **error ),
+     int (*deliver_function)(
+            intptr_t *value,
+            libcerror_error_t **error ),
+     int (*free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libfsntfs_ordered_queue_free(
+     libfsntfs_ordered_queue_t **ordered_queue,
+     libcerror_error_t **error );
+
+int libfsntfs_ordered_queue_entry_initialize(
+     libfsntfs_ordered_queue_entry_t **entry,
+     libfsntfs_ordered_queue_t *ordered_queue,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+int libfsntfs_ordered_queue_entry_free(
+     libfsntfs_ordered_queue_entry_t **entry,
+     libcerror_error_t **error );
+
+int libfsntfs_ordered_queue_get_abort(
+     libfsntfs_ordered_queue_t *ordered_queue,
+     int *abort,
+     libcerror_error_t **error );
+
+int libfsntfs_ordered_queue_set_abort(
+     libfsntfs_ordered_queue_t *ordered_queue,
+     libcerror_error_t **error );
+
+int libfsntfs_ordered_queue_process_entry(
+     libfsntfs_ordered_queue_entry_t *entry,
+     libfsntfs_ordered_queue_t *ordered_queue );
+
+int libfsntfs_ordered_queue_entry_wait(
+     libfsntfs_ordered_queue_entry_t *entry,
+     libcerror_error_t **error );
+
+int libfsntfs_ordered_queue_entry_deliver(
+     libfsntfs_ordered_queue_entry_t *entry,
+     libcerror_error_t **error );
+
+int libfsntfs_ordered_queue_complete_entry(
+     libfsntfs_ordered_queue_t *ordered_queue,
+     uint8_t deliver,
+     libcerror_error_t **error );
+
+int libfsntfs_ordered_queue_push(
+     libfsntfs_ordered_queue_t *ordered_queue,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+int libfsntfs_ordered_queue_join(
+     libfsntfs_ordered_queue_t *ordered_queue,
+     uint8_t deliver,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
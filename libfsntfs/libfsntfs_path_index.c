@@ -0,0 +1,2165 @@
+/*
+ * Path index functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_attribute.h"
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_file_entry.h"
+#include "libfsntfs_file_name_values.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+#include "libfsntfs_libuna.h"
+#include "libfsntfs_mft_entry.h"
+#include "libfsntfs_path_index.h"
+
+/* Creates a path index
+ * Make sure the value path_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_index_initialize(
+     libfsntfs_path_index_t **path_index,
+     uint64_t number_of_entries,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_path_index_t *internal_path_index = NULL;
+	static char *function                                = "libfsntfs_path_index_initialize";
+	size_t entries_size                                  = 0;
+	size_t name_hash_table_size                          = 0;
+
+	if( path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid path index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries > ( (uint64_t) SSIZE_MAX / sizeof( libfsntfs_path_index_entry_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of entries value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	internal_path_index = memory_allocate_structure(
+	                       libfsntfs_internal_path_index_t );
+
+	if( internal_path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_path_index,
+	     0,
+	     sizeof( libfsntfs_internal_path_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear path index.",
+		 function );
+
+		memory_free(
+		 internal_path_index );
+
+		return( -1 );
+	}
+	if( number_of_entries > 0 )
+	{
+		entries_size = sizeof( libfsntfs_path_index_entry_t ) * (size_t) number_of_entries;
+
+		internal_path_index->entries = (libfsntfs_path_index_entry_t *) memory_allocate(
+		                                                                 entries_size );
+
+		if( internal_path_index->entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     internal_path_index->entries,
+		     0,
+		     entries_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_path_index->number_of_entries = number_of_entries;
+
+	internal_path_index->number_of_name_hash_table_slots = LIBFSNTFS_PATH_INDEX_INITIAL_NUMBER_OF_NAME_HASH_TABLE_SLOTS;
+
+	name_hash_table_size = sizeof( uint32_t ) * internal_path_index->number_of_name_hash_table_slots;
+
+	internal_path_index->name_hash_table = (uint32_t *) memory_allocate(
+	                                                     name_hash_table_size );
+
+	if( internal_path_index->name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name hash table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_path_index->name_hash_table,
+	     0,
+	     name_hash_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear name hash table.",
+		 function );
+
+		goto on_error;
+	}
+	/* The path of the orphan directory is stored at the start of the paths data
+	 */
+	if( libfsntfs_internal_path_index_append_data(
+	     &( internal_path_index->paths_data ),
+	     &( internal_path_index->paths_data_size ),
+	     &( internal_path_index->allocated_paths_data_size ),
+	     (uint8_t *) LIBFSNTFS_PATH_INDEX_ORPHAN_PATH,
+	     sizeof( LIBFSNTFS_PATH_INDEX_ORPHAN_PATH ) - 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append orphan path.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_path_index->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	*path_index = (libfsntfs_path_index_t *) internal_path_index;
+
+	return( 1 );
+
+on_error:
+	if( internal_path_index != NULL )
+	{
+		if( internal_path_index->paths_data != NULL )
+		{
+			memory_free(
+			 internal_path_index->paths_data );
+		}
+		if( internal_path_index->name_hash_table != NULL )
+		{
+			memory_free(
+			 internal_path_index->name_hash_table );
+		}
+		if( internal_path_index->entries != NULL )
+		{
+			memory_free(
+			 internal_path_index->entries );
+		}
+		memory_free(
+		 internal_path_index );
+	}
+	return( -1 );
+}
+
+/* Frees a path index
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_index_free(
+     libfsntfs_path_index_t **path_index,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_path_index_t *internal_path_index = NULL;
+	static char *function                                = "libfsntfs_path_index_free";
+	int result                                           = 1;
+
+	if( path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_index != NULL )
+	{
+		internal_path_index = (libfsntfs_internal_path_index_t *) *path_index;
+		*path_index         = NULL;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( internal_path_index->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( internal_path_index->paths_data != NULL )
+		{
+			memory_free(
+			 internal_path_index->paths_data );
+		}
+		if( internal_path_index->names_data != NULL )
+		{
+			memory_free(
+			 internal_path_index->names_data );
+		}
+		if( internal_path_index->name_hash_table != NULL )
+		{
+			memory_free(
+			 internal_path_index->name_hash_table );
+		}
+		if( internal_path_index->entries != NULL )
+		{
+			memory_free(
+			 internal_path_index->entries );
+		}
+		memory_free(
+		 internal_path_index );
+	}
+	return( result );
+}
+
+/* Resizes the data of a names or paths data buffer
+ * The allocated size is doubled until the required size fits
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_path_index_resize_data(
+     uint8_t **data,
+     size_t *allocated_data_size,
+     size_t required_data_size,
+     libcerror_error_t **error )
+{
+	void *reallocation         = NULL;
+	static char *function      = "libfsntfs_internal_path_index_resize_data";
+	size_t safe_allocated_size = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocated_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocated data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( required_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid required data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( required_data_size <= *allocated_data_size )
+	{
+		return( 1 );
+	}
+	safe_allocated_size = *allocated_data_size;
+
+	if( safe_allocated_size == 0 )
+	{
+		safe_allocated_size = LIBFSNTFS_PATH_INDEX_INITIAL_DATA_SIZE;
+	}
+	while( safe_allocated_size < required_data_size )
+	{
+		if( safe_allocated_size > ( (size_t) SSIZE_MAX / 2 ) )
+		{
+			safe_allocated_size = (size_t) SSIZE_MAX;
+
+			break;
+		}
+		safe_allocated_size *= 2;
+	}
+	reallocation = memory_reallocate(
+	                *data,
+	                sizeof( uint8_t ) * safe_allocated_size );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize data.",
+		 function );
+
+		return( -1 );
+	}
+	*data                = (uint8_t *) reallocation;
+	*allocated_data_size = safe_allocated_size;
+
+	return( 1 );
+}
+
+/* Appends data to a names or paths data buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_path_index_append_data(
+     uint8_t **data,
+     size_t *data_size,
+     size_t *allocated_data_size,
+     const uint8_t *append_data,
+     size_t append_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_internal_path_index_append_data";
+
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( append_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid append data.",
+		 function );
+
+		return( -1 );
+	}
+	if( append_data_size > ( (size_t) SSIZE_MAX - *data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid append data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_internal_path_index_resize_data(
+	     data,
+	     allocated_data_size,
+	     *data_size + append_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize data.",
+		 function );
+
+		return( -1 );
+	}
+	if( append_data_size > 0 )
+	{
+		if( memory_copy(
+		     &( ( *data )[ *data_size ] ),
+		     append_data,
+		     append_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*data_size += append_data_size;
+
+	return( 1 );
+}
+
+/* Calculates the FNV-1a hash of a name
+ * Returns the hash
+ */
+uint32_t libfsntfs_internal_path_index_get_name_hash(
+          const uint8_t *name,
+          uint16_t name_size )
+{
+	uint32_t hash       = 0x811c9dc5UL;
+	uint16_t name_index = 0;
+
+	for( name_index = 0;
+	     name_index < name_size;
+	     name_index++ )
+	{
+		hash ^= (uint32_t) name[ name_index ];
+		hash *= 0x01000193UL;
+	}
+	return( hash );
+}
+
+/* Doubles the number of slots of the name hash table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_path_index_resize_name_hash_table(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     libcerror_error_t **error )
+{
+	uint32_t *name_hash_table   = NULL;
+	static char *function       = "libfsntfs_internal_path_index_resize_name_hash_table";
+	size_t name_hash_table_size = 0;
+	uint32_t hash               = 0;
+	uint32_t number_of_slots    = 0;
+	uint32_t record_offset      = 0;
+	uint32_t slot_index         = 0;
+	uint32_t table_index        = 0;
+	uint16_t name_size          = 0;
+
+	if( internal_path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_path_index->number_of_name_hash_table_slots > ( (uint32_t) INT32_MAX / 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path index - number of name hash table slots value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_slots      = internal_path_index->number_of_name_hash_table_slots * 2;
+	name_hash_table_size = sizeof( uint32_t ) * number_of_slots;
+
+	name_hash_table = (uint32_t *) memory_allocate(
+	                                name_hash_table_size );
+
+	if( name_hash_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name hash table.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     name_hash_table,
+	     0,
+	     name_hash_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear name hash table.",
+		 function );
+
+		memory_free(
+		 name_hash_table );
+
+		return( -1 );
+	}
+	for( table_index = 0;
+	     table_index < internal_path_index->number_of_name_hash_table_slots;
+	     table_index++ )
+	{
+		if( internal_path_index->name_hash_table[ table_index ] == 0 )
+		{
+			continue;
+		}
+		record_offset = internal_path_index->name_hash_table[ table_index ] - 1;
+
+		byte_stream_copy_to_uint16_little_endian(
+		 &( internal_path_index->names_data[ record_offset ] ),
+		 name_size );
+
+		hash = libfsntfs_internal_path_index_get_name_hash(
+		        &( internal_path_index->names_data[ record_offset + 2 ] ),
+		        name_size );
+
+		slot_index = hash & ( number_of_slots - 1 );
+
+		while( name_hash_table[ slot_index ] != 0 )
+		{
+			slot_index = ( slot_index + 1 ) & ( number_of_slots - 1 );
+		}
+		name_hash_table[ slot_index ] = record_offset + 1;
+	}
+	memory_free(
+	 internal_path_index->name_hash_table );
+
+	internal_path_index->name_hash_table                 = name_hash_table;
+	internal_path_index->number_of_name_hash_table_slots = number_of_slots;
+
+	return( 1 );
+}
+
+/* Interns an UTF-8 encoded name
+ * Every distinct name is stored once in the names data, prefixed by its 16-bit size
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_path_index_intern_name(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     const uint8_t *name,
+     uint16_t name_size,
+     uint32_t *name_offset,
+     libcerror_error_t **error )
+{
+	uint8_t name_size_data[ 2 ];
+
+	static char *function     = "libfsntfs_internal_path_index_intern_name";
+	uint32_t hash             = 0;
+	uint32_t record_offset    = 0;
+	uint32_t slot_index       = 0;
+	uint16_t record_name_size = 0;
+
+	if( internal_path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* Keep the load factor of the name hash table at or below 1/2
+	 */
+	if( internal_path_index->number_of_names >= ( internal_path_index->number_of_name_hash_table_slots / 2 ) )
+	{
+		if( libfsntfs_internal_path_index_resize_name_hash_table(
+		     internal_path_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize name hash table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	hash = libfsntfs_internal_path_index_get_name_hash(
+	        name,
+	        name_size );
+
+	slot_index = hash & ( internal_path_index->number_of_name_hash_table_slots - 1 );
+
+	while( internal_path_index->name_hash_table[ slot_index ] != 0 )
+	{
+		record_offset = internal_path_index->name_hash_table[ slot_index ] - 1;
+
+		byte_stream_copy_to_uint16_little_endian(
+		 &( internal_path_index->names_data[ record_offset ] ),
+		 record_name_size );
+
+		if( ( record_name_size == name_size )
+		 && ( memory_compare(
+		       &( internal_path_index->names_data[ record_offset + 2 ] ),
+		       name,
+		       name_size ) == 0 ) )
+		{
+			*name_offset = record_offset + 2;
+
+			return( 1 );
+		}
+		slot_index = ( slot_index + 1 ) & ( internal_path_index->number_of_name_hash_table_slots - 1 );
+	}
+	if( ( internal_path_index->names_data_size + 2 + name_size ) >= (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path index - names data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	record_offset = (uint32_t) internal_path_index->names_data_size;
+
+	byte_stream_copy_from_uint16_little_endian(
+	 name_size_data,
+	 name_size );
+
+	if( libfsntfs_internal_path_index_append_data(
+	     &( internal_path_index->names_data ),
+	     &( internal_path_index->names_data_size ),
+	     &( internal_path_index->allocated_names_data_size ),
+	     name_size_data,
+	     2,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append name size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_internal_path_index_append_data(
+	     &( internal_path_index->names_data ),
+	     &( internal_path_index->names_data_size ),
+	     &( internal_path_index->allocated_names_data_size ),
+	     name,
+	     (size_t) name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append name.",
+		 function );
+
+		return( -1 );
+	}
+	internal_path_index->name_hash_table[ slot_index ] = record_offset + 1;
+
+	internal_path_index->number_of_names += 1;
+
+	*name_offset = record_offset + 2;
+
+	return( 1 );
+}
+
+/* Reads the path index entry of a file entry
+ * This function is used as the callback function of the MFT scan
+ * The name of the entry is taken from the first $FILE_NAME attribute that is not
+ * in the DOS namespace, or the DOS name if that is the only name
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_index_read_file_entry(
+     libfsntfs_file_entry_t *file_entry,
+     void *path_index,
+     libcerror_error_t **error )
+{
+	uint8_t name[ LIBFSNTFS_PATH_INDEX_MAXIMUM_NAME_SIZE ];
+
+	libfsntfs_attribute_t *attribute                     = NULL;
+	libfsntfs_file_name_values_t *file_name_values       = NULL;
+	libfsntfs_file_name_values_t *name_file_name_values  = NULL;
+	libfsntfs_internal_file_entry_t *internal_file_entry = NULL;
+	libfsntfs_internal_path_index_t *internal_path_index = NULL;
+	libfsntfs_mft_entry_t *mft_entry                     = NULL;
+	libfsntfs_path_index_entry_t *path_index_entry       = NULL;
+	static char *function                                = "libfsntfs_path_index_read_file_entry";
+	size_t name_size                                     = 0;
+	uint32_t attribute_type                              = 0;
+	uint32_t name_offset                                 = 0;
+	int attribute_index                                  = 0;
+	int number_of_attributes                             = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfsntfs_internal_file_entry_t *) file_entry;
+
+	if( path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_path_index = (libfsntfs_internal_path_index_t *) path_index;
+
+	mft_entry = internal_file_entry->mft_entry;
+
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	/* Extension records are part of the entry of their base record
+	 */
+	if( ( mft_entry->base_record_file_reference != 0 )
+	 || ( (uint64_t) mft_entry->index >= internal_path_index->number_of_entries ) )
+	{
+		return( 1 );
+	}
+	path_index_entry = &( internal_path_index->entries[ mft_entry->index ] );
+
+	path_index_entry->sequence = mft_entry->sequence;
+
+	if( ( mft_entry->flags & LIBFSNTFS_MFT_ENTRY_FLAG_IN_USE ) != 0 )
+	{
+		path_index_entry->flags |= LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_IN_USE;
+	}
+	if( libfsntfs_mft_entry_get_number_of_attributes(
+	     mft_entry,
+	     &number_of_attributes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of attributes.",
+		 function );
+
+		return( -1 );
+	}
+	for( attribute_index = 0;
+	     attribute_index < number_of_attributes;
+	     attribute_index++ )
+	{
+		if( libfsntfs_mft_entry_get_attribute_by_index(
+		     mft_entry,
+		     attribute_index,
+		     &attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve attribute: %d.",
+			 function,
+			 attribute_index );
+
+			return( -1 );
+		}
+		if( libfsntfs_attribute_get_type(
+		     attribute,
+		     &attribute_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve attribute: %d type.",
+			 function,
+			 attribute_index );
+
+			return( -1 );
+		}
+		if( attribute_type != LIBFSNTFS_ATTRIBUTE_TYPE_FILE_NAME )
+		{
+			continue;
+		}
+		if( libfsntfs_attribute_get_value(
+		     attribute,
+		     (intptr_t **) &file_name_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve attribute: %d value.",
+			 function,
+			 attribute_index );
+
+			return( -1 );
+		}
+		if( file_name_values == NULL )
+		{
+			continue;
+		}
+		if( name_file_name_values == NULL )
+		{
+			name_file_name_values = file_name_values;
+		}
+		if( file_name_values->name_namespace != LIBFSNTFS_FILE_NAME_NAMESPACE_DOS )
+		{
+			name_file_name_values = file_name_values;
+
+			break;
+		}
+	}
+	if( name_file_name_values == NULL )
+	{
+		return( 1 );
+	}
+	if( libfsntfs_file_name_values_get_utf8_name_size(
+	     name_file_name_values,
+	     &name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 name size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_size == 0 )
+	 || ( name_size > (size_t) LIBFSNTFS_PATH_INDEX_MAXIMUM_NAME_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid UTF-8 name size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_file_name_values_get_utf8_name(
+	     name_file_name_values,
+	     name,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 name.",
+		 function );
+
+		return( -1 );
+	}
+	/* The name size includes the end of string character
+	 */
+	name_size -= 1;
+
+	if( libfsntfs_internal_path_index_intern_name(
+	     internal_path_index,
+	     name,
+	     (uint16_t) name_size,
+	     &name_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to intern name.",
+		 function );
+
+		return( -1 );
+	}
+	path_index_entry->parent_file_reference = name_file_name_values->parent_file_reference;
+	path_index_entry->name_offset           = name_offset;
+	path_index_entry->name_size             = (uint16_t) name_size;
+	path_index_entry->flags                |= LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_HAS_NAME;
+
+	return( 1 );
+}
+
+/* Retrieves the index of the parent entry
+ * The parent is valid if it has a name and its sequence matches the sequence in the
+ * parent file reference. A parent that is no longer in use is also valid if its sequence
+ * was incremented by 1, since the sequence is incremented when an MFT entry is freed.
+ * A sequence of 0 in the parent file reference matches any sequence.
+ * Returns 1 if successful, 0 if the entry is an orphan or -1 on error
+ */
+int libfsntfs_internal_path_index_get_parent_entry_index(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     uint64_t mft_entry_index,
+     uint64_t *parent_entry_index,
+     libcerror_error_t **error )
+{
+	libfsntfs_path_index_entry_t *parent_path_index_entry = NULL;
+	libfsntfs_path_index_entry_t *path_index_entry        = NULL;
+	static char *function                                 = "libfsntfs_internal_path_index_get_parent_entry_index";
+	uint64_t safe_parent_entry_index                      = 0;
+	uint16_t parent_sequence                              = 0;
+
+	if( internal_path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry_index >= internal_path_index->number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent entry index.",
+		 function );
+
+		return( -1 );
+	}
+	path_index_entry = &( internal_path_index->entries[ mft_entry_index ] );
+
+	safe_parent_entry_index = path_index_entry->parent_file_reference & 0xffffffffffffUL;
+	parent_sequence         = (uint16_t) ( path_index_entry->parent_file_reference >> 48 );
+
+	if( ( safe_parent_entry_index >= internal_path_index->number_of_entries )
+	 || ( safe_parent_entry_index == mft_entry_index ) )
+	{
+		return( 0 );
+	}
+	parent_path_index_entry = &( internal_path_index->entries[ safe_parent_entry_index ] );
+
+	if( ( parent_path_index_entry->flags & LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_HAS_NAME ) == 0 )
+	{
+		return( 0 );
+	}
+	if( ( parent_sequence != 0 )
+	 && ( parent_sequence != parent_path_index_entry->sequence ) )
+	{
+		if( ( ( parent_path_index_entry->flags & LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_IN_USE ) != 0 )
+		 || ( (uint16_t) ( parent_sequence + 1 ) != parent_path_index_entry->sequence ) )
+		{
+			return( 0 );
+		}
+	}
+	*parent_entry_index = safe_parent_entry_index;
+
+	return( 1 );
+}
+
+/* Resolves the path of a directory entry
+ * The path is memoized in the paths data, the path of the root directory is empty
+ * Orphans, parent cycles and paths deeper than the maximum recursion depth are placed
+ * in the orphan directory
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_path_index_resolve_path(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     uint64_t mft_entry_index,
+     int recursion_depth,
+     size_t *path_offset,
+     size_t *path_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_path_index_entry_t *path_index_entry = NULL;
+	static char *function                          = "libfsntfs_internal_path_index_resolve_path";
+	size_t parent_path_offset                      = 0;
+	size_t parent_path_size                        = 0;
+	size_t safe_path_offset                        = 0;
+	size_t safe_path_size                          = 0;
+	uint64_t parent_entry_index                    = 0;
+	int result                                     = 0;
+
+	if( internal_path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry_index >= internal_path_index->number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path size.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry_index == LIBFSNTFS_MFT_ENTRY_INDEX_ROOT_DIRECTORY )
+	{
+		*path_offset = 0;
+		*path_size   = 0;
+
+		return( 1 );
+	}
+	path_index_entry = &( internal_path_index->entries[ mft_entry_index ] );
+
+	if( ( path_index_entry->flags & LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_HAS_PATH ) != 0 )
+	{
+		*path_offset = path_index_entry->path_offset;
+		*path_size   = (size_t) path_index_entry->path_size;
+
+		return( 1 );
+	}
+	path_index_entry->flags |= LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_IS_RESOLVING;
+
+	result = 0;
+
+	if( recursion_depth < LIBFSNTFS_MAXIMUM_RECURSION_DEPTH )
+	{
+		result = libfsntfs_internal_path_index_get_parent_entry_index(
+		          internal_path_index,
+		          mft_entry_index,
+		          &parent_entry_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent entry index.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( ( internal_path_index->entries[ parent_entry_index ].flags & LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_IS_RESOLVING ) != 0 )
+			{
+				result = 0;
+			}
+		}
+	}
+	if( result != 0 )
+	{
+		if( libfsntfs_internal_path_index_resolve_path(
+		     internal_path_index,
+		     parent_entry_index,
+		     recursion_depth + 1,
+		     &parent_path_offset,
+		     &parent_path_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to resolve path of MFT entry: %" PRIu64 ".",
+			 function,
+			 parent_entry_index );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		/* The path of the orphan directory is stored at the start of the paths data
+		 */
+		parent_path_offset = 0;
+		parent_path_size   = sizeof( LIBFSNTFS_PATH_INDEX_ORPHAN_PATH ) - 1;
+	}
+	safe_path_offset = internal_path_index->paths_data_size;
+	safe_path_size   = parent_path_size + 1 + (size_t) path_index_entry->name_size;
+
+	if( safe_path_size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( safe_path_size > ( (size_t) SSIZE_MAX - safe_path_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid paths data size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* The parent path is part of the paths data, resize the paths data before copying it
+	 */
+	if( libfsntfs_internal_path_index_resize_data(
+	     &( internal_path_index->paths_data ),
+	     &( internal_path_index->allocated_paths_data_size ),
+	     safe_path_offset + safe_path_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize paths data.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_path_size > 0 )
+	{
+		if( memory_copy(
+		     &( internal_path_index->paths_data[ safe_path_offset ] ),
+		     &( internal_path_index->paths_data[ parent_path_offset ] ),
+		     parent_path_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy parent path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_path_index->paths_data[ safe_path_offset + parent_path_size ] = (uint8_t) LIBFSNTFS_SEPARATOR;
+
+	if( path_index_entry->name_size > 0 )
+	{
+		if( memory_copy(
+		     &( internal_path_index->paths_data[ safe_path_offset + parent_path_size + 1 ] ),
+		     &( internal_path_index->names_data[ path_index_entry->name_offset ] ),
+		     (size_t) path_index_entry->name_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy name.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_path_index->paths_data_size = safe_path_offset + safe_path_size;
+
+	path_index_entry->path_offset = safe_path_offset;
+	path_index_entry->path_size   = (uint32_t) safe_path_size;
+	path_index_entry->flags      &= ~( LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_IS_RESOLVING );
+	path_index_entry->flags      |= LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_HAS_PATH;
+
+	*path_offset = safe_path_offset;
+	*path_size   = safe_path_size;
+
+	return( 1 );
+
+on_error:
+	path_index_entry->flags &= ~( LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_IS_RESOLVING );
+
+	return( -1 );
+}
+
+/* Retrieves the parent path and the name that make up the path of an entry
+ * The path consists of the parent path, a separator and the name
+ * Only the paths of the parent directories are memoized
+ * Returns 1 if successful, 0 if the entry has no name or -1 on error
+ */
+int libfsntfs_internal_path_index_get_path(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     uint64_t mft_entry_index,
+     size_t *parent_path_offset,
+     size_t *parent_path_size,
+     const uint8_t **name,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_path_index_entry_t *path_index_entry = NULL;
+	static char *function                          = "libfsntfs_internal_path_index_get_path";
+	uint64_t parent_entry_index                    = 0;
+	int result                                     = 0;
+
+	if( internal_path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry_index >= internal_path_index->number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_path_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent path offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_path_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent path size.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name size.",
+		 function );
+
+		return( -1 );
+	}
+	path_index_entry = &( internal_path_index->entries[ mft_entry_index ] );
+
+	if( ( path_index_entry->flags & LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_HAS_NAME ) == 0 )
+	{
+		return( 0 );
+	}
+	/* The path of the root directory consists of the separator only
+	 */
+	if( mft_entry_index == LIBFSNTFS_MFT_ENTRY_INDEX_ROOT_DIRECTORY )
+	{
+		*parent_path_offset = 0;
+		*parent_path_size   = 0;
+		*name               = NULL;
+		*name_size          = 0;
+
+		return( 1 );
+	}
+	result = libfsntfs_internal_path_index_get_parent_entry_index(
+	          internal_path_index,
+	          mft_entry_index,
+	          &parent_entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent entry index.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libfsntfs_internal_path_index_resolve_path(
+		     internal_path_index,
+		     parent_entry_index,
+		     1,
+		     parent_path_offset,
+		     parent_path_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to resolve path of MFT entry: %" PRIu64 ".",
+			 function,
+			 parent_entry_index );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		*parent_path_offset = 0;
+		*parent_path_size   = sizeof( LIBFSNTFS_PATH_INDEX_ORPHAN_PATH ) - 1;
+	}
+	*name      = &( internal_path_index->names_data[ path_index_entry->name_offset ] );
+	*name_size = (size_t) path_index_entry->name_size;
+
+	return( 1 );
+}
+
+/* Retrieves the number of entries
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_path_index_get_number_of_entries(
+     libfsntfs_path_index_t *path_index,
+     uint64_t *number_of_entries,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_path_index_t *internal_path_index = NULL;
+	static char *function                                = "libfsntfs_path_index_get_number_of_entries";
+
+	if( path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_path_index = (libfsntfs_internal_path_index_t *) path_index;
+
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_entries = internal_path_index->number_of_entries;
+
+	return( 1 );
+}
+
+/* Retrieves the size of the UTF-8 encoded path of a specific MFT entry
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if the MFT entry has no name or -1 on error
+ */
+int libfsntfs_path_index_get_utf8_path_size(
+     libfsntfs_path_index_t *path_index,
+     uint64_t mft_entry_index,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_path_index_t *internal_path_index = NULL;
+	const uint8_t *name                                  = NULL;
+	static char *function                                = "libfsntfs_path_index_get_utf8_path_size";
+	size_t name_size                                     = 0;
+	size_t parent_path_offset                            = 0;
+	size_t parent_path_size                              = 0;
+	int result                                           = 0;
+
+	if( path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_path_index = (libfsntfs_internal_path_index_t *) path_index;
+
+	if( utf8_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_path_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsntfs_internal_path_index_get_path(
+	          internal_path_index,
+	          mft_entry_index,
+	          &parent_path_offset,
+	          &parent_path_size,
+	          &name,
+	          &name_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path of MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+	}
+	else if( result != 0 )
+	{
+		*utf8_string_size = parent_path_size + 1 + name_size + 1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_path_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Copies the path of an entry into an UTF-8 encoded string
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_path_index_copy_utf8_path(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     size_t parent_path_offset,
+     size_t parent_path_size,
+     const uint8_t *name,
+     size_t name_size,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_internal_path_index_copy_utf8_path";
+
+	if( internal_path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size < ( parent_path_size + 1 + name_size + 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: UTF-8 string is too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_path_size > 0 )
+	{
+		if( memory_copy(
+		     utf8_string,
+		     &( internal_path_index->paths_data[ parent_path_offset ] ),
+		     parent_path_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy parent path.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	utf8_string[ parent_path_size ] = (uint8_t) LIBFSNTFS_SEPARATOR;
+
+	if( name_size > 0 )
+	{
+		if( memory_copy(
+		     &( utf8_string[ parent_path_size + 1 ] ),
+		     name,
+		     name_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy name.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	utf8_string[ parent_path_size + 1 + name_size ] = 0;
+
+	return( 1 );
+}
+
+/* Retrieves the UTF-8 encoded path of a specific MFT entry
+ * The size should include the end of string character
+ * Paths of entries whose parent is missing or was reused start with the orphan directory
+ * Returns 1 if successful, 0 if the MFT entry has no name or -1 on error
+ */
+int libfsntfs_path_index_get_utf8_path(
+     libfsntfs_path_index_t *path_index,
+     uint64_t mft_entry_index,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_path_index_t *internal_path_index = NULL;
+	const uint8_t *name                                  = NULL;
+	static char *function                                = "libfsntfs_path_index_get_utf8_path";
+	size_t name_size                                     = 0;
+	size_t parent_path_offset                            = 0;
+	size_t parent_path_size                              = 0;
+	int result                                           = 0;
+
+	if( path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_path_index = (libfsntfs_internal_path_index_t *) path_index;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_path_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsntfs_internal_path_index_get_path(
+	          internal_path_index,
+	          mft_entry_index,
+	          &parent_path_offset,
+	          &parent_path_size,
+	          &name,
+	          &name_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path of MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+	}
+	else if( result != 0 )
+	{
+		if( libfsntfs_internal_path_index_copy_utf8_path(
+		     internal_path_index,
+		     parent_path_offset,
+		     parent_path_size,
+		     name,
+		     name_size,
+		     utf8_string,
+		     utf8_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy path of MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_path_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-8 encoded path of a specific MFT entry into a newly allocated string
+ * Returns 1 if successful, 0 if the MFT entry has no name or -1 on error
+ */
+int libfsntfs_internal_path_index_get_utf8_path_copy(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     uint64_t mft_entry_index,
+     uint8_t **utf8_string,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *name       = NULL;
+	uint8_t *safe_utf8_string = NULL;
+	static char *function     = "libfsntfs_internal_path_index_get_utf8_path_copy";
+	size_t name_size          = 0;
+	size_t parent_path_offset = 0;
+	size_t parent_path_size   = 0;
+	size_t safe_utf8_size     = 0;
+	int result                = 0;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_internal_path_index_get_path(
+	          internal_path_index,
+	          mft_entry_index,
+	          &parent_path_offset,
+	          &parent_path_size,
+	          &name,
+	          &name_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path of MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	safe_utf8_size = parent_path_size + 1 + name_size + 1;
+
+	safe_utf8_string = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * safe_utf8_size );
+
+	if( safe_utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_internal_path_index_copy_utf8_path(
+	     internal_path_index,
+	     parent_path_offset,
+	     parent_path_size,
+	     name,
+	     name_size,
+	     safe_utf8_string,
+	     safe_utf8_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy path of MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		memory_free(
+		 safe_utf8_string );
+
+		return( -1 );
+	}
+	*utf8_string      = safe_utf8_string;
+	*utf8_string_size = safe_utf8_size;
+
+	return( 1 );
+}
+
+/* Retrieves the size of the UTF-16 encoded path of a specific MFT entry
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if the MFT entry has no name or -1 on error
+ */
+int libfsntfs_path_index_get_utf16_path_size(
+     libfsntfs_path_index_t *path_index,
+     uint64_t mft_entry_index,
+     size_t *utf16_string_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_path_index_t *internal_path_index = NULL;
+	uint8_t *utf8_string                                 = NULL;
+	static char *function                                = "libfsntfs_path_index_get_utf16_path_size";
+	size_t utf8_string_size                              = 0;
+	int result                                           = 0;
+
+	if( path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_path_index = (libfsntfs_internal_path_index_t *) path_index;
+
+	if( utf16_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_path_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsntfs_internal_path_index_get_utf8_path_copy(
+	          internal_path_index,
+	          mft_entry_index,
+	          &utf8_string,
+	          &utf8_string_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 path of MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+	}
+	else if( result != 0 )
+	{
+		if( libuna_utf16_string_size_from_utf8(
+		     utf8_string,
+		     utf8_string_size,
+		     utf16_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve UTF-16 string size.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 utf8_string );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_path_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-16 encoded path of a specific MFT entry
+ * The size should include the end of string character
+ * Paths of entries whose parent is missing or was reused start with the orphan directory
+ * Returns 1 if successful, 0 if the MFT entry has no name or -1 on error
+ */
+int libfsntfs_path_index_get_utf16_path(
+     libfsntfs_path_index_t *path_index,
+     uint64_t mft_entry_index,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_path_index_t *internal_path_index = NULL;
+	uint8_t *utf8_string                                 = NULL;
+	static char *function                                = "libfsntfs_path_index_get_utf16_path";
+	size_t utf8_string_size                              = 0;
+	int result                                           = 0;
+
+	if( path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	internal_path_index = (libfsntfs_internal_path_index_t *) path_index;
+
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_path_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libfsntfs_internal_path_index_get_utf8_path_copy(
+	          internal_path_index,
+	          mft_entry_index,
+	          &utf8_string,
+	          &utf8_string_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 path of MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+	}
+	else if( result != 0 )
+	{
+		if( libuna_utf16_string_copy_from_utf8(
+		     utf16_string,
+		     utf16_string_size,
+		     utf8_string,
+		     utf8_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy UTF-16 string.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 utf8_string );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_path_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
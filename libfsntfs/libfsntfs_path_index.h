@@ -0,0 +1,258 @@
+/*
+ * Path index functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_PATH_INDEX_H )
+#define _LIBFSNTFS_PATH_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_extern.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libcthreads.h"
+#include "libfsntfs_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+enum LIBFSNTFS_PATH_INDEX_ENTRY_FLAGS
+{
+	LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_HAS_NAME			= 0x01,
+	LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_IN_USE				= 0x02,
+	LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_HAS_PATH			= 0x04,
+	LIBFSNTFS_PATH_INDEX_ENTRY_FLAG_IS_RESOLVING			= 0x08
+};
+
+typedef struct libfsntfs_path_index_entry libfsntfs_path_index_entry_t;
+
+struct libfsntfs_path_index_entry
+{
+	/* The parent file reference
+	 */
+	uint64_t parent_file_reference;
+
+	/* The offset of the path in the paths data
+	 */
+	size_t path_offset;
+
+	/* The size of the path, without the end of string character
+	 */
+	uint32_t path_size;
+
+	/* The offset of the interned name in the names data
+	 */
+	uint32_t name_offset;
+
+	/* The size of the name, without the end of string character
+	 */
+	uint16_t name_size;
+
+	/* The sequence
+	 */
+	uint16_t sequence;
+
+	/* The flags
+	 */
+	uint8_t flags;
+};
+
+typedef struct libfsntfs_internal_path_index libfsntfs_internal_path_index_t;
+
+struct libfsntfs_internal_path_index
+{
+	/* The entries, one per MFT entry
+	 */
+	libfsntfs_path_index_entry_t *entries;
+
+	/* The number of entries
+	 */
+	uint64_t number_of_entries;
+
+	/* The names data, contains the interned UTF-8 encoded names
+	 */
+	uint8_t *names_data;
+
+	/* The names data size
+	 */
+	size_t names_data_size;
+
+	/* The allocated names data size
+	 */
+	size_t allocated_names_data_size;
+
+	/* The name hash table, contains the names data offset + 1 of the interned names
+	 */
+	uint32_t *name_hash_table;
+
+	/* The number of slots in the name hash table
+	 */
+	uint32_t number_of_name_hash_table_slots;
+
+	/* The number of interned names
+	 */
+	uint32_t number_of_names;
+
+	/* The paths data, contains the memoized UTF-8 encoded paths of the parent directories
+	 */
+	uint8_t *paths_data;
+
+	/* The paths data size
+	 */
+	size_t paths_data_size;
+
+	/* The allocated paths data size
+	 */
+	size_t allocated_paths_data_size;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libfsntfs_path_index_initialize(
+     libfsntfs_path_index_t **path_index,
+     uint64_t number_of_entries,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_index_free(
+     libfsntfs_path_index_t **path_index,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_index_resize_data(
+     uint8_t **data,
+     size_t *allocated_data_size,
+     size_t required_data_size,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_index_append_data(
+     uint8_t **data,
+     size_t *data_size,
+     size_t *allocated_data_size,
+     const uint8_t *append_data,
+     size_t append_data_size,
+     libcerror_error_t **error );
+
+uint32_t libfsntfs_internal_path_index_get_name_hash(
+          const uint8_t *name,
+          uint16_t name_size );
+
+int libfsntfs_internal_path_index_resize_name_hash_table(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_index_intern_name(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     const uint8_t *name,
+     uint16_t name_size,
+     uint32_t *name_offset,
+     libcerror_error_t **error );
+
+int libfsntfs_path_index_read_file_entry(
+     libfsntfs_file_entry_t *file_entry,
+     void *path_index,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_index_get_parent_entry_index(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     uint64_t mft_entry_index,
+     uint64_t *parent_entry_index,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_index_resolve_path(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     uint64_t mft_entry_index,
+     int recursion_depth,
+     size_t *path_offset,
+     size_t *path_size,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_index_get_path(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     uint64_t mft_entry_index,
+     size_t *parent_path_offset,
+     size_t *parent_path_size,
+     const uint8_t **name,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_index_get_number_of_entries(
+     libfsntfs_path_index_t *path_index,
+     uint64_t *number_of_entries,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_index_get_utf8_path_size(
+     libfsntfs_path_index_t *path_index,
+     uint64_t mft_entry_index,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_index_copy_utf8_path(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     size_t parent_path_offset,
+     size_t parent_path_size,
+     const uint8_t *name,
+     size_t name_size,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_index_get_utf8_path(
+     libfsntfs_path_index_t *path_index,
+     uint64_t mft_entry_index,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_path_index_get_utf8_path_copy(
+     libfsntfs_internal_path_index_t *internal_path_index,
+     uint64_t mft_entry_index,
+     uint8_t **utf8_string,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_index_get_utf16_path_size(
+     libfsntfs_path_index_t *path_index,
+     uint64_t mft_entry_index,
+     size_t *utf16_string_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_path_index_get_utf16_path(
+     libfsntfs_path_index_t *path_index,
+     uint64_t mft_entry_index,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
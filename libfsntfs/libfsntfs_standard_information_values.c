@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsntfs_arena.h"
 #include "libfsntfs_attribute.h"
 #include "libfsntfs_debug.h"
 #include "libfsntfs_libcerror.h"
@@ -36,10 +37,12 @@
 
 /* Creates standard information values
  * Make sure the value standard_information_values is referencing, is set to NULL
+ * If an arena is provided the values are allocated from the arena
  * Returns 1 if successful or -1 on error
  */
 int libfsntfs_standard_information_values_initialize(
      libfsntfs_standard_information_values_t **standard_information_values,
+     libfsntfs_arena_t *arena,
      libcerror_error_t **error )
 {
 	static char *function = "libfsntfs_standard_information_values_initialize";
@@ -66,19 +69,40 @@ int libfsntfs_standard_information_values_initialize(
 
 		return( -1 );
 	}
-	*standard_information_values = memory_allocate_structure(
-	                                libfsntfs_standard_information_values_t );
+	if( arena != NULL )
+	{
+		if( libfsntfs_arena_allocate(
+		     arena,
+		     sizeof( libfsntfs_standard_information_values_t ),
+		     (uint8_t **) standard_information_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create standard information values.",
+			 function );
 
-	if( *standard_information_values == NULL )
+			goto on_error;
+		}
+	}
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create standard information values.",
-		 function );
+		*standard_information_values = memory_allocate_structure(
+		                                libfsntfs_standard_information_values_t );
 
-		goto on_error;
+		if( *standard_information_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create standard information values.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	if( memory_set(
 	     *standard_information_values,
@@ -94,14 +118,18 @@ int libfsntfs_standard_information_values_initialize(
 
 		goto on_error;
 	}
+	( *standard_information_values )->arena = arena;
+
 	return( 1 );
 
 on_error:
 	if( *standard_information_values != NULL )
 	{
-		memory_free(
-		 *standard_information_values );
-
+		if( arena == NULL )
+		{
+			memory_free(
+			 *standard_information_values );
+		}
 		*standard_information_values = NULL;
 	}
 	return( -1 );
@@ -129,9 +157,13 @@ int libfsntfs_standard_information_values_free(
 	}
 	if( *standard_information_values != NULL )
 	{
-		memory_free(
-		 *standard_information_values );
-
+		/* Standard information values allocated from the arena are freed together with the arena
+		 */
+		if( ( *standard_information_values )->arena == NULL )
+		{
+			memory_free(
+			 *standard_information_values );
+		}
 		*standard_information_values = NULL;
 	}
 	return( 1 );
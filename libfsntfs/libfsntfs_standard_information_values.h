@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_arena.h"
 #include "libfsntfs_libcerror.h"
 
 #if defined( __cplusplus )
@@ -35,6 +36,11 @@ typedef struct libfsntfs_standard_information_values libfsntfs_standard_informat
 
 struct libfsntfs_standard_information_values
 {
+	/* The arena the values are allocated from
+	 * NULL if they are allocated on the heap
+	 */
+	libfsntfs_arena_t *arena;
+
 	/* The creation time
 	 */
 	uint64_t creation_time;
@@ -70,6 +76,7 @@ struct libfsntfs_standard_information_values
 
 int libfsntfs_standard_information_values_initialize(
      libfsntfs_standard_information_values_t **standard_information_values,
+     libfsntfs_arena_t *arena,
      libcerror_error_t **error );
 
 int libfsntfs_standard_information_values_free(
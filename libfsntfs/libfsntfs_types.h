@@ -38,6 +38,7 @@ typedef struct libfsntfs_attribute {}		libfsntfs_attribute_t;
 typedef struct libfsntfs_data_stream {}		libfsntfs_data_stream_t;
 typedef struct libfsntfs_file_entry {}		libfsntfs_file_entry_t;
 typedef struct libfsntfs_mft_metadata_file {}	libfsntfs_mft_metadata_file_t;
+typedef struct libfsntfs_path_index {}		libfsntfs_path_index_t;
 typedef struct libfsntfs_usn_change_journal {}	libfsntfs_usn_change_journal_t;
 typedef struct libfsntfs_volume {}		libfsntfs_volume_t;
 
@@ -46,11 +47,57 @@ typedef intptr_t libfsntfs_attribute_t;
 typedef intptr_t libfsntfs_data_stream_t;
 typedef intptr_t libfsntfs_file_entry_t;
 typedef intptr_t libfsntfs_mft_metadata_file_t;
+typedef intptr_t libfsntfs_path_index_t;
 typedef intptr_t libfsntfs_usn_change_journal_t;
 typedef intptr_t libfsntfs_volume_t;
 
 #endif
 
+/* The range of data of a vectored read
+ */
+typedef struct libfsntfs_read_range libfsntfs_read_range_t;
+
+struct libfsntfs_read_range
+{
+	/* The offset of the data
+	 */
+	off64_t offset;
+
+	/* The size of the data
+	 */
+	size_t size;
+
+	/* The buffer the data is read into
+	 */
+	void *buffer;
+
+	/* The number of bytes read
+	 * Is less than size if the range extends beyond the end of the data
+	 */
+	size_t read_count;
+};
+
+/* The USN record view of a batched USN record read
+ */
+typedef struct libfsntfs_usn_record_view libfsntfs_usn_record_view_t;
+
+struct libfsntfs_usn_record_view
+{
+	/* The offset of the USN record in the $J data stream
+	 * This is the update sequence number (USN) of the record
+	 */
+	off64_t offset;
+
+	/* The USN record data
+	 * Points into the buffer of the read
+	 */
+	const uint8_t *data;
+
+	/* The USN record data size
+	 */
+	size_t data_size;
+};
+
 #endif /* defined( HAVE_LOCAL_LIBFSNTFS ) */
 
 /* The largest primary (or scalar) available
@@ -0,0 +1,496 @@
+/*
+ * Upcase table functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_libuna.h"
+#include "libfsntfs_upcase_table.h"
+
+/* Creates an upcase table
+ * Make sure the value upcase_table is referencing, is set to NULL
+ * The table maps every character onto itself until it is read
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_upcase_table_initialize(
+     libfsntfs_upcase_table_t **upcase_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_upcase_table_initialize";
+	uint32_t character    = 0;
+
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upcase table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *upcase_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid upcase table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*upcase_table = memory_allocate_structure(
+	                 libfsntfs_upcase_table_t );
+
+	if( *upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create upcase table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *upcase_table,
+	     0,
+	     sizeof( libfsntfs_upcase_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear upcase table.",
+		 function );
+
+		goto on_error;
+	}
+	( *upcase_table )->characters = (uint16_t *) memory_allocate(
+	                                              sizeof( uint16_t ) * LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_CHARACTERS );
+
+	if( ( *upcase_table )->characters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create characters.",
+		 function );
+
+		goto on_error;
+	}
+	for( character = 0;
+	     character < LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_CHARACTERS;
+	     character++ )
+	{
+		( *upcase_table )->characters[ character ] = (uint16_t) character;
+	}
+	return( 1 );
+
+on_error:
+	if( *upcase_table != NULL )
+	{
+		memory_free(
+		 *upcase_table );
+
+		*upcase_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an upcase table
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_upcase_table_free(
+     libfsntfs_upcase_table_t **upcase_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_upcase_table_free";
+
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upcase table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *upcase_table != NULL )
+	{
+		if( ( *upcase_table )->characters != NULL )
+		{
+			memory_free(
+			 ( *upcase_table )->characters );
+		}
+		memory_free(
+		 *upcase_table );
+
+		*upcase_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads the upcase table from part of the $UpCase data
+ * The data offset is relative to the start of the $UpCase data,
+ * data beyond the last character of the table is ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_upcase_table_read_data(
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *data,
+     size_t data_size,
+     size_t data_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_upcase_table_read_data";
+	size_t character      = 0;
+	size_t data_index     = 0;
+
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upcase table.",
+		 function );
+
+		return( -1 );
+	}
+	if( upcase_table->characters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid upcase table - missing characters.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_offset % 2 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	character = data_offset / 2;
+
+	while( ( ( data_index + 1 ) < data_size )
+	    && ( character < LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_CHARACTERS ) )
+	{
+		byte_stream_copy_to_uint16_little_endian(
+		 &( data[ data_index ] ),
+		 upcase_table->characters[ character ] );
+
+		data_index += 2;
+		character  += 1;
+	}
+	return( 1 );
+}
+
+/* Compares an UTF-16 little-endian encoded name with an UTF-8 encoded string
+ * The characters are compared after they are mapped by the upcase table,
+ * which matches the name collation of Windows
+ * Returns 1 if the strings are equal, 0 if not or -1 on error
+ */
+int libfsntfs_upcase_table_compare_name_with_utf8_string(
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *name,
+     size_t name_size,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
+{
+	uint16_t string_characters[ 2 ];
+
+	libuna_unicode_character_t unicode_character = 0;
+	static char *function                        = "libfsntfs_upcase_table_compare_name_with_utf8_string";
+	size_t name_index                            = 0;
+	size_t number_of_string_characters           = 0;
+	size_t string_character_index                = 0;
+	size_t utf8_string_index                     = 0;
+	uint16_t name_character                      = 0;
+
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upcase table.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid name size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Ignore the end of string character
+	 */
+	if( ( utf8_string_length > 0 )
+	 && ( utf8_string[ utf8_string_length - 1 ] == 0 ) )
+	{
+		utf8_string_length -= 1;
+	}
+	while( ( name_index + 1 ) < name_size )
+	{
+		if( string_character_index >= number_of_string_characters )
+		{
+			if( utf8_string_index >= utf8_string_length )
+			{
+				return( 0 );
+			}
+			if( libuna_unicode_character_copy_from_utf8(
+			     &unicode_character,
+			     utf8_string,
+			     utf8_string_length,
+			     &utf8_string_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy UTF-8 string to Unicode character.",
+				 function );
+
+				return( -1 );
+			}
+			number_of_string_characters = 0;
+			string_character_index      = 0;
+
+			if( libuna_unicode_character_copy_to_utf16(
+			     unicode_character,
+			     string_characters,
+			     2,
+			     &number_of_string_characters,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy Unicode character to UTF-16.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		byte_stream_copy_to_uint16_little_endian(
+		 &( name[ name_index ] ),
+		 name_character );
+
+		name_index += 2;
+
+		if( upcase_table->characters[ name_character ] != upcase_table->characters[ string_characters[ string_character_index ] ] )
+		{
+			return( 0 );
+		}
+		string_character_index++;
+	}
+	if( ( string_character_index < number_of_string_characters )
+	 || ( utf8_string_index < utf8_string_length ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Compares an UTF-16 little-endian encoded name with an UTF-16 encoded string
+ * The characters are compared after they are mapped by the upcase table,
+ * which matches the name collation of Windows
+ * Returns 1 if the strings are equal, 0 if not or -1 on error
+ */
+int libfsntfs_upcase_table_compare_name_with_utf16_string(
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *name,
+     size_t name_size,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error )
+{
+	static char *function     = "libfsntfs_upcase_table_compare_name_with_utf16_string";
+	size_t name_index         = 0;
+	size_t utf16_string_index = 0;
+	uint16_t name_character   = 0;
+
+	if( upcase_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upcase table.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid name size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Ignore the end of string character
+	 */
+	if( ( utf16_string_length > 0 )
+	 && ( utf16_string[ utf16_string_length - 1 ] == 0 ) )
+	{
+		utf16_string_length -= 1;
+	}
+	if( ( name_size / 2 ) != utf16_string_length )
+	{
+		return( 0 );
+	}
+	while( utf16_string_index < utf16_string_length )
+	{
+		byte_stream_copy_to_uint16_little_endian(
+		 &( name[ name_index ] ),
+		 name_character );
+
+		if( upcase_table->characters[ name_character ] != upcase_table->characters[ utf16_string[ utf16_string_index ] ] )
+		{
+			return( 0 );
+		}
+		name_index         += 2;
+		utf16_string_index += 1;
+	}
+	return( 1 );
+}
+
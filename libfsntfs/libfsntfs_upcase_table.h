@@ -0,0 +1,79 @@
+/*
+ * Upcase table functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_UPCASE_TABLE_H )
+#define _LIBFSNTFS_UPCASE_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfsntfs_upcase_table libfsntfs_upcase_table_t;
+
+struct libfsntfs_upcase_table
+{
+	/* The upper case characters, one for each UTF-16 character
+	 */
+	uint16_t *characters;
+};
+
+int libfsntfs_upcase_table_initialize(
+     libfsntfs_upcase_table_t **upcase_table,
+     libcerror_error_t **error );
+
+int libfsntfs_upcase_table_free(
+     libfsntfs_upcase_table_t **upcase_table,
+     libcerror_error_t **error );
+
+int libfsntfs_upcase_table_read_data(
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *data,
+     size_t data_size,
+     size_t data_offset,
+     libcerror_error_t **error );
+
+int libfsntfs_upcase_table_compare_name_with_utf8_string(
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *name,
+     size_t name_size,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error );
+
+int libfsntfs_upcase_table_compare_name_with_utf16_string(
+     libfsntfs_upcase_table_t *upcase_table,
+     const uint8_t *name,
+     size_t name_size,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -24,10 +24,12 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfsntfs_cluster_block_stream.h"
 #include "libfsntfs_data_stream.h"
 #include "libfsntfs_definitions.h"
 #include "libfsntfs_file_entry.h"
 #include "libfsntfs_usn_change_journal.h"
+#include "libfsntfs_usn_scanner.h"
 #include "libfsntfs_types.h"
 
 /* Creates an USN change journal
@@ -162,55 +164,9 @@ int libfsntfs_usn_change_journal_initialize(
 
 		goto on_error;
 	}
-	if( libfsntfs_data_stream_get_number_of_extents(
-	     internal_usn_change_journal->data_stream,
-	     &( internal_usn_change_journal->number_of_extents ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve $J data stream number of extents.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfsntfs_data_stream_get_extent_by_index(
-	     internal_usn_change_journal->data_stream,
-	     internal_usn_change_journal->extent_index,
-	     &( internal_usn_change_journal->extent_offset ),
-	     &( internal_usn_change_journal->extent_size ),
-	     &( internal_usn_change_journal->extent_flags ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve $J data stream extent: %d.",
-		 function,
-		 internal_usn_change_journal->extent_index );
-
-		goto on_error;
-	}
 /* TODO what defines the journal block size? the index entry size? */
 	internal_usn_change_journal->journal_block_size = 0x1000;
 
-	internal_usn_change_journal->journal_block_data = (uint8_t *) memory_allocate(
-	                                                               sizeof( uint8_t ) * internal_usn_change_journal->journal_block_size );
-
-	if( internal_usn_change_journal->journal_block_data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create journal block data.",
-		 function );
-
-		goto on_error;
-	}
 	internal_usn_change_journal->file_io_handle  = file_io_handle;
 	internal_usn_change_journal->mft_entry       = mft_entry;
 	internal_usn_change_journal->directory_entry = directory_entry;
@@ -262,7 +218,8 @@ int libfsntfs_usn_change_journal_free(
 		internal_usn_change_journal = (libfsntfs_internal_usn_change_journal_t *) *usn_change_journal;
 		*usn_change_journal         = NULL;
 
-		/* The file_io_handle, mft_entry and data_attribute references are freed elsewhere
+		/* The file_io_handle reference is freed elsewhere
+		 * the data_attribute reference is freed with the MFT entry
 		 */
 		if( libfsntfs_directory_entry_free(
 		     &( internal_usn_change_journal->directory_entry ),
@@ -290,8 +247,24 @@ int libfsntfs_usn_change_journal_free(
 
 			result = -1;
 		}
-		memory_free(
-		 internal_usn_change_journal->journal_block_data );
+		if( libfsntfs_mft_entry_free(
+		     &( internal_usn_change_journal->mft_entry ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free MFT entry.",
+			 function );
+
+			result = -1;
+		}
+		if( internal_usn_change_journal->journal_data != NULL )
+		{
+			memory_free(
+			 internal_usn_change_journal->journal_data );
+		}
 		memory_free(
 		 internal_usn_change_journal );
 	}
@@ -299,6 +272,7 @@ int libfsntfs_usn_change_journal_free(
 }
 
 /* Retrieves the current offset of the default data stream (nameless $DATA attribute)
+ * The current offset is the update sequence number (USN) of the next USN record
  * Returns the offset if successful or -1 on error
  */
 int libfsntfs_usn_change_journal_get_offset(
@@ -338,21 +312,29 @@ int libfsntfs_usn_change_journal_get_offset(
 	return( 1 );
 }
 
-/* Reads an USN record from the USN change journal
- * Returns the number of bytes read if successful or -1 on error
+/* Seeks the USN record with a specific update sequence number (USN)
+ * The USN is the offset of the USN record in the $J data stream
+ * If LIBFSNTFS_USN_SEEK_FLAG_AFTER is set the USN record is verified and the current offset
+ * is set to the next USN record, which allows to resume from the last USN record that was read
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libfsntfs_usn_change_journal_read_usn_record(
-         libfsntfs_usn_change_journal_t *usn_change_journal,
-         uint8_t *usn_record_data,
-         size_t usn_record_data_size,
-         libcerror_error_t **error )
+int libfsntfs_usn_change_journal_seek_usn(
+     libfsntfs_usn_change_journal_t *usn_change_journal,
+     uint64_t update_sequence_number,
+     uint8_t seek_flags,
+     libcerror_error_t **error )
 {
+	uint8_t usn_record_header_data[ 60 ];
+
 	libfsntfs_internal_usn_change_journal_t *internal_usn_change_journal = NULL;
-	static char *function                                                = "libfsntfs_usn_change_journal_read_usn_record";
-	size_t read_size                                                     = 0;
+	static char *function                                                = "libfsntfs_usn_change_journal_seek_usn";
+	size_t journal_block_remainder                                       = 0;
 	ssize_t read_count                                                   = 0;
+	off64_t data_offset                                                  = 0;
+	uint64_t usn_record_update_sequence_number                           = 0;
 	uint32_t usn_record_size                                             = 0;
-	int read_journal_block                                               = 0;
+	uint16_t major_format_version                                        = 0;
+	int result                                                           = 0;
 
 	if( usn_change_journal == NULL )
 	{
@@ -367,227 +349,846 @@ ssize_t libfsntfs_usn_change_journal_read_usn_record(
 	}
 	internal_usn_change_journal = (libfsntfs_internal_usn_change_journal_t *) usn_change_journal;
 
-	if( internal_usn_change_journal->journal_block_size < 60 )
+	if( internal_usn_change_journal->journal_block_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
 		 "%s: invalid USN change journal - journal block size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( usn_record_data == NULL )
+	/* USN records are 8-byte aligned
+	 */
+	if( ( update_sequence_number > (uint64_t) INT64_MAX )
+	 || ( update_sequence_number > internal_usn_change_journal->data_size )
+	 || ( ( update_sequence_number % 8 ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid USN record data.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid update sequence number value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( usn_record_data_size > (size_t) SSIZE_MAX )
+	if( ( seek_flags & ~( LIBFSNTFS_USN_SEEK_FLAG_AFTER ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported seek flags: 0x%02" PRIx8 ".",
+		 function,
+		 seek_flags );
+
+		return( -1 );
+	}
+	if( ( seek_flags & LIBFSNTFS_USN_SEEK_FLAG_AFTER ) == 0 )
+	{
+		internal_usn_change_journal->data_offset = (off64_t) update_sequence_number;
+
+		return( 1 );
+	}
+	journal_block_remainder = internal_usn_change_journal->journal_block_size
+	                        - (size_t) ( update_sequence_number % internal_usn_change_journal->journal_block_size );
+
+	if( ( journal_block_remainder < 60 )
+	 || ( ( update_sequence_number + 60 ) > internal_usn_change_journal->data_size ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid USN record data size value out of bounds.",
+		 "%s: invalid update sequence number value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_usn_change_journal->extent_index >= internal_usn_change_journal->number_of_extents )
+	/* The oldest USN records are removed from the journal by making them sparse
+	 */
+	result = libfsntfs_cluster_block_stream_get_data_or_hole_offset(
+	          internal_usn_change_journal->data_attribute,
+	          internal_usn_change_journal->data_size,
+	          (off64_t) update_sequence_number,
+	          LIBFSNTFS_SEEK_DATA,
+	          &data_offset,
+	          error );
+
+	if( result == -1 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data offset.",
+		 function );
+
+		return( -1 );
 	}
-	while( usn_record_size == 0 )
+	else if( ( result == 0 )
+	      || ( data_offset != (off64_t) update_sequence_number ) )
 	{
-		while( ( ( internal_usn_change_journal->extent_flags & LIBFSNTFS_EXTENT_FLAG_IS_SPARSE ) != 0 )
-		    || ( ( internal_usn_change_journal->journal_block_offset >= ( internal_usn_change_journal->journal_block_size - 60 ) )
-		     &&  ( (size64_t) internal_usn_change_journal->extent_offset >= internal_usn_change_journal->extent_size ) ) )
-		{
-			internal_usn_change_journal->extent_index += 1;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: USN record: %" PRIu64 " no longer in journal.",
+		 function,
+		 update_sequence_number );
 
-			if( internal_usn_change_journal->extent_index >= internal_usn_change_journal->number_of_extents )
-			{
-				return( 0 );
-			}
-/* TODO make sure internal values are reset on error */
-			if( libfsntfs_data_stream_get_extent_by_index(
-			     internal_usn_change_journal->data_stream,
-			     internal_usn_change_journal->extent_index,
-			     &( internal_usn_change_journal->extent_offset ),
-			     &( internal_usn_change_journal->extent_size ),
-			     &( internal_usn_change_journal->extent_flags ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve $J data stream extent: %d.",
-				 function,
-				 internal_usn_change_journal->extent_index );
+		return( -1 );
+	}
+	read_count = libfsntfs_data_stream_read_buffer_at_offset(
+	              internal_usn_change_journal->data_stream,
+	              usn_record_header_data,
+	              60,
+	              (off64_t) update_sequence_number,
+	              error );
 
-				return( -1 );
-			}
-			if( ( internal_usn_change_journal->extent_flags & LIBFSNTFS_EXTENT_FLAG_IS_SPARSE ) != 0 )
-			{
-				internal_usn_change_journal->data_offset += internal_usn_change_journal->extent_size;
-			}
-			else
-			{
-				if( libfsntfs_data_stream_seek_offset(
-				     internal_usn_change_journal->data_stream,
-				     internal_usn_change_journal->extent_offset,
-				     SEEK_SET,
-				     error ) != internal_usn_change_journal->extent_offset )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_SEEK_FAILED,
-					 "%s: unable to seek offset: 0x%08" PRIx64 " in $J data stream.",
-					 function,
-					 internal_usn_change_journal->extent_offset );
-
-					return( -1 );
-				}
-				internal_usn_change_journal->extent_size += internal_usn_change_journal->extent_offset;
-
-				read_journal_block = 1;
-			}
-		}
-		if( ( internal_usn_change_journal->journal_block_offset == 0 )
-		 || ( internal_usn_change_journal->journal_block_offset >= ( internal_usn_change_journal->journal_block_size - 60 ) ) )
-		{
-			read_journal_block = 1;
-		}
-		if( read_journal_block != 0 )
-		{
-			if( (size64_t) internal_usn_change_journal->extent_offset >= internal_usn_change_journal->extent_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid USN change journal - extent data offset value out of bounds.",
-				 function );
+	if( read_count != (ssize_t) 60 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read USN record: %" PRIu64 " header data from $J data stream.",
+		 function,
+		 update_sequence_number );
 
-				return( -1 );
-			}
-			if( memory_set(
-			     internal_usn_change_journal->journal_block_data,
-			     0,
-			     internal_usn_change_journal->journal_block_size ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-				 "%s: unable to clear journal block.",
-				 function );
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( usn_record_header_data[ 0 ] ),
+	 usn_record_size );
 
-				return( -1 );
-			}
-			read_size = internal_usn_change_journal->journal_block_size;
+	byte_stream_copy_to_uint16_little_endian(
+	 &( usn_record_header_data[ 4 ] ),
+	 major_format_version );
 
-			if( read_size > ( internal_usn_change_journal->extent_size - internal_usn_change_journal->extent_offset ) )
-			{
-				read_size = (size_t) ( internal_usn_change_journal->extent_size - internal_usn_change_journal->extent_offset );
-			}
-			read_count = libfsntfs_data_stream_read_buffer(
-				      internal_usn_change_journal->data_stream,
-				      internal_usn_change_journal->journal_block_data,
-				      read_size,
-				      error );
+	if( ( usn_record_size < 60 )
+	 || ( (size_t) usn_record_size > journal_block_remainder ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid USN record: %" PRIu64 " size value out of bounds.",
+		 function,
+		 update_sequence_number );
 
-			if( read_count != (ssize_t) read_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read journal block from $J data stream.",
-				 function );
+		return( -1 );
+	}
+	/* The USN is stored after the 64-bit file references in version 2
+	 * and after the 128-bit file references in version 3 and 4
+	 */
+	if( major_format_version == 2 )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( usn_record_header_data[ 24 ] ),
+		 usn_record_update_sequence_number );
+	}
+	else if( ( major_format_version == 3 )
+	      || ( major_format_version == 4 ) )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( usn_record_header_data[ 40 ] ),
+		 usn_record_update_sequence_number );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported USN record: %" PRIu64 " major format version: %" PRIu16 ".",
+		 function,
+		 update_sequence_number,
+		 major_format_version );
 
-				return( -1 );
-			}
-			internal_usn_change_journal->extent_offset       += read_count;
-			internal_usn_change_journal->journal_block_offset = 0;
+		return( -1 );
+	}
+	if( usn_record_update_sequence_number != update_sequence_number )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in USN record: %" PRIu64 " update sequence number: %" PRIu64 ".",
+		 function,
+		 update_sequence_number,
+		 usn_record_update_sequence_number );
 
-/* TODO do an empty block check
-			if( buffer[ 0 ] == 0 )
-			{
-				continue;
-			}
-*/
-		}
-		if( internal_usn_change_journal->journal_block_offset >= ( internal_usn_change_journal->journal_block_size - 60 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid USN change journal - journal block offset value out of bounds.",
-			 function );
+		return( -1 );
+	}
+	internal_usn_change_journal->data_offset = (off64_t) ( update_sequence_number + usn_record_size );
 
-			return( -1 );
-		}
-		byte_stream_copy_to_uint32_little_endian(
-		 &( internal_usn_change_journal->journal_block_data[ internal_usn_change_journal->journal_block_offset ] ),
-		 usn_record_size );
+	return( 1 );
+}
 
-		if( usn_record_size == 0 )
-		{
-			internal_usn_change_journal->data_offset          = internal_usn_change_journal->journal_block_size - internal_usn_change_journal->journal_block_offset;
-			internal_usn_change_journal->journal_block_offset = internal_usn_change_journal->journal_block_size;
-		}
+/* Reads journal data from the $J data stream
+ * Sparse extents before the journal data offset are skipped and the read stops
+ * at a journal block boundary, the start of the next sparse extent or the end of the data
+ * On return journal_data_offset contains the offset of the journal data that was read
+ * Returns 1 if successful, 0 if no more journal data or -1 on error
+ */
+int libfsntfs_internal_usn_change_journal_read_journal_data(
+     libfsntfs_internal_usn_change_journal_t *internal_usn_change_journal,
+     uint8_t *journal_data,
+     size_t journal_data_size,
+     off64_t *journal_data_offset,
+     size_t *read_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_internal_usn_change_journal_read_journal_data";
+	off64_t data_offset   = 0;
+	off64_t hole_offset   = 0;
+	off64_t read_offset   = 0;
+	ssize_t read_count    = 0;
+	int result            = 0;
+
+	if( internal_usn_change_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN change journal.",
+		 function );
+
+		return( -1 );
 	}
-	if( ( usn_record_size < 60 )
-	 || ( usn_record_size > ( internal_usn_change_journal->journal_block_size - internal_usn_change_journal->journal_block_offset ) ) )
+	if( internal_usn_change_journal->journal_block_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid USN record size value out of bounds.",
+		 "%s: invalid USN change journal - journal block size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( usn_record_data_size < usn_record_size )
+	if( journal_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: USN record data size value too small.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal data.",
 		 function );
 
 		return( -1 );
 	}
-	if( memory_copy(
-	     usn_record_data,
-	     &( internal_usn_change_journal->journal_block_data[ internal_usn_change_journal->journal_block_offset ] ),
-	     (size_t) usn_record_size ) == NULL )
+	if( ( journal_data_size < internal_usn_change_journal->journal_block_size )
+	 || ( journal_data_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy USN record data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid journal data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( journal_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read size.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = *journal_data_offset;
+
+	if( ( data_offset < 0 )
+	 || ( (size64_t) data_offset >= internal_usn_change_journal->data_size ) )
+	{
+		return( 0 );
+	}
+	/* The journal is mostly sparse, the sparse extents are skipped with
+	 * an extent lookup instead of reading them
+	 */
+	result = libfsntfs_cluster_block_stream_get_data_or_hole_offset(
+	          internal_usn_change_journal->data_attribute,
+	          internal_usn_change_journal->data_size,
+	          data_offset,
+	          LIBFSNTFS_SEEK_DATA,
+	          &data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data offset.",
 		 function );
 
 		return( -1 );
 	}
-	internal_usn_change_journal->data_offset          += usn_record_size;
-	internal_usn_change_journal->journal_block_offset += usn_record_size;
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libfsntfs_cluster_block_stream_get_data_or_hole_offset(
+	     internal_usn_change_journal->data_attribute,
+	     internal_usn_change_journal->data_size,
+	     data_offset,
+	     LIBFSNTFS_SEEK_HOLE,
+	     &hole_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hole offset.",
+		 function );
 
-	return( (ssize_t) usn_record_size );
+		return( -1 );
+	}
+	/* USN records do not cross journal block boundaries, hence the read
+	 * is stopped at a journal block boundary
+	 */
+	read_offset  = data_offset + (off64_t) journal_data_size;
+	read_offset -= read_offset % internal_usn_change_journal->journal_block_size;
+
+	if( read_offset > hole_offset )
+	{
+		read_offset = hole_offset;
+	}
+	read_count = libfsntfs_data_stream_read_buffer_at_offset(
+	              internal_usn_change_journal->data_stream,
+	              journal_data,
+	              (size_t) ( read_offset - data_offset ),
+	              data_offset,
+	              error );
+
+	if( read_count != (ssize_t) ( read_offset - data_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read journal data at offset: 0x%08" PRIx64 " from $J data stream.",
+		 function,
+		 data_offset );
+
+		return( -1 );
+	}
+	*journal_data_offset = data_offset;
+	*read_size           = (size_t) read_count;
+
+	return( 1 );
+}
+
+/* Parses the USN records in journal data
+ * The USN records are not copied, the USN record views point into the journal data
+ * On return parsed_data_size contains the size of the journal data up to the next USN record
+ * If an invalid USN record follows USN records that were parsed, the parsed USN records
+ * are returned and the invalid USN record is reported when parsing continues from it
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_usn_change_journal_parse_usn_records(
+     size_t journal_block_size,
+     const uint8_t *journal_data,
+     size_t journal_data_size,
+     off64_t journal_data_offset,
+     libfsntfs_usn_record_view_t *usn_records,
+     int maximum_number_of_usn_records,
+     int *number_of_usn_records,
+     size_t *parsed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function          = "libfsntfs_usn_change_journal_parse_usn_records";
+	size_t journal_block_remainder = 0;
+	size_t journal_data_index      = 0;
+	uint32_t usn_record_size       = 0;
+	int usn_record_index           = 0;
+
+	if( journal_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid journal block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( journal_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal data.",
+		 function );
+
+		return( -1 );
+	}
+	if( journal_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid journal data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( usn_records == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN records.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_usn_records <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of USN records value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_usn_records == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of USN records.",
+		 function );
+
+		return( -1 );
+	}
+	if( parsed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parsed data size.",
+		 function );
+
+		return( -1 );
+	}
+	while( journal_data_index < journal_data_size )
+	{
+		if( usn_record_index >= maximum_number_of_usn_records )
+		{
+			break;
+		}
+		journal_block_remainder = journal_block_size
+		                        - (size_t) ( (size64_t) ( journal_data_offset + journal_data_index ) % journal_block_size );
+
+		if( journal_block_remainder > ( journal_data_size - journal_data_index ) )
+		{
+			journal_block_remainder = journal_data_size - journal_data_index;
+		}
+		/* The remainder of a journal block that is too small to contain an USN record
+		 * or that starts with a size of 0 contains no USN records
+		 */
+		if( journal_block_remainder < 60 )
+		{
+			journal_data_index += journal_block_remainder;
+
+			continue;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( journal_data[ journal_data_index ] ),
+		 usn_record_size );
+
+		if( usn_record_size == 0 )
+		{
+			journal_data_index += journal_block_remainder;
+
+			continue;
+		}
+		if( ( usn_record_size < 60 )
+		 || ( (size_t) usn_record_size > journal_block_remainder ) )
+		{
+			if( usn_record_index > 0 )
+			{
+				break;
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid USN record: 0x%08" PRIx64 " size value out of bounds.",
+			 function,
+			 journal_data_offset + journal_data_index );
+
+			return( -1 );
+		}
+		usn_records[ usn_record_index ].offset    = journal_data_offset + (off64_t) journal_data_index;
+		usn_records[ usn_record_index ].data      = &( journal_data[ journal_data_index ] );
+		usn_records[ usn_record_index ].data_size = (size_t) usn_record_size;
+
+		usn_record_index++;
+
+		journal_data_index += (size_t) usn_record_size;
+	}
+	*number_of_usn_records = usn_record_index;
+	*parsed_data_size      = journal_data_index;
+
+	return( 1 );
+}
+
+/* Reads an USN record from the USN change journal
+ * Returns the number of bytes read if successful, 0 if no more USN records or -1 on error
+ */
+ssize_t libfsntfs_usn_change_journal_read_usn_record(
+         libfsntfs_usn_change_journal_t *usn_change_journal,
+         uint8_t *usn_record_data,
+         size_t usn_record_data_size,
+         libcerror_error_t **error )
+{
+	libfsntfs_usn_record_view_t usn_record;
+
+	libfsntfs_internal_usn_change_journal_t *internal_usn_change_journal = NULL;
+	static char *function                                                = "libfsntfs_usn_change_journal_read_usn_record";
+	off64_t journal_data_offset                                          = 0;
+	size_t journal_data_index                                            = 0;
+	size_t parsed_data_size                                              = 0;
+	size_t read_size                                                     = 0;
+	int number_of_usn_records                                            = 0;
+	int result                                                           = 0;
+
+	if( usn_change_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN change journal.",
+		 function );
+
+		return( -1 );
+	}
+	internal_usn_change_journal = (libfsntfs_internal_usn_change_journal_t *) usn_change_journal;
+
+	if( usn_record_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN record data.",
+		 function );
+
+		return( -1 );
+	}
+	if( usn_record_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid USN record data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_usn_change_journal->journal_data == NULL )
+	{
+		internal_usn_change_journal->journal_data = (uint8_t *) memory_allocate(
+		                                                         sizeof( uint8_t ) * LIBFSNTFS_USN_CHANGE_JOURNAL_BUFFER_SIZE );
+
+		if( internal_usn_change_journal->journal_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create journal data.",
+			 function );
+
+			return( -1 );
+		}
+		internal_usn_change_journal->journal_data_offset = 0;
+		internal_usn_change_journal->journal_data_size   = 0;
+	}
+	while( number_of_usn_records == 0 )
+	{
+		/* The journal data is only read when the data offset is outside
+		 * the journal data that was read previously
+		 */
+		if( ( internal_usn_change_journal->data_offset < internal_usn_change_journal->journal_data_offset )
+		 || ( internal_usn_change_journal->data_offset >= ( internal_usn_change_journal->journal_data_offset + (off64_t) internal_usn_change_journal->journal_data_size ) ) )
+		{
+			journal_data_offset = internal_usn_change_journal->data_offset;
+
+			result = libfsntfs_internal_usn_change_journal_read_journal_data(
+			          internal_usn_change_journal,
+			          internal_usn_change_journal->journal_data,
+			          LIBFSNTFS_USN_CHANGE_JOURNAL_BUFFER_SIZE,
+			          &journal_data_offset,
+			          &read_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read journal data.",
+				 function );
+
+				internal_usn_change_journal->journal_data_size = 0;
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				return( 0 );
+			}
+			internal_usn_change_journal->data_offset         = journal_data_offset;
+			internal_usn_change_journal->journal_data_offset = journal_data_offset;
+			internal_usn_change_journal->journal_data_size   = read_size;
+		}
+		journal_data_index = (size_t) ( internal_usn_change_journal->data_offset - internal_usn_change_journal->journal_data_offset );
+
+		if( libfsntfs_usn_change_journal_parse_usn_records(
+		     internal_usn_change_journal->journal_block_size,
+		     &( internal_usn_change_journal->journal_data[ journal_data_index ] ),
+		     internal_usn_change_journal->journal_data_size - journal_data_index,
+		     internal_usn_change_journal->data_offset,
+		     &usn_record,
+		     1,
+		     &number_of_usn_records,
+		     &parsed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to parse USN record.",
+			 function );
+
+			return( -1 );
+		}
+		if( number_of_usn_records == 0 )
+		{
+			internal_usn_change_journal->data_offset += (off64_t) parsed_data_size;
+		}
+	}
+	if( usn_record_data_size < usn_record.data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: USN record data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     usn_record_data,
+	     usn_record.data,
+	     usn_record.data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy USN record data.",
+		 function );
+
+		return( -1 );
+	}
+	internal_usn_change_journal->data_offset += (off64_t) parsed_data_size;
+
+	return( (ssize_t) usn_record.data_size );
+}
+
+/* Reads multiple USN records from the USN change journal
+ * The journal data is read into the buffer in large reads and the USN records
+ * are returned as views into the buffer, which remain valid until the buffer is reused.
+ * The buffer size must be at least the journal block size of 4096 bytes
+ * Returns 1 if successful, 0 if no more USN records or -1 on error
+ */
+int libfsntfs_usn_change_journal_read_usn_records(
+     libfsntfs_usn_change_journal_t *usn_change_journal,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libfsntfs_usn_record_view_t *usn_records,
+     int maximum_number_of_usn_records,
+     int *number_of_usn_records,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_usn_change_journal_t *internal_usn_change_journal = NULL;
+	static char *function                                                = "libfsntfs_usn_change_journal_read_usn_records";
+	off64_t journal_data_offset                                          = 0;
+	size_t parsed_data_size                                              = 0;
+	size_t read_size                                                     = 0;
+	int result                                                           = 0;
+
+	if( usn_change_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN change journal.",
+		 function );
+
+		return( -1 );
+	}
+	internal_usn_change_journal = (libfsntfs_internal_usn_change_journal_t *) usn_change_journal;
+
+	if( number_of_usn_records == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of USN records.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_usn_records = 0;
+
+	while( *number_of_usn_records == 0 )
+	{
+		journal_data_offset = internal_usn_change_journal->data_offset;
+
+		result = libfsntfs_internal_usn_change_journal_read_journal_data(
+		          internal_usn_change_journal,
+		          buffer,
+		          buffer_size,
+		          &journal_data_offset,
+		          &read_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read journal data.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( libfsntfs_usn_change_journal_parse_usn_records(
+		     internal_usn_change_journal->journal_block_size,
+		     buffer,
+		     read_size,
+		     journal_data_offset,
+		     usn_records,
+		     maximum_number_of_usn_records,
+		     number_of_usn_records,
+		     &parsed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to parse USN records.",
+			 function );
+
+			return( -1 );
+		}
+		internal_usn_change_journal->data_offset = journal_data_offset + (off64_t) parsed_data_size;
+	}
+	return( 1 );
+}
+
+
+/* Scans the USN records from the current offset using multiple threads
+ * The journal data is split into block-aligned chunks that are read by the calling thread
+ * and parsed by number_of_threads worker threads
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
+ */
+int libfsntfs_usn_change_journal_scan_parallel(
+     libfsntfs_usn_change_journal_t *usn_change_journal,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            const libfsntfs_usn_record_view_t *usn_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_usn_change_journal_t *internal_usn_change_journal = NULL;
+	static char *function                                                = "libfsntfs_usn_change_journal_scan_parallel";
+	int result                                                           = 0;
+
+	if( usn_change_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN change journal.",
+		 function );
+
+		return( -1 );
+	}
+	internal_usn_change_journal = (libfsntfs_internal_usn_change_journal_t *) usn_change_journal;
+
+	result = libfsntfs_usn_scan_parallel(
+	          internal_usn_change_journal,
+	          number_of_threads,
+	          scan_flags,
+	          callback_function,
+	          callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to scan USN records.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
 }
 
@@ -25,7 +25,13 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_attribute.h"
+#include "libfsntfs_directory_entry.h"
 #include "libfsntfs_extern.h"
+#include "libfsntfs_io_handle.h"
+#include "libfsntfs_libbfio.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_mft_entry.h"
 #include "libfsntfs_types.h"
 
 #if defined( __cplusplus )
@@ -56,7 +62,7 @@ struct libfsntfs_internal_usn_change_journal
 	 */
 	libfsntfs_data_stream_t *data_stream;
 
-	/* The data offset
+	/* The data offset, which is the offset of the next USN record
 	 */
 	off64_t data_offset;
 
@@ -64,37 +70,22 @@ struct libfsntfs_internal_usn_change_journal
 	 */
 	size64_t data_size;
 
-	/* The number of extents
-	 */
-	int number_of_extents;
-
-	/* The extent index
-	 */
-	int extent_index;
-
-	/* The extent offset
-	 */
-	off64_t extent_offset;
-
-	/* The extent size
-	 */
-	size64_t extent_size;
-
-	/* The extent flags
+	/* The journal block size
 	 */
-	uint32_t extent_flags;
+	size_t journal_block_size;
 
-	/* The journal block data
+	/* The journal data
+	 * Contains the data of multiple journal blocks and is allocated on demand by read_usn_record
 	 */
-	uint8_t *journal_block_data;
+	uint8_t *journal_data;
 
-	/* The journal block (data) offset
+	/* The journal data offset
 	 */
-	size_t journal_block_offset;
+	off64_t journal_data_offset;
 
-	/* The journal block size
+	/* The journal data size
 	 */
-	size64_t journal_block_size;
+	size_t journal_data_size;
 };
 
 int libfsntfs_usn_change_journal_initialize(
@@ -117,6 +108,32 @@ int libfsntfs_usn_change_journal_get_offset(
      off64_t *offset,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_usn_change_journal_seek_usn(
+     libfsntfs_usn_change_journal_t *usn_change_journal,
+     uint64_t update_sequence_number,
+     uint8_t seek_flags,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_usn_change_journal_read_journal_data(
+     libfsntfs_internal_usn_change_journal_t *internal_usn_change_journal,
+     uint8_t *journal_data,
+     size_t journal_data_size,
+     off64_t *journal_data_offset,
+     size_t *read_size,
+     libcerror_error_t **error );
+
+int libfsntfs_usn_change_journal_parse_usn_records(
+     size_t journal_block_size,
+     const uint8_t *journal_data,
+     size_t journal_data_size,
+     off64_t journal_data_offset,
+     libfsntfs_usn_record_view_t *usn_records,
+     int maximum_number_of_usn_records,
+     int *number_of_usn_records,
+     size_t *parsed_data_size,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 ssize_t libfsntfs_usn_change_journal_read_usn_record(
          libfsntfs_usn_change_journal_t *usn_change_journal,
@@ -124,6 +141,28 @@ ssize_t libfsntfs_usn_change_journal_read_usn_record(
          size_t usn_record_data_size,
          libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_usn_change_journal_read_usn_records(
+     libfsntfs_usn_change_journal_t *usn_change_journal,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libfsntfs_usn_record_view_t *usn_records,
+     int maximum_number_of_usn_records,
+     int *number_of_usn_records,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_usn_change_journal_scan_parallel(
+     libfsntfs_usn_change_journal_t *usn_change_journal,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            const libfsntfs_usn_record_view_t *usn_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
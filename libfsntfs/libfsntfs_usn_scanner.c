@@ -0,0 +1,1132 @@
+/*
+ * USN scanner functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfsntfs_definitions.h"
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_types.h"
+#include "libfsntfs_usn_change_journal.h"
+#include "libfsntfs_usn_scanner.h"
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+/* Creates an USN scanner
+ * Make sure the value usn_scanner is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_usn_scanner_initialize(
+     libfsntfs_usn_scanner_t **usn_scanner,
+     libfsntfs_internal_usn_change_journal_t *usn_change_journal,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            const libfsntfs_usn_record_view_t *usn_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_usn_scanner_initialize";
+
+	if( usn_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *usn_scanner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid USN scanner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( usn_change_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN change journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	*usn_scanner = memory_allocate_structure(
+	                libfsntfs_usn_scanner_t );
+
+	if( *usn_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create USN scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *usn_scanner,
+	     0,
+	     sizeof( libfsntfs_usn_scanner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear USN scanner.",
+		 function );
+
+		memory_free(
+		 *usn_scanner );
+
+		*usn_scanner = NULL;
+
+		return( -1 );
+	}
+	( *usn_scanner )->usn_change_journal = usn_change_journal;
+	( *usn_scanner )->scan_flags         = scan_flags;
+	( *usn_scanner )->callback_function  = callback_function;
+	( *usn_scanner )->callback_data      = callback_data;
+
+	return( 1 );
+}
+
+/* Frees an USN scanner
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_usn_scanner_free(
+     libfsntfs_usn_scanner_t **usn_scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_usn_scanner_free";
+
+	if( usn_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *usn_scanner != NULL )
+	{
+		/* The usn_change_journal reference is freed elsewhere
+		 */
+		memory_free(
+		 *usn_scanner );
+
+		*usn_scanner = NULL;
+	}
+	return( 1 );
+}
+
+/* Creates an USN scanner chunk
+ * Make sure the value chunk is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_usn_scanner_chunk_initialize(
+     libfsntfs_usn_scanner_chunk_t **chunk,
+     libfsntfs_usn_scanner_t *usn_scanner,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_usn_scanner_chunk_initialize";
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( usn_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk = memory_allocate_structure(
+	          libfsntfs_usn_scanner_chunk_t );
+
+	if( *chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk,
+	     0,
+	     sizeof( libfsntfs_usn_scanner_chunk_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk.",
+		 function );
+
+		memory_free(
+		 *chunk );
+
+		*chunk = NULL;
+
+		return( -1 );
+	}
+	( *chunk )->data = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * data_size );
+
+	if( ( *chunk )->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk )->scanner   = usn_scanner;
+	( *chunk )->data_size = data_size;
+
+	return( 1 );
+
+on_error:
+	if( *chunk != NULL )
+	{
+		memory_free(
+		 *chunk );
+
+		*chunk = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an USN scanner chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_usn_scanner_chunk_free(
+     libfsntfs_usn_scanner_chunk_t **chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_usn_scanner_chunk_free";
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk != NULL )
+	{
+		/* The scanner reference is freed elsewhere
+		 */
+		if( ( *chunk )->usn_records != NULL )
+		{
+			memory_free(
+			 ( *chunk )->usn_records );
+		}
+		if( ( *chunk )->data != NULL )
+		{
+			memory_free(
+			 ( *chunk )->data );
+		}
+		memory_free(
+		 *chunk );
+
+		*chunk = NULL;
+	}
+	return( 1 );
+}
+
+/* Parses the USN records of an USN scanner chunk
+ * If the callbacks are not delivered in USN order the callback function is called
+ * for every USN record, otherwise the USN records are stored in the chunk
+ * Process callback function for the ordered queue, called by the worker threads
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int libfsntfs_usn_scanner_chunk_parse_usn_records(
+     libfsntfs_usn_scanner_chunk_t *chunk,
+     libcerror_error_t **error )
+{
+	libfsntfs_usn_record_view_t *usn_records = NULL;
+	libfsntfs_usn_scanner_t *usn_scanner     = NULL;
+	static char *function                    = "libfsntfs_usn_scanner_chunk_parse_usn_records";
+	size_t parsed_data_size                  = 0;
+	int abort                                = 0;
+	int maximum_number_of_usn_records        = 0;
+	int number_of_usn_records                = 0;
+	int result                               = 0;
+	int usn_record_index                     = 0;
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk->scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk - missing scanner.",
+		 function );
+
+		return( -1 );
+	}
+	usn_scanner = chunk->scanner;
+
+	if( usn_scanner->usn_change_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid USN scanner - missing USN change journal.",
+		 function );
+
+		return( -1 );
+	}
+	/* An USN record is at least 60 bytes in size
+	 */
+	if( ( ( chunk->data_size / 60 ) + 1 ) > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_usn_records = (int) ( chunk->data_size / 60 ) + 1;
+
+	if( libfsntfs_ordered_queue_get_abort(
+	     usn_scanner->queue,
+	     &abort,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve abort.",
+		 function );
+
+		return( -1 );
+	}
+	if( abort != 0 )
+	{
+		return( 0 );
+	}
+	usn_records = (libfsntfs_usn_record_view_t *) memory_allocate(
+	                                               sizeof( libfsntfs_usn_record_view_t ) * maximum_number_of_usn_records );
+
+	if( usn_records == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create USN records.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_usn_change_journal_parse_usn_records(
+	     usn_scanner->usn_change_journal->journal_block_size,
+	     chunk->data,
+	     chunk->data_size,
+	     chunk->data_offset,
+	     usn_records,
+	     maximum_number_of_usn_records,
+	     &number_of_usn_records,
+	     &parsed_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to parse USN records at offset: 0x%08" PRIx64 ".",
+		 function,
+		 chunk->data_offset );
+
+		goto on_error;
+	}
+	/* The parsing stops at an invalid USN record that follows valid USN records
+	 */
+	if( parsed_data_size < chunk->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid USN record at offset: 0x%08" PRIx64 ".",
+		 function,
+		 chunk->data_offset + (off64_t) parsed_data_size );
+
+		goto on_error;
+	}
+	if( ( usn_scanner->scan_flags & LIBFSNTFS_SCAN_FLAG_UNORDERED ) == 0 )
+	{
+		chunk->usn_records           = usn_records;
+		chunk->number_of_usn_records = number_of_usn_records;
+
+		return( 1 );
+	}
+	for( usn_record_index = 0;
+	     usn_record_index < number_of_usn_records;
+	     usn_record_index++ )
+	{
+		if( libfsntfs_ordered_queue_get_abort(
+		     usn_scanner->queue,
+		     &abort,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve abort.",
+			 function );
+
+			goto on_error;
+		}
+		if( abort != 0 )
+		{
+			break;
+		}
+		result = usn_scanner->callback_function(
+		          &( usn_records[ usn_record_index ] ),
+		          usn_scanner->callback_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: callback function failed for USN record at offset: 0x%08" PRIx64 ".",
+			 function,
+			 usn_records[ usn_record_index ].offset );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libfsntfs_ordered_queue_set_abort(
+			     usn_scanner->queue,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set abort.",
+				 function );
+
+				goto on_error;
+			}
+			abort = 1;
+
+			break;
+		}
+	}
+	memory_free(
+	 usn_records );
+
+	if( abort != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( usn_records != NULL )
+	{
+		memory_free(
+		 usn_records );
+	}
+	return( -1 );
+}
+
+/* Delivers the USN records of a processed USN scanner chunk in USN order
+ * Deliver callback function for the ordered queue, called by the calling thread
+ * Returns 1 if successful, 0 if stopped or -1 on error
+ */
+int libfsntfs_usn_scanner_chunk_deliver(
+     libfsntfs_usn_scanner_chunk_t *chunk,
+     libcerror_error_t **error )
+{
+	libfsntfs_usn_scanner_t *usn_scanner = NULL;
+	static char *function                = "libfsntfs_usn_scanner_chunk_deliver";
+	int result                           = 0;
+	int usn_record_index                 = 0;
+
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk->scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk - missing scanner.",
+		 function );
+
+		return( -1 );
+	}
+	usn_scanner = chunk->scanner;
+
+	for( usn_record_index = 0;
+	     usn_record_index < chunk->number_of_usn_records;
+	     usn_record_index++ )
+	{
+		result = usn_scanner->callback_function(
+		          &( chunk->usn_records[ usn_record_index ] ),
+		          usn_scanner->callback_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: callback function failed for USN record at offset: 0x%08" PRIx64 ".",
+			 function,
+			 chunk->usn_records[ usn_record_index ].offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Scans the USN records using a pool of worker threads
+ * The calling thread reads the journal data in chunks that are parsed by the worker threads.
+ * The chunks are block-aligned ranges of the data extents of $J, since USN records do not
+ * cross journal block boundaries the chunks can be parsed independently.
+ * The callbacks are delivered in USN order by the calling thread unless
+ * LIBFSNTFS_SCAN_FLAG_UNORDERED is set, in which case the worker threads
+ * call the callback function concurrently
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
+ */
+int libfsntfs_usn_scanner_scan(
+     libfsntfs_usn_scanner_t *usn_scanner,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libfsntfs_usn_scanner_chunk_t *chunk = NULL;
+	static char *function                = "libfsntfs_usn_scanner_scan";
+	size_t read_size                     = 0;
+	off64_t data_offset                  = 0;
+	off64_t journal_data_offset          = 0;
+	int read_result                      = 0;
+	int result                           = 1;
+
+	if( usn_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( usn_scanner->usn_change_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid USN scanner - missing USN change journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( usn_scanner->queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid USN scanner - queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_ordered_queue_initialize(
+	     &( usn_scanner->queue ),
+	     number_of_threads,
+	     (int (*)(intptr_t *, libcerror_error_t **)) &libfsntfs_usn_scanner_chunk_parse_usn_records,
+	     (int (*)(intptr_t *, libcerror_error_t **)) &libfsntfs_usn_scanner_chunk_deliver,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_usn_scanner_chunk_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create queue.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = usn_scanner->usn_change_journal->data_offset;
+
+	while( result != 0 )
+	{
+		if( libfsntfs_usn_scanner_chunk_initialize(
+		     &chunk,
+		     usn_scanner,
+		     LIBFSNTFS_USN_SCANNER_CHUNK_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk.",
+			 function );
+
+			goto on_error;
+		}
+		/* The sparse extents are skipped and the read stops at a journal block boundary
+		 * or the start of the next sparse extent
+		 */
+		journal_data_offset = data_offset;
+
+		read_result = libfsntfs_internal_usn_change_journal_read_journal_data(
+		               usn_scanner->usn_change_journal,
+		               chunk->data,
+		               LIBFSNTFS_USN_SCANNER_CHUNK_SIZE,
+		               &journal_data_offset,
+		               &read_size,
+		               error );
+
+		if( read_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read journal data at offset: 0x%08" PRIx64 ".",
+			 function,
+			 data_offset );
+
+			goto on_error;
+		}
+		else if( read_result == 0 )
+		{
+			break;
+		}
+		chunk->data_offset = journal_data_offset;
+		chunk->data_size   = read_size;
+
+		data_offset = journal_data_offset + (off64_t) read_size;
+
+		result = libfsntfs_ordered_queue_push(
+		          usn_scanner->queue,
+		          (intptr_t *) chunk,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			chunk = NULL;
+		}
+	}
+	if( chunk != NULL )
+	{
+		if( libfsntfs_usn_scanner_chunk_free(
+		     &chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Once stopped the queued chunks are not delivered
+	 */
+	result = libfsntfs_ordered_queue_join(
+	          usn_scanner->queue,
+	          (uint8_t) ( result != 0 ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to join queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_ordered_queue_free(
+	     &( usn_scanner->queue ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free queue.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( usn_scanner->queue != NULL )
+	{
+		/* Freeing the queue stops the worker threads before the queued chunks are freed
+		 */
+		libfsntfs_ordered_queue_free(
+		 &( usn_scanner->queue ),
+		 NULL );
+	}
+	if( chunk != NULL )
+	{
+		libfsntfs_usn_scanner_chunk_free(
+		 &chunk,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+/* Scans the USN records
+ * The journal data is read in large reads and every USN record is passed to the callback function
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
+ */
+int libfsntfs_usn_scan(
+     libfsntfs_internal_usn_change_journal_t *usn_change_journal,
+     int (*callback_function)(
+            const libfsntfs_usn_record_view_t *usn_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libfsntfs_usn_record_view_t *usn_records = NULL;
+	uint8_t *journal_data                    = NULL;
+	static char *function                    = "libfsntfs_usn_scan";
+	size_t parsed_data_size                  = 0;
+	size_t read_size                         = 0;
+	off64_t data_offset                      = 0;
+	off64_t journal_data_offset              = 0;
+	int maximum_number_of_usn_records        = 0;
+	int number_of_usn_records                = 0;
+	int result                               = 1;
+	int usn_record_index                     = 0;
+
+	if( usn_change_journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid USN change journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	journal_data = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * LIBFSNTFS_USN_CHANGE_JOURNAL_BUFFER_SIZE );
+
+	if( journal_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create journal data.",
+		 function );
+
+		goto on_error;
+	}
+	/* An USN record is at least 60 bytes in size
+	 */
+	maximum_number_of_usn_records = ( LIBFSNTFS_USN_CHANGE_JOURNAL_BUFFER_SIZE / 60 ) + 1;
+
+	usn_records = (libfsntfs_usn_record_view_t *) memory_allocate(
+	                                               sizeof( libfsntfs_usn_record_view_t ) * maximum_number_of_usn_records );
+
+	if( usn_records == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create USN records.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = usn_change_journal->data_offset;
+
+	while( result != 0 )
+	{
+		journal_data_offset = data_offset;
+
+		result = libfsntfs_internal_usn_change_journal_read_journal_data(
+		          usn_change_journal,
+		          journal_data,
+		          LIBFSNTFS_USN_CHANGE_JOURNAL_BUFFER_SIZE,
+		          &journal_data_offset,
+		          &read_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read journal data at offset: 0x%08" PRIx64 ".",
+			 function,
+			 data_offset );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			result = 1;
+
+			break;
+		}
+		if( libfsntfs_usn_change_journal_parse_usn_records(
+		     usn_change_journal->journal_block_size,
+		     journal_data,
+		     read_size,
+		     journal_data_offset,
+		     usn_records,
+		     maximum_number_of_usn_records,
+		     &number_of_usn_records,
+		     &parsed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to parse USN records at offset: 0x%08" PRIx64 ".",
+			 function,
+			 journal_data_offset );
+
+			goto on_error;
+		}
+		for( usn_record_index = 0;
+		     usn_record_index < number_of_usn_records;
+		     usn_record_index++ )
+		{
+			result = callback_function(
+			          &( usn_records[ usn_record_index ] ),
+			          callback_data,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: callback function failed for USN record at offset: 0x%08" PRIx64 ".",
+				 function,
+				 usn_records[ usn_record_index ].offset );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+		}
+		/* If the parsing stopped at an invalid USN record it is reported by the next parse
+		 */
+		data_offset = journal_data_offset + (off64_t) parsed_data_size;
+	}
+	memory_free(
+	 usn_records );
+
+	memory_free(
+	 journal_data );
+
+	return( result );
+
+on_error:
+	if( usn_records != NULL )
+	{
+		memory_free(
+		 usn_records );
+	}
+	if( journal_data != NULL )
+	{
+		memory_free(
+		 journal_data );
+	}
+	return( -1 );
+}
+
+/* Scans the USN records using multiple threads
+ * Falls back to a sequential scan if multi-threading support is not available
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
+ */
+int libfsntfs_usn_scan_parallel(
+     libfsntfs_internal_usn_change_journal_t *usn_change_journal,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            const libfsntfs_usn_record_view_t *usn_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libfsntfs_usn_scanner_t *usn_scanner = NULL;
+#endif
+	static char *function                = "libfsntfs_usn_scan_parallel";
+	int result                           = 0;
+
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( scan_flags & ~( LIBFSNTFS_SCAN_FLAG_UNORDERED ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported scan flags: 0x%02" PRIx8 ".",
+		 function,
+		 scan_flags );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libfsntfs_usn_scanner_initialize(
+	     &usn_scanner,
+	     usn_change_journal,
+	     scan_flags,
+	     callback_function,
+	     callback_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create USN scanner.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfsntfs_usn_scanner_scan(
+	          usn_scanner,
+	          number_of_threads,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to scan USN records.",
+		 function );
+
+		libfsntfs_usn_scanner_free(
+		 &usn_scanner,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libfsntfs_usn_scanner_free(
+	     &usn_scanner,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free USN scanner.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	result = libfsntfs_usn_scan(
+	          usn_change_journal,
+	          callback_function,
+	          callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to scan USN records.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,161 @@
+/*
+ * USN scanner functions
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSNTFS_USN_SCANNER_H )
+#define _LIBFSNTFS_USN_SCANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfsntfs_libcerror.h"
+#include "libfsntfs_ordered_queue.h"
+#include "libfsntfs_types.h"
+#include "libfsntfs_usn_change_journal.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+
+typedef struct libfsntfs_usn_scanner libfsntfs_usn_scanner_t;
+
+struct libfsntfs_usn_scanner
+{
+	/* The USN change journal
+	 */
+	libfsntfs_internal_usn_change_journal_t *usn_change_journal;
+
+	/* The scan flags
+	 */
+	uint8_t scan_flags;
+
+	/* The callback function
+	 */
+	int (*callback_function)(
+	       const libfsntfs_usn_record_view_t *usn_record,
+	       void *callback_data,
+	       libcerror_error_t **error );
+
+	/* The callback data
+	 */
+	void *callback_data;
+
+	/* The ordered queue of chunks
+	 */
+	libfsntfs_ordered_queue_t *queue;
+};
+
+typedef struct libfsntfs_usn_scanner_chunk libfsntfs_usn_scanner_chunk_t;
+
+struct libfsntfs_usn_scanner_chunk
+{
+	/* The scanner
+	 */
+	libfsntfs_usn_scanner_t *scanner;
+
+	/* The journal data
+	 */
+	uint8_t *data;
+
+	/* The journal data size
+	 */
+	size_t data_size;
+
+	/* The offset of the journal data in the $J data stream
+	 */
+	off64_t data_offset;
+
+	/* The USN records, used when the callbacks are delivered in USN order
+	 */
+	libfsntfs_usn_record_view_t *usn_records;
+
+	/* The number of USN records
+	 */
+	int number_of_usn_records;
+};
+
+int libfsntfs_usn_scanner_initialize(
+     libfsntfs_usn_scanner_t **usn_scanner,
+     libfsntfs_internal_usn_change_journal_t *usn_change_journal,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            const libfsntfs_usn_record_view_t *usn_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+int libfsntfs_usn_scanner_free(
+     libfsntfs_usn_scanner_t **usn_scanner,
+     libcerror_error_t **error );
+
+int libfsntfs_usn_scanner_chunk_initialize(
+     libfsntfs_usn_scanner_chunk_t **chunk,
+     libfsntfs_usn_scanner_t *usn_scanner,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfsntfs_usn_scanner_chunk_free(
+     libfsntfs_usn_scanner_chunk_t **chunk,
+     libcerror_error_t **error );
+
+int libfsntfs_usn_scanner_chunk_parse_usn_records(
+     libfsntfs_usn_scanner_chunk_t *chunk,
+     libcerror_error_t **error );
+
+int libfsntfs_usn_scanner_chunk_deliver(
+     libfsntfs_usn_scanner_chunk_t *chunk,
+     libcerror_error_t **error );
+
+int libfsntfs_usn_scanner_scan(
+     libfsntfs_usn_scanner_t *usn_scanner,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT ) */
+
+int libfsntfs_usn_scan(
+     libfsntfs_internal_usn_change_journal_t *usn_change_journal,
+     int (*callback_function)(
+            const libfsntfs_usn_record_view_t *usn_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+int libfsntfs_usn_scan_parallel(
+     libfsntfs_internal_usn_change_journal_t *usn_change_journal,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            const libfsntfs_usn_record_view_t *usn_record,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
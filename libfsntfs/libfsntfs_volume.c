@@ -24,21 +24,27 @@
 #include <types.h>
 
 #include "libfsntfs_attribute.h"
+#include "libfsntfs_cluster_bitmap.h"
 #include "libfsntfs_cluster_block.h"
 #include "libfsntfs_cluster_block_vector.h"
-#include "libfsntfs_data_run.h"
 #include "libfsntfs_debug.h"
+#include "libfsntfs_decompression_pool.h"
 #include "libfsntfs_definitions.h"
 #include "libfsntfs_directory_entries_tree.h"
 #include "libfsntfs_directory_entry.h"
+#include "libfsntfs_directory_entry_cache.h"
 #include "libfsntfs_file_entry.h"
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libcdata.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_libcnotify.h"
+#include "libfsntfs_libcthreads.h"
 #include "libfsntfs_libcstring.h"
 #include "libfsntfs_libuna.h"
 #include "libfsntfs_mft_entry.h"
+#include "libfsntfs_mft_scanner.h"
+#include "libfsntfs_path_index.h"
+#include "libfsntfs_upcase_table.h"
 #include "libfsntfs_usn_change_journal.h"
 #include "libfsntfs_volume.h"
 
@@ -519,6 +525,7 @@ int libfsntfs_volume_open_file_io_handle(
 	int bfio_access_flags                        = 0;
 	int file_io_handle_is_open                   = 0;
 	int file_io_handle_opened_in_library         = 0;
+	int result                                   = 1;
 
 	if( volume == NULL )
 	{
@@ -615,6 +622,23 @@ int libfsntfs_volume_open_file_io_handle(
 		}
 		file_io_handle_opened_in_library = 1;
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	internal_volume->access_flags = access_flags;
+
 	if( libfsntfs_volume_open_read(
 	     internal_volume,
 	     file_io_handle,
@@ -627,11 +651,32 @@ int libfsntfs_volume_open_file_io_handle(
 		 "%s: unable to read from file IO handle.",
 		 function );
 
-		goto on_error;
+		result = -1;
+	}
+	else
+	{
+		internal_volume->file_io_handle                   = file_io_handle;
+		internal_volume->file_io_handle_opened_in_library = file_io_handle_opened_in_library;
 	}
-	internal_volume->file_io_handle                   = file_io_handle;
-	internal_volume->file_io_handle_opened_in_library = file_io_handle_opened_in_library;
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -679,6 +724,21 @@ int libfsntfs_volume_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -762,6 +822,53 @@ int libfsntfs_volume_close(
 
 		result = -1;
 	}
+	if( internal_volume->cluster_bitmap != NULL )
+	{
+		if( libfsntfs_cluster_bitmap_free(
+		     &( internal_volume->cluster_bitmap ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cluster bitmap.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->directory_entry_cache != NULL )
+	{
+		if( libfsntfs_directory_entry_cache_free(
+		     &( internal_volume->directory_entry_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory entry cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	return( result );
 }
 
@@ -773,9 +880,10 @@ int libfsntfs_volume_open_read(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	libfsntfs_mft_entry_t *mft_entry = NULL;
-	static char *function            = "libfsntfs_volume_open_read";
-	size64_t mft_size                = 0;
+	libcerror_error_t *upcase_table_error = NULL;
+	libfsntfs_mft_entry_t *mft_entry      = NULL;
+	static char *function                 = "libfsntfs_volume_open_read";
+	size64_t mft_size                     = 0;
 
 	if( internal_volume == NULL )
 	{
@@ -941,51 +1049,88 @@ int libfsntfs_volume_open_read(
 	}
 /* TODO what about the mirror MFT ? */
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( ( internal_volume->access_flags & LIBFSNTFS_ACCESS_FLAG_DEFER_READ_BITMAP ) == 0 )
 	{
-		libcnotify_printf(
-		 "Reading MFT entry: 6 ($Bitmap):\n" );
-	}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading MFT entry: 6 ($Bitmap):\n" );
+		}
 #endif
-	if( libfsntfs_volume_read_bitmap(
-	     internal_volume,
-	     file_io_handle,
-	     error ) != 1 )
+		if( libfsntfs_volume_read_bitmap(
+		     internal_volume,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read MFT entry: 6.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( internal_volume->access_flags & LIBFSNTFS_ACCESS_FLAG_DEFER_READ_SECURITY_DESCRIPTORS ) == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read MFT entry: 6.",
-		 function );
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading MFT entry: 9 ($Secure):\n" );
+		}
+#endif
+		if( libfsntfs_volume_read_security_descriptors(
+		     internal_volume,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read MFT entry: 9.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
 		libcnotify_printf(
-		 "Reading MFT entry: 9 ($Secure):\n" );
+		 "Reading MFT entry: 10 ($UpCase):\n" );
 	}
 #endif
-	if( libfsntfs_volume_read_security_descriptors(
+	/* Names are compared without the upcase table if $UpCase cannot be read
+	 */
+	if( libfsntfs_volume_read_upcase_table(
 	     internal_volume,
 	     file_io_handle,
-	     error ) != 1 )
+	     &upcase_table_error ) == -1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read MFT entry: 9.",
-		 function );
-
-		goto on_error;
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read MFT entry: 10.\n",
+			 function );
+		}
+#endif
+		libcerror_error_free(
+		 &upcase_table_error );
 	}
 	return( 1 );
 
 on_error:
+	if( internal_volume->cluster_bitmap != NULL )
+	{
+		libfsntfs_cluster_bitmap_free(
+		 &( internal_volume->cluster_bitmap ),
+		 NULL );
+	}
 	if( internal_volume->mft != NULL )
 	{
 		libfsntfs_mft_free(
@@ -1077,16 +1222,18 @@ int libfsntfs_volume_has_volume_shadow_snapshots(
 	return( 0 );
 }
 
-/* Retrieves the cluster block size
+/* Sets the maximum number of entries of a specific cache
+ * The limit applies to caches created afterwards, set it before opening the volume
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_cluster_block_size(
+int libfsntfs_volume_set_cache_limit(
      libfsntfs_volume_t *volume,
-     size_t *cluster_block_size,
+     int cache_type,
+     int maximum_number_of_cache_entries,
      libcerror_error_t **error )
 {
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_cluster_block_size";
+	static char *function                        = "libfsntfs_volume_set_cache_limit";
 
 	if( volume == NULL )
 	{
@@ -1112,83 +1259,75 @@ int libfsntfs_volume_get_cluster_block_size(
 
 		return( -1 );
 	}
-	if( cluster_block_size == NULL )
+	if( ( cache_type < 0 )
+	 || ( cache_type >= LIBFSNTFS_NUMBER_OF_CACHE_TYPES ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid cluster block size.",
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported cache type.",
 		 function );
 
 		return( -1 );
 	}
-	*cluster_block_size = internal_volume->io_handle->cluster_block_size;
-
-	return( 1 );
-}
-
-/* Retrieves the MFT entry size
- * Returns 1 if successful or -1 on error
- */
-int libfsntfs_volume_get_mft_entry_size(
-     libfsntfs_volume_t *volume,
-     size32_t *mft_entry_size,
-     libcerror_error_t **error )
-{
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_mft_entry_size";
-
-	if( volume == NULL )
+	if( maximum_number_of_cache_entries <= 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid maximum number of cache entries value less than or equal to zero.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libfsntfs_internal_volume_t *) volume;
-
-	if( internal_volume->io_handle == NULL )
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( mft_entry_size == NULL )
+#endif
+	internal_volume->io_handle->maximum_number_of_cache_entries[ cache_type ] = maximum_number_of_cache_entries;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid MFT entry size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	*mft_entry_size = (size32_t) internal_volume->io_handle->mft_entry_size;
-
+#endif
 	return( 1 );
 }
 
-/* Retrieves the index entry size
+/* Retrieves the maximum number of entries of a specific cache
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_index_entry_size(
+int libfsntfs_volume_get_cache_limit(
      libfsntfs_volume_t *volume,
-     size32_t *index_entry_size,
+     int cache_type,
+     int *maximum_number_of_cache_entries,
      libcerror_error_t **error )
 {
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_index_entry_size";
+	static char *function                        = "libfsntfs_volume_get_cache_limit";
 
 	if( volume == NULL )
 	{
@@ -1214,79 +1353,79 @@ int libfsntfs_volume_get_index_entry_size(
 
 		return( -1 );
 	}
-	if( index_entry_size == NULL )
+	if( ( cache_type < 0 )
+	 || ( cache_type >= LIBFSNTFS_NUMBER_OF_CACHE_TYPES ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid index entry size.",
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported cache type.",
 		 function );
 
 		return( -1 );
 	}
-	*index_entry_size = (size32_t) internal_volume->io_handle->index_entry_size;
-
-	return( 1 );
-}
-
-/* Retrieves the size of the UTF-8 encoded name
- * The returned size includes the end of string character
- * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
- * Returns 1 if successful or -1 on error
- */
-int libfsntfs_volume_get_utf8_name_size(
-     libfsntfs_volume_t *volume,
-     size_t *utf8_name_size,
-     libcerror_error_t **error )
-{
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_utf8_name_size";
-
-	if( volume == NULL )
+	if( maximum_number_of_cache_entries == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid maximum number of cache entries.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libfsntfs_internal_volume_t *) volume;
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-	if( libfsntfs_mft_get_utf8_volume_name_size(
-	     internal_volume->mft,
-	     internal_volume->file_io_handle,
-	     utf8_name_size,
+		return( -1 );
+	}
+#endif
+	*maximum_number_of_cache_entries = internal_volume->io_handle->maximum_number_of_cache_entries[ cache_type ];
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size of UTF-8 volume name.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
+#endif
 	return( 1 );
 }
 
-/* Retrieves the UTF-8 encoded name
- * The size should include the end of string character
- * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
+/* Retrieves the number of hits and misses of a specific cache
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_utf8_name(
+int libfsntfs_volume_get_cache_statistics(
      libfsntfs_volume_t *volume,
-     uint8_t *utf8_name,
-     size_t utf8_name_size,
+     int cache_type,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
      libcerror_error_t **error )
 {
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_utf8_name";
+	static char *function                        = "libfsntfs_volume_get_cache_statistics";
+	uint64_t number_of_cache_lookups             = 0;
+	uint64_t number_of_cache_misses              = 0;
+	int result                                   = 0;
 
 	if( volume == NULL )
 	{
@@ -1301,169 +1440,121 @@ int libfsntfs_volume_get_utf8_name(
 	}
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
-	if( libfsntfs_mft_get_utf8_volume_name(
-	     internal_volume->mft,
-	     internal_volume->file_io_handle,
-	     utf8_name,
-	     utf8_name_size,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 volume name.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-/* Retrieves the size of the UTF-16 encoded name
- * The returned size includes the end of string character
- * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
- * Returns 1 if successful or -1 on error
- */
-int libfsntfs_volume_get_utf16_name_size(
-     libfsntfs_volume_t *volume,
-     size_t *utf16_name_size,
-     libcerror_error_t **error )
-{
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_utf16_name_size";
-
-	if( volume == NULL )
+	if( ( cache_type < 0 )
+	 || ( cache_type >= LIBFSNTFS_NUMBER_OF_CACHE_TYPES ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported cache type.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libfsntfs_internal_volume_t *) volume;
-
-	if( libfsntfs_mft_get_utf16_volume_name_size(
-	     internal_volume->mft,
-	     internal_volume->file_io_handle,
-	     utf16_name_size,
-	     error ) != 1 )
+	if( number_of_hits == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size of UTF-16 volune name.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-/* Retrieves the UTF-16 encoded name
- * The size should include the end of string character
- * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
- * Returns 1 if successful or -1 on error
- */
-int libfsntfs_volume_get_utf16_name(
-     libfsntfs_volume_t *volume,
-     uint16_t *utf16_name,
-     size_t utf16_name_size,
-     libcerror_error_t **error )
-{
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_utf16_name";
-
-	if( volume == NULL )
+	if( number_of_misses == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid number of misses.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libfsntfs_internal_volume_t *) volume;
-
-	if( libfsntfs_mft_get_utf16_volume_name(
-	     internal_volume->mft,
-	     internal_volume->file_io_handle,
-	     utf16_name,
-	     utf16_name_size,
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 volume name.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-/* Retrieves the version
- * Returns 1 if successful or -1 on error
- */
-int libfsntfs_volume_get_version(
-     libfsntfs_volume_t *volume,
-     uint8_t *major_version,
-     uint8_t *minor_version,
-     libcerror_error_t **error )
-{
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_version";
+#endif
+	result = libfsntfs_io_handle_get_cache_statistics(
+	          internal_volume->io_handle,
+	          cache_type,
+	          &number_of_cache_lookups,
+	          &number_of_cache_misses,
+	          error );
 
-	if( volume == NULL )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache statistics.",
 		 function );
-
-		return( -1 );
 	}
-	internal_volume = (libfsntfs_internal_volume_t *) volume;
-
-	if( libfsntfs_mft_get_volume_version(
-	     internal_volume->mft,
-	     internal_volume->file_io_handle,
-	     major_version,
-	     minor_version,
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume version.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	*number_of_hits   = number_of_cache_lookups - number_of_cache_misses;
+	*number_of_misses = number_of_cache_misses;
+
 	return( 1 );
 }
 
-/* Retrieves the serial number
+/* Sets the number of threads used to decompress compression units
+ * Reads of compressed data that cover multiple compression units decompress them concurrently,
+ * a value of 0 or 1 decompresses the compression units in the calling thread
+ * Without multi-threading support the compression units are always decompressed in the calling thread
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_serial_number(
+int libfsntfs_volume_set_number_of_decompression_threads(
      libfsntfs_volume_t *volume,
-     uint64_t *serial_number,
+     int number_of_threads,
      libcerror_error_t **error )
 {
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_serial_number";
+	static char *function                        = "libfsntfs_volume_set_number_of_decompression_threads";
+	int result                                   = 1;
 
 	if( volume == NULL )
 	{
@@ -1489,75 +1580,108 @@ int libfsntfs_volume_get_serial_number(
 
 		return( -1 );
 	}
-	if( serial_number == NULL )
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > ( INT_MAX / 4 ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid serial number.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	*serial_number = internal_volume->io_handle->volume_serial_number;
-
-	return( 1 );
-}
-
-/* Retrieves the number of file entries (MFT entries)
- * Returns 1 if successful or -1 on error
- */
-int libfsntfs_volume_get_number_of_file_entries(
-     libfsntfs_volume_t *volume,
-     uint64_t *number_of_file_entries,
-     libcerror_error_t **error )
-{
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	static char *function                        = "libfsntfs_volume_get_number_of_file_entries";
-
-	if( volume == NULL )
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libfsntfs_internal_volume_t *) volume;
+	/* The worker threads of the previous decompression pool are joined
+	 * before a pool with the new number of threads is created
+	 */
+	if( ( internal_volume->io_handle->decompression_pool != NULL )
+	 && ( internal_volume->io_handle->decompression_pool->number_of_threads != number_of_threads ) )
+	{
+		if( libfsntfs_decompression_pool_free(
+		     &( internal_volume->io_handle->decompression_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free decompression pool.",
+			 function );
 
-	if( libfsntfs_mft_get_number_of_entries(
-	     internal_volume->mft,
-	     number_of_file_entries,
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( number_of_threads > 1 )
+	 && ( internal_volume->io_handle->decompression_pool == NULL ) )
+	{
+		if( libfsntfs_decompression_pool_initialize(
+		     &( internal_volume->io_handle->decompression_pool ),
+		     number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create decompression pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( result == 1 )
+	{
+		internal_volume->io_handle->number_of_decompression_threads = number_of_threads;
+	}
+	else
+	{
+		internal_volume->io_handle->number_of_decompression_threads = 0;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->io_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of MFT entries.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
+#endif
+	return( result );
 }
 
-/* Retrieves the file entry of a specific MFT entry index
+/* Retrieves the number of threads used to decompress compression units
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_file_entry_by_index(
+int libfsntfs_volume_get_number_of_decompression_threads(
      libfsntfs_volume_t *volume,
-     uint64_t mft_entry_index,
-     libfsntfs_file_entry_t **file_entry,
+     int *number_of_threads,
      libcerror_error_t **error )
 {
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	libfsntfs_mft_entry_t *mft_entry             = NULL;
-	static char *function                        = "libfsntfs_volume_get_file_entry_by_index";
+	static char *function                        = "libfsntfs_volume_get_number_of_decompression_threads";
 
 	if( volume == NULL )
 	{
@@ -1572,78 +1696,73 @@ int libfsntfs_volume_get_file_entry_by_index(
 	}
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
-	if( file_entry == NULL )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file entry.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( *file_entry != NULL )
+	if( number_of_threads == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file entry value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfsntfs_mft_get_mft_entry_by_index(
-	     internal_volume->mft,
-	     internal_volume->file_io_handle,
-	     mft_entry_index,
-	     &mft_entry,
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry: %" PRIi64 ".",
-		 function,
-		 mft_entry_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
 		return( -1 );
 	}
-	if( libfsntfs_file_entry_initialize(
-	     file_entry,
-	     internal_volume->io_handle,
-	     internal_volume->file_io_handle,
-	     internal_volume->mft,
-	     mft_entry,
-	     NULL,
-	     0,
+#endif
+	*number_of_threads = internal_volume->io_handle->number_of_decompression_threads;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file entry.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
+#endif
 	return( 1 );
 }
 
-/* Retrieves the root directory file entry
+/* Retrieves the cluster block size
  * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_root_directory(
+int libfsntfs_volume_get_cluster_block_size(
      libfsntfs_volume_t *volume,
-     libfsntfs_file_entry_t **file_entry,
+     size_t *cluster_block_size,
      libcerror_error_t **error )
 {
 	libfsntfs_internal_volume_t *internal_volume = NULL;
-	libfsntfs_mft_entry_t *mft_entry             = NULL;
-	static char *function                        = "libfsntfs_volume_get_root_directory";
+	static char *function                        = "libfsntfs_volume_get_cluster_block_size";
 
 	if( volume == NULL )
 	{
@@ -1658,85 +1777,3061 @@ int libfsntfs_volume_get_root_directory(
 	}
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
-	if( file_entry == NULL )
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( cluster_block_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file entry.",
+		 "%s: invalid cluster block size.",
 		 function );
 
 		return( -1 );
 	}
-	if( *file_entry != NULL )
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file entry value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfsntfs_mft_get_mft_entry_by_index(
-	     internal_volume->mft,
-	     internal_volume->file_io_handle,
-	     LIBFSNTFS_MFT_ENTRY_INDEX_ROOT_DIRECTORY,
-	     &mft_entry,
+#endif
+	*cluster_block_size = internal_volume->io_handle->cluster_block_size;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry: 5.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfsntfs_file_entry_initialize(
-	     file_entry,
-	     internal_volume->io_handle,
+#endif
+	return( 1 );
+}
+
+/* Retrieves the MFT entry size
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_mft_entry_size(
+     libfsntfs_volume_t *volume,
+     size32_t *mft_entry_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_mft_entry_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*mft_entry_size = (size32_t) internal_volume->io_handle->mft_entry_size;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the index entry size
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_index_entry_size(
+     libfsntfs_volume_t *volume,
+     size32_t *index_entry_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_index_entry_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_entry_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index entry size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*index_entry_size = (size32_t) internal_volume->io_handle->index_entry_size;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the size of the UTF-8 encoded name
+ * The returned size includes the end of string character
+ * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_utf8_name_size(
+     libfsntfs_volume_t *volume,
+     size_t *utf8_name_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_utf8_name_size";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_mft_get_utf8_volume_name_size(
+	     internal_volume->mft,
+	     internal_volume->file_io_handle,
+	     utf8_name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of UTF-8 volume name.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-8 encoded name
+ * The size should include the end of string character
+ * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_utf8_name(
+     libfsntfs_volume_t *volume,
+     uint8_t *utf8_name,
+     size_t utf8_name_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_utf8_name";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_mft_get_utf8_volume_name(
+	     internal_volume->mft,
+	     internal_volume->file_io_handle,
+	     utf8_name,
+	     utf8_name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 volume name.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the UTF-16 encoded name
+ * The returned size includes the end of string character
+ * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_utf16_name_size(
+     libfsntfs_volume_t *volume,
+     size_t *utf16_name_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_utf16_name_size";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_mft_get_utf16_volume_name_size(
+	     internal_volume->mft,
+	     internal_volume->file_io_handle,
+	     utf16_name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of UTF-16 volune name.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-16 encoded name
+ * The size should include the end of string character
+ * This value is retrieved from the $VOLUME_NAME attribute of the $Volume metadata file
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_utf16_name(
+     libfsntfs_volume_t *volume,
+     uint16_t *utf16_name,
+     size_t utf16_name_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_utf16_name";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_mft_get_utf16_volume_name(
+	     internal_volume->mft,
+	     internal_volume->file_io_handle,
+	     utf16_name,
+	     utf16_name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 volume name.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the version
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_version(
+     libfsntfs_volume_t *volume,
+     uint8_t *major_version,
+     uint8_t *minor_version,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_version";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_mft_get_volume_version(
+	     internal_volume->mft,
+	     internal_volume->file_io_handle,
+	     major_version,
+	     minor_version,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume version.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the serial number
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_serial_number(
+     libfsntfs_volume_t *volume,
+     uint64_t *serial_number,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_serial_number";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( serial_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid serial number.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*serial_number = internal_volume->io_handle->volume_serial_number;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads the cluster allocation bitmap from $Bitmap if it was not read before
+ * The read/write lock of the IO handle is only grabbed for writing when the bitmap still needs to be read
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_volume_read_cluster_bitmap(
+     libfsntfs_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_internal_volume_read_cluster_bitmap";
+	int result            = 1;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->cluster_bitmap != NULL )
+	{
+		result = 0;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Another thread could have read the bitmap while the read/write lock was released
+	 */
+	if( internal_volume->cluster_bitmap == NULL )
+	{
+		if( internal_volume->file_io_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid volume - missing file IO handle.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+		else if( libcthreads_mutex_grab(
+		          internal_volume->io_handle->cache_mutex,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab cache mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		else
+		{
+			/* The MFT entry cache can be used by other threads that only hold the cache mutex
+			 */
+			if( libfsntfs_volume_read_bitmap(
+			     internal_volume,
+			     internal_volume->file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read MFT entry: 6.",
+				 function );
+
+				result = -1;
+			}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_release(
+			     internal_volume->io_handle->cache_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release cache mutex.",
+				 function );
+
+				result = -1;
+			}
+#endif
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the cluster allocation bitmap
+ * The caller must hold the read/write lock of the IO handle and have read the bitmap
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_internal_volume_get_cluster_bitmap(
+     libfsntfs_internal_volume_t *internal_volume,
+     libfsntfs_cluster_bitmap_t **cluster_bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libfsntfs_internal_volume_get_cluster_bitmap";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	/* The volume can have been closed after the bitmap was read
+	 */
+	if( internal_volume->cluster_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	*cluster_bitmap = internal_volume->cluster_bitmap;
+
+	return( 1 );
+}
+
+/* Determines if a specific cluster is allocated
+ * Returns 1 if allocated, 0 if not or -1 on error
+ */
+int libfsntfs_volume_is_cluster_allocated(
+     libfsntfs_volume_t *volume,
+     uint64_t cluster_number,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_bitmap_t *cluster_bitmap   = NULL;
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_is_cluster_allocated";
+	int result                                   = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_internal_volume_read_cluster_bitmap(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_internal_volume_get_cluster_bitmap(
+	     internal_volume,
+	     &cluster_bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster bitmap.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		result = libfsntfs_cluster_bitmap_is_cluster_allocated(
+		          cluster_bitmap,
+		          cluster_number,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if cluster: %" PRIu64 " is allocated.",
+			 function,
+			 cluster_number );
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the allocated range that contains or follows a specific offset
+ * If the cluster that contains the offset is allocated the range starts at the offset
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int libfsntfs_volume_get_next_allocated_range(
+     libfsntfs_volume_t *volume,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_bitmap_t *cluster_bitmap   = NULL;
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_next_allocated_range";
+	uint64_t cluster_number                      = 0;
+	uint64_t first_cluster_number                = 0;
+	uint64_t number_of_clusters                  = 0;
+	int result                                   = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle->cluster_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing cluster block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	cluster_number = (uint64_t) offset / internal_volume->io_handle->cluster_block_size;
+
+	if( libfsntfs_internal_volume_read_cluster_bitmap(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_internal_volume_get_cluster_bitmap(
+	     internal_volume,
+	     &cluster_bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster bitmap.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		result = libfsntfs_cluster_bitmap_get_next_allocated_range(
+		          cluster_bitmap,
+		          cluster_number,
+		          &first_cluster_number,
+		          &number_of_clusters,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next allocated range.",
+			 function );
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		*range_offset = (off64_t) ( first_cluster_number * internal_volume->io_handle->cluster_block_size );
+		*range_size   = (size64_t) ( number_of_clusters * internal_volume->io_handle->cluster_block_size );
+
+		if( *range_offset < offset )
+		{
+			*range_size  -= (size64_t) ( offset - *range_offset );
+			*range_offset = offset;
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the unallocated range that contains or follows a specific offset
+ * If the cluster that contains the offset is unallocated the range starts at the offset
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int libfsntfs_volume_get_next_unallocated_range(
+     libfsntfs_volume_t *volume,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_bitmap_t *cluster_bitmap   = NULL;
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_next_unallocated_range";
+	uint64_t cluster_number                      = 0;
+	uint64_t first_cluster_number                = 0;
+	uint64_t number_of_clusters                  = 0;
+	int result                                   = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle->cluster_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing cluster block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	cluster_number = (uint64_t) offset / internal_volume->io_handle->cluster_block_size;
+
+	if( libfsntfs_internal_volume_read_cluster_bitmap(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_internal_volume_get_cluster_bitmap(
+	     internal_volume,
+	     &cluster_bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster bitmap.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		result = libfsntfs_cluster_bitmap_get_next_unallocated_range(
+		          cluster_bitmap,
+		          cluster_number,
+		          &first_cluster_number,
+		          &number_of_clusters,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next unallocated range.",
+			 function );
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		*range_offset = (off64_t) ( first_cluster_number * internal_volume->io_handle->cluster_block_size );
+		*range_size   = (size64_t) ( number_of_clusters * internal_volume->io_handle->cluster_block_size );
+
+		if( *range_offset < offset )
+		{
+			*range_size  -= (size64_t) ( offset - *range_offset );
+			*range_offset = offset;
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the number of allocated and unallocated clusters
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_cluster_allocation_counts(
+     libfsntfs_volume_t *volume,
+     uint64_t *number_of_allocated_clusters,
+     uint64_t *number_of_unallocated_clusters,
+     libcerror_error_t **error )
+{
+	libfsntfs_cluster_bitmap_t *cluster_bitmap   = NULL;
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_cluster_allocation_counts";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_internal_volume_read_cluster_bitmap(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read cluster bitmap.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_internal_volume_get_cluster_bitmap(
+	     internal_volume,
+	     &cluster_bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster bitmap.",
+		 function );
+
+		result = -1;
+	}
+	else if( libfsntfs_cluster_bitmap_get_allocation_counts(
+	          cluster_bitmap,
+	          number_of_allocated_clusters,
+	          number_of_unallocated_clusters,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cluster allocation counts.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of file entries (MFT entries)
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_number_of_file_entries(
+     libfsntfs_volume_t *volume,
+     uint64_t *number_of_file_entries,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_get_number_of_file_entries";
+	int result                                   = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_mft_get_number_of_entries(
+	     internal_volume->mft,
+	     number_of_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of MFT entries.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the file entry of a specific MFT entry index
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_file_entry_by_index(
+     libfsntfs_volume_t *volume,
+     uint64_t mft_entry_index,
+     libfsntfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	libfsntfs_mft_entry_t *mft_entry             = NULL;
+	static char *function                        = "libfsntfs_volume_get_file_entry_by_index";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_mft_read_mft_entry_by_index(
+	     internal_volume->mft,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     mft_entry_index,
+	     &mft_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		goto on_error;
+	}
+	/* libfsntfs_file_entry_initialize takes over management of mft_entry
+	 */
+	if( libfsntfs_file_entry_initialize(
+	     file_entry,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     internal_volume->mft,
+	     mft_entry,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->io_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Scans the file entries of all MFT entries that are not empty
+ * The MFT is read in large sequential reads and every file entry is passed to the callback function.
+ * The file entry is freed after the callback function returns.
+ * MFT entries that cannot be read, e.g. due to corruption, are skipped.
+ * The volume is locked for reading during the scan, so the callback function should not close the volume.
+ * The callback function should return 1 to continue, 0 to stop or -1 on error
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
+ */
+int libfsntfs_volume_scan_mft(
+     libfsntfs_volume_t *volume,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_scan_mft";
+	int result                                   = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing MFT.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfsntfs_mft_scan(
+	          internal_volume->mft,
+	          internal_volume->io_handle,
+	          internal_volume->file_io_handle,
+	          0,
+	          callback_function,
+	          callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to scan MFT.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->io_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Scans the file entries of all MFT entries that are not empty using multiple threads
+ * The MFT is read in large sequential reads by the calling thread and parsed by number_of_threads worker threads.
+ * The callbacks are delivered in MFT order by the calling thread, unless LIBFSNTFS_SCAN_FLAG_UNORDERED
+ * is set in which case the callback function is called concurrently by the worker threads.
+ * The file entry is freed after the callback function returns.
+ * MFT entries that cannot be read, e.g. due to corruption, are skipped.
+ * The volume is locked for reading during the scan, so the callback function should not close the volume.
+ * The callback function should return 1 to continue, 0 to stop or -1 on error
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
+ */
+int libfsntfs_volume_scan_mft_parallel(
+     libfsntfs_volume_t *volume,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_scan_mft_parallel";
+	int result                                   = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing MFT.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfsntfs_mft_scan_parallel(
+	          internal_volume->mft,
+	          internal_volume->io_handle,
+	          internal_volume->file_io_handle,
+	          0,
+	          number_of_threads,
+	          scan_flags,
+	          callback_function,
+	          callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to scan MFT.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->io_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Builds a path index of all MFT entries
+ * The MFT is read in a single sequential pass and the full paths are reconstructed from
+ * the parent file references in the $FILE_NAME attributes
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_build_path_index(
+     libfsntfs_volume_t *volume,
+     libfsntfs_path_index_t **path_index,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	static char *function                        = "libfsntfs_volume_build_path_index";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( path_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid path index value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->mft == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing MFT.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_path_index_initialize(
+	     path_index,
+	     internal_volume->mft->number_of_mft_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create path index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_scan(
+	     internal_volume->mft,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     0,
+	     &libfsntfs_path_index_read_file_entry,
+	     (void *) *path_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to scan MFT.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		libfsntfs_path_index_free(
+		 path_index,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *path_index != NULL )
+	{
+		libfsntfs_path_index_free(
+		 path_index,
+		 NULL );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->io_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the root directory file entry
+ * Returns 1 if successful or -1 on error
+ */
+int libfsntfs_volume_get_root_directory(
+     libfsntfs_volume_t *volume,
+     libfsntfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	libfsntfs_mft_entry_t *mft_entry             = NULL;
+	static char *function                        = "libfsntfs_volume_get_root_directory";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfsntfs_mft_read_mft_entry_by_index(
+	     internal_volume->mft,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     LIBFSNTFS_MFT_ENTRY_INDEX_ROOT_DIRECTORY,
+	     &mft_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read MFT entry: 5.",
+		 function );
+
+		goto on_error;
+	}
+	/* libfsntfs_file_entry_initialize takes over management of mft_entry
+	 */
+	if( libfsntfs_file_entry_initialize(
+	     file_entry,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     internal_volume->mft,
+	     mft_entry,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->io_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Determines if the MFT entry referenced by a directory entry still has the sequence of the reference
+ * Returns 1 if current, 0 if the MFT entry was reused or -1 on error
+ */
+int libfsntfs_internal_volume_is_directory_entry_current(
+     libfsntfs_internal_volume_t *internal_volume,
+     libfsntfs_directory_entry_t *directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_mft_entry_t *mft_entry = NULL;
+	static char *function            = "libfsntfs_internal_volume_is_directory_entry_current";
+	uint64_t mft_entry_index         = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_directory_entry_get_mft_entry_index(
+	     directory_entry,
+	     &mft_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfsntfs_mft_get_mft_entry_by_index(
+	     internal_volume->mft,
 	     internal_volume->file_io_handle,
+	     mft_entry_index,
+	     &mft_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+		 function,
+		 mft_entry_index );
+
+		return( -1 );
+	}
+	if( mft_entry->sequence != (uint16_t) ( directory_entry->file_reference >> 48 ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the directory entry for an UTF-8 or UTF-16 encoded name in a directory
+ * Either the UTF-8 or the UTF-16 string should be set
+ * The lookup uses the directory entry cache, which is created on first use
+ * Entries are keyed by the parent file reference and only cached and returned
+ * from the cache when the sequence of the MFT entry matches the file reference
+ * Note that the parent MFT entry can be evicted from the MFT entry cache by this function
+ * The caller must hold the cache mutex of the IO handle
+ * A new directory_entry is allocated if a match is found
+ * Returns 1 if successful, 0 if no such directory entry or -1 on error
+ */
+int libfsntfs_internal_volume_get_directory_entry_by_name(
+     libfsntfs_internal_volume_t *internal_volume,
+     libfsntfs_mft_entry_t *parent_mft_entry,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_cache_key_t key;
+
+	libfsntfs_directory_entry_t *safe_directory_entry = NULL;
+	static char *function                             = "libfsntfs_internal_volume_get_directory_entry_by_name";
+	uint64_t parent_file_reference                    = 0;
+	uint64_t parent_mft_entry_index                   = 0;
+	int is_cacheable                                  = 0;
+	int result                                        = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf8_string == NULL )
+	 && ( utf16_string == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 and UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->directory_entry_cache == NULL )
+	{
+		if( libfsntfs_directory_entry_cache_initialize(
+		     &( internal_volume->directory_entry_cache ),
+		     internal_volume->io_handle->upcase_table,
+		     internal_volume->io_handle->maximum_number_of_cache_entries[ LIBFSNTFS_CACHE_TYPE_DIRECTORY_ENTRIES ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create directory entry cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	parent_mft_entry_index = (uint64_t) parent_mft_entry->index;
+	parent_file_reference  = ( (uint64_t) parent_mft_entry->sequence << 48 ) | parent_mft_entry_index;
+
+	if( utf8_string != NULL )
+	{
+		is_cacheable = libfsntfs_directory_entry_cache_key_set_from_utf8_string(
+		                &key,
+		                internal_volume->directory_entry_cache->upcase_table,
+		                parent_file_reference,
+		                utf8_string,
+		                utf8_string_length,
+		                error );
+	}
+	else
+	{
+		is_cacheable = libfsntfs_directory_entry_cache_key_set_from_utf16_string(
+		                &key,
+		                internal_volume->directory_entry_cache->upcase_table,
+		                parent_file_reference,
+		                utf16_string,
+		                utf16_string_length,
+		                error );
+	}
+	if( is_cacheable == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set directory entry cache key.",
+		 function );
+
+		goto on_error;
+	}
+	if( is_cacheable != 0 )
+	{
+		if( libfsntfs_io_handle_update_cache_statistics(
+		     internal_volume->io_handle,
+		     LIBFSNTFS_CACHE_TYPE_DIRECTORY_ENTRIES,
+		     1,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update cache statistics.",
+			 function );
+
+			goto on_error;
+		}
+		result = libfsntfs_directory_entry_cache_get_directory_entry(
+		          internal_volume->directory_entry_cache,
+		          &key,
+		          &safe_directory_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory entry from cache.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			result = libfsntfs_internal_volume_is_directory_entry_current(
+			          internal_volume,
+			          safe_directory_entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if directory entry is current.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				*directory_entry = safe_directory_entry;
+
+				return( 1 );
+			}
+			/* The MFT entry was reused since the directory entry was cached
+			 */
+			if( libfsntfs_directory_entry_free(
+			     &safe_directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free directory entry.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfsntfs_directory_entry_cache_remove_directory_entry(
+			     internal_volume->directory_entry_cache,
+			     &key,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to remove directory entry from cache.",
+				 function );
+
+				goto on_error;
+			}
+			/* Retrieving the referenced MFT entry can have evicted the parent MFT entry
+			 */
+			parent_mft_entry = NULL;
+
+			if( libfsntfs_mft_get_mft_entry_by_index(
+			     internal_volume->mft,
+			     internal_volume->file_io_handle,
+			     parent_mft_entry_index,
+			     &parent_mft_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+				 function,
+				 parent_mft_entry_index );
+
+				goto on_error;
+			}
+		}
+		if( libfsntfs_io_handle_update_cache_statistics(
+		     internal_volume->io_handle,
+		     LIBFSNTFS_CACHE_TYPE_DIRECTORY_ENTRIES,
+		     0,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update cache statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( utf8_string != NULL )
+	{
+		result = libfsntfs_mft_entry_get_directory_entry_by_utf8_name(
+		          parent_mft_entry,
+		          internal_volume->io_handle,
+		          internal_volume->file_io_handle,
+		          utf8_string,
+		          utf8_string_length,
+		          0,
+		          &safe_directory_entry,
+		          error );
+	}
+	else
+	{
+		result = libfsntfs_mft_entry_get_directory_entry_by_utf16_name(
+		          parent_mft_entry,
+		          internal_volume->io_handle,
+		          internal_volume->file_io_handle,
+		          utf16_string,
+		          utf16_string_length,
+		          0,
+		          &safe_directory_entry,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve directory entry by name.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( is_cacheable != 0 )
+	{
+		result = libfsntfs_internal_volume_is_directory_entry_current(
+		          internal_volume,
+		          safe_directory_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if directory entry is current.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libfsntfs_directory_entry_cache_set_directory_entry(
+			     internal_volume->directory_entry_cache,
+			     &key,
+			     safe_directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set directory entry in cache.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	*directory_entry = safe_directory_entry;
+
+	return( 1 );
+
+on_error:
+	if( safe_directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 &safe_directory_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the MFT entry for an UTF-8 encoded path
+ * The MFT entry is owned by the MFT entry cache, the caller must hold the cache mutex
+ * of the IO handle for as long as the MFT entry is used
+ * A new directory_entry is allocated if a match is found
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
+ */
+int libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path(
+     libfsntfs_internal_volume_t *internal_volume,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libfsntfs_mft_entry_t **mft_entry,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_t *safe_directory_entry = NULL;
+	uint8_t *utf8_string_segment                      = NULL;
+	static char *function                             = "libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path";
+	libuna_unicode_character_t unicode_character      = 0;
+	size_t utf8_string_index                          = 0;
+	size_t utf8_string_segment_length                 = 0;
+	uint64_t mft_entry_index                          = 0;
+	int result                                        = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( mft_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > 0 )
+	{
+		/* Ignore a leading separator
+		 */
+		if( utf8_string[ utf8_string_index ] == (uint8_t) LIBFSNTFS_SEPARATOR )
+		{
+			utf8_string_index++;
+		}
+	}
+	if( libfsntfs_mft_get_mft_entry_by_index(
 	     internal_volume->mft,
+	     internal_volume->file_io_handle,
+	     LIBFSNTFS_MFT_ENTRY_INDEX_ROOT_DIRECTORY,
 	     mft_entry,
-	     NULL,
-	     0,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file entry.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry: 5.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( utf8_string_length == 0 )
+	 || ( utf8_string_length == 1 ) )
+	{
+		result = 1;
+	}
+	else while( utf8_string_index < utf8_string_length )
+	{
+		if( safe_directory_entry != NULL )
+		{
+			if( libfsntfs_directory_entry_free(
+			     &safe_directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free directory entry.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		utf8_string_segment        = (uint8_t *) &( utf8_string[ utf8_string_index ] );
+		utf8_string_segment_length = utf8_string_index;
+
+		while( utf8_string_index < utf8_string_length )
+		{
+			if( libuna_unicode_character_copy_from_utf8(
+			     &unicode_character,
+			     utf8_string,
+			     utf8_string_length,
+			     &utf8_string_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy UTF-8 string to Unicode character.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( unicode_character == (libuna_unicode_character_t) LIBFSNTFS_SEPARATOR )
+			 || ( unicode_character == 0 ) )
+			{
+				utf8_string_segment_length += 1;
+
+				break;
+			}
+		}
+		utf8_string_segment_length = utf8_string_index - utf8_string_segment_length;
+
+		if( utf8_string_segment_length == 0 )
+		{
+			result = 0;
+		}
+		else
+		{
+			result = libfsntfs_internal_volume_get_directory_entry_by_name(
+			          internal_volume,
+			          *mft_entry,
+			          utf8_string_segment,
+			          utf8_string_segment_length,
+			          NULL,
+			          0,
+			          &safe_directory_entry,
+			          error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory entry by name.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libfsntfs_directory_entry_get_mft_entry_index(
+		     safe_directory_entry,
+		     &mft_entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry index.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfsntfs_mft_get_mft_entry_by_index(
+		     internal_volume->mft,
+		     internal_volume->file_io_handle,
+		     mft_entry_index,
+		     mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+	}
+	if( result != 0 )
+	{
+		*directory_entry     = safe_directory_entry;
+		safe_directory_entry = NULL;
+	}
+	return( result );
+
+on_error:
+	if( safe_directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 &safe_directory_entry,
+		 NULL );
+	}
+	if( *directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 directory_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the file entry for an UTF-8 encoded path
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
+ */
+int libfsntfs_volume_get_file_entry_by_utf8_path(
+     libfsntfs_volume_t *volume,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libfsntfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfsntfs_directory_entry_t *directory_entry = NULL;
+	libfsntfs_internal_volume_t *internal_volume = NULL;
+	libfsntfs_mft_entry_t *cached_mft_entry      = NULL;
+	libfsntfs_mft_entry_t *mft_entry             = NULL;
+	static char *function                        = "libfsntfs_volume_get_file_entry_by_utf8_path";
+	uint32_t mft_entry_index                     = 0;
+	int result                                   = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfsntfs_internal_volume_t *) volume;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
+	if( libcthreads_mutex_grab(
+	     internal_volume->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	result = libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path(
+	          internal_volume,
+	          utf8_string,
+	          utf8_string_length,
+	          &cached_mft_entry,
+	          &directory_entry,
+	          error );
+
+	/* The MFT entry returned by the path lookup is owned by the MFT entry cache
+	 * and can only be used while the cache mutex is held
+	 */
+	if( result == 1 )
+	{
+		mft_entry_index = cached_mft_entry->index;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_volume->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT and directory entry by path.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		/* The MFT entry returned by the path lookup is owned by the MFT entry cache
+		 * the file entry requires its own copy
+		 */
+		if( libfsntfs_mft_read_mft_entry_by_index(
+		     internal_volume->mft,
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     (uint64_t) mft_entry_index,
+		     &mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read MFT entry: %" PRIu32 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		/* libfsntfs_file_entry_initialize takes over management of mft_entry and directory_entry
+		 */
+		if( libfsntfs_file_entry_initialize(
+		     file_entry,
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     internal_volume->mft,
+		     mft_entry,
+		     directory_entry,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
+	if( directory_entry != NULL )
+	{
+		libfsntfs_directory_entry_free(
+		 &directory_entry,
+		 NULL );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->io_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the MFT entry for an UTF-8 encoded path
+/* Retrieves the MFT entry for an UTF-16 encoded path
+ * The MFT entry is owned by the MFT entry cache, the caller must hold the cache mutex
+ * of the IO handle for as long as the MFT entry is used
  * A new directory_entry is allocated if a match is found
  * Returns 1 if successful, 0 if no such file entry or -1 on error
  */
-int libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path(
+int libfsntfs_volume_get_mft_and_directory_entry_by_utf16_path(
      libfsntfs_internal_volume_t *internal_volume,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
      libfsntfs_mft_entry_t **mft_entry,
      libfsntfs_directory_entry_t **directory_entry,
      libcerror_error_t **error )
 {
-	libcdata_btree_t *directory_entries_tree          = NULL;
 	libfsntfs_directory_entry_t *safe_directory_entry = NULL;
-	uint8_t *utf8_string_segment                      = NULL;
-	static char *function                             = "libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path";
+	uint16_t *utf16_string_segment                    = NULL;
+	static char *function                             = "libfsntfs_volume_get_mft_and_directory_entry_by_utf16_path";
 	libuna_unicode_character_t unicode_character      = 0;
-	size_t utf8_string_index                          = 0;
-	size_t utf8_string_segment_length                 = 0;
+	size_t utf16_string_index                         = 0;
+	size_t utf16_string_segment_length                = 0;
 	uint64_t mft_entry_index                          = 0;
 	int result                                        = 0;
 
@@ -1773,13 +4868,13 @@ int libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path(
 
 		return( -1 );
 	}
-	if( utf8_string_length > 0 )
+	if( utf16_string_length > 0 )
 	{
 		/* Ignore a leading separator
 		 */
-		if( utf8_string[ utf8_string_index ] == (uint8_t) LIBFSNTFS_SEPARATOR )
+		if( utf16_string[ utf16_string_index ] == (uint16_t) LIBFSNTFS_SEPARATOR )
 		{
-			utf8_string_index++;
+			utf16_string_index++;
 		}
 	}
 	if( libfsntfs_mft_get_mft_entry_by_index(
@@ -1798,78 +4893,46 @@ int libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path(
 
 		goto on_error;
 	}
-	if( ( utf8_string_length == 0 )
-	 || ( utf8_string_length == 1 ) )
+	if( ( utf16_string_length == 0 )
+	 || ( utf16_string_length == 1 ) )
 	{
 		result = 1;
 	}
-	else while( utf8_string_index < utf8_string_length )
+	else while( utf16_string_index < utf16_string_length )
 	{
-		if( directory_entries_tree != NULL )
+		if( safe_directory_entry != NULL )
 		{
-			if( libcdata_btree_free(
-			     &directory_entries_tree,
-			     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_directory_entry_free,
+			if( libfsntfs_directory_entry_free(
+			     &safe_directory_entry,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free directory entries array.",
+				 "%s: unable to free directory entry.",
 				 function );
 
 				goto on_error;
 			}
 		}
-		if( libcdata_btree_initialize(
-		     &directory_entries_tree,
-		     LIBFSNTFS_DIRECTORY_ENTRIES_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create directory entries tree.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfsntfs_mft_entry_read_directory_entries_tree(
-		     *mft_entry,
-		     internal_volume->io_handle,
-		     internal_volume->file_io_handle,
-		     directory_entries_tree,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read directory entries tree.",
-			 function );
-
-			goto on_error;
-		}
-		utf8_string_segment        = (uint8_t *) &( utf8_string[ utf8_string_index ] );
-		utf8_string_segment_length = utf8_string_index;
+		utf16_string_segment        = (uint16_t *) &( utf16_string[ utf16_string_index ] );
+		utf16_string_segment_length = utf16_string_index;
 
-		while( utf8_string_index < utf8_string_length )
+		while( utf16_string_index < utf16_string_length )
 		{
-			if( libuna_unicode_character_copy_from_utf8(
+			if( libuna_unicode_character_copy_from_utf16(
 			     &unicode_character,
-			     utf8_string,
-			     utf8_string_length,
-			     &utf8_string_index,
+			     utf16_string,
+			     utf16_string_length,
+			     &utf16_string_index,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-				 "%s: unable to copy UTF-8 string to Unicode character.",
+				 "%s: unable to copy UTF-16 string to Unicode character.",
 				 function );
 
 				goto on_error;
@@ -1877,23 +4940,26 @@ int libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path(
 			if( ( unicode_character == (libuna_unicode_character_t) LIBFSNTFS_SEPARATOR )
 			 || ( unicode_character == 0 ) )
 			{
-				utf8_string_segment_length += 1;
+				utf16_string_segment_length += 1;
 
 				break;
 			}
 		}
-		utf8_string_segment_length = utf8_string_index - utf8_string_segment_length;
+		utf16_string_segment_length = utf16_string_index - utf16_string_segment_length;
 
-		if( utf8_string_segment_length == 0 )
+		if( utf16_string_segment_length == 0 )
 		{
 			result = 0;
 		}
 		else
 		{
-			result = libfsntfs_directory_entries_tree_get_directory_entry_by_utf8_name(
-			          directory_entries_tree,
-				  utf8_string_segment,
-				  utf8_string_segment_length,
+			result = libfsntfs_internal_volume_get_directory_entry_by_name(
+			          internal_volume,
+			          *mft_entry,
+			          NULL,
+			          0,
+			          utf16_string_segment,
+			          utf16_string_segment_length,
 			          &safe_directory_entry,
 			          error );
 		}
@@ -1946,46 +5012,16 @@ int libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path(
 	}
 	if( result != 0 )
 	{
-		if( libfsntfs_directory_entry_clone(
-		     directory_entry,
-		     safe_directory_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create directory entry.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( directory_entries_tree != NULL )
-	{
-		if( libcdata_btree_free(
-		     &directory_entries_tree,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_directory_entry_free,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free directory entries array.",
-			 function );
-
-			goto on_error;
-		}
+		*directory_entry     = safe_directory_entry;
+		safe_directory_entry = NULL;
 	}
 	return( result );
 
 on_error:
-	if( directory_entries_tree != NULL )
+	if( safe_directory_entry != NULL )
 	{
-		libcdata_btree_free(
-		 &directory_entries_tree,
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_directory_entry_free,
+		libfsntfs_directory_entry_free(
+		 &safe_directory_entry,
 		 NULL );
 	}
 	if( *directory_entry != NULL )
@@ -1997,20 +5033,22 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the file entry for an UTF-8 encoded path
+/* Retrieves the file entry for an UTF-16 encoded path
  * Returns 1 if successful, 0 if no such file entry or -1 on error
  */
-int libfsntfs_volume_get_file_entry_by_utf8_path(
+int libfsntfs_volume_get_file_entry_by_utf16_path(
      libfsntfs_volume_t *volume,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
      libfsntfs_file_entry_t **file_entry,
      libcerror_error_t **error )
 {
 	libfsntfs_directory_entry_t *directory_entry = NULL;
 	libfsntfs_internal_volume_t *internal_volume = NULL;
+	libfsntfs_mft_entry_t *cached_mft_entry      = NULL;
 	libfsntfs_mft_entry_t *mft_entry             = NULL;
-	static char *function                        = "libfsntfs_volume_get_file_entry_by_utf8_path";
+	static char *function                        = "libfsntfs_volume_get_file_entry_by_utf16_path";
+	uint32_t mft_entry_index                     = 0;
 	int result                                   = 0;
 
 	if( volume == NULL )
@@ -2048,14 +5086,64 @@ int libfsntfs_volume_get_file_entry_by_utf8_path(
 
 		return( -1 );
 	}
-	result = libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path(
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_volume->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	result = libfsntfs_volume_get_mft_and_directory_entry_by_utf16_path(
 	          internal_volume,
-	          utf8_string,
-	          utf8_string_length,
-	          &mft_entry,
+	          utf16_string,
+	          utf16_string_length,
+	          &cached_mft_entry,
 	          &directory_entry,
 	          error );
 
+	/* The MFT entry returned by the path lookup is owned by the MFT entry cache
+	 * and can only be used while the cache mutex is held
+	 */
+	if( result == 1 )
+	{
+		mft_entry_index = cached_mft_entry->index;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_volume->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	if( result == -1 )
 	{
 		libcerror_error_set(
@@ -2069,7 +5157,28 @@ int libfsntfs_volume_get_file_entry_by_utf8_path(
 	}
 	else if( result != 0 )
 	{
-		/* libfsntfs_file_entry_initialize takes over management of directory_entry
+		/* The MFT entry returned by the path lookup is owned by the MFT entry cache
+		 * the file entry requires its own copy
+		 */
+		if( libfsntfs_mft_read_mft_entry_by_index(
+		     internal_volume->mft,
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     (uint64_t) mft_entry_index,
+		     &mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read MFT entry: %" PRIu32 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		/* libfsntfs_file_entry_initialize takes over management of mft_entry and directory_entry
 		 */
 		if( libfsntfs_file_entry_initialize(
 		     file_entry,
@@ -2091,39 +5200,62 @@ int libfsntfs_volume_get_file_entry_by_utf8_path(
 			goto on_error;
 		}
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	return( result );
 
 on_error:
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
 	if( directory_entry != NULL )
 	{
 		libfsntfs_directory_entry_free(
 		 &directory_entry,
 		 NULL );
 	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->io_handle->read_write_lock,
+	 NULL );
+#endif
 	return( -1 );
 }
 
-/* Retrieves the MFT entry for an UTF-16 encoded path
- * A new directory_entry is allocated if a match is found
- * Returns 1 if successful, 0 if no such file entry or -1 on error
+/* Reads the bitmap file entry
+ * The caller must hold the cache mutex of the IO handle when other threads can access the MFT entry cache
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_mft_and_directory_entry_by_utf16_path(
+int libfsntfs_volume_read_bitmap(
      libfsntfs_internal_volume_t *internal_volume,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
-     libfsntfs_mft_entry_t **mft_entry,
-     libfsntfs_directory_entry_t **directory_entry,
+     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	libcdata_btree_t *directory_entries_tree          = NULL;
-	libfsntfs_directory_entry_t *safe_directory_entry = NULL;
-	uint16_t *utf16_string_segment                    = NULL;
-	static char *function                             = "libfsntfs_volume_get_mft_and_directory_entry_by_utf16_path";
-	libuna_unicode_character_t unicode_character      = 0;
-	size_t utf16_string_index                         = 0;
-	size_t utf16_string_segment_length                = 0;
-	uint64_t mft_entry_index                          = 0;
-	int result                                        = 0;
+	libfcache_cache_t *cluster_block_cache   = NULL;
+	libfdata_vector_t *cluster_block_vector  = NULL;
+	libfsntfs_cluster_block_t *cluster_block = NULL;
+	libfsntfs_mft_entry_t *mft_entry         = NULL;
+	static char *function                    = "libfsntfs_volume_read_bitmap";
+	uint64_t first_cluster_number            = 0;
+	uint64_t number_of_clusters              = 0;
+	int cluster_block_index                  = 0;
+	int number_of_cluster_blocks             = 0;
 
 	if( internal_volume == NULL )
 	{
@@ -2131,367 +5263,388 @@ int libfsntfs_volume_get_mft_and_directory_entry_by_utf16_path(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid internal volume.",
 		 function );
 
 		return( -1 );
 	}
-	if( mft_entry == NULL )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid MFT entry.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( directory_entry == NULL )
+	if( internal_volume->io_handle->cluster_block_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid directory entry.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing cluster block size.",
 		 function );
 
 		return( -1 );
 	}
-	if( utf16_string_length > 0 )
+	if( internal_volume->cluster_bitmap != NULL )
 	{
-		/* Ignore a leading separator
-		 */
-		if( utf16_string[ utf16_string_index ] == (uint16_t) LIBFSNTFS_SEPARATOR )
-		{
-			utf16_string_index++;
-		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - cluster bitmap value already set.",
+		 function );
+
+		return( -1 );
 	}
 	if( libfsntfs_mft_get_mft_entry_by_index(
 	     internal_volume->mft,
-	     internal_volume->file_io_handle,
-	     LIBFSNTFS_MFT_ENTRY_INDEX_ROOT_DIRECTORY,
-	     mft_entry,
+	     file_io_handle,
+	     LIBFSNTFS_MFT_ENTRY_INDEX_BITMAP,
+	     &mft_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry: 5.",
-		 function );
+		 "%s: unable to retrieve MFT entry: %d.",
+		 function,
+		 LIBFSNTFS_MFT_ENTRY_INDEX_BITMAP );
 
 		goto on_error;
 	}
-	if( ( utf16_string_length == 0 )
-	 || ( utf16_string_length == 1 ) )
+	if( mft_entry == NULL )
 	{
-		result = 1;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing MFT entry: %d.",
+		 function,
+		 LIBFSNTFS_MFT_ENTRY_INDEX_BITMAP );
+
+		goto on_error;
 	}
-	else while( utf16_string_index < utf16_string_length )
+	if( mft_entry->data_attribute == NULL )
 	{
-		if( directory_entries_tree != NULL )
-		{
-			if( libcdata_btree_free(
-			     &directory_entries_tree,
-			     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_directory_entry_free,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free directory entries array.",
-				 function );
-
-				goto on_error;
-			}
-		}
-		if( libcdata_btree_initialize(
-		     &directory_entries_tree,
-		     LIBFSNTFS_DIRECTORY_ENTRIES_TREE_MAXIMUM_NUMBER_OF_SUB_NODES,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create directory entries tree.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid MFT entry: %d - missing data attribute.",
+		 function,
+		 LIBFSNTFS_MFT_ENTRY_INDEX_BITMAP );
 
-			goto on_error;
-		}
-		if( libfsntfs_mft_entry_read_directory_entries_tree(
-		     *mft_entry,
-		     internal_volume->io_handle,
-		     internal_volume->file_io_handle,
-		     directory_entries_tree,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read directory entries tree.",
-			 function );
+		goto on_error;
+	}
+	number_of_clusters = internal_volume->io_handle->volume_size / internal_volume->io_handle->cluster_block_size;
 
-			goto on_error;
-		}
-		utf16_string_segment        = (uint16_t *) &( utf16_string[ utf16_string_index ] );
-		utf16_string_segment_length = utf16_string_index;
+	if( libfsntfs_cluster_bitmap_initialize(
+	     &( internal_volume->cluster_bitmap ),
+	     number_of_clusters,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cluster bitmap.",
+		 function );
 
-		while( utf16_string_index < utf16_string_length )
-		{
-			if( libuna_unicode_character_copy_from_utf16(
-			     &unicode_character,
-			     utf16_string,
-			     utf16_string_length,
-			     &utf16_string_index,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-				 "%s: unable to copy UTF-16 string to Unicode character.",
-				 function );
+		goto on_error;
+	}
+	if( libfsntfs_cluster_block_vector_initialize(
+	     &cluster_block_vector,
+	     internal_volume->io_handle,
+	     mft_entry->data_attribute,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cluster block vector.",
+		 function );
 
-				goto on_error;
-			}
-			if( ( unicode_character == (libuna_unicode_character_t) LIBFSNTFS_SEPARATOR )
-			 || ( unicode_character == 0 ) )
-			{
-				utf16_string_segment_length += 1;
+		goto on_error;
+	}
+	if( libfcache_cache_initialize(
+	     &cluster_block_cache,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cluster block cache.",
+		 function );
 
-				break;
-			}
-		}
-		utf16_string_segment_length = utf16_string_index - utf16_string_segment_length;
+		goto on_error;
+	}
+	if( libfdata_vector_get_number_of_elements(
+	     cluster_block_vector,
+	     &number_of_cluster_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cluster blocks.",
+		 function );
 
-		if( utf16_string_segment_length == 0 )
-		{
-			result = 0;
-		}
-		else
-		{
-			result = libfsntfs_directory_entries_tree_get_directory_entry_by_utf16_name(
-			          directory_entries_tree,
-				  utf16_string_segment,
-				  utf16_string_segment_length,
-			          &safe_directory_entry,
-			          error );
-		}
-		if( result == -1 )
+		goto on_error;
+	}
+	for( cluster_block_index = 0;
+	     cluster_block_index < number_of_cluster_blocks;
+	     cluster_block_index++ )
+	{
+		if( libfdata_vector_get_element_value_by_index(
+		     cluster_block_vector,
+		     (intptr_t *) file_io_handle,
+		     cluster_block_cache,
+		     cluster_block_index,
+		     (intptr_t **) &cluster_block,
+		     0,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve directory entry by name.",
-			 function );
+			 "%s: unable to retrieve cluster block: %d from vector.",
+			 function,
+			 cluster_block_index );
 
 			goto on_error;
 		}
-		else if( result == 0 )
-		{
-			break;
-		}
-		if( libfsntfs_directory_entry_get_mft_entry_index(
-		     safe_directory_entry,
-		     &mft_entry_index,
-		     error ) != 1 )
+		if( cluster_block == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve MFT entry index.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing cluster block: %d.",
+			 function,
+			 cluster_block_index );
 
 			goto on_error;
 		}
-		if( libfsntfs_mft_get_mft_entry_by_index(
-		     internal_volume->mft,
-		     internal_volume->file_io_handle,
-		     mft_entry_index,
-		     mft_entry,
-		     error ) != 1 )
+		if( cluster_block->data == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve MFT entry: %" PRIu64 ".",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid cluster block: %d - missing data.",
 			 function,
-			 mft_entry_index );
+			 cluster_block_index );
 
 			goto on_error;
 		}
-	}
-	if( result != 0 )
-	{
-		if( libfsntfs_directory_entry_clone(
-		     directory_entry,
-		     safe_directory_entry,
-		     error ) != 1 )
+		if( ( ( cluster_block->data_size % 4 ) != 0 )
+		 || ( cluster_block->data_size > (size_t) SSIZE_MAX ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create directory entry.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: cluster block: %d data size value out of bounds.",
+			 function,
+			 cluster_block_index );
 
 			goto on_error;
 		}
-	}
-	if( directory_entries_tree != NULL )
-	{
-		if( libcdata_btree_free(
-		     &directory_entries_tree,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_directory_entry_free,
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: bitmap segment: %d data:\n",
+			 function,
+			 cluster_block_index );
+			libcnotify_print_data(
+			 cluster_block->data,
+			 cluster_block->data_size,
+			 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
+		}
+#endif
+		if( libfsntfs_cluster_bitmap_read_data(
+		     internal_volume->cluster_bitmap,
+		     cluster_block->data,
+		     cluster_block->data_size,
+		     first_cluster_number,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free directory entries array.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read cluster bitmap from cluster block: %d.",
+			 function,
+			 cluster_block_index );
 
 			goto on_error;
 		}
+		first_cluster_number += (uint64_t) cluster_block->data_size * 8;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+		/* The remaining cluster blocks only contain bits of clusters beyond the end of the volume
+		 */
+		if( first_cluster_number >= number_of_clusters )
+		{
+			break;
+		}
 	}
-	return( result );
+	if( libfdata_vector_free(
+	     &cluster_block_vector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cluster block vector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfcache_cache_free(
+	     &cluster_block_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free cluster block cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
 
 on_error:
-	if( directory_entries_tree != NULL )
+	if( cluster_block_cache != NULL )
 	{
-		libcdata_btree_free(
-		 &directory_entries_tree,
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libfsntfs_directory_entry_free,
+		libfcache_cache_free(
+		 &cluster_block_cache,
 		 NULL );
 	}
-	if( *directory_entry != NULL )
+	if( cluster_block_vector != NULL )
 	{
-		libfsntfs_directory_entry_free(
-		 directory_entry,
+		libfdata_vector_free(
+		 &cluster_block_vector,
+		 NULL );
+	}
+	if( internal_volume->cluster_bitmap != NULL )
+	{
+		libfsntfs_cluster_bitmap_free(
+		 &( internal_volume->cluster_bitmap ),
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Retrieves the file entry for an UTF-16 encoded path
- * Returns 1 if successful, 0 if no such file entry or -1 on error
+/* Reads the security descriptors file entry
+ * Returns 1 if successful or -1 on error
  */
-int libfsntfs_volume_get_file_entry_by_utf16_path(
-     libfsntfs_volume_t *volume,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
-     libfsntfs_file_entry_t **file_entry,
+int libfsntfs_volume_read_security_descriptors(
+     libfsntfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	libfsntfs_directory_entry_t *directory_entry = NULL;
-	libfsntfs_internal_volume_t *internal_volume = NULL;
-	libfsntfs_mft_entry_t *mft_entry             = NULL;
-	static char *function                        = "libfsntfs_volume_get_file_entry_by_utf16_path";
-	int result                                   = 0;
+	libfsntfs_mft_entry_t *mft_entry = NULL;
+	static char *function            = "libfsntfs_volume_read_security_descriptors";
 
-	if( volume == NULL )
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid internal volume.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libfsntfs_internal_volume_t *) volume;
-
-	if( file_entry == NULL )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file entry.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( *file_entry != NULL )
+	if( libfsntfs_mft_get_mft_entry_by_index(
+	     internal_volume->mft,
+	     file_io_handle,
+	     LIBFSNTFS_MFT_ENTRY_INDEX_SECURE,
+	     &mft_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file entry value already set.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve MFT entry: %d.",
+		 function,
+		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
 
-		return( -1 );
+		goto on_error;
 	}
-	result = libfsntfs_volume_get_mft_and_directory_entry_by_utf16_path(
-	          internal_volume,
-	          utf16_string,
-	          utf16_string_length,
-	          &mft_entry,
-	          &directory_entry,
-	          error );
-
-	if( result == -1 )
+	if( mft_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT and directory entry by path.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing MFT entry: %d.",
+		 function,
+		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
 
 		goto on_error;
 	}
-	else if( result != 0 )
+	if( libfsntfs_mft_entry_read_security_identifiers(
+	     mft_entry,
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     0,
+	     error ) != 1 )
 	{
-		/* libfsntfs_file_entry_initialize takes over management of directory_entry
-		 */
-		if( libfsntfs_file_entry_initialize(
-		     file_entry,
-		     internal_volume->io_handle,
-		     internal_volume->file_io_handle,
-		     internal_volume->mft,
-		     mft_entry,
-		     directory_entry,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create file entry.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read security descriptors.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
 	}
-	return( result );
+	return( 1 );
 
 on_error:
-	if( directory_entry != NULL )
-	{
-		libfsntfs_directory_entry_free(
-		 &directory_entry,
-		 NULL );
-	}
 	return( -1 );
 }
 
-/* Reads the bitmap file entry
- * Returns 1 if successful or -1 on error
+/* Reads the upcase table file entry
+ * Returns 1 if successful, 0 if the volume has no $UpCase data or -1 on error
  */
-int libfsntfs_volume_read_bitmap(
+int libfsntfs_volume_read_upcase_table(
      libfsntfs_internal_volume_t *internal_volume,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
@@ -2500,12 +5653,8 @@ int libfsntfs_volume_read_bitmap(
 	libfdata_vector_t *cluster_block_vector  = NULL;
 	libfsntfs_cluster_block_t *cluster_block = NULL;
 	libfsntfs_mft_entry_t *mft_entry         = NULL;
-	static char *function                    = "libfsntfs_volume_read_bitmap";
-	off64_t bitmap_offset                    = 0;
-	off64_t start_offset                     = 0;
-	size_t cluster_block_data_offset         = 0;
-	uint32_t value_32bit                     = 0;
-	uint8_t bit_index                        = 0;
+	static char *function                    = "libfsntfs_volume_read_upcase_table";
+	size_t data_offset                       = 0;
 	int cluster_block_index                  = 0;
 	int number_of_cluster_blocks             = 0;
 
@@ -2531,10 +5680,21 @@ int libfsntfs_volume_read_bitmap(
 
 		return( -1 );
 	}
+	if( internal_volume->io_handle->upcase_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - upcase table value already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfsntfs_mft_get_mft_entry_by_index(
 	     internal_volume->mft,
 	     file_io_handle,
-	     LIBFSNTFS_MFT_ENTRY_INDEX_BITMAP,
+	     LIBFSNTFS_MFT_ENTRY_INDEX_UPPERCASE,
 	     &mft_entry,
 	     error ) != 1 )
 	{
@@ -2544,7 +5704,7 @@ int libfsntfs_volume_read_bitmap(
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 		 "%s: unable to retrieve MFT entry: %d.",
 		 function,
-		 LIBFSNTFS_MFT_ENTRY_INDEX_BITMAP );
+		 LIBFSNTFS_MFT_ENTRY_INDEX_UPPERCASE );
 
 		goto on_error;
 	}
@@ -2556,19 +5716,24 @@ int libfsntfs_volume_read_bitmap(
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
 		 "%s: missing MFT entry: %d.",
 		 function,
-		 LIBFSNTFS_MFT_ENTRY_INDEX_BITMAP );
+		 LIBFSNTFS_MFT_ENTRY_INDEX_UPPERCASE );
 
 		goto on_error;
 	}
 	if( mft_entry->data_attribute == NULL )
+	{
+		return( 0 );
+	}
+	if( libfsntfs_upcase_table_initialize(
+	     &( internal_volume->io_handle->upcase_table ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid MFT entry: %d - missing data attribute.",
-		 function,
-		 LIBFSNTFS_MFT_ENTRY_INDEX_BITMAP );
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create upcase table.",
+		 function );
 
 		goto on_error;
 	}
@@ -2662,7 +5827,7 @@ int libfsntfs_volume_read_bitmap(
 
 			goto on_error;
 		}
-		if( ( ( cluster_block->data_size % 4 ) != 0 )
+		if( ( ( cluster_block->data_size % 2 ) != 0 )
 		 || ( cluster_block->data_size > (size_t) SSIZE_MAX ) )
 		{
 			libcerror_error_set(
@@ -2675,120 +5840,31 @@ int libfsntfs_volume_read_bitmap(
 
 			goto on_error;
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( libfsntfs_upcase_table_read_data(
+		     internal_volume->io_handle->upcase_table,
+		     cluster_block->data,
+		     cluster_block->data_size,
+		     data_offset,
+		     error ) != 1 )
 		{
-			libcnotify_printf(
-			 "%s: bitmap segment: %d data:\n",
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read upcase table from cluster block: %d.",
 			 function,
 			 cluster_block_index );
-			libcnotify_print_data(
-			 cluster_block->data,
-			 cluster_block->data_size,
-			 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
-		}
-#endif
-		cluster_block_data_offset = 0;
-		start_offset              = -1;
-
-		while( cluster_block_data_offset < cluster_block->data_size )
-		{
-			byte_stream_copy_to_uint32_little_endian(
-			 &( cluster_block->data[ cluster_block_data_offset ] ),
-			 value_32bit );
 
-			for( bit_index = 0;
-			     bit_index < 32;
-			     bit_index++ )
-			{
-				if( ( value_32bit & 0x00000001UL ) == 0 )
-				{
-					if( start_offset >= 0 )
-					{
-#if defined( HAVE_DEBUG_OUTPUT )
-						if( libcnotify_verbose != 0 )
-						{
-							libcnotify_printf(
-							 "%s: offset range\t\t: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-							 function,
-							 start_offset,
-							 bitmap_offset,
-							 bitmap_offset - start_offset );
-						}
-#endif
-/*
-						if( libfsntfs_offset_list_append_offset(
-						     offset_list,
-						     start_offset,
-						     bitmap_offset - start_offset,
-						     1,
-						     error ) != 1 )
-						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-							 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-							 "%s: unable to append offset range to offset list.",
-							 function );
-
-							goto on_error;
-						}
-*/
-						start_offset = -1;
-					}
-				}
-				else
-				{
-					if( start_offset < 0 )
-					{
-						start_offset = bitmap_offset;
-					}
-				}
-				bitmap_offset += internal_volume->io_handle->cluster_block_size;
-
-				value_32bit >>= 1;
-			}
-			cluster_block_data_offset += 4;
+			goto on_error;
 		}
-		if( start_offset >= 0 )
-		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: offset range\t\t: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-				 function,
-				 start_offset,
-				 bitmap_offset,
-				 bitmap_offset - start_offset );
-			}
-#endif
-/* TODO
-			if( libfsntfs_offset_list_append_offset(
-			     offset_list,
-			     start_offset,
-			     bitmap_offset - start_offset,
-			     1,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append offset range to offset list.",
-				 function );
+		data_offset += cluster_block->data_size;
 
-				goto on_error;
-			}
-*/
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		/* The remaining cluster blocks do not contain upcase table characters
+		 */
+		if( data_offset >= ( sizeof( uint16_t ) * LIBFSNTFS_UPCASE_TABLE_NUMBER_OF_CHARACTERS ) )
 		{
-			libcnotify_printf(
-			 "\n" );
+			break;
 		}
-#endif
 	}
 	if( libfdata_vector_free(
 	     &cluster_block_vector,
@@ -2831,90 +5907,12 @@ on_error:
 		 &cluster_block_vector,
 		 NULL );
 	}
-	return( -1 );
-}
-
-/* Reads the security descriptors file entry
- * Returns 1 if successful or -1 on error
- */
-int libfsntfs_volume_read_security_descriptors(
-     libfsntfs_internal_volume_t *internal_volume,
-     libbfio_handle_t *file_io_handle,
-     libcerror_error_t **error )
-{
-	libfsntfs_mft_entry_t *mft_entry = NULL;
-	static char *function            = "libfsntfs_volume_read_security_descriptors";
-
-	if( internal_volume == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid internal volume.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_volume->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( libfsntfs_mft_get_mft_entry_by_index(
-	     internal_volume->mft,
-	     file_io_handle,
-	     LIBFSNTFS_MFT_ENTRY_INDEX_SECURE,
-	     &mft_entry,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve MFT entry: %d.",
-		 function,
-		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
-
-		goto on_error;
-	}
-	if( mft_entry == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing MFT entry: %d.",
-		 function,
-		 LIBFSNTFS_MFT_ENTRY_INDEX_SECURE );
-
-		goto on_error;
-	}
-	if( libfsntfs_mft_entry_read_security_identifiers(
-	     mft_entry,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     0,
-	     error ) != 1 )
+	if( internal_volume->io_handle->upcase_table != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read security descriptors.",
-		 function );
-
-		goto on_error;
+		libfsntfs_upcase_table_free(
+		 &( internal_volume->io_handle->upcase_table ),
+		 NULL );
 	}
-	return( 1 );
-
-on_error:
 	return( -1 );
 }
 
@@ -2929,8 +5927,10 @@ int libfsntfs_volume_get_usn_change_journal(
 	libfsntfs_attribute_t *data_attribute        = NULL;
 	libfsntfs_directory_entry_t *directory_entry = NULL;
 	libfsntfs_internal_volume_t *internal_volume = NULL;
+	libfsntfs_mft_entry_t *cached_mft_entry      = NULL;
 	libfsntfs_mft_entry_t *mft_entry             = NULL;
 	static char *function                        = "libfsntfs_volume_get_usn_change_journal";
+	uint32_t mft_entry_index                     = 0;
 	int result                                   = 0;
 
 	if( volume == NULL )
@@ -2946,85 +5946,191 @@ int libfsntfs_volume_get_usn_change_journal(
 	}
 	internal_volume = (libfsntfs_internal_volume_t *) volume;
 
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->io_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_volume->io_handle->cache_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab cache mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	result = libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path(
 	          internal_volume,
 	          (uint8_t *) "\\$Extend\\$UsnJrnl",
 	          17,
-	          &mft_entry,
+	          &cached_mft_entry,
 	          &directory_entry,
 	          error );
 
-	if( result == -1 )
+	/* The MFT entry returned by the path lookup is owned by the MFT entry cache
+	 * and can only be used while the cache mutex is held
+	 */
+	if( result == 1 )
+	{
+		mft_entry_index = cached_mft_entry->index;
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_volume->io_handle->cache_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve \\$Extend\\$UsnJrnl MFT and directory entry by path.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release cache mutex.",
 		 function );
 
 		goto on_error;
 	}
-	else if( result == 0 )
-	{
-		return( 0 );
-	}
-	result = libfsntfs_mft_entry_get_alternate_data_attribute_by_utf8_name(
-	          mft_entry,
-	          (uint8_t *) "$J",
-	          2,
-	          &data_attribute,
-	          error );
-
+#endif
 	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve $J data attribute.",
+		 "%s: unable to retrieve \\$Extend\\$UsnJrnl MFT and directory entry by path.",
 		 function );
 
 		goto on_error;
 	}
-	else if( result == 0 )
+	else if( result != 0 )
 	{
-		if( libfsntfs_directory_entry_free(
-		     &directory_entry,
+		/* The USN change journal requires its own copy of the MFT entry
+		 * since the $J data attribute is referenced for its lifetime
+		 */
+		if( libfsntfs_mft_read_mft_entry_by_index(
+		     internal_volume->mft,
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     (uint64_t) mft_entry_index,
+		     &mft_entry,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free directory entry.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read MFT entry: %" PRIu32 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		result = libfsntfs_mft_entry_get_alternate_data_attribute_by_utf8_name(
+		          mft_entry,
+		          (uint8_t *) "$J",
+		          2,
+		          &data_attribute,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve $J data attribute.",
 			 function );
 
 			goto on_error;
 		}
-		return( 0 );
 	}
-	/* libfsntfs_usn_change_journal_initialize takes over management of directory_entry
-	 */
-	if( libfsntfs_usn_change_journal_initialize(
-	     usn_change_journal,
-	     internal_volume->io_handle,
-	     internal_volume->file_io_handle,
-	     mft_entry,
-	     directory_entry,
-	     data_attribute,
+	if( result == 0 )
+	{
+		if( directory_entry != NULL )
+		{
+			if( libfsntfs_directory_entry_free(
+			     &directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free directory entry.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( mft_entry != NULL )
+		{
+			if( libfsntfs_mft_entry_free(
+			     &mft_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MFT entry.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	else
+	{
+		/* libfsntfs_usn_change_journal_initialize takes over management of mft_entry and directory_entry
+		 */
+		if( libfsntfs_usn_change_journal_initialize(
+		     usn_change_journal,
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     mft_entry,
+		     directory_entry,
+		     data_attribute,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create USN change journal.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->io_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create USN change journal.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( 1 );
+#endif
+	return( result );
 
 on_error:
 	if( directory_entry != NULL )
@@ -3033,6 +6139,17 @@ on_error:
 		 &directory_entry,
 		 NULL );
 	}
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
+#if defined( HAVE_LIBFSNTFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->io_handle->read_write_lock,
+	 NULL );
+#endif
 	return( -1 );
 }
 
@@ -25,13 +25,16 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfsntfs_cluster_bitmap.h"
 #include "libfsntfs_directory_entry.h"
+#include "libfsntfs_directory_entry_cache.h"
 #include "libfsntfs_extern.h"
 #include "libfsntfs_io_handle.h"
 #include "libfsntfs_libbfio.h"
 #include "libfsntfs_libcerror.h"
 #include "libfsntfs_mft.h"
 #include "libfsntfs_mft_entry.h"
+#include "libfsntfs_path_index.h"
 #include "libfsntfs_types.h"
 
 #if defined( __cplusplus )
@@ -58,9 +61,21 @@ struct libfsntfs_internal_volume
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* The access flags
+	 */
+	int access_flags;
+
 	/* The MFT
 	 */
 	libfsntfs_mft_t *mft;
+
+	/* The cluster allocation bitmap
+	 */
+	libfsntfs_cluster_bitmap_t *cluster_bitmap;
+
+	/* The directory entry cache used by the path lookups
+	 */
+	libfsntfs_directory_entry_cache_t *directory_entry_cache;
 };
 
 LIBFSNTFS_EXTERN \
@@ -121,6 +136,40 @@ int libfsntfs_volume_has_volume_shadow_snapshots(
      libfsntfs_volume_t *volume,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_set_cache_limit(
+     libfsntfs_volume_t *volume,
+     int cache_type,
+     int maximum_number_of_cache_entries,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_get_cache_limit(
+     libfsntfs_volume_t *volume,
+     int cache_type,
+     int *maximum_number_of_cache_entries,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_get_cache_statistics(
+     libfsntfs_volume_t *volume,
+     int cache_type,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_set_number_of_decompression_threads(
+     libfsntfs_volume_t *volume,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_get_number_of_decompression_threads(
+     libfsntfs_volume_t *volume,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_volume_get_cluster_block_size(
      libfsntfs_volume_t *volume,
@@ -178,6 +227,44 @@ int libfsntfs_volume_get_serial_number(
      uint64_t *serial_number,
      libcerror_error_t **error );
 
+int libfsntfs_internal_volume_read_cluster_bitmap(
+     libfsntfs_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_volume_get_cluster_bitmap(
+     libfsntfs_internal_volume_t *internal_volume,
+     libfsntfs_cluster_bitmap_t **cluster_bitmap,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_is_cluster_allocated(
+     libfsntfs_volume_t *volume,
+     uint64_t cluster_number,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_get_next_allocated_range(
+     libfsntfs_volume_t *volume,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_get_next_unallocated_range(
+     libfsntfs_volume_t *volume,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_get_cluster_allocation_counts(
+     libfsntfs_volume_t *volume,
+     uint64_t *number_of_allocated_clusters,
+     uint64_t *number_of_unallocated_clusters,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_volume_get_number_of_file_entries(
      libfsntfs_volume_t *volume,
@@ -191,12 +278,55 @@ int libfsntfs_volume_get_file_entry_by_index(
      libfsntfs_file_entry_t **file_entry,
      libcerror_error_t **error );
 
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_scan_mft(
+     libfsntfs_volume_t *volume,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_scan_mft_parallel(
+     libfsntfs_volume_t *volume,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback_function)(
+            libfsntfs_file_entry_t *file_entry,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+LIBFSNTFS_EXTERN \
+int libfsntfs_volume_build_path_index(
+     libfsntfs_volume_t *volume,
+     libfsntfs_path_index_t **path_index,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_volume_get_root_directory(
      libfsntfs_volume_t *volume,
      libfsntfs_file_entry_t **root_directory_file_entry,
      libcerror_error_t **error );
 
+int libfsntfs_internal_volume_is_directory_entry_current(
+     libfsntfs_internal_volume_t *internal_volume,
+     libfsntfs_directory_entry_t *directory_entry,
+     libcerror_error_t **error );
+
+int libfsntfs_internal_volume_get_directory_entry_by_name(
+     libfsntfs_internal_volume_t *internal_volume,
+     libfsntfs_mft_entry_t *parent_mft_entry,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libfsntfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
 int libfsntfs_volume_get_mft_and_directory_entry_by_utf8_path(
      libfsntfs_internal_volume_t *internal_volume,
      const uint8_t *utf8_string,
@@ -239,6 +369,11 @@ int libfsntfs_volume_read_security_descriptors(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libfsntfs_volume_read_upcase_table(
+     libfsntfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
 LIBFSNTFS_EXTERN \
 int libfsntfs_volume_get_usn_change_journal(
      libfsntfs_volume_t *volume,
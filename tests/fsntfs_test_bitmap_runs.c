@@ -0,0 +1,456 @@
+/*
+ * Bitmap run extraction testing program
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( FSNTFS_TEST_BENCHMARK )
+#include <time.h>
+#endif
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libcstring.h"
+#include "fsntfs_test_unused.h"
+
+#include "../libfsntfs/libfsntfs_bitmap_runs.h"
+
+/* Size of the large bitmaps, 4 MiB represents a volume of 128 GiB
+ * with a cluster block size of 4 KiB
+ */
+#define FSNTFS_TEST_BITMAP_RUNS_LARGE_SIZE	( 4 * 1024 * 1024 )
+
+#define FSNTFS_TEST_BITMAP_RUNS_MAXIMUM_SIZE	64
+
+/* Retrieves the next run of set bits testing one bit at a time
+ * Returns 1 if successful or 0 if no such run
+ */
+int fsntfs_test_bitmap_runs_get_next_run_scalar(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t bit_index,
+     uint64_t *run_bit_index,
+     uint64_t *run_number_of_bits )
+{
+	uint64_t number_of_bits = (uint64_t) data_size * 8;
+	uint8_t in_run          = 0;
+
+	while( bit_index < number_of_bits )
+	{
+		if( ( ( data[ bit_index / 8 ] >> ( bit_index % 8 ) ) & 0x01 ) != 0 )
+		{
+			if( in_run == 0 )
+			{
+				*run_bit_index = bit_index;
+				in_run         = 1;
+			}
+		}
+		else if( in_run != 0 )
+		{
+			break;
+		}
+		bit_index++;
+	}
+	if( in_run == 0 )
+	{
+		return( 0 );
+	}
+	*run_number_of_bits = bit_index - *run_bit_index;
+
+	return( 1 );
+}
+
+/* Fills a bitmap with random bits
+ */
+void fsntfs_test_bitmap_runs_fill_random(
+     uint8_t *data,
+     size_t data_size )
+{
+	size_t data_offset = 0;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( rand() & 0xff );
+	}
+}
+
+/* Fills a bitmap with a pattern that resembles a used volume
+ * mostly long runs of allocated and unallocated clusters with fragmented areas
+ */
+void fsntfs_test_bitmap_runs_fill_realistic(
+     uint8_t *data,
+     size_t data_size )
+{
+	uint64_t bit_index      = 0;
+	uint64_t number_of_bits = (uint64_t) data_size * 8;
+	uint64_t run_size       = 0;
+	uint8_t bit_value       = 1;
+
+	memory_set(
+	 data,
+	 0,
+	 data_size );
+
+	/* Leave the last quarter of the volume unallocated
+	 */
+	number_of_bits -= number_of_bits / 4;
+
+	while( bit_index < number_of_bits )
+	{
+		if( ( rand() % 8 ) == 0 )
+		{
+			run_size = 1 + ( rand() % 16 );
+		}
+		else
+		{
+			run_size = 1 + ( rand() % 65536 );
+		}
+		if( run_size > ( number_of_bits - bit_index ) )
+		{
+			run_size = number_of_bits - bit_index;
+		}
+		if( bit_value != 0 )
+		{
+			while( run_size > 0 )
+			{
+				data[ bit_index / 8 ] |= (uint8_t) ( 1 << ( bit_index % 8 ) );
+
+				bit_index++;
+				run_size--;
+			}
+		}
+		else
+		{
+			bit_index += run_size;
+		}
+		bit_value = 1 - bit_value;
+	}
+}
+
+/* Compares the runs of the word-at-a-time and the scalar implementation
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int fsntfs_test_bitmap_runs_compare(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t bit_index )
+{
+	libcerror_error_t *error    = NULL;
+	uint64_t run_bit_index      = 0;
+	uint64_t run_number_of_bits = 0;
+	uint64_t scalar_bit_index   = 0;
+	uint64_t scalar_bit_count   = 0;
+	int result                  = 0;
+	int scalar_result           = 0;
+
+	do
+	{
+		result = libfsntfs_bitmap_runs_get_next_run(
+		          data,
+		          data_size,
+		          bit_index,
+		          &run_bit_index,
+		          &run_number_of_bits,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+			libcerror_error_free(
+			 &error );
+
+			return( -1 );
+		}
+		scalar_result = fsntfs_test_bitmap_runs_get_next_run_scalar(
+		                 data,
+		                 data_size,
+		                 bit_index,
+		                 &scalar_bit_index,
+		                 &scalar_bit_count );
+
+		if( result != scalar_result )
+		{
+			return( 0 );
+		}
+		if( result != 0 )
+		{
+			if( ( run_bit_index != scalar_bit_index )
+			 || ( run_number_of_bits != scalar_bit_count ) )
+			{
+				fprintf(
+				 stderr,
+				 "Mismatch at bit: %" PRIu64 " got: %" PRIu64 " (%" PRIu64 ") expected: %" PRIu64 " (%" PRIu64 ")\n",
+				 bit_index,
+				 run_bit_index,
+				 run_number_of_bits,
+				 scalar_bit_index,
+				 scalar_bit_count );
+
+				return( 0 );
+			}
+			bit_index = run_bit_index + run_number_of_bits;
+		}
+	}
+	while( result != 0 );
+
+	return( 1 );
+}
+
+#if defined( FSNTFS_TEST_BENCHMARK )
+
+/* Times the extraction of all the runs of a bitmap
+ * The benchmark is only built when FSNTFS_TEST_BENCHMARK is defined
+ * Returns 1 if successful or -1 on error
+ */
+int fsntfs_test_bitmap_runs_benchmark(
+     const char *description,
+     const uint8_t *data,
+     size_t data_size )
+{
+	libcerror_error_t *error       = NULL;
+	clock_t scalar_time            = 0;
+	clock_t start_time             = 0;
+	clock_t word_time              = 0;
+	uint64_t bit_index             = 0;
+	uint64_t number_of_runs        = 0;
+	uint64_t run_bit_index         = 0;
+	uint64_t run_number_of_bits    = 0;
+	uint64_t scalar_number_of_runs = 0;
+	int result                     = 0;
+
+	start_time = clock();
+
+	while( fsntfs_test_bitmap_runs_get_next_run_scalar(
+	        data,
+	        data_size,
+	        bit_index,
+	        &run_bit_index,
+	        &run_number_of_bits ) == 1 )
+	{
+		bit_index = run_bit_index + run_number_of_bits;
+
+		scalar_number_of_runs++;
+	}
+	scalar_time = clock() - start_time;
+
+	bit_index  = 0;
+	start_time = clock();
+
+	do
+	{
+		result = libfsntfs_bitmap_runs_get_next_run(
+		          data,
+		          data_size,
+		          bit_index,
+		          &run_bit_index,
+		          &run_number_of_bits,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+			libcerror_error_free(
+			 &error );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			bit_index = run_bit_index + run_number_of_bits;
+
+			number_of_runs++;
+		}
+	}
+	while( result != 0 );
+
+	word_time = clock() - start_time;
+
+	fprintf(
+	 stdout,
+	 "%s bitmap: %" PRIu64 " runs, scalar: %.3f s, word-at-a-time: %.3f s\n",
+	 description,
+	 number_of_runs,
+	 (double) scalar_time / CLOCKS_PER_SEC,
+	 (double) word_time / CLOCKS_PER_SEC );
+
+	if( number_of_runs != scalar_number_of_runs )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( FSNTFS_TEST_BENCHMARK ) */
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	uint8_t *data      = NULL;
+	size_t data_size   = 0;
+	uint64_t bit_index = 0;
+	int iteration      = 0;
+
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	srand(
+	 0x4e544653UL );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * FSNTFS_TEST_BITMAP_RUNS_LARGE_SIZE );
+
+	if( data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data.\n" );
+
+		goto on_error;
+	}
+	/* Test small bitmaps of every size and start bit, including the all-zero and all-one bitmaps
+	 */
+	for( iteration = 0;
+	     iteration < 4096;
+	     iteration++ )
+	{
+		data_size = 1 + ( iteration % FSNTFS_TEST_BITMAP_RUNS_MAXIMUM_SIZE );
+
+		if( iteration < FSNTFS_TEST_BITMAP_RUNS_MAXIMUM_SIZE )
+		{
+			memory_set(
+			 data,
+			 0xff,
+			 data_size );
+		}
+		else if( iteration < ( 2 * FSNTFS_TEST_BITMAP_RUNS_MAXIMUM_SIZE ) )
+		{
+			memory_set(
+			 data,
+			 0x00,
+			 data_size );
+		}
+		else
+		{
+			fsntfs_test_bitmap_runs_fill_random(
+			 data,
+			 data_size );
+		}
+		for( bit_index = 0;
+		     bit_index <= (uint64_t) data_size * 8;
+		     bit_index += 1 + ( rand() % 13 ) )
+		{
+			if( fsntfs_test_bitmap_runs_compare(
+			     data,
+			     data_size,
+			     bit_index ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Runs of bitmap of size: %" PRIzd " from bit: %" PRIu64 " differ.\n",
+				 data_size,
+				 bit_index );
+
+				goto on_error;
+			}
+		}
+	}
+	fsntfs_test_bitmap_runs_fill_random(
+	 data,
+	 FSNTFS_TEST_BITMAP_RUNS_LARGE_SIZE );
+
+	if( fsntfs_test_bitmap_runs_compare(
+	     data,
+	     FSNTFS_TEST_BITMAP_RUNS_LARGE_SIZE,
+	     0 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Runs of random bitmap differ.\n" );
+
+		goto on_error;
+	}
+#if defined( FSNTFS_TEST_BENCHMARK )
+	if( fsntfs_test_bitmap_runs_benchmark(
+	     "Random",
+	     data,
+	     FSNTFS_TEST_BITMAP_RUNS_LARGE_SIZE ) != 1 )
+	{
+		goto on_error;
+	}
+#endif
+	fsntfs_test_bitmap_runs_fill_realistic(
+	 data,
+	 FSNTFS_TEST_BITMAP_RUNS_LARGE_SIZE );
+
+	if( fsntfs_test_bitmap_runs_compare(
+	     data,
+	     FSNTFS_TEST_BITMAP_RUNS_LARGE_SIZE,
+	     0 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Runs of realistic bitmap differ.\n" );
+
+		goto on_error;
+	}
+#if defined( FSNTFS_TEST_BENCHMARK )
+	if( fsntfs_test_bitmap_runs_benchmark(
+	     "Realistic",
+	     data,
+	     FSNTFS_TEST_BITMAP_RUNS_LARGE_SIZE ) != 1 )
+	{
+		goto on_error;
+	}
+#endif
+	memory_free(
+	 data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( EXIT_FAILURE );
+}
+
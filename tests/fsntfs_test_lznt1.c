@@ -0,0 +1,838 @@
+/*
+ * LZNT1 decompression testing program
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( FSNTFS_TEST_BENCHMARK )
+#include <time.h>
+#endif
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libcstring.h"
+#include "fsntfs_test_libfwnt.h"
+
+#include "../libfsntfs/libfsntfs_lznt1.h"
+
+/* The size of a compression unit of 16 clusters of 4 KiB
+ */
+#define FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE		65536
+
+/* The compressed data contains a 2-byte header per chunk and the end-of-stream marker
+ */
+#define FSNTFS_TEST_LZNT1_COMPRESSED_DATA_SIZE		( FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE + ( ( FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE / 4096 ) * 2 ) + 2 )
+
+#define FSNTFS_TEST_LZNT1_MAXIMUM_NUMBER_OF_UNITS	64
+
+#if defined( FSNTFS_TEST_BENCHMARK )
+#define FSNTFS_TEST_LZNT1_NUMBER_OF_ITERATIONS		16
+#endif
+
+#define FSNTFS_TEST_LZNT1_MAXIMUM_MATCH_DEPTH		32
+
+enum FSNTFS_TEST_LZNT1_CORPUS_TYPES
+{
+	FSNTFS_TEST_LZNT1_CORPUS_TYPE_TEXT,
+	FSNTFS_TEST_LZNT1_CORPUS_TYPE_RECORDS,
+	FSNTFS_TEST_LZNT1_CORPUS_TYPE_PATTERNS,
+	FSNTFS_TEST_LZNT1_CORPUS_TYPE_RANDOM
+};
+
+typedef struct fsntfs_test_lznt1_corpus fsntfs_test_lznt1_corpus_t;
+
+struct fsntfs_test_lznt1_corpus
+{
+	/* The uncompressed data of the compression units
+	 */
+	uint8_t *uncompressed_data;
+
+	/* The uncompressed data sizes
+	 */
+	size_t uncompressed_data_sizes[ FSNTFS_TEST_LZNT1_MAXIMUM_NUMBER_OF_UNITS ];
+
+	/* The compressed data of the compression units
+	 */
+	uint8_t *compressed_data;
+
+	/* The compressed data sizes
+	 */
+	size_t compressed_data_sizes[ FSNTFS_TEST_LZNT1_MAXIMUM_NUMBER_OF_UNITS ];
+
+	/* The number of compression units
+	 */
+	int number_of_units;
+};
+
+static const char *fsntfs_test_lznt1_words[ 16 ] = {
+	"the ", "file ", "system ", "volume ", "entry ", "attribute ", "index ", "record ",
+	"data ", "stream ", "cluster ", "NTFS ", "of ", "and ", "windows ", "\r\n" };
+
+/* Determines the number of bits of the match size at a specific position in the uncompressed chunk
+ * Returns the number of bits
+ */
+uint8_t fsntfs_test_lznt1_get_offset_shift(
+         size_t position )
+{
+	uint8_t offset_shift = 12;
+
+	for( position -= 1;
+	     position >= 0x10;
+	     position >>= 1 )
+	{
+		offset_shift--;
+	}
+	return( offset_shift );
+}
+
+/* Compresses a chunk of at most 4096 bytes with greedy matching
+ * Returns the size of the compressed chunk data
+ */
+size_t fsntfs_test_lznt1_compress_chunk(
+        const uint8_t *data,
+        size_t data_size,
+        uint8_t *compressed_data )
+{
+	int hash_heads[ 4096 ];
+	int hash_previous[ 4096 ];
+
+	size_t best_match_offset  = 0;
+	size_t best_match_size    = 0;
+	size_t compressed_offset  = 0;
+	size_t data_offset        = 0;
+	size_t flag_byte_offset   = 0;
+	size_t match_offset       = 0;
+	size_t match_size         = 0;
+	size_t maximum_offset     = 0;
+	size_t maximum_size       = 0;
+	uint16_t compression_tuple = 0;
+	uint8_t flag_bit_index    = 8;
+	uint8_t offset_shift      = 0;
+	int candidate_offset      = 0;
+	int hash_index            = 0;
+	int match_depth           = 0;
+
+	for( hash_index = 0;
+	     hash_index < 4096;
+	     hash_index++ )
+	{
+		hash_heads[ hash_index ] = -1;
+	}
+	while( data_offset < data_size )
+	{
+		if( flag_bit_index == 8 )
+		{
+			flag_byte_offset = compressed_offset++;
+			flag_bit_index   = 0;
+
+			compressed_data[ flag_byte_offset ] = 0;
+		}
+		best_match_size = 0;
+
+		if( ( data_offset > 0 )
+		 && ( ( data_size - data_offset ) >= 3 ) )
+		{
+			offset_shift   = fsntfs_test_lznt1_get_offset_shift(
+			                  data_offset );
+			maximum_offset = (size_t) 1 << ( 16 - offset_shift );
+			maximum_size   = ( (size_t) 1 << offset_shift ) + 2;
+
+			hash_index = ( ( data[ data_offset ] << 4 ) ^ ( data[ data_offset + 1 ] << 2 ) ^ data[ data_offset + 2 ] ) & 0x0fff;
+
+			candidate_offset = hash_heads[ hash_index ];
+			match_depth      = 0;
+
+			while( ( candidate_offset >= 0 )
+			    && ( match_depth < FSNTFS_TEST_LZNT1_MAXIMUM_MATCH_DEPTH ) )
+			{
+				match_offset = data_offset - (size_t) candidate_offset;
+
+				if( match_offset > maximum_offset )
+				{
+					break;
+				}
+				match_size = 0;
+
+				while( ( match_size < maximum_size )
+				    && ( ( data_offset + match_size ) < data_size )
+				    && ( data[ candidate_offset + match_size ] == data[ data_offset + match_size ] ) )
+				{
+					match_size++;
+				}
+				if( match_size > best_match_size )
+				{
+					best_match_offset = match_offset;
+					best_match_size   = match_size;
+				}
+				candidate_offset = hash_previous[ candidate_offset ];
+
+				match_depth++;
+			}
+		}
+		if( best_match_size >= 3 )
+		{
+			compression_tuple = (uint16_t) ( ( ( best_match_offset - 1 ) << offset_shift ) | ( best_match_size - 3 ) );
+
+			byte_stream_copy_from_uint16_little_endian(
+			 &( compressed_data[ compressed_offset ] ),
+			 compression_tuple );
+
+			compressed_offset += 2;
+
+			compressed_data[ flag_byte_offset ] |= (uint8_t) ( 1 << flag_bit_index );
+		}
+		else
+		{
+			best_match_size = 1;
+
+			compressed_data[ compressed_offset++ ] = data[ data_offset ];
+		}
+		while( best_match_size > 0 )
+		{
+			if( ( data_size - data_offset ) >= 3 )
+			{
+				hash_index = ( ( data[ data_offset ] << 4 ) ^ ( data[ data_offset + 1 ] << 2 ) ^ data[ data_offset + 2 ] ) & 0x0fff;
+
+				hash_previous[ data_offset ] = hash_heads[ hash_index ];
+				hash_heads[ hash_index ]     = (int) data_offset;
+			}
+			data_offset++;
+			best_match_size--;
+		}
+		flag_bit_index++;
+	}
+	return( compressed_offset );
+}
+
+/* Compresses the data of a compression unit
+ * Chunks that do not compress are stored uncompressed
+ * Returns the size of the compressed data
+ */
+size_t fsntfs_test_lznt1_compress(
+        const uint8_t *data,
+        size_t data_size,
+        uint8_t *compressed_data )
+{
+	uint8_t chunk_data[ 4096 + 512 ];
+
+	size_t chunk_data_size   = 0;
+	size_t chunk_size        = 0;
+	size_t compressed_offset = 0;
+	size_t data_offset       = 0;
+	uint16_t chunk_header    = 0;
+
+	while( data_offset < data_size )
+	{
+		chunk_size = data_size - data_offset;
+
+		if( chunk_size > 4096 )
+		{
+			chunk_size = 4096;
+		}
+		chunk_data_size = fsntfs_test_lznt1_compress_chunk(
+		                   &( data[ data_offset ] ),
+		                   chunk_size,
+		                   chunk_data );
+
+		if( chunk_data_size < chunk_size )
+		{
+			chunk_header = (uint16_t) ( 0xb000 | ( chunk_data_size - 1 ) );
+
+			memory_copy(
+			 &( compressed_data[ compressed_offset + 2 ] ),
+			 chunk_data,
+			 chunk_data_size );
+		}
+		else
+		{
+			chunk_header    = (uint16_t) ( 0x3000 | ( chunk_size - 1 ) );
+			chunk_data_size = chunk_size;
+
+			memory_copy(
+			 &( compressed_data[ compressed_offset + 2 ] ),
+			 &( data[ data_offset ] ),
+			 chunk_size );
+		}
+		byte_stream_copy_from_uint16_little_endian(
+		 &( compressed_data[ compressed_offset ] ),
+		 chunk_header );
+
+		compressed_offset += 2 + chunk_data_size;
+		data_offset       += chunk_size;
+	}
+	/* Add the end-of-stream marker
+	 */
+	compressed_data[ compressed_offset++ ] = 0;
+	compressed_data[ compressed_offset++ ] = 0;
+
+	return( compressed_offset );
+}
+
+/* Fills the data of a compression unit
+ */
+void fsntfs_test_lznt1_fill(
+      uint8_t *data,
+      size_t data_size,
+      int corpus_type )
+{
+	const char *word    = NULL;
+	size_t data_offset  = 0;
+	size_t record_index = 0;
+	size_t run_size     = 0;
+	size_t period       = 0;
+	uint8_t byte_value  = 0;
+
+	while( data_offset < data_size )
+	{
+		switch( corpus_type )
+		{
+			case FSNTFS_TEST_LZNT1_CORPUS_TYPE_TEXT:
+				word = fsntfs_test_lznt1_words[ rand() % 16 ];
+
+				while( ( *word != 0 )
+				    && ( data_offset < data_size ) )
+				{
+					data[ data_offset++ ] = (uint8_t) *word++;
+				}
+				break;
+
+			/* Records with a counter, a few random values and zero padding,
+			 * which resemble the tables found in executables and databases
+			 */
+			case FSNTFS_TEST_LZNT1_CORPUS_TYPE_RECORDS:
+				for( run_size = 0;
+				     ( run_size < 32 ) && ( data_offset < data_size );
+				     run_size++ )
+				{
+					if( run_size < 4 )
+					{
+						byte_value = (uint8_t) ( record_index >> ( run_size * 8 ) );
+					}
+					else if( run_size < 8 )
+					{
+						byte_value = (uint8_t) ( rand() & 0x0f );
+					}
+					else if( run_size < 12 )
+					{
+						byte_value = (uint8_t) ( rand() & 0xff );
+					}
+					else
+					{
+						byte_value = 0;
+					}
+					data[ data_offset++ ] = byte_value;
+				}
+				record_index++;
+
+				break;
+
+			/* Repeating patterns with a short period, which are decompressed
+			 * with overlapping matches
+			 */
+			case FSNTFS_TEST_LZNT1_CORPUS_TYPE_PATTERNS:
+				period   = 1 + ( rand() % 12 );
+				run_size = period + ( rand() % 512 );
+
+				for( record_index = 0;
+				     ( record_index < run_size ) && ( data_offset < data_size );
+				     record_index++ )
+				{
+					if( record_index < period )
+					{
+						data[ data_offset ] = (uint8_t) ( rand() & 0xff );
+					}
+					else
+					{
+						data[ data_offset ] = data[ data_offset - period ];
+					}
+					data_offset++;
+				}
+				break;
+
+			default:
+				data[ data_offset++ ] = (uint8_t) ( rand() & 0xff );
+				break;
+		}
+	}
+}
+
+/* Adds a compression unit to the corpus
+ * Returns 1 if successful or -1 on error
+ */
+int fsntfs_test_lznt1_corpus_append_unit(
+     fsntfs_test_lznt1_corpus_t *corpus,
+     const uint8_t *data,
+     size_t data_size )
+{
+	uint8_t *compressed_data   = NULL;
+	uint8_t *uncompressed_data = NULL;
+
+	if( corpus->number_of_units >= FSNTFS_TEST_LZNT1_MAXIMUM_NUMBER_OF_UNITS )
+	{
+		return( -1 );
+	}
+	uncompressed_data = &( corpus->uncompressed_data[ corpus->number_of_units * FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE ] );
+	compressed_data   = &( corpus->compressed_data[ corpus->number_of_units * FSNTFS_TEST_LZNT1_COMPRESSED_DATA_SIZE ] );
+
+	memory_copy(
+	 uncompressed_data,
+	 data,
+	 data_size );
+
+	corpus->uncompressed_data_sizes[ corpus->number_of_units ] = data_size;
+
+	corpus->compressed_data_sizes[ corpus->number_of_units ] = fsntfs_test_lznt1_compress(
+	                                                            uncompressed_data,
+	                                                            data_size,
+	                                                            compressed_data );
+
+	corpus->number_of_units += 1;
+
+	return( 1 );
+}
+
+/* Checks that both decompressors reproduce the data of every compression unit of the corpus
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int fsntfs_test_lznt1_compare(
+     fsntfs_test_lznt1_corpus_t *corpus,
+     uint8_t *libfwnt_data,
+     uint8_t *libfsntfs_data )
+{
+	libcerror_error_t *error    = NULL;
+	size_t libfsntfs_data_size  = 0;
+	size_t libfwnt_data_size    = 0;
+	int unit_index              = 0;
+
+	for( unit_index = 0;
+	     unit_index < corpus->number_of_units;
+	     unit_index++ )
+	{
+		libfwnt_data_size = FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE;
+
+		if( libfwnt_lznt1_decompress(
+		     &( corpus->compressed_data[ unit_index * FSNTFS_TEST_LZNT1_COMPRESSED_DATA_SIZE ] ),
+		     corpus->compressed_data_sizes[ unit_index ],
+		     libfwnt_data,
+		     &libfwnt_data_size,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		libfsntfs_data_size = FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE;
+
+		if( libfsntfs_lznt1_decompress(
+		     &( corpus->compressed_data[ unit_index * FSNTFS_TEST_LZNT1_COMPRESSED_DATA_SIZE ] ),
+		     corpus->compressed_data_sizes[ unit_index ],
+		     libfsntfs_data,
+		     &libfsntfs_data_size,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( ( libfsntfs_data_size != libfwnt_data_size )
+		 || ( libfsntfs_data_size != corpus->uncompressed_data_sizes[ unit_index ] ) )
+		{
+			fprintf(
+			 stderr,
+			 "Compression unit: %d size: %" PRIzd " differs from libfwnt: %" PRIzd " and original: %" PRIzd ".\n",
+			 unit_index,
+			 libfsntfs_data_size,
+			 libfwnt_data_size,
+			 corpus->uncompressed_data_sizes[ unit_index ] );
+
+			return( 0 );
+		}
+		if( ( memory_compare(
+		       libfsntfs_data,
+		       libfwnt_data,
+		       libfsntfs_data_size ) != 0 )
+		 || ( memory_compare(
+		       libfsntfs_data,
+		       &( corpus->uncompressed_data[ unit_index * FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE ] ),
+		       libfsntfs_data_size ) != 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Compression unit: %d data differs.\n",
+			 unit_index );
+
+			return( 0 );
+		}
+	}
+	return( 1 );
+
+on_error:
+	libcerror_error_backtrace_fprint(
+	 error,
+	 stderr );
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#if defined( FSNTFS_TEST_BENCHMARK )
+
+/* Times the decompression of the corpus with libfwnt and the local decoder
+ * The benchmark is only built when FSNTFS_TEST_BENCHMARK is defined
+ * Returns 1 if successful or -1 on error
+ */
+int fsntfs_test_lznt1_benchmark(
+     const char *description,
+     fsntfs_test_lznt1_corpus_t *corpus,
+     uint8_t *uncompressed_data )
+{
+	libcerror_error_t *error     = NULL;
+	clock_t libfsntfs_time       = 0;
+	clock_t libfwnt_time         = 0;
+	clock_t start_time           = 0;
+	double compressed_size       = 0.0;
+	double uncompressed_size     = 0.0;
+	size_t uncompressed_data_size = 0;
+	int iteration                = 0;
+	int unit_index               = 0;
+
+	for( unit_index = 0;
+	     unit_index < corpus->number_of_units;
+	     unit_index++ )
+	{
+		compressed_size   += (double) corpus->compressed_data_sizes[ unit_index ];
+		uncompressed_size += (double) corpus->uncompressed_data_sizes[ unit_index ];
+	}
+	start_time = clock();
+
+	for( iteration = 0;
+	     iteration < FSNTFS_TEST_LZNT1_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		for( unit_index = 0;
+		     unit_index < corpus->number_of_units;
+		     unit_index++ )
+		{
+			uncompressed_data_size = FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE;
+
+			if( libfwnt_lznt1_decompress(
+			     &( corpus->compressed_data[ unit_index * FSNTFS_TEST_LZNT1_COMPRESSED_DATA_SIZE ] ),
+			     corpus->compressed_data_sizes[ unit_index ],
+			     uncompressed_data,
+			     &uncompressed_data_size,
+			     &error ) != 1 )
+			{
+				goto on_error;
+			}
+		}
+	}
+	libfwnt_time = clock() - start_time;
+	start_time   = clock();
+
+	for( iteration = 0;
+	     iteration < FSNTFS_TEST_LZNT1_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		for( unit_index = 0;
+		     unit_index < corpus->number_of_units;
+		     unit_index++ )
+		{
+			uncompressed_data_size = FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE;
+
+			if( libfsntfs_lznt1_decompress(
+			     &( corpus->compressed_data[ unit_index * FSNTFS_TEST_LZNT1_COMPRESSED_DATA_SIZE ] ),
+			     corpus->compressed_data_sizes[ unit_index ],
+			     uncompressed_data,
+			     &uncompressed_data_size,
+			     &error ) != 1 )
+			{
+				goto on_error;
+			}
+		}
+	}
+	libfsntfs_time = clock() - start_time;
+
+	fprintf(
+	 stdout,
+	 "%s: %d compression units, ratio: %.2f, libfwnt: %.3f s, libfsntfs: %.3f s\n",
+	 description,
+	 corpus->number_of_units,
+	 uncompressed_size > 0.0 ? compressed_size / uncompressed_size : 0.0,
+	 (double) libfwnt_time / CLOCKS_PER_SEC,
+	 (double) libfsntfs_time / CLOCKS_PER_SEC );
+
+	return( 1 );
+
+on_error:
+	libcerror_error_backtrace_fprint(
+	 error,
+	 stderr );
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( FSNTFS_TEST_BENCHMARK ) */
+
+/* Reads the compression units of the corpus from a file
+ * Returns 1 if successful or -1 on error
+ */
+int fsntfs_test_lznt1_corpus_read_file(
+     fsntfs_test_lznt1_corpus_t *corpus,
+     const libcstring_system_character_t *filename,
+     uint8_t *data )
+{
+	FILE *file_stream = NULL;
+	size_t read_count = 0;
+
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               L"rb" );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_READ );
+#endif
+	if( file_stream == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open file: %" PRIs_LIBCSTRING_SYSTEM ".\n",
+		 filename );
+
+		return( -1 );
+	}
+	while( corpus->number_of_units < FSNTFS_TEST_LZNT1_MAXIMUM_NUMBER_OF_UNITS )
+	{
+		read_count = file_stream_read(
+		              file_stream,
+		              data,
+		              FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE );
+
+		if( read_count == 0 )
+		{
+			break;
+		}
+		if( fsntfs_test_lznt1_corpus_append_unit(
+		     corpus,
+		     data,
+		     read_count ) != 1 )
+		{
+			break;
+		}
+	}
+	file_stream_close(
+	 file_stream );
+
+	return( 1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	fsntfs_test_lznt1_corpus_t corpus;
+
+	const char *corpus_descriptions[ 4 ] = {
+		"Text", "Records", "Patterns", "Random" };
+
+	uint8_t *data       = NULL;
+	uint8_t *data_copy  = NULL;
+	size_t data_size    = 0;
+	int corpus_type     = 0;
+	int result          = 0;
+	int unit_index      = 0;
+
+	if( argc > 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported number of arguments.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	srand(
+	 0x4e544653UL );
+
+	memory_set(
+	 &corpus,
+	 0,
+	 sizeof( fsntfs_test_lznt1_corpus_t ) );
+
+	corpus.uncompressed_data = (uint8_t *) memory_allocate(
+	                                        sizeof( uint8_t ) * FSNTFS_TEST_LZNT1_MAXIMUM_NUMBER_OF_UNITS * FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE );
+
+	corpus.compressed_data = (uint8_t *) memory_allocate(
+	                                      sizeof( uint8_t ) * FSNTFS_TEST_LZNT1_MAXIMUM_NUMBER_OF_UNITS * FSNTFS_TEST_LZNT1_COMPRESSED_DATA_SIZE );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE );
+
+	data_copy = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE );
+
+	if( ( corpus.uncompressed_data == NULL )
+	 || ( corpus.compressed_data == NULL )
+	 || ( data == NULL )
+	 || ( data_copy == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data.\n" );
+
+		goto on_error;
+	}
+	for( corpus_type = FSNTFS_TEST_LZNT1_CORPUS_TYPE_TEXT;
+	     corpus_type <= FSNTFS_TEST_LZNT1_CORPUS_TYPE_RANDOM;
+	     corpus_type++ )
+	{
+		corpus.number_of_units = 0;
+
+		for( unit_index = 0;
+		     unit_index < FSNTFS_TEST_LZNT1_MAXIMUM_NUMBER_OF_UNITS;
+		     unit_index++ )
+		{
+			/* The last compression unit of a file is mostly partial
+			 */
+			data_size = FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE;
+
+			if( ( unit_index % 8 ) == 7 )
+			{
+				data_size = 1 + ( rand() % FSNTFS_TEST_LZNT1_COMPRESSION_UNIT_SIZE );
+			}
+			fsntfs_test_lznt1_fill(
+			 data,
+			 data_size,
+			 corpus_type );
+
+			if( fsntfs_test_lznt1_corpus_append_unit(
+			     &corpus,
+			     data,
+			     data_size ) != 1 )
+			{
+				goto on_error;
+			}
+		}
+		result = fsntfs_test_lznt1_compare(
+		          &corpus,
+		          data,
+		          data_copy );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Decompressed data of corpus: %s differs.\n",
+			 corpus_descriptions[ corpus_type ] );
+
+			goto on_error;
+		}
+#if defined( FSNTFS_TEST_BENCHMARK )
+		if( fsntfs_test_lznt1_benchmark(
+		     corpus_descriptions[ corpus_type ],
+		     &corpus,
+		     data ) != 1 )
+		{
+			goto on_error;
+		}
+#endif
+	}
+	/* The compression units of a file, for example extracted from a compressed volume,
+	 * can be used as an additional corpus
+	 */
+	if( argc == 2 )
+	{
+		corpus.number_of_units = 0;
+
+		if( fsntfs_test_lznt1_corpus_read_file(
+		     &corpus,
+		     argv[ 1 ],
+		     data ) != 1 )
+		{
+			goto on_error;
+		}
+		result = fsntfs_test_lznt1_compare(
+		          &corpus,
+		          data,
+		          data_copy );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Decompressed data of file corpus differs.\n" );
+
+			goto on_error;
+		}
+#if defined( FSNTFS_TEST_BENCHMARK )
+		if( fsntfs_test_lznt1_benchmark(
+		     "File",
+		     &corpus,
+		     data ) != 1 )
+		{
+			goto on_error;
+		}
+#endif
+	}
+	memory_free(
+	 data_copy );
+	memory_free(
+	 data );
+	memory_free(
+	 corpus.compressed_data );
+	memory_free(
+	 corpus.uncompressed_data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( data_copy != NULL )
+	{
+		memory_free(
+		 data_copy );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( corpus.compressed_data != NULL )
+	{
+		memory_free(
+		 corpus.compressed_data );
+	}
+	if( corpus.uncompressed_data != NULL )
+	{
+		memory_free(
+		 corpus.uncompressed_data );
+	}
+	return( EXIT_FAILURE );
+}
+
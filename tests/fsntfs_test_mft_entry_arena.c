@@ -0,0 +1,816 @@
+/*
+ * MFT entry arena testing and benchmark program
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <time.h>
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libcstring.h"
+#include "fsntfs_test_unused.h"
+
+/* The test uses internal functions of the library, which are only
+ * exported by a shared library build with the GNU compiler
+ */
+#if defined( __GNUC__ ) && !defined( LIBFSNTFS_DLL_IMPORT )
+#define FSNTFS_TEST_MFT_ENTRY_ARENA_HAVE_INTERNALS
+
+#include "../libfsntfs/libfsntfs_arena.h"
+#include "../libfsntfs/libfsntfs_io_handle.h"
+#include "../libfsntfs/libfsntfs_mft_entry.h"
+#endif
+
+/* The heap allocations are counted by wrapping the allocation functions
+ * of the GNU C library
+ */
+#if defined( FSNTFS_TEST_MFT_ENTRY_ARENA_HAVE_INTERNALS ) && defined( __GLIBC__ )
+#define FSNTFS_TEST_MFT_ENTRY_ARENA_COUNT_ALLOCATIONS
+#endif
+
+/* The number of MFT entries in the synthetic MFT
+ */
+#define FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ENTRIES	16384
+
+#define FSNTFS_TEST_MFT_ENTRY_ARENA_MFT_ENTRY_SIZE	1024
+
+#define FSNTFS_TEST_MFT_ENTRY_ARENA_CLUSTER_BLOCK_SIZE	4096
+
+/* The number of attributes of every MFT entry in the synthetic MFT
+ */
+#define FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ATTRIBUTES	5
+
+/* The minimum number of heap allocations the arena must save per MFT entry
+ * Every attribute is allocated from the arena instead of the heap, while
+ * the attributes of a MFT entry fit in a single arena block
+ */
+#define FSNTFS_TEST_MFT_ENTRY_ARENA_MINIMUM_SAVED_ALLOCATIONS	( FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ATTRIBUTES - 1 )
+
+#if defined( FSNTFS_TEST_MFT_ENTRY_ARENA_COUNT_ALLOCATIONS )
+
+extern void *__libc_malloc(
+              size_t size );
+
+extern void *__libc_calloc(
+              size_t number_of_elements,
+              size_t element_size );
+
+extern void *__libc_realloc(
+              void *buffer,
+              size_t size );
+
+static uint64_t fsntfs_test_mft_entry_arena_number_of_allocations = 0;
+
+/* Counts and allocates a buffer
+ */
+void *malloc(
+       size_t size )
+{
+	fsntfs_test_mft_entry_arena_number_of_allocations++;
+
+	return( __libc_malloc(
+	         size ) );
+}
+
+/* Counts and allocates a cleared buffer
+ */
+void *calloc(
+       size_t number_of_elements,
+       size_t element_size )
+{
+	fsntfs_test_mft_entry_arena_number_of_allocations++;
+
+	return( __libc_calloc(
+	         number_of_elements,
+	         element_size ) );
+}
+
+/* Counts and reallocates a buffer
+ */
+void *realloc(
+       void *buffer,
+       size_t size )
+{
+	fsntfs_test_mft_entry_arena_number_of_allocations++;
+
+	return( __libc_realloc(
+	         buffer,
+	         size ) );
+}
+
+#endif /* defined( FSNTFS_TEST_MFT_ENTRY_ARENA_COUNT_ALLOCATIONS ) */
+
+#if defined( FSNTFS_TEST_MFT_ENTRY_ARENA_HAVE_INTERNALS )
+
+/* Writes an ASCII string as an UTF-16 little-endian stream
+ * Returns the size of the stream
+ */
+size_t fsntfs_test_mft_entry_arena_write_utf16_stream(
+        uint8_t *data,
+        const char *string,
+        size_t string_length )
+{
+	size_t string_index = 0;
+
+	for( string_index = 0;
+	     string_index < string_length;
+	     string_index++ )
+	{
+		data[ string_index * 2 ]       = (uint8_t) string[ string_index ];
+		data[ ( string_index * 2 ) + 1 ] = 0;
+	}
+	return( string_length * 2 );
+}
+
+/* Writes the header of a MFT attribute
+ */
+void fsntfs_test_mft_entry_arena_write_attribute_header(
+      uint8_t *data,
+      uint32_t type,
+      uint32_t size,
+      uint8_t non_resident_flag,
+      uint8_t name_length,
+      uint16_t name_offset,
+      uint16_t identifier )
+{
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 0 ] ),
+	 type );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 4 ] ),
+	 size );
+
+	data[ 8 ] = non_resident_flag;
+	data[ 9 ] = name_length;
+
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 10 ] ),
+	 name_offset );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 14 ] ),
+	 identifier );
+}
+
+/* Writes a resident MFT attribute
+ * Returns the size of the attribute
+ */
+size_t fsntfs_test_mft_entry_arena_write_resident_attribute(
+        uint8_t *data,
+        uint32_t type,
+        const char *name,
+        const uint8_t *value_data,
+        uint32_t value_data_size,
+        uint16_t identifier )
+{
+	size_t attribute_size = 0;
+	size_t name_length    = 0;
+	size_t value_offset   = 24;
+
+	if( name != NULL )
+	{
+		name_length = strlen(
+		               name );
+
+		value_offset += fsntfs_test_mft_entry_arena_write_utf16_stream(
+		                 &( data[ 24 ] ),
+		                 name,
+		                 name_length );
+	}
+	value_offset   = ( value_offset + 7 ) & ~( (size_t) 7 );
+	attribute_size = ( value_offset + value_data_size + 7 ) & ~( (size_t) 7 );
+
+	fsntfs_test_mft_entry_arena_write_attribute_header(
+	 data,
+	 type,
+	 (uint32_t) attribute_size,
+	 0,
+	 (uint8_t) name_length,
+	 24,
+	 identifier );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 16 ] ),
+	 value_data_size );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 20 ] ),
+	 (uint16_t) value_offset );
+
+	memory_copy(
+	 &( data[ value_offset ] ),
+	 value_data,
+	 value_data_size );
+
+	return( attribute_size );
+}
+
+/* Writes a non-resident unnamed $DATA attribute with 3 data runs
+ * Returns the size of the attribute
+ */
+size_t fsntfs_test_mft_entry_arena_write_data_attribute(
+        uint8_t *data,
+        uint64_t first_cluster_block_number,
+        uint16_t identifier )
+{
+	size_t attribute_size       = 0;
+	size_t data_runs_offset     = 64;
+	uint64_t number_of_clusters = 16 + 8 + 4;
+
+	/* 16 clusters at the first cluster block number
+	 */
+	data[ data_runs_offset++ ] = 0x31;
+	data[ data_runs_offset++ ] = 16;
+	data[ data_runs_offset++ ] = (uint8_t) ( first_cluster_block_number & 0xff );
+	data[ data_runs_offset++ ] = (uint8_t) ( ( first_cluster_block_number >> 8 ) & 0xff );
+	data[ data_runs_offset++ ] = (uint8_t) ( ( first_cluster_block_number >> 16 ) & 0x7f );
+
+	/* 8 clusters 32 clusters further
+	 */
+	data[ data_runs_offset++ ] = 0x11;
+	data[ data_runs_offset++ ] = 8;
+	data[ data_runs_offset++ ] = 32;
+
+	/* 4 sparse clusters
+	 */
+	data[ data_runs_offset++ ] = 0x01;
+	data[ data_runs_offset++ ] = 4;
+
+	data[ data_runs_offset++ ] = 0;
+
+	attribute_size = ( data_runs_offset + 7 ) & ~( (size_t) 7 );
+
+	fsntfs_test_mft_entry_arena_write_attribute_header(
+	 data,
+	 LIBFSNTFS_ATTRIBUTE_TYPE_DATA,
+	 (uint32_t) attribute_size,
+	 1,
+	 0,
+	 64,
+	 identifier );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 16 ] ),
+	 (uint64_t) 0 );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 24 ] ),
+	 number_of_clusters - 1 );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 32 ] ),
+	 64 );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 40 ] ),
+	 number_of_clusters * FSNTFS_TEST_MFT_ENTRY_ARENA_CLUSTER_BLOCK_SIZE );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 48 ] ),
+	 ( number_of_clusters * FSNTFS_TEST_MFT_ENTRY_ARENA_CLUSTER_BLOCK_SIZE ) - 100 );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 56 ] ),
+	 ( number_of_clusters * FSNTFS_TEST_MFT_ENTRY_ARENA_CLUSTER_BLOCK_SIZE ) - 100 );
+
+	return( attribute_size );
+}
+
+/* Writes a $FILE_NAME attribute
+ * Returns the size of the attribute
+ */
+size_t fsntfs_test_mft_entry_arena_write_file_name_attribute(
+        uint8_t *data,
+        const char *name,
+        uint8_t name_namespace,
+        uint16_t identifier )
+{
+	uint8_t value_data[ 66 + 512 ];
+
+	size_t name_length = strlen(
+	                      name );
+
+	memory_set(
+	 value_data,
+	 0,
+	 66 );
+
+	/* The parent is the root directory
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 &( value_data[ 0 ] ),
+	 ( (uint64_t) 5 << 48 ) | 5 );
+	byte_stream_copy_from_uint64_little_endian(
+	 &( value_data[ 8 ] ),
+	 0x01d1a2b3c4d5e6f7ULL );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( value_data[ 56 ] ),
+	 0x00000020UL );
+
+	value_data[ 64 ] = (uint8_t) name_length;
+	value_data[ 65 ] = name_namespace;
+
+	fsntfs_test_mft_entry_arena_write_utf16_stream(
+	 &( value_data[ 66 ] ),
+	 name,
+	 name_length );
+
+	return( fsntfs_test_mft_entry_arena_write_resident_attribute(
+	         data,
+	         LIBFSNTFS_ATTRIBUTE_TYPE_FILE_NAME,
+	         NULL,
+	         value_data,
+	         (uint32_t) ( 66 + ( name_length * 2 ) ),
+	         identifier ) );
+}
+
+/* Writes a MFT entry of a file with a long and a short name, a fragmented
+ * default data stream and a Zone.Identifier alternate data stream
+ */
+void fsntfs_test_mft_entry_arena_write_mft_entry(
+      uint8_t *data,
+      uint32_t mft_entry_index )
+{
+	char long_name[ 32 ];
+	char short_name[ 16 ];
+	uint8_t standard_information_data[ 72 ];
+
+	const char *zone_identifier = "[ZoneTransfer]\r\nZoneId=3\r\n";
+	size_t data_offset          = 56;
+	size_t sector_offset        = 0;
+	uint16_t fixup_value_index  = 1;
+
+	memory_set(
+	 data,
+	 0,
+	 FSNTFS_TEST_MFT_ENTRY_ARENA_MFT_ENTRY_SIZE );
+
+	memory_copy(
+	 data,
+	 "FILE",
+	 4 );
+
+	/* The fixup values are stored directly after the 48 byte header
+	 */
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 4 ] ),
+	 48 );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 6 ] ),
+	 1 + ( FSNTFS_TEST_MFT_ENTRY_ARENA_MFT_ENTRY_SIZE / 512 ) );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 16 ] ),
+	 1 );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 18 ] ),
+	 1 );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 20 ] ),
+	 (uint16_t) data_offset );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 22 ] ),
+	 LIBFSNTFS_MFT_ENTRY_FLAG_IN_USE );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 28 ] ),
+	 FSNTFS_TEST_MFT_ENTRY_ARENA_MFT_ENTRY_SIZE );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 40 ] ),
+	 FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ATTRIBUTES );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 44 ] ),
+	 mft_entry_index );
+
+	memory_set(
+	 standard_information_data,
+	 0,
+	 72 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( standard_information_data[ 0 ] ),
+	 0x01d1a2b3c4d5e6f7ULL );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( standard_information_data[ 32 ] ),
+	 0x00000020UL );
+
+	data_offset += fsntfs_test_mft_entry_arena_write_resident_attribute(
+	                &( data[ data_offset ] ),
+	                LIBFSNTFS_ATTRIBUTE_TYPE_STANDARD_INFORMATION,
+	                NULL,
+	                standard_information_data,
+	                72,
+	                0 );
+
+	snprintf(
+	 long_name,
+	 32,
+	 "document %05" PRIu32 ".txt",
+	 mft_entry_index );
+
+	data_offset += fsntfs_test_mft_entry_arena_write_file_name_attribute(
+	                &( data[ data_offset ] ),
+	                long_name,
+	                LIBFSNTFS_FILE_NAME_NAMESPACE_WINDOWS,
+	                1 );
+
+	snprintf(
+	 short_name,
+	 16,
+	 "DOC%05" PRIu32 ".TXT",
+	 mft_entry_index );
+
+	data_offset += fsntfs_test_mft_entry_arena_write_file_name_attribute(
+	                &( data[ data_offset ] ),
+	                short_name,
+	                LIBFSNTFS_FILE_NAME_NAMESPACE_DOS,
+	                2 );
+
+	data_offset += fsntfs_test_mft_entry_arena_write_data_attribute(
+	                &( data[ data_offset ] ),
+	                0x1000 + ( (uint64_t) mft_entry_index * 64 ),
+	                3 );
+
+	data_offset += fsntfs_test_mft_entry_arena_write_resident_attribute(
+	                &( data[ data_offset ] ),
+	                LIBFSNTFS_ATTRIBUTE_TYPE_DATA,
+	                "Zone.Identifier",
+	                (const uint8_t *) zone_identifier,
+	                (uint32_t) strlen( zone_identifier ),
+	                4 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ data_offset ] ),
+	 LIBFSNTFS_ATTRIBUTE_TYPE_END_OF_ATTRIBUTES );
+
+	data_offset += 8;
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 24 ] ),
+	 (uint32_t) data_offset );
+
+	/* Apply the fixup values, the last 2 bytes of every sector are stored
+	 * in the fixup values and replaced by the fixup placeholder value
+	 */
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 48 ] ),
+	 1 );
+
+	for( sector_offset = 510;
+	     sector_offset < FSNTFS_TEST_MFT_ENTRY_ARENA_MFT_ENTRY_SIZE;
+	     sector_offset += 512 )
+	{
+		data[ 48 + ( fixup_value_index * 2 ) ]     = data[ sector_offset ];
+		data[ 48 + ( fixup_value_index * 2 ) + 1 ] = data[ sector_offset + 1 ];
+
+		byte_stream_copy_from_uint16_little_endian(
+		 &( data[ sector_offset ] ),
+		 1 );
+
+		fixup_value_index++;
+	}
+}
+
+/* Reads all the MFT entries of the synthetic MFT
+ * Returns 1 if successful or -1 on error
+ */
+int fsntfs_test_mft_entry_arena_read_mft_entries(
+     libfsntfs_io_handle_t *io_handle,
+     const uint8_t *mft_data,
+     uint8_t use_arena,
+     int *number_of_attributes,
+     libcerror_error_t **error )
+{
+	libfsntfs_mft_entry_t *mft_entry = NULL;
+	static char *function            = "fsntfs_test_mft_entry_arena_read_mft_entries";
+	uint32_t mft_entry_index         = 0;
+	int mft_entry_number_of_attributes = 0;
+
+	*number_of_attributes = 0;
+
+	for( mft_entry_index = 0;
+	     mft_entry_index < FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ENTRIES;
+	     mft_entry_index++ )
+	{
+		if( libfsntfs_mft_entry_initialize(
+		     &mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create MFT entry.",
+			 function );
+
+			goto on_error;
+		}
+		/* Without an arena the MFT entry is read as before the arena was introduced
+		 */
+		if( use_arena == 0 )
+		{
+			if( libfsntfs_arena_free(
+			     &( mft_entry->arena ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free arena.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libfsntfs_mft_entry_read_data(
+		     mft_entry,
+		     io_handle,
+		     NULL,
+		     NULL,
+		     NULL,
+		     &( mft_data[ mft_entry_index * FSNTFS_TEST_MFT_ENTRY_ARENA_MFT_ENTRY_SIZE ] ),
+		     FSNTFS_TEST_MFT_ENTRY_ARENA_MFT_ENTRY_SIZE,
+		     mft_entry_index,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read MFT entry: %" PRIu32 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		if( libfsntfs_mft_entry_get_number_of_attributes(
+		     mft_entry,
+		     &mft_entry_number_of_attributes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of attributes of MFT entry: %" PRIu32 ".",
+			 function,
+			 mft_entry_index );
+
+			goto on_error;
+		}
+		*number_of_attributes += mft_entry_number_of_attributes;
+
+		if( libfsntfs_mft_entry_free(
+		     &mft_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free MFT entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( mft_entry != NULL )
+	{
+		libfsntfs_mft_entry_free(
+		 &mft_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Times reading the synthetic MFT and counts the heap allocations
+ * Returns 1 if successful or -1 on error
+ */
+int fsntfs_test_mft_entry_arena_benchmark(
+     const char *description,
+     libfsntfs_io_handle_t *io_handle,
+     const uint8_t *mft_data,
+     uint8_t use_arena,
+     uint64_t *number_of_allocations,
+     int *number_of_attributes )
+{
+	libcerror_error_t *error = NULL;
+	clock_t start_time       = 0;
+	clock_t read_time        = 0;
+
+	*number_of_allocations = 0;
+
+#if defined( FSNTFS_TEST_MFT_ENTRY_ARENA_COUNT_ALLOCATIONS )
+	fsntfs_test_mft_entry_arena_number_of_allocations = 0;
+#endif
+	start_time = clock();
+
+	if( fsntfs_test_mft_entry_arena_read_mft_entries(
+	     io_handle,
+	     mft_data,
+	     use_arena,
+	     number_of_attributes,
+	     &error ) != 1 )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	read_time = clock() - start_time;
+
+#if defined( FSNTFS_TEST_MFT_ENTRY_ARENA_COUNT_ALLOCATIONS )
+	*number_of_allocations = fsntfs_test_mft_entry_arena_number_of_allocations;
+
+	fprintf(
+	 stdout,
+	 "%s: %d MFT entries, %.2f allocations per MFT entry, %.3f s\n",
+	 description,
+	 FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ENTRIES,
+	 (double) *number_of_allocations / FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ENTRIES,
+	 (double) read_time / CLOCKS_PER_SEC );
+#else
+	fprintf(
+	 stdout,
+	 "%s: %d MFT entries, %.3f s\n",
+	 description,
+	 FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ENTRIES,
+	 (double) read_time / CLOCKS_PER_SEC );
+#endif
+	return( 1 );
+}
+
+#endif /* defined( FSNTFS_TEST_MFT_ENTRY_ARENA_HAVE_INTERNALS ) */
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( FSNTFS_TEST_MFT_ENTRY_ARENA_HAVE_INTERNALS )
+	libcerror_error_t *error            = NULL;
+	libfsntfs_io_handle_t *io_handle    = NULL;
+	uint8_t *mft_data                   = NULL;
+	uint64_t arena_number_of_allocations = 0;
+	uint64_t heap_number_of_allocations = 0;
+	uint32_t mft_entry_index            = 0;
+	int arena_number_of_attributes      = 0;
+	int heap_number_of_attributes       = 0;
+#endif
+
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( FSNTFS_TEST_MFT_ENTRY_ARENA_HAVE_INTERNALS )
+	mft_data = (uint8_t *) memory_allocate(
+	                        sizeof( uint8_t ) * FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ENTRIES * FSNTFS_TEST_MFT_ENTRY_ARENA_MFT_ENTRY_SIZE );
+
+	if( mft_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create MFT data.\n" );
+
+		goto on_error;
+	}
+	for( mft_entry_index = 0;
+	     mft_entry_index < FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ENTRIES;
+	     mft_entry_index++ )
+	{
+		fsntfs_test_mft_entry_arena_write_mft_entry(
+		 &( mft_data[ mft_entry_index * FSNTFS_TEST_MFT_ENTRY_ARENA_MFT_ENTRY_SIZE ] ),
+		 mft_entry_index );
+	}
+	if( libfsntfs_io_handle_initialize(
+	     &io_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create IO handle.\n" );
+
+		goto on_error;
+	}
+	io_handle->mft_entry_size     = FSNTFS_TEST_MFT_ENTRY_ARENA_MFT_ENTRY_SIZE;
+	io_handle->cluster_block_size = FSNTFS_TEST_MFT_ENTRY_ARENA_CLUSTER_BLOCK_SIZE;
+
+	if( fsntfs_test_mft_entry_arena_benchmark(
+	     "Heap",
+	     io_handle,
+	     mft_data,
+	     0,
+	     &heap_number_of_allocations,
+	     &heap_number_of_attributes ) != 1 )
+	{
+		goto on_error;
+	}
+	if( fsntfs_test_mft_entry_arena_benchmark(
+	     "Arena",
+	     io_handle,
+	     mft_data,
+	     1,
+	     &arena_number_of_allocations,
+	     &arena_number_of_attributes ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ( heap_number_of_attributes != ( FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ENTRIES * FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ATTRIBUTES ) )
+	 || ( arena_number_of_attributes != heap_number_of_attributes ) )
+	{
+		fprintf(
+		 stderr,
+		 "Number of attributes read differ (heap: %d, arena: %d).\n",
+		 heap_number_of_attributes,
+		 arena_number_of_attributes );
+
+		goto on_error;
+	}
+#if defined( FSNTFS_TEST_MFT_ENTRY_ARENA_COUNT_ALLOCATIONS )
+	if( ( arena_number_of_allocations >= heap_number_of_allocations )
+	 || ( ( heap_number_of_allocations - arena_number_of_allocations ) < ( (uint64_t) FSNTFS_TEST_MFT_ENTRY_ARENA_NUMBER_OF_ENTRIES * FSNTFS_TEST_MFT_ENTRY_ARENA_MINIMUM_SAVED_ALLOCATIONS ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Reading with an arena does not save at least %d allocations per MFT entry (heap: %" PRIu64 ", arena: %" PRIu64 ").\n",
+		 FSNTFS_TEST_MFT_ENTRY_ARENA_MINIMUM_SAVED_ALLOCATIONS,
+		 heap_number_of_allocations,
+		 arena_number_of_allocations );
+
+		goto on_error;
+	}
+#endif
+	if( libfsntfs_io_handle_free(
+	     &io_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free IO handle.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 mft_data );
+#else
+	fprintf(
+	 stdout,
+	 "MFT entry arena benchmark requires access to the library internals.\n" );
+#endif
+	return( EXIT_SUCCESS );
+
+#if defined( FSNTFS_TEST_MFT_ENTRY_ARENA_HAVE_INTERNALS )
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libfsntfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( mft_data != NULL )
+	{
+		memory_free(
+		 mft_data );
+	}
+	return( EXIT_FAILURE );
+#endif
+}
+
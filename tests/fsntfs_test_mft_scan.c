@@ -0,0 +1,516 @@
+/*
+ * Library MFT scan testing program
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libcstring.h"
+#include "fsntfs_test_libfsntfs.h"
+#include "fsntfs_test_unused.h"
+
+/* The name of the synthetic $MFT metadata file
+ */
+#define FSNTFS_TEST_MFT_SCAN_FILENAME			"fsntfs_test_mft_scan.mft"
+
+/* The number of MFT entries in the synthetic $MFT metadata file
+ */
+#define FSNTFS_TEST_MFT_SCAN_NUMBER_OF_ENTRIES		64
+
+/* The index of the corrupted MFT entry, in the middle of the synthetic $MFT metadata file
+ */
+#define FSNTFS_TEST_MFT_SCAN_CORRUPTED_ENTRY_INDEX	32
+
+#define FSNTFS_TEST_MFT_SCAN_MFT_ENTRY_SIZE		1024
+
+/* The in use flag of a MFT entry
+ */
+#define FSNTFS_TEST_MFT_SCAN_MFT_ENTRY_FLAG_IN_USE	0x0001
+
+typedef struct fsntfs_test_mft_scan_values fsntfs_test_mft_scan_values_t;
+
+struct fsntfs_test_mft_scan_values
+{
+	/* The number of file entries passed to the callback function
+	 */
+	int number_of_file_entries;
+
+	/* Value to indicate the corrupted MFT entry was passed to the callback function
+	 */
+	int has_corrupted_entry;
+};
+
+/* Writes a resident MFT attribute
+ * Returns the size of the attribute
+ */
+size_t fsntfs_test_mft_scan_write_resident_attribute(
+        uint8_t *data,
+        uint32_t type,
+        const uint8_t *value_data,
+        uint32_t value_data_size,
+        uint16_t identifier )
+{
+	size_t attribute_size = ( 24 + value_data_size + 7 ) & ~( (size_t) 7 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 0 ] ),
+	 type );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 4 ] ),
+	 (uint32_t) attribute_size );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 10 ] ),
+	 24 );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 14 ] ),
+	 identifier );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 16 ] ),
+	 value_data_size );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 20 ] ),
+	 24 );
+
+	memory_copy(
+	 &( data[ 24 ] ),
+	 value_data,
+	 value_data_size );
+
+	return( attribute_size );
+}
+
+/* Writes a MFT entry with a $STANDARD_INFORMATION, a $FILE_NAME and a resident $DATA attribute
+ */
+void fsntfs_test_mft_scan_write_mft_entry(
+      uint8_t *data,
+      uint32_t mft_entry_index )
+{
+	uint8_t file_name_data[ 66 + 32 ];
+	uint8_t standard_information_data[ 72 ];
+	char name[ 16 ];
+
+	size_t data_offset         = 56;
+	size_t name_index          = 0;
+	size_t name_length         = 0;
+	size_t sector_offset       = 0;
+	uint16_t fixup_value_index = 1;
+
+	memory_set(
+	 data,
+	 0,
+	 FSNTFS_TEST_MFT_SCAN_MFT_ENTRY_SIZE );
+
+	memory_copy(
+	 data,
+	 "FILE",
+	 4 );
+
+	/* The fixup values are stored directly after the 48 byte header
+	 */
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 4 ] ),
+	 48 );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 6 ] ),
+	 1 + ( FSNTFS_TEST_MFT_SCAN_MFT_ENTRY_SIZE / 512 ) );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 16 ] ),
+	 1 );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 18 ] ),
+	 1 );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 20 ] ),
+	 (uint16_t) data_offset );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 22 ] ),
+	 FSNTFS_TEST_MFT_SCAN_MFT_ENTRY_FLAG_IN_USE );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 28 ] ),
+	 FSNTFS_TEST_MFT_SCAN_MFT_ENTRY_SIZE );
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 40 ] ),
+	 3 );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 44 ] ),
+	 mft_entry_index );
+
+	memory_set(
+	 standard_information_data,
+	 0,
+	 72 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( standard_information_data[ 0 ] ),
+	 0x01d1a2b3c4d5e6f7ULL );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( standard_information_data[ 32 ] ),
+	 0x00000020UL );
+
+	data_offset += fsntfs_test_mft_scan_write_resident_attribute(
+	                &( data[ data_offset ] ),
+	                LIBFSNTFS_ATTRIBUTE_TYPE_STANDARD_INFORMATION,
+	                standard_information_data,
+	                72,
+	                0 );
+
+	name_length = (size_t) snprintf(
+	                        name,
+	                        16,
+	                        "file%05" PRIu32,
+	                        mft_entry_index );
+
+	memory_set(
+	 file_name_data,
+	 0,
+	 66 + 32 );
+
+	/* The parent is the root directory
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_name_data[ 0 ] ),
+	 ( (uint64_t) 5 << 48 ) | 5 );
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_name_data[ 56 ] ),
+	 0x00000020UL );
+
+	file_name_data[ 64 ] = (uint8_t) name_length;
+	file_name_data[ 65 ] = 1;
+
+	for( name_index = 0;
+	     name_index < name_length;
+	     name_index++ )
+	{
+		file_name_data[ 66 + ( name_index * 2 ) ] = (uint8_t) name[ name_index ];
+	}
+	data_offset += fsntfs_test_mft_scan_write_resident_attribute(
+	                &( data[ data_offset ] ),
+	                LIBFSNTFS_ATTRIBUTE_TYPE_FILE_NAME,
+	                file_name_data,
+	                (uint32_t) ( 66 + ( name_length * 2 ) ),
+	                1 );
+
+	data_offset += fsntfs_test_mft_scan_write_resident_attribute(
+	                &( data[ data_offset ] ),
+	                LIBFSNTFS_ATTRIBUTE_TYPE_DATA,
+	                (const uint8_t *) name,
+	                (uint32_t) name_length,
+	                2 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ data_offset ] ),
+	 LIBFSNTFS_ATTRIBUTE_TYPE_END_OF_ATTRIBUTES );
+
+	data_offset += 8;
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 24 ] ),
+	 (uint32_t) data_offset );
+
+	/* Apply the fixup values, the last 2 bytes of every sector are stored
+	 * in the fixup values and replaced by the fixup placeholder value
+	 */
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 48 ] ),
+	 1 );
+
+	for( sector_offset = 510;
+	     sector_offset < FSNTFS_TEST_MFT_SCAN_MFT_ENTRY_SIZE;
+	     sector_offset += 512 )
+	{
+		data[ 48 + ( fixup_value_index * 2 ) ]     = data[ sector_offset ];
+		data[ 48 + ( fixup_value_index * 2 ) + 1 ] = data[ sector_offset + 1 ];
+
+		byte_stream_copy_from_uint16_little_endian(
+		 &( data[ sector_offset ] ),
+		 1 );
+
+		fixup_value_index++;
+	}
+}
+
+/* Writes the synthetic $MFT metadata file with a corrupted MFT entry
+ * Returns 1 if successful or -1 on error
+ */
+int fsntfs_test_mft_scan_write_file(
+     const char *filename )
+{
+	uint8_t mft_entry_data[ FSNTFS_TEST_MFT_SCAN_MFT_ENTRY_SIZE ];
+
+	FILE *file_stream        = NULL;
+	uint32_t mft_entry_index = 0;
+
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_WRITE );
+
+	if( file_stream == NULL )
+	{
+		return( -1 );
+	}
+	for( mft_entry_index = 0;
+	     mft_entry_index < FSNTFS_TEST_MFT_SCAN_NUMBER_OF_ENTRIES;
+	     mft_entry_index++ )
+	{
+		fsntfs_test_mft_scan_write_mft_entry(
+		 mft_entry_data,
+		 mft_entry_index );
+
+		if( mft_entry_index == FSNTFS_TEST_MFT_SCAN_CORRUPTED_ENTRY_INDEX )
+		{
+			memory_copy(
+			 mft_entry_data,
+			 "XXXX",
+			 4 );
+		}
+		if( file_stream_write(
+		     file_stream,
+		     mft_entry_data,
+		     FSNTFS_TEST_MFT_SCAN_MFT_ENTRY_SIZE ) != FSNTFS_TEST_MFT_SCAN_MFT_ENTRY_SIZE )
+		{
+			file_stream_close(
+			 file_stream );
+
+			return( -1 );
+		}
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Counts the file entries passed by the scan
+ * Returns 1 to continue
+ */
+int fsntfs_test_mft_scan_callback(
+     libfsntfs_file_entry_t *file_entry,
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	fsntfs_test_mft_scan_values_t *scan_values = NULL;
+	uint64_t file_reference                    = 0;
+
+	scan_values = (fsntfs_test_mft_scan_values_t *) callback_data;
+
+	if( libfsntfs_file_entry_get_file_reference(
+	     file_entry,
+	     &file_reference,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( ( file_reference & 0x0000ffffffffffffULL ) == FSNTFS_TEST_MFT_SCAN_CORRUPTED_ENTRY_INDEX )
+	{
+		scan_values->has_corrupted_entry = 1;
+	}
+	scan_values->number_of_file_entries++;
+
+	return( 1 );
+}
+
+/* Tests scanning a $MFT metadata file that contains a corrupted MFT entry
+ * A number_of_threads of 0 uses the sequential scan, otherwise the parallel scan
+ * is used with the callbacks delivered in MFT order
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fsntfs_test_mft_scan_corrupted_entry(
+     libfsntfs_mft_metadata_file_t *mft_metadata_file,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	fsntfs_test_mft_scan_values_t scan_values;
+
+	int result = 0;
+
+	scan_values.number_of_file_entries = 0;
+	scan_values.has_corrupted_entry    = 0;
+
+	if( number_of_threads == 0 )
+	{
+		result = libfsntfs_mft_metadata_file_scan(
+		          mft_metadata_file,
+		          &fsntfs_test_mft_scan_callback,
+		          (void *) &scan_values,
+		          error );
+	}
+	else
+	{
+		result = libfsntfs_mft_metadata_file_scan_parallel(
+		          mft_metadata_file,
+		          number_of_threads,
+		          0,
+		          &fsntfs_test_mft_scan_callback,
+		          (void *) &scan_values,
+		          error );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 stdout,
+	 "Scan with %d threads: %d file entries\n",
+	 number_of_threads,
+	 scan_values.number_of_file_entries );
+
+	if( ( scan_values.number_of_file_entries != ( FSNTFS_TEST_MFT_SCAN_NUMBER_OF_ENTRIES - 1 ) )
+	 || ( scan_values.has_corrupted_entry != 0 ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSNTFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSNTFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error                         = NULL;
+	libfsntfs_mft_metadata_file_t *mft_metadata_file = NULL;
+	int result                                       = 0;
+
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSNTFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+	if( fsntfs_test_mft_scan_write_file(
+	     FSNTFS_TEST_MFT_SCAN_FILENAME ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write MFT metadata file.\n" );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_metadata_file_initialize(
+	     &mft_metadata_file,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create MFT metadata file.\n" );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_metadata_file_open(
+	     mft_metadata_file,
+	     FSNTFS_TEST_MFT_SCAN_FILENAME,
+	     LIBFSNTFS_OPEN_READ,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open MFT metadata file.\n" );
+
+		goto on_error;
+	}
+	result = fsntfs_test_mft_scan_corrupted_entry(
+	          mft_metadata_file,
+	          0,
+	          &error );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Scan did not skip the corrupted MFT entry.\n" );
+
+		goto on_error;
+	}
+	result = fsntfs_test_mft_scan_corrupted_entry(
+	          mft_metadata_file,
+	          4,
+	          &error );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Parallel scan did not skip the corrupted MFT entry.\n" );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_metadata_file_close(
+	     mft_metadata_file,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close MFT metadata file.\n" );
+
+		goto on_error;
+	}
+	if( libfsntfs_mft_metadata_file_free(
+	     &mft_metadata_file,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free MFT metadata file.\n" );
+
+		goto on_error;
+	}
+	remove(
+	 FSNTFS_TEST_MFT_SCAN_FILENAME );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( mft_metadata_file != NULL )
+	{
+		libfsntfs_mft_metadata_file_close(
+		 mft_metadata_file,
+		 NULL );
+		libfsntfs_mft_metadata_file_free(
+		 &mft_metadata_file,
+		 NULL );
+	}
+	remove(
+	 FSNTFS_TEST_MFT_SCAN_FILENAME );
+
+	return( EXIT_FAILURE );
+}
+
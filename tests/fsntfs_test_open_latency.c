@@ -0,0 +1,293 @@
+/*
+ * Library open latency testing and benchmark program
+ *
+ * Copyright (C) 2010-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <time.h>
+
+#include "fsntfs_test_libcerror.h"
+#include "fsntfs_test_libcstring.h"
+#include "fsntfs_test_libfsntfs.h"
+
+#define FSNTFS_TEST_OPEN_LATENCY_NUMBER_OF_ITERATIONS	16
+
+/* Opens a volume, optionally retrieves the cluster allocation counts and closes it
+ * Returns 1 if successful or -1 on error
+ */
+int fsntfs_test_open_latency_open_close_volume(
+     const libcstring_system_character_t *filename,
+     int access_flags,
+     uint64_t *number_of_allocated_clusters,
+     uint64_t *number_of_unallocated_clusters,
+     libcerror_error_t **error )
+{
+	libfsntfs_volume_t *volume = NULL;
+	static char *function      = "fsntfs_test_open_latency_open_close_volume";
+
+	if( libfsntfs_volume_initialize(
+	     &volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create volume.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libfsntfs_volume_open_wide(
+	     volume,
+	     filename,
+	     access_flags,
+	     error ) != 1 )
+#else
+	if( libfsntfs_volume_open(
+	     volume,
+	     filename,
+	     access_flags,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_allocated_clusters != NULL )
+	 && ( number_of_unallocated_clusters != NULL ) )
+	{
+		if( libfsntfs_volume_get_cluster_allocation_counts(
+		     volume,
+		     number_of_allocated_clusters,
+		     number_of_unallocated_clusters,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cluster allocation counts.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfsntfs_volume_close(
+	     volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfsntfs_volume_free(
+	     &volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free volume.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( volume != NULL )
+	{
+		libfsntfs_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Measures the average time of opening and closing a volume
+ * Returns 1 if successful or -1 on error
+ */
+int fsntfs_test_open_latency_measure(
+     const libcstring_system_character_t *filename,
+     int access_flags,
+     double *average_time,
+     libcerror_error_t **error )
+{
+	static char *function = "fsntfs_test_open_latency_measure";
+	clock_t start_time    = 0;
+	int iteration         = 0;
+
+	start_time = clock();
+
+	for( iteration = 0;
+	     iteration < FSNTFS_TEST_OPEN_LATENCY_NUMBER_OF_ITERATIONS;
+	     iteration++ )
+	{
+		if( fsntfs_test_open_latency_open_close_volume(
+		     filename,
+		     access_flags,
+		     NULL,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to open and close volume.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*average_time = ( (double) ( clock() - start_time ) / CLOCKS_PER_SEC )
+	              / FSNTFS_TEST_OPEN_LATENCY_NUMBER_OF_ITERATIONS;
+
+	return( 1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                         = NULL;
+	libcstring_system_character_t *source            = NULL;
+	double deferred_average_time                     = 0.0;
+	double eager_average_time                        = 0.0;
+	uint64_t deferred_number_of_allocated_clusters   = 0;
+	uint64_t deferred_number_of_unallocated_clusters = 0;
+	uint64_t eager_number_of_allocated_clusters      = 0;
+	uint64_t eager_number_of_unallocated_clusters    = 0;
+
+	if( argc != 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported number of arguments.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ 1 ];
+
+	if( fsntfs_test_open_latency_measure(
+	     source,
+	     LIBFSNTFS_OPEN_READ,
+	     &eager_average_time,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to measure open latency.\n" );
+
+		goto on_error;
+	}
+	if( fsntfs_test_open_latency_measure(
+	     source,
+	     LIBFSNTFS_OPEN_READ_DEFERRED,
+	     &deferred_average_time,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to measure deferred open latency.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Average open latency of: %" PRIs_LIBCSTRING_SYSTEM " with access: read: %.6f s, read deferred: %.6f s\n",
+	 source,
+	 eager_average_time,
+	 deferred_average_time );
+
+	/* The deferred bitmap must be read when first needed and match the one read at open time
+	 */
+	if( fsntfs_test_open_latency_open_close_volume(
+	     source,
+	     LIBFSNTFS_OPEN_READ,
+	     &eager_number_of_allocated_clusters,
+	     &eager_number_of_unallocated_clusters,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve cluster allocation counts.\n" );
+
+		goto on_error;
+	}
+	if( fsntfs_test_open_latency_open_close_volume(
+	     source,
+	     LIBFSNTFS_OPEN_READ_DEFERRED,
+	     &deferred_number_of_allocated_clusters,
+	     &deferred_number_of_unallocated_clusters,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve deferred cluster allocation counts.\n" );
+
+		goto on_error;
+	}
+	if( ( deferred_number_of_allocated_clusters != eager_number_of_allocated_clusters )
+	 || ( deferred_number_of_unallocated_clusters != eager_number_of_unallocated_clusters ) )
+	{
+		fprintf(
+		 stderr,
+		 "Cluster allocation counts of deferred open differ.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
@@ -37,6 +38,7 @@
  */
 
 #define FSNTFS_TEST_READ_BUFFER_SIZE		4096
+#define FSNTFS_TEST_READ_MAXIMUM_NUMBER_OF_RANGES	4
 #define FSNTFS_TEST_READ_NUMBER_OF_THREADS	4
 
 /* Tests libfsntfs_file_entry_seek_offset
@@ -352,6 +354,199 @@ int fsntfs_test_seek_offset_and_read_buffer(
 	return( result );
 }
 
+/* Tests libfsntfs_file_entry_read_vector
+ * The data of every range is compared with the data read by libfsntfs_file_entry_read_buffer_at_offset
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fsntfs_test_read_vector(
+     libfsntfs_file_entry_t *file_entry,
+     size64_t file_size,
+     const char *description,
+     off64_t *range_offsets,
+     size_t *range_sizes,
+     int number_of_ranges )
+{
+	uint8_t expected_data[ FSNTFS_TEST_READ_BUFFER_SIZE ];
+	uint8_t range_data[ FSNTFS_TEST_READ_MAXIMUM_NUMBER_OF_RANGES ][ FSNTFS_TEST_READ_BUFFER_SIZE ];
+
+	libfsntfs_read_range_t ranges[ FSNTFS_TEST_READ_MAXIMUM_NUMBER_OF_RANGES ];
+
+	libcerror_error_t *error     = NULL;
+	off64_t current_offset       = 0;
+	off64_t result_offset        = 0;
+	size_t expected_read_count   = 0;
+	ssize_t read_count           = 0;
+	ssize_t expected_total_count = 0;
+	int range_index              = 0;
+	int result                   = 0;
+
+	if( file_entry == NULL )
+	{
+		return( -1 );
+	}
+	if( ( number_of_ranges < 0 )
+	 || ( number_of_ranges > FSNTFS_TEST_READ_MAXIMUM_NUMBER_OF_RANGES ) )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 stdout,
+	 "Testing reading vector of %d %s ranges\t",
+	 number_of_ranges,
+	 description );
+
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		if( range_sizes[ range_index ] > FSNTFS_TEST_READ_BUFFER_SIZE )
+		{
+			return( -1 );
+		}
+		ranges[ range_index ].offset     = range_offsets[ range_index ];
+		ranges[ range_index ].size       = range_sizes[ range_index ];
+		ranges[ range_index ].buffer     = range_data[ range_index ];
+		ranges[ range_index ].read_count = 0;
+	}
+	if( libfsntfs_file_entry_get_offset(
+	     file_entry,
+	     &current_offset,
+	     &error ) != 1 )
+	{
+		result = -1;
+
+		goto on_error;
+	}
+	read_count = libfsntfs_file_entry_read_vector(
+	              file_entry,
+	              ranges,
+	              number_of_ranges,
+	              &error );
+
+	if( read_count < 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to read vector.\n" );
+
+		goto on_error;
+	}
+	/* The vectored read should not change the current offset
+	 */
+	if( libfsntfs_file_entry_get_offset(
+	     file_entry,
+	     &result_offset,
+	     &error ) != 1 )
+	{
+		result = -1;
+
+		goto on_error;
+	}
+	if( result_offset != current_offset )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected offset: %" PRIi64 "\n",
+		 result_offset );
+
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		expected_read_count = 0;
+
+		if( ( range_sizes[ range_index ] > 0 )
+		 && ( (size64_t) range_offsets[ range_index ] < file_size ) )
+		{
+			read_count = libfsntfs_file_entry_read_buffer_at_offset(
+			              file_entry,
+			              expected_data,
+			              range_sizes[ range_index ],
+			              range_offsets[ range_index ],
+			              &error );
+
+			if( read_count < 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to read buffer at offset: %" PRIi64 ".\n",
+				 range_offsets[ range_index ] );
+
+				goto on_error;
+			}
+			expected_read_count = (size_t) read_count;
+		}
+		if( ranges[ range_index ].read_count != expected_read_count )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected read count: %" PRIu64 " of range: %d\n",
+			 (uint64_t) ranges[ range_index ].read_count,
+			 range_index );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     range_data[ range_index ],
+		     expected_data,
+		     expected_read_count ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected data of range: %d\n",
+			 range_index );
+
+			goto on_error;
+		}
+		expected_total_count += (ssize_t) expected_read_count;
+	}
+	if( libfsntfs_file_entry_read_vector(
+	     file_entry,
+	     ranges,
+	     number_of_ranges,
+	     &error ) != expected_total_count )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected total read count.\n" );
+
+		goto on_error;
+	}
+	result = 1;
+
+on_error:
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		if( result != 1 )
+		{
+			libcerror_error_backtrace_fprint(
+			 error,
+			 stderr );
+		}
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
 /* Tests reading data from a file entry
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -359,6 +554,9 @@ int fsntfs_test_read_from_file_entry(
      libfsntfs_file_entry_t *file_entry,
      size64_t file_size )
 {
+	off64_t range_offsets[ FSNTFS_TEST_READ_MAXIMUM_NUMBER_OF_RANGES ];
+	size_t range_sizes[ FSNTFS_TEST_READ_MAXIMUM_NUMBER_OF_RANGES ];
+
 	int result = 0;
 
 	if( file_entry == NULL )
@@ -581,6 +779,145 @@ int fsntfs_test_read_from_file_entry(
 
 		return( result );
 	}
+	/* Case 4: test vector read
+	 */
+
+	/* Test: ranges in order of their offset
+	 * Expected result: the data read by read buffer at offset
+	 */
+	range_offsets[ 0 ] = 0;
+	range_sizes[ 0 ]   = 512;
+	range_offsets[ 1 ] = 4096;
+	range_sizes[ 1 ]   = 1024;
+	range_offsets[ 2 ] = (off64_t) ( file_size / 2 );
+	range_sizes[ 2 ]   = 4096;
+
+	result = fsntfs_test_read_vector(
+	          file_entry,
+	          file_size,
+	          "sorted",
+	          range_offsets,
+	          range_sizes,
+	          3 );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read vector.\n" );
+
+		return( result );
+	}
+
+	/* Test: ranges not in order of their offset
+	 * Expected result: the data read by read buffer at offset
+	 */
+	range_offsets[ 0 ] = (off64_t) ( file_size / 2 );
+	range_sizes[ 0 ]   = 4096;
+	range_offsets[ 1 ] = 0;
+	range_sizes[ 1 ]   = 512;
+	range_offsets[ 2 ] = 4096;
+	range_sizes[ 2 ]   = 1024;
+
+	result = fsntfs_test_read_vector(
+	          file_entry,
+	          file_size,
+	          "unsorted",
+	          range_offsets,
+	          range_sizes,
+	          3 );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read vector.\n" );
+
+		return( result );
+	}
+
+	/* Test: ranges that overlap, including a range contained in another range
+	 * Expected result: the data read by read buffer at offset
+	 */
+	range_offsets[ 0 ] = 1000;
+	range_sizes[ 0 ]   = 3000;
+	range_offsets[ 1 ] = 2000;
+	range_sizes[ 1 ]   = 3000;
+	range_offsets[ 2 ] = 1500;
+	range_sizes[ 2 ]   = 100;
+
+	result = fsntfs_test_read_vector(
+	          file_entry,
+	          file_size,
+	          "overlapping",
+	          range_offsets,
+	          range_sizes,
+	          3 );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read vector.\n" );
+
+		return( result );
+	}
+
+	/* Test: ranges that are adjacent
+	 * Expected result: the data read by read buffer at offset
+	 */
+	range_offsets[ 0 ] = 0;
+	range_sizes[ 0 ]   = 4096;
+	range_offsets[ 1 ] = 4096;
+	range_sizes[ 1 ]   = 4096;
+	range_offsets[ 2 ] = 8192;
+	range_sizes[ 2 ]   = 100;
+
+	result = fsntfs_test_read_vector(
+	          file_entry,
+	          file_size,
+	          "adjacent",
+	          range_offsets,
+	          range_sizes,
+	          3 );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read vector.\n" );
+
+		return( result );
+	}
+
+	/* Test: ranges that extend beyond or start at or after the end of the data, and an empty range
+	 * Expected result: the data read by read buffer at offset
+	 */
+	range_offsets[ 0 ] = ( file_size > 100 ) ? (off64_t) file_size - 100 : 0;
+	range_sizes[ 0 ]   = 200;
+	range_offsets[ 1 ] = (off64_t) file_size;
+	range_sizes[ 1 ]   = 10;
+	range_offsets[ 2 ] = (off64_t) file_size + 4096;
+	range_sizes[ 2 ]   = 10;
+	range_offsets[ 3 ] = 0;
+	range_sizes[ 3 ]   = 0;
+
+	result = fsntfs_test_read_vector(
+	          file_entry,
+	          file_size,
+	          "past end",
+	          range_offsets,
+	          range_sizes,
+	          4 );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read vector.\n" );
+
+		return( result );
+	}
 	return( 1 );
 }
 
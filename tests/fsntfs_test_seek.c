@@ -35,6 +35,22 @@
 #define FSNTFS_TEST_SEEK_VERBOSE
  */
 
+/* The number of clusters in a compression unit
+ */
+#define FSNTFS_TEST_SEEK_COMPRESSION_UNIT_NUMBER_OF_CLUSTERS	16
+
+/* The maximum number of extents of which the start and middle are tested
+ */
+#define FSNTFS_TEST_SEEK_MAXIMUM_NUMBER_OF_TESTED_EXTENTS	16
+
+enum FSNTFS_TEST_SEEK_DATA_TYPES
+{
+	FSNTFS_TEST_SEEK_DATA_TYPE_RESIDENT,
+	FSNTFS_TEST_SEEK_DATA_TYPE_SPARSE,
+	FSNTFS_TEST_SEEK_DATA_TYPE_COMPRESSED,
+	FSNTFS_TEST_SEEK_DATA_TYPE_OTHER
+};
+
 /* Tests libfsntfs_file_entry_seek_offset
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -65,6 +81,14 @@ int fsntfs_test_seek_offset(
 	{
 		whence_string = "SEEK_SET";
 	}
+	else if( input_whence == LIBFSNTFS_SEEK_DATA )
+	{
+		whence_string = "LIBFSNTFS_SEEK_DATA";
+	}
+	else if( input_whence == LIBFSNTFS_SEEK_HOLE )
+	{
+		whence_string = "LIBFSNTFS_SEEK_HOLE";
+	}
 	else
 	{
 		whence_string = "UNKNOWN";
@@ -417,6 +441,644 @@ int fsntfs_test_seek(
 	return( result );
 }
 
+/* Determines if a range of the default data stream is entirely covered by sparse extents
+ * Returns 1 if sparse, 0 if not or -1 on error
+ */
+int fsntfs_test_seek_is_sparse_range(
+     libfsntfs_file_entry_t *file_entry,
+     off64_t range_offset,
+     size64_t range_size,
+     libcerror_error_t **error )
+{
+	off64_t covered_end_offset = 0;
+	off64_t extent_offset      = 0;
+	size64_t extent_size       = 0;
+	uint32_t extent_flags      = 0;
+	int extent_index           = 0;
+	int number_of_extents      = 0;
+
+	if( libfsntfs_file_entry_get_number_of_extents(
+	     file_entry,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	covered_end_offset = range_offset;
+
+	/* The extents are stored in order of their offset
+	 */
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libfsntfs_file_entry_get_extent_by_index(
+		     file_entry,
+		     extent_index,
+		     &extent_offset,
+		     &extent_size,
+		     &extent_flags,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		if( ( ( extent_flags & LIBFSNTFS_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		 && ( extent_offset <= covered_end_offset )
+		 && ( ( extent_offset + (off64_t) extent_size ) > covered_end_offset ) )
+		{
+			covered_end_offset = extent_offset + (off64_t) extent_size;
+		}
+		if( covered_end_offset >= ( range_offset + (off64_t) range_size ) )
+		{
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Determines the expected result of seeking the next data or hole
+ * A compression unit is only a hole if it is entirely sparse and the end of the data is a hole
+ * Returns 1 if successful or -1 on error
+ */
+int fsntfs_test_seek_get_expected_data_or_hole_offset(
+     libfsntfs_file_entry_t *file_entry,
+     size64_t file_size,
+     size_t block_size,
+     size_t compression_unit_size,
+     off64_t offset,
+     int whence,
+     off64_t *expected_offset,
+     libcerror_error_t **error )
+{
+	off64_t range_offset = 0;
+	size64_t range_size  = 0;
+	int result           = 0;
+
+	/* There is no data or hole at or after the end of the data
+	 */
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= file_size ) )
+	{
+		*expected_offset = -1;
+
+		return( 1 );
+	}
+	while( (size64_t) offset < file_size )
+	{
+		range_offset = offset;
+		range_size   = 1;
+
+		if( compression_unit_size != 0 )
+		{
+			range_offset -= (off64_t) ( (size64_t) offset % compression_unit_size );
+			range_size    = compression_unit_size;
+
+			if( range_size > ( file_size - (size64_t) range_offset ) )
+			{
+				range_size = file_size - (size64_t) range_offset;
+			}
+		}
+		result = fsntfs_test_seek_is_sparse_range(
+		          file_entry,
+		          range_offset,
+		          range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			return( -1 );
+		}
+		if( ( ( whence == LIBFSNTFS_SEEK_DATA )
+		  &&  ( result == 0 ) )
+		 || ( ( whence == LIBFSNTFS_SEEK_HOLE )
+		  &&  ( result != 0 ) ) )
+		{
+			*expected_offset = offset;
+
+			return( 1 );
+		}
+		offset = ( ( offset / (off64_t) block_size ) + 1 ) * (off64_t) block_size;
+	}
+	if( whence == LIBFSNTFS_SEEK_DATA )
+	{
+		*expected_offset = -1;
+	}
+	else
+	{
+		*expected_offset = (off64_t) file_size;
+	}
+	return( 1 );
+}
+
+/* Tests seeking the next data and hole at a specific offset
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fsntfs_test_seek_data_and_hole_at_offset(
+     libfsntfs_file_entry_t *file_entry,
+     size64_t file_size,
+     size_t block_size,
+     size_t compression_unit_size,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	off64_t expected_offset = 0;
+	int result              = 0;
+	int whence              = 0;
+
+	for( whence = LIBFSNTFS_SEEK_DATA;
+	     whence <= LIBFSNTFS_SEEK_HOLE;
+	     whence++ )
+	{
+		if( fsntfs_test_seek_get_expected_data_or_hole_offset(
+		     file_entry,
+		     file_size,
+		     block_size,
+		     compression_unit_size,
+		     offset,
+		     whence,
+		     &expected_offset,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		result = fsntfs_test_seek_offset(
+		          file_entry,
+		          offset,
+		          whence,
+		          expected_offset );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to test seek offset.\n" );
+
+			return( result );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests seeking the next data and hole in a file
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fsntfs_test_seek_data_and_hole(
+     libfsntfs_file_entry_t *file_entry,
+     size64_t file_size,
+     size_t block_size,
+     size_t compression_unit_size,
+     libcerror_error_t **error )
+{
+	off64_t extent_offset = 0;
+	size64_t extent_size  = 0;
+	uint32_t extent_flags = 0;
+	int extent_index      = 0;
+	int number_of_extents = 0;
+	int result            = 0;
+
+	if( file_size > (size64_t) INT64_MAX )
+	{
+		fprintf(
+		 stderr,
+		 "File size exceeds maximum.\n" );
+
+		return( -1 );
+	}
+	/* Test: LIBFSNTFS_SEEK_DATA and LIBFSNTFS_SEEK_HOLE offset: 0, <file_size / 2> and <file_size - 1>
+	 * Expected result: the offsets determined from the extents
+	 */
+	result = fsntfs_test_seek_data_and_hole_at_offset(
+	          file_entry,
+	          file_size,
+	          block_size,
+	          compression_unit_size,
+	          0,
+	          error );
+
+	if( result == 1 )
+	{
+		result = fsntfs_test_seek_data_and_hole_at_offset(
+		          file_entry,
+		          file_size,
+		          block_size,
+		          compression_unit_size,
+		          (off64_t) ( file_size / 2 ),
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = fsntfs_test_seek_data_and_hole_at_offset(
+		          file_entry,
+		          file_size,
+		          block_size,
+		          compression_unit_size,
+		          (off64_t) ( file_size - 1 ),
+		          error );
+	}
+	if( result != 1 )
+	{
+		return( result );
+	}
+	/* Test: LIBFSNTFS_SEEK_DATA and LIBFSNTFS_SEEK_HOLE offset: the start and middle of the extents
+	 * Expected result: the offsets determined from the extents
+	 */
+	if( libfsntfs_file_entry_get_number_of_extents(
+	     file_entry,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( extent_index >= FSNTFS_TEST_SEEK_MAXIMUM_NUMBER_OF_TESTED_EXTENTS )
+		{
+			break;
+		}
+		if( libfsntfs_file_entry_get_extent_by_index(
+		     file_entry,
+		     extent_index,
+		     &extent_offset,
+		     &extent_size,
+		     &extent_flags,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		result = fsntfs_test_seek_data_and_hole_at_offset(
+		          file_entry,
+		          file_size,
+		          block_size,
+		          compression_unit_size,
+		          extent_offset,
+		          error );
+
+		if( result == 1 )
+		{
+			result = fsntfs_test_seek_data_and_hole_at_offset(
+			          file_entry,
+			          file_size,
+			          block_size,
+			          compression_unit_size,
+			          extent_offset + (off64_t) ( extent_size / 2 ),
+			          error );
+		}
+		if( result != 1 )
+		{
+			return( result );
+		}
+	}
+	/* Test: LIBFSNTFS_SEEK_DATA and LIBFSNTFS_SEEK_HOLE offset: <file_size> and <file_size + 987>
+	 * Expected result: -1
+	 */
+	result = fsntfs_test_seek_data_and_hole_at_offset(
+	          file_entry,
+	          file_size,
+	          block_size,
+	          compression_unit_size,
+	          (off64_t) file_size,
+	          error );
+
+	if( result == 1 )
+	{
+		result = fsntfs_test_seek_data_and_hole_at_offset(
+		          file_entry,
+		          file_size,
+		          block_size,
+		          compression_unit_size,
+		          (off64_t) ( file_size + 987 ),
+		          error );
+	}
+	return( result );
+}
+
+/* Determines the type of the data of the default data stream of a file entry
+ * Returns 1 if successful, 0 if the file entry has no default data stream or -1 on error
+ */
+int fsntfs_test_seek_get_data_type(
+     libfsntfs_file_entry_t *file_entry,
+     int *data_type,
+     libcerror_error_t **error )
+{
+	libfsntfs_attribute_t *attribute = NULL;
+	off64_t extent_offset            = 0;
+	size64_t extent_size             = 0;
+	size_t utf8_name_size            = 0;
+	uint64_t data_first_vcn          = 0;
+	uint64_t data_last_vcn           = 0;
+	uint32_t attribute_type          = 0;
+	uint32_t extent_flags            = 0;
+	uint32_t file_attribute_flags    = 0;
+	int attribute_index              = 0;
+	int extent_index                 = 0;
+	int number_of_attributes         = 0;
+	int number_of_extents            = 0;
+	int result                       = 0;
+
+	result = libfsntfs_file_entry_has_default_data_stream(
+	          file_entry,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	*data_type = FSNTFS_TEST_SEEK_DATA_TYPE_OTHER;
+
+	if( libfsntfs_file_entry_get_number_of_attributes(
+	     file_entry,
+	     &number_of_attributes,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	for( attribute_index = 0;
+	     attribute_index < number_of_attributes;
+	     attribute_index++ )
+	{
+		if( libfsntfs_file_entry_get_attribute_by_index(
+		     file_entry,
+		     attribute_index,
+		     &attribute,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		result = libfsntfs_attribute_get_type(
+		          attribute,
+		          &attribute_type,
+		          error );
+
+		if( ( result == 1 )
+		 && ( attribute_type == LIBFSNTFS_ATTRIBUTE_TYPE_DATA ) )
+		{
+			result = libfsntfs_attribute_get_utf8_name_size(
+			          attribute,
+			          &utf8_name_size,
+			          error );
+
+			/* The default data stream is the nameless $DATA attribute
+			 */
+			if( ( result == 1 )
+			 && ( utf8_name_size == 0 ) )
+			{
+				result = libfsntfs_attribute_get_data_vcn_range(
+				          attribute,
+				          &data_first_vcn,
+				          &data_last_vcn,
+				          error );
+
+				if( result == 0 )
+				{
+					*data_type = FSNTFS_TEST_SEEK_DATA_TYPE_RESIDENT;
+				}
+				else if( result == 1 )
+				{
+					result = 0;
+				}
+				attribute_index = number_of_attributes;
+			}
+		}
+		if( libfsntfs_attribute_free(
+		     &attribute,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		if( result == -1 )
+		{
+			return( -1 );
+		}
+	}
+	if( *data_type == FSNTFS_TEST_SEEK_DATA_TYPE_RESIDENT )
+	{
+		return( 1 );
+	}
+	if( libfsntfs_file_entry_get_file_attribute_flags(
+	     file_entry,
+	     &file_attribute_flags,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libfsntfs_file_entry_get_number_of_extents(
+	     file_entry,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libfsntfs_file_entry_get_extent_by_index(
+		     file_entry,
+		     extent_index,
+		     &extent_offset,
+		     &extent_size,
+		     &extent_flags,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		if( ( extent_flags & LIBFSNTFS_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		{
+			/* The sparse extents of compressed data mostly fill the remainder
+			 * of a compression unit, which makes the compression unit partially sparse
+			 */
+			if( ( file_attribute_flags & LIBFSNTFS_FILE_ATTRIBUTE_FLAG_COMPRESSED ) != 0 )
+			{
+				*data_type = FSNTFS_TEST_SEEK_DATA_TYPE_COMPRESSED;
+			}
+			else if( ( file_attribute_flags & LIBFSNTFS_FILE_ATTRIBUTE_FLAG_SPARSE_FILE ) != 0 )
+			{
+				*data_type = FSNTFS_TEST_SEEK_DATA_TYPE_SPARSE;
+			}
+			break;
+		}
+	}
+	return( 1 );
+}
+
+/* Tests seeking the next data and hole in a resident, a sparse and a compressed file of a volume
+ * The first file entry of every type of data is tested, types that are not found are skipped
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int fsntfs_test_seek_data_and_hole_in_volume(
+     libfsntfs_volume_t *volume,
+     libcerror_error_t **error )
+{
+	const char *data_type_descriptions[ 3 ] = {
+		"resident", "sparse", "compressed" };
+
+	int data_type_found[ 3 ]                = { 0, 0, 0 };
+
+	libfsntfs_file_entry_t *file_entry      = NULL;
+	size64_t file_size                      = 0;
+	size_t block_size                       = 0;
+	size_t cluster_block_size               = 0;
+	size_t compression_unit_size            = 0;
+	uint64_t file_entry_index               = 0;
+	uint64_t number_of_file_entries         = 0;
+	int data_type                           = 0;
+	int number_of_data_types_found          = 0;
+	int result                              = 0;
+
+	if( libfsntfs_volume_get_cluster_block_size(
+	     volume,
+	     &cluster_block_size,
+	     error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve cluster block size.\n" );
+
+		goto on_error;
+	}
+	if( libfsntfs_volume_get_number_of_file_entries(
+	     volume,
+	     &number_of_file_entries,
+	     error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve number of file entries.\n" );
+
+		goto on_error;
+	}
+	for( file_entry_index = 0;
+	     file_entry_index < number_of_file_entries;
+	     file_entry_index++ )
+	{
+		if( number_of_data_types_found == 3 )
+		{
+			break;
+		}
+		/* Unused MFT entries cannot be retrieved as a file entry
+		 */
+		if( libfsntfs_volume_get_file_entry_by_index(
+		     volume,
+		     file_entry_index,
+		     &file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_free(
+			 error );
+
+			continue;
+		}
+		result = fsntfs_test_seek_get_data_type(
+		          file_entry,
+		          &data_type,
+		          error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to determine data type of file entry: %" PRIu64 ".\n",
+			 file_entry_index );
+
+			goto on_error;
+		}
+		else if( ( result != 0 )
+		      && ( data_type != FSNTFS_TEST_SEEK_DATA_TYPE_OTHER )
+		      && ( data_type_found[ data_type ] == 0 ) )
+		{
+			if( libfsntfs_file_entry_get_size(
+			     file_entry,
+			     &file_size,
+			     error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to retrieve file entry: %" PRIu64 " size.\n",
+				 file_entry_index );
+
+				goto on_error;
+			}
+			if( file_size > 0 )
+			{
+				fprintf(
+				 stdout,
+				 "Testing seek of data and hole in %s file entry: %" PRIu64 "\n",
+				 data_type_descriptions[ data_type ],
+				 file_entry_index );
+
+				block_size            = cluster_block_size;
+				compression_unit_size = 0;
+
+				if( data_type == FSNTFS_TEST_SEEK_DATA_TYPE_RESIDENT )
+				{
+					block_size = 1;
+				}
+				else if( data_type == FSNTFS_TEST_SEEK_DATA_TYPE_COMPRESSED )
+				{
+					compression_unit_size = cluster_block_size * FSNTFS_TEST_SEEK_COMPRESSION_UNIT_NUMBER_OF_CLUSTERS;
+					block_size            = compression_unit_size;
+				}
+				result = fsntfs_test_seek_data_and_hole(
+				          file_entry,
+				          file_size,
+				          block_size,
+				          compression_unit_size,
+				          error );
+
+				if( result != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unable to test seek of data and hole.\n" );
+
+					libfsntfs_file_entry_free(
+					 &file_entry,
+					 NULL );
+
+					return( result );
+				}
+				data_type_found[ data_type ] = 1;
+
+				number_of_data_types_found++;
+			}
+		}
+		if( libfsntfs_file_entry_free(
+		     &file_entry,
+		     error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free file entry.\n" );
+
+			goto on_error;
+		}
+	}
+	for( data_type = FSNTFS_TEST_SEEK_DATA_TYPE_RESIDENT;
+	     data_type < FSNTFS_TEST_SEEK_DATA_TYPE_OTHER;
+	     data_type++ )
+	{
+		if( data_type_found[ data_type ] == 0 )
+		{
+			fprintf(
+			 stdout,
+			 "No %s file entry found, skipping seek of data and hole.\n",
+			 data_type_descriptions[ data_type ] );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		libfsntfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Tests seeking in a file entry
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -497,6 +1159,21 @@ int fsntfs_test_seek_file_entry(
 
 		goto on_error;
 	}
+	if( result == 1 )
+	{
+		result = fsntfs_test_seek_data_and_hole_in_volume(
+		          volume,
+		          error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to seek data and hole in volume.\n" );
+
+			goto on_error;
+		}
+	}
 	if( libfsntfs_file_entry_free(
 	     &file_entry,
 	     error ) != 1 )
@@ -589,7 +1266,6 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-/* TODO add compressed file seek test */
 /* TODO add ADS seek test */
 	return( EXIT_SUCCESS );
 